@@ -58,6 +58,27 @@ def enable_random(name, probability, failnum=1, failinfo=None, flags=0):
         raise RuntimeError(r)
 
 
+_delay_dists = {
+    "fixed": _ll.FIU_DELAY_FIXED,
+    "uniform": _ll.FIU_DELAY_UNIFORM,
+    "lognormal": _ll.FIU_DELAY_LOGNORMAL,
+}
+
+
+def enable_delay(name, usec, dist="fixed", param=0, probability=1, flags=0):
+    """Enables the given point of failure to delay the caller instead of
+    failing, with the given probability.
+
+    The delay is taken from the given distribution: "fixed" (always usec
+    microseconds), "uniform" (between usec and param), or "lognormal" (with
+    median usec, and param as the standard deviation of its logarithm)."""
+    r = _ll.enable_delay(
+        name, flags, probability, _delay_dists[dist], usec, param
+    )
+    if r != 0:
+        raise RuntimeError(r)
+
+
 def enable_external(name, cb, failnum=1, flags=0):
     """Enables the given point of failure, leaving the decision whether to
     fail or not to the given external function, which should return 0 if
@@ -116,3 +137,11 @@ def rc_fifo(basename):
     r = _ll.rc_fifo(basename)
     if r != 0:
         raise RuntimeError(r)
+
+
+def rc_fifo_lazy(basename, signum):
+    """Like rc_fifo(), but the named pipe is not created until the process
+    receives the given signal."""
+    r = _ll.rc_fifo_lazy(basename, signum)
+    if r != 0:
+        raise RuntimeError(r)
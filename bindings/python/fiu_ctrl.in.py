@@ -40,7 +40,8 @@ class _ControlBase(object):
     """Base class for remote control objects."""
 
     def run_raw_cmd(self, cmd, args):
-        """Runs a new raw command. To be implemented by subclasses"""
+        """Runs a new raw command, returns a list with the output lines (if
+        the command produces any). To be implemented by subclasses"""
         raise NotImplementedError
 
     def _basic_args(self, name, failnum, failinfo, flags):
@@ -68,6 +69,21 @@ class _ControlBase(object):
         args.append("probability=%f" % probability)
         self.run_raw_cmd("enable_random", args)
 
+    def enable_delay(
+        self, name, usec, dist="fixed", param=0, probability=1, flags=()
+    ):
+        """Enables the given point of failure to delay the caller instead of
+        failing, see fiu.enable_delay()."""
+        args = self._basic_args(name, None, None, flags)
+        args.append("delay=%f" % usec)
+        args.append("dist=%s" % dist)
+        if dist == "uniform":
+            args.append("max=%f" % param)
+        elif dist == "lognormal":
+            args.append("sigma=%f" % param)
+        args.append("probability=%f" % probability)
+        self.run_raw_cmd("enable_delay", args)
+
     def enable_stack_by_name(
         self,
         name,
@@ -92,6 +108,11 @@ class _ControlBase(object):
         """Disables the given point of failure."""
         self.run_raw_cmd("disable", ["name=%s" % name])
 
+    def list(self):
+        """Returns the enabled points of failure, as a list of the commands
+        that describe them (for example, "enable name=x,failnum=1,...")."""
+        return self.run_raw_cmd("list", [])
+
 
 def _open_with_timeout(path, mode, timeout=3):
     """Open a file, waiting if it doesn't exist yet."""
@@ -133,10 +154,26 @@ class PipeControl(_ControlBase):
         fd_in.write(s)
         fd_in.flush()
 
-        r = int(fd_out.readline())
+        # Commands can output some lines before the result, which is always
+        # the last line and just a number.
+        output = []
+        while True:
+            line = fd_out.readline()
+            if not line:
+                raise CommandError("Unexpected end of reply")
+
+            line = line.rstrip("\n")
+            try:
+                r = int(line)
+                break
+            except ValueError:
+                output.append(line)
+
         if r != 0:
             raise CommandError
 
+        return output
+
 
 class EnvironmentControl(_ControlBase):
     """Pre-execution environment control."""
@@ -146,7 +183,13 @@ class EnvironmentControl(_ControlBase):
 
     def run_raw_cmd(self, cmd, args):
         """Add a raw command to the environment."""
+        # Nothing is enabled until the process starts, so we just return
+        # the commands we have so far.
+        if cmd == "list":
+            return self.env.splitlines()
+
         self.env += "%s %s\n" % (cmd, ",".join(args))
+        return []
 
 
 class Subprocess(_ControlBase):
@@ -184,7 +227,7 @@ class Subprocess(_ControlBase):
         self.ctrl = EnvironmentControl()
 
     def run_raw_cmd(self, cmd, args):
-        self.ctrl.run_raw_cmd(cmd, args)
+        return self.ctrl.run_raw_cmd(cmd, args)
 
     def start(self):
         self.tmpdir = tempfile.mkdtemp(prefix="fiu_ctrl-")
@@ -80,6 +80,22 @@ static PyObject *enable_random(PyObject *self, PyObject *args)
 	    fiu_enable_random(name, failnum, failinfo, flags, probability));
 }
 
+static PyObject *enable_delay(PyObject *self, PyObject *args)
+{
+	char *name;
+	unsigned int flags;
+	double probability;
+	int dist;
+	double usec, param;
+
+	if (!PyArg_ParseTuple(args, "sIdidd:enable_delay", &name, &flags,
+	                      &probability, &dist, &usec, &param))
+		return NULL;
+
+	return PyLong_FromLong(
+	    fiu_enable_delay(name, flags, probability, dist, usec, param));
+}
+
 static int external_callback(const char *name, int *failnum, void **failinfo,
                              unsigned int *flags)
 {
@@ -206,17 +222,30 @@ static PyObject *rc_fifo(PyObject *self, PyObject *args)
 	return PyLong_FromLong(fiu_rc_fifo(basename));
 }
 
+static PyObject *rc_fifo_lazy(PyObject *self, PyObject *args)
+{
+	char *basename;
+	int signum;
+
+	if (!PyArg_ParseTuple(args, "si:rc_fifo_lazy", &basename, &signum))
+		return NULL;
+
+	return PyLong_FromLong(fiu_rc_fifo_lazy(basename, signum));
+}
+
 static PyMethodDef fiu_methods[] = {
     {"fail", (PyCFunction)fail, METH_VARARGS, NULL},
     {"failinfo", (PyCFunction)failinfo, METH_VARARGS, NULL},
     {"enable", (PyCFunction)enable, METH_VARARGS, NULL},
     {"enable_random", (PyCFunction)enable_random, METH_VARARGS, NULL},
+    {"enable_delay", (PyCFunction)enable_delay, METH_VARARGS, NULL},
     {"enable_external", (PyCFunction)enable_external, METH_VARARGS, NULL},
     {"enable_stack_by_name", (PyCFunction)enable_stack_by_name, METH_VARARGS,
      NULL},
     {"disable", (PyCFunction)disable, METH_VARARGS, NULL},
     {"set_prng_seed", (PyCFunction)set_prng_seed, METH_VARARGS, NULL},
     {"rc_fifo", (PyCFunction)rc_fifo, METH_VARARGS, NULL},
+    {"rc_fifo_lazy", (PyCFunction)rc_fifo_lazy, METH_VARARGS, NULL},
     {NULL}};
 
 static PyModuleDef fiu_module = {
@@ -233,6 +262,9 @@ PyMODINIT_FUNC PyInit_fiu_ll(void)
 	m = PyModule_Create(&fiu_module);
 
 	PyModule_AddIntConstant(m, "FIU_ONETIME", FIU_ONETIME);
+	PyModule_AddIntConstant(m, "FIU_DELAY_FIXED", FIU_DELAY_FIXED);
+	PyModule_AddIntConstant(m, "FIU_DELAY_UNIFORM", FIU_DELAY_UNIFORM);
+	PyModule_AddIntConstant(m, "FIU_DELAY_LOGNORMAL", FIU_DELAY_LOGNORMAL);
 
 	fiu_init(0);
 
@@ -9,6 +9,9 @@
 #ifndef _FIU_CONTROL_H
 #define _FIU_CONTROL_H
 
+#include <stddef.h> /* size_t */
+#include <stdint.h> /* uint64_t, int64_t */
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -20,6 +23,12 @@ extern "C" {
 #define FIU_ONETIME 1
 
 /** Enables the given point of failure unconditionally.
+ *
+ * The name can end in '*' to enable all the points of failure that begin
+ * with the rest of it; any other '*' or '?' in it is a literal character. If
+ * it begins with "glob:", the rest of it is a glob pattern instead, where
+ * '*' matches any sequence of characters and '?' any single character. The
+ * other fiu_enable*() functions take the same names.
  *
  * @param name  Name of the point of failure to enable.
  * @param failnum  What will fiu_fail() return, must be != 0.
@@ -111,6 +120,44 @@ int fiu_enable_stack_by_name(const char *name, int failnum, void *failinfo,
                              unsigned int flags, const char *func_name,
                              int func_pos_in_stack);
 
+/** Distributions of the delays, for fiu_enable_delay(). */
+#define FIU_DELAY_FIXED 1
+#define FIU_DELAY_UNIFORM 2
+#define FIU_DELAY_LOGNORMAL 3
+
+/** Enables the given point of failure to delay the caller instead of making
+ * it fail.
+ *
+ * When the point is checked, with the given probability the caller sleeps
+ * for a duration taken from the given distribution, and then fiu_fail()
+ * returns 0 as usual. Delays of up to 10ms are accurate to within a few
+ * microseconds, as their last 100us are spent busy-waiting instead of
+ * sleeping, which uses that much CPU time; the FIU_DELAY_SPIN environment
+ * variable changes how long that is (in microseconds), and 0 turns it off.
+ * Longer delays just sleep, and can be late by the kernel's timer slack.
+ *
+ * With the POSIX preload library this simulates slow system calls, as the
+ * wrappers check their points before calling the original function. Note
+ * that a point enabled with a wildcard can match more than one of the points
+ * a function checks (for example posix/io/rw/read and
+ * posix/io/rw/read/reduce), and then the call is delayed once for each.
+ *
+ * @param name  Name of the point of failure to enable.
+ * @param flags  Flags; with FIU_ONETIME, it only delays once.
+ * @param probability  Probability of delaying each time the point is
+ * 		checked, between 0 and 1.
+ * @param dist  Distribution of the delay: FIU_DELAY_FIXED (always usec),
+ * 		FIU_DELAY_UNIFORM (between usec and param), or
+ * 		FIU_DELAY_LOGNORMAL (with median usec, and param as the
+ * 		standard deviation of its logarithm, which makes the tail
+ * 		longer as it grows).
+ * @param usec  Delay in microseconds, see dist.
+ * @param param  Second parameter of the distribution, see dist.
+ * @returns  0 if success, < 0 otherwise.
+ */
+int fiu_enable_delay(const char *name, unsigned int flags, float probability,
+                     int dist, double usec, double param);
+
 /** Disables the given point of failure. That makes it NOT fail.
  *
  * @param name  Name of the point of failure to disable.
@@ -118,6 +165,253 @@ int fiu_enable_stack_by_name(const char *name, int failnum, void *failinfo,
  */
 int fiu_disable(const char *name);
 
+/** Restricts an enabled point of failure to operations on a path.
+ *
+ * The point of failure will only fail when it is checked with a path that
+ * begins with the given prefix, using fiu_fail_path() or fiu_fail_id_path().
+ * The POSIX preload library does that for the functions that take a path or
+ * a file descriptor, so for example "posix/io/rw/write" can be restricted to
+ * "/data/wal/" without affecting writes to other files. Paths are compared
+ * as given to the functions, they are not made absolute nor resolved.
+ *
+ * The restriction is removed when the point of failure is disabled or
+ * enabled again. The remote control "path" parameter (see fiu_rc_fifo())
+ * applies it at the same time the point is enabled, so it never fails for
+ * other paths in between.
+ *
+ * @param name  Name of the enabled point of failure (exactly as it was
+ *		enabled, wildcards are not expanded).
+ * @param prefix  Path prefix, or NULL to remove the restriction.
+ * @returns  0 if success, < 0 otherwise (for example, if the point is not
+ *		enabled).
+ */
+int fiu_set_path(const char *name, const char *prefix);
+
+/** Tells if any point of failure was ever restricted to a path, with
+ * fiu_set_path() or the remote control "path" parameter.
+ *
+ * Once set, it stays set. The POSIX preload library only records the paths
+ * of the file descriptors after that, so the ones opened before are not
+ * known, and the points restricted to a path never fail for them.
+ *
+ * @returns  1 if a path was ever set, 0 otherwise.
+ */
+int fiu_paths_used(void);
+
+/** Makes an enabled point of failure fail in bursts.
+ *
+ * Once the point of failure fails, it keeps failing for the following checks
+ * until it has failed count times in a row, without looking at how it was
+ * enabled (its probability, for example). Combined with fiu_enable_random(),
+ * this gives occasional storms of failures, like the bursts of spurious
+ * EAGAIN a busy network can produce.
+ *
+ * Like fiu_set_path(), the setting is removed when the point of failure is
+ * disabled or enabled again, and the remote control "burst" parameter
+ * applies it at the same time the point is enabled.
+ *
+ * @param name  Name of the enabled point of failure (exactly as it was
+ *		enabled, wildcards are not expanded).
+ * @param count  How many times it fails in a row; 0 or 1 to fail normally.
+ * @returns  0 if success, < 0 otherwise (for example, if the point is not
+ *		enabled).
+ */
+int fiu_set_burst(const char *name, unsigned int count);
+
+/** Restricts an enabled point of failure to big operations.
+ *
+ * The point of failure will only fail when it is checked with
+ * fiu_fail_id_size() for an operation of at least min_size bytes, and when
+ * the total the caller gives along with it is at least min_total. The POSIX
+ * preload library does that for the memory allocation functions, passing
+ * the size being allocated, and as the total, the memory the allocator got
+ * from the system (only available with glibc); so for example
+ * "libc/mm/malloc" can be restricted to allocations of 1 MiB or more, to
+ * test the code that handles them without breaking all the small ones.
+ *
+ * Small operations are discarded without taking any locks, so a restricted
+ * point of failure costs very little to the operations it does not cover.
+ *
+ * Like fiu_set_path(), the setting is removed when the point of failure is
+ * disabled or enabled again, and the remote control "minsize" and
+ * "mintotal" parameters apply it at the same time the point is enabled.
+ *
+ * @param name  Name of the enabled point of failure (exactly as it was
+ *		enabled, wildcards are not expanded).
+ * @param min_size  Minimum size of the operation, 0 for no minimum.
+ * @param min_total  Minimum total, 0 for no minimum.
+ * @returns  0 if success, < 0 otherwise (for example, if the point is not
+ *		enabled).
+ */
+int fiu_set_size(const char *name, size_t min_size, size_t min_total);
+
+/** Restricts an enabled point of failure to operations whose arguments match
+ * a predicate.
+ *
+ * The point of failure will only fail when it is checked with
+ * fiu_fail_id_op() for an operation whose arguments match. The POSIX preload
+ * library gives each function's parameters as the arguments, in order, so
+ * for example "posix/io/rw/write" can be restricted to writes of more than
+ * 4096 bytes to the file descriptor 7 with "arg1==7&&arg3>4096".
+ *
+ * The predicate is a list of comparisons between an argument (argN, counting
+ * from 1) and a number, with ==, !=, <, <=, >, >= or & (true if any of the
+ * bits are set), joined with && and ||, without spaces nor parentheses. It is
+ * compiled once, here, so checking it is cheap.
+ *
+ * Like fiu_set_path(), the setting is removed when the point of failure is
+ * disabled or enabled again, and the remote control "when" parameter
+ * applies it at the same time the point is enabled.
+ *
+ * @param name  Name of the enabled point of failure (exactly as it was
+ *		enabled, wildcards are not expanded).
+ * @param predicate  The predicate, or NULL to remove the restriction.
+ * @returns  0 if success, < 0 otherwise (for example, if the point is not
+ *		enabled, or the predicate is not valid).
+ */
+int fiu_set_predicate(const char *name, const char *predicate);
+
+/** Restricts an enabled point of failure to some threads.
+ *
+ * The point of failure will only fail in the threads with the given thread
+ * ID (as returned by gettid()), or whose name (as set with
+ * pthread_setname_np()) is the given one, or that have been tagged with
+ * fiu_thread_tag(). The thread name can have wildcards, like the names of
+ * the points of failure. Only the ones given (non-zero or non-NULL) are
+ * used, and matching any of them is enough.
+ *
+ * Each thread works out which restrictions it matches when it first checks
+ * a point after they change, so checking is cheap. The names are read at
+ * that time, so threads should be named before then (tags don't have this
+ * problem). Thread IDs and names are only available on Linux.
+ *
+ * Like fiu_set_path(), the setting is removed when the point of failure is
+ * disabled or enabled again, and the remote control "tid", "thread" and
+ * "tag" parameters apply it at the same time the point is enabled.
+ *
+ * @param name  Name of the enabled point of failure (exactly as it was
+ *		enabled, wildcards are not expanded).
+ * @param tid  Thread ID, or 0.
+ * @param thread_name  Thread name, or NULL.
+ * @param tag  Tag, or NULL.
+ * @returns  0 if success, < 0 otherwise (for example, if the point is not
+ *		enabled, or there are too many different restrictions in
+ *		use).
+ */
+int fiu_set_threads(const char *name, long tid, const char *thread_name,
+                    const char *tag);
+
+/** Returns the seed of libfiu's PRNG: the one given to fiu_set_prng_seed()
+ * (or with FIU_PRNG_SEED), or otherwise one taken from the clock, which
+ * changes after each fork().
+ *
+ * This is for code that has its own PRNG, like the POSIX preload library, so
+ * it can derive its seeds from libfiu's, and setting that one is enough to
+ * reproduce the results of both.
+ *
+ * @param gen  If not NULL, it's set to a number that changes every time the
+ * 	seed does.
+ * @returns  The seed.
+ */
+uint64_t fiu_get_prng_seed(unsigned int *gen);
+
+/** Watches a set of points of failure.
+ *
+ * libfiu will keep the given bit mask up to date so that bit i (that is,
+ * mask[i / 64] & (1 << (i % 64))) is set while names[i] is covered by an
+ * enabled point of failure (either directly or by a wildcard), and clear
+ * otherwise. This allows callers with many points of failure (like the POSIX
+ * preload library) to skip fiu_fail() entirely when it could not possibly
+ * fail, with a single load.
+ *
+ * The words are written atomically, and can be read with a relaxed atomic
+ * load. A set bit only means fiu_fail() could fail, not that it will.
+ *
+ * The names array and the mask must be valid for the lifetime of the
+ * process; NULL names are allowed and their bits are never set.
+ *
+ * @param names  Names of the points of failure to watch.
+ * @param n  Number of elements in names.
+ * @param mask  Bit mask to update, with room for at least n bits.
+ * @returns  0 on success, -1 on errors. */
+int fiu_watch(const char *const *names, unsigned int n, uint64_t *mask);
+
+/** Opaque handle to a set of watched points of failure, see
+ * fiu_watch_ids(). */
+struct fiu_watch;
+
+/** Watches a set of points of failure, and allows checking them by ID.
+ *
+ * Like fiu_watch(), but returns a handle that can be given to fiu_fail_id()
+ * to check names[id] without looking it up by name, which is cheaper than
+ * fiu_fail() for callers that check the same points over and over again.
+ *
+ * @param names  Names of the points of failure to watch.
+ * @param n  Number of elements in names.
+ * @param mask  Bit mask to update, with room for at least n bits.
+ * @returns  The handle on success, NULL on errors. */
+struct fiu_watch *fiu_watch_ids(const char *const *names, unsigned int n,
+                                uint64_t *mask);
+
+/** Returns how many arguments the predicate of a watched point of failure
+ * looks at (see fiu_set_predicate()), that is, one more than the position of
+ * the last one; 0 if it's not enabled or has no predicate.
+ *
+ * Callers of fiu_fail_id_op() can use it to skip working out the arguments
+ * nobody looks at, and give only the first ones. It can change at any time,
+ * but if it grows right before the check, the predicate just doesn't match.
+ *
+ * @param watch  Handle returned by fiu_watch_ids(); if NULL, it returns 0.
+ * @param id  Position of the point of failure in the watched names.
+ * @returns  The number of arguments. */
+unsigned int fiu_watch_nargs(struct fiu_watch *watch, unsigned int id);
+
+/** Returns the failure status of a watched point of failure.
+ *
+ * It behaves exactly like fiu_fail(names[id]) would (see fiu.h), including
+ * setting the information returned by fiu_failinfo().
+ *
+ * @param watch  Handle returned by fiu_watch_ids(); if NULL, it returns 0.
+ * @param id  Position of the point of failure in the watched names.
+ * @returns  0 if the point of failure should not fail, the failnum it was
+ *		enabled with otherwise. */
+int fiu_fail_id(struct fiu_watch *watch, unsigned int id);
+
+/** Like fiu_fail_id(), for an operation on the given path (see
+ * fiu_fail_path()). */
+int fiu_fail_id_path(struct fiu_watch *watch, unsigned int id,
+                     const char *path);
+
+/** Description of an operation, for the points of failure restricted to
+ * some of them (see fiu_fail_id_op()). Fields that don't apply to an
+ * operation can be left as 0 or NULL, and then the points restricted by
+ * them never fail. */
+struct fiu_op {
+	/** The path the operation is on, see fiu_set_path(). */
+	const char *path;
+
+	/** Its size, and a function returning the total, see
+	 * fiu_set_size(). */
+	size_t size;
+	size_t (*total)(void);
+
+	/** Its arguments, see fiu_set_predicate(). */
+	const int64_t *args;
+	unsigned int nargs;
+};
+
+/** Like fiu_fail_id(), for the given operation. It checks all the
+ * restrictions of the point of failure (path, size and predicate). */
+int fiu_fail_id_op(struct fiu_watch *watch, unsigned int id,
+                   const struct fiu_op *op);
+
+/** Like fiu_fail_id_path(), for an operation of the given size (see
+ * fiu_set_size()). The total function is only called if the point of
+ * failure is restricted by it, and the size is big enough; it can be NULL
+ * if there is no total, and then those points never fail. */
+int fiu_fail_id_size(struct fiu_watch *watch, unsigned int id,
+                     const char *path, size_t size, size_t (*total)(void));
+
 /** Enables remote control over a named pipe.
  *
  * The name pipe path will begin with the given basename. "-$PID" will be
@@ -131,6 +425,24 @@ int fiu_disable(const char *name);
  * @returns  0 on success, -1 on errors. */
 int fiu_rc_fifo(const char *basename);
 
+/** Enables remote control over a named pipe, lazily.
+ *
+ * Like fiu_rc_fifo(), but the named pipes (and the thread serving them) are
+ * not created until the process receives the given signal. This also applies
+ * to the processes it forks, which makes fork() much cheaper for programs
+ * that fork a lot of children; only the ones that are signalled pay the cost.
+ * As the signal handler can't create them, they are created by the next call
+ * to fiu_fail() (or its variants) after the signal; a process that doesn't
+ * make any won't answer.
+ *
+ * The given signal should not be used by the program, as the handler will be
+ * replaced.
+ *
+ * @param basename  Base path to use in the creation of the named pipes.
+ * @param signum  Signal that triggers the creation of the named pipes.
+ * @returns  0 on success, -1 on errors. */
+int fiu_rc_fifo_lazy(const char *basename, int signum);
+
 /** Applies a remote control command given via a string.
  *
  * The format of the string is not stable and is still subject to change.
@@ -144,6 +456,35 @@ int fiu_rc_fifo(const char *basename);
  */
 int fiu_rc_string(const char *cmd, char **const error);
 
+/** Lists the enabled points of failure.
+ *
+ * Calls cb once for each enabled point of failure, with the remote control
+ * command that describes it, like the "list" command does. Applying the
+ * commands with fiu_rc_string() enables the same points again, except for
+ * the ones enabled with fiu_enable_external() and fiu_enable_stack(), whose
+ * commands are only descriptive. The points whose command doesn't fit in a
+ * line (see the remote control documentation) are left out. It's not an
+ * atomic snapshot: points enabled or disabled meanwhile may or may not show
+ * up.
+ *
+ * @param cb  Function to call with each command; if it returns < 0, the
+ *		listing stops.
+ * @param arg  Passed to cb as is.
+ * @returns  0 if success, < 0 otherwise.
+ */
+int fiu_rc_list(int (*cb)(const char *line, void *arg), void *arg);
+
+/** Tells when the output of fiu_rc_list() may have changed.
+ *
+ * This is for callers that keep the commands around, like the POSIX preload
+ * library does to pass them to the programs it runs, so they only list them
+ * again when needed.
+ *
+ * @returns  A number that changes every time the enabled points of failure
+ * 	(or their restrictions) do.
+ */
+unsigned int fiu_rc_list_gen(void);
+
 #ifdef __cplusplus
 }
 #endif
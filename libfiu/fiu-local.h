@@ -22,8 +22,12 @@
 
 #define fiu_init(flags) 0
 #define fiu_fail(name) 0
+#define fiu_fail_path(name, path) 0
 #define fiu_failinfo() NULL
+#define fiu_thread_tag(tag) 0
+#define fiu_thread_untag(tag) 0
 #define fiu_do_on(name, action)
+#define fiu_delay_on(name)
 #define fiu_exit_on(name)
 #define fiu_return_on(name, retval)
 
@@ -6,6 +6,9 @@
 #include <errno.h>     /* errno and friends */
 #include <fcntl.h>     /* open() and friends */
 #include <pthread.h>   /* pthread_create() and friends */
+#include <signal.h>    /* sigaddset() and friends */
+#include <stdarg.h>    /* va_list */
+#include <stdbool.h>   /* bool */
 #include <stdio.h>     /* snprintf() */
 #include <stdlib.h>    /* malloc()/free() */
 #include <string.h>    /* strncpy() */
@@ -19,9 +22,6 @@
 #include "fiu-control.h"
 #include "internal.h"
 
-/* Max length of a line containing a control directive */
-#define MAX_LINE 512
-
 /*
  * Generic remote control
  */
@@ -61,6 +61,67 @@ static int read_line(int fd, char *buf)
 	return len;
 }
 
+/* Parses a size in bytes, with an optional k, M or G suffix (in powers of
+ * 1024). Returns 0 if it can't be parsed. */
+static size_t parse_size(const char *s)
+{
+	unsigned long long n;
+	char *end;
+
+	n = strtoull(s, &end, 10);
+	switch (*end) {
+	case 'k':
+	case 'K':
+		return n << 10;
+	case 'm':
+	case 'M':
+		return n << 20;
+	case 'g':
+	case 'G':
+		return n << 30;
+	default:
+		return n;
+	}
+}
+
+/* Splits the next parameter off *s, and returns it. Parameters are separated
+ * by commas, and end at the first whitespace. A backslash makes the
+ * character after it part of the parameter (and is removed), so values can
+ * contain commas, whitespace and backslashes. Leaves *s at the next one. */
+static char *next_param(char **s)
+{
+	char *param = *s, *in = *s, *out = *s;
+	char c;
+
+	while (*in != '\0' && *in != ',' && *in != ' ' && *in != '\t') {
+		if (*in == '\\' && in[1] != '\0')
+			in++;
+		*out++ = *in++;
+	}
+
+	c = *in;
+	*out = '\0';
+	*s = c == ',' ? in + 1 : in + strlen(in);
+	return param;
+}
+
+/* Like getsubopt(), but for the parameters as split by next_param(). */
+static int parse_param(char *param, char *const *token, char **value)
+{
+	int i;
+
+	*value = strchr(param, '=');
+	if (*value != NULL)
+		*(*value)++ = '\0';
+
+	for (i = 0; token[i] != NULL; i++) {
+		if (strcmp(param, token[i]) == 0)
+			return i;
+	}
+
+	return -1;
+}
+
 /* Remote control command processing.
  *
  * Supported commands:
@@ -68,15 +129,43 @@ static int read_line(int fd, char *buf)
  *  - enable name=N,failnum=F,failinfo=I
  *  - enable_random <same as enable>,probability=P
  *  - enable_stack_by_name <same as enable>,func_name=F,pos_in_stack=P
+ *  - enable_delay name=N,delay=D[,dist=fixed|uniform|lognormal]
+ *      [,max=M][,sigma=S][,probability=P]
+ *      (delays D microseconds; with dist=uniform, between D and M; with
+ *      dist=lognormal, D is the median and S the standard deviation of its
+ *      logarithm; see fiu_enable_delay())
+ *  - list
+ *  - ping
  *
  * All enable* commands can also take an additional "onetime" parameter,
  * indicating that this should only fail once (analogous to the FIU_ONETIME
- * flag).
+ * flag), a "path=P" parameter, restricting the point of failure to
+ * operations on paths that begin with P (see fiu_set_path()), a
+ * "burst=B" parameter, making it fail B times in a row once it fails (see
+ * fiu_set_burst()), and "minsize=S" and "mintotal=T" parameters, restricting
+ * it to operations of at least S bytes when the total is at least T (see
+ * fiu_set_size(); both take an optional k, M or G suffix), and a "when=W"
+ * parameter, restricting it to operations whose arguments match the
+ * predicate W (see fiu_set_predicate()), and "tid=T", "thread=N" and
+ * "tag=G" parameters, restricting it to the thread with ID T, the threads
+ * named N, and the threads tagged with G (see fiu_set_threads()).
+ *
+ * In the values, a backslash escapes the character after it, for the ones
+ * that would end them otherwise (commas, whitespace and backslashes); see
+ * next_param() and rc_append_value().
+ *
+ * The list command outputs, using the given out() function, one line per
+ * enabled point of failure; each line is the enable* command that describes
+ * it. It is only available if out is not NULL.
+ *
+ * The ping command does nothing, it is used to check that the process is
+ * alive and its remote control is working.
  *
  * This function is ugly, but we aim for simplicity and ease to extend for
  * future commands.
  */
-int fiu_rc_string(const char *cmd, char **const error)
+static int rc_string(const char *cmd, char **const error,
+                     int (*out)(const char *line, void *arg), void *out_arg)
 {
 	char m_cmd[MAX_LINE] = {0};
 	char command[MAX_LINE] = {0};
@@ -85,23 +174,22 @@ int fiu_rc_string(const char *cmd, char **const error)
 	/* We need a version of cmd we can write to for parsing */
 	strncpy(m_cmd, cmd, MAX_LINE - 1);
 
-	/* Separate command and parameters */
+	/* Separate command and parameters; the latter can have escaped
+	 * whitespace, so next_param() finds where they end. */
 	{
-		char *tok = NULL, *state = NULL;
+		char *s = m_cmd + strspn(m_cmd, " \t");
+		size_t len = strcspn(s, " \t");
 
-		tok = strtok_r(m_cmd, " \t", &state);
-		if (tok == NULL) {
+		if (len == 0) {
 			*error = "Cannot get command";
 			return -1;
 		}
-		strncpy(command, tok, MAX_LINE - 1);
+		memcpy(command, s, len);
 
-		tok = strtok_r(NULL, " \t", &state);
-		if (tok == NULL) {
-			*error = "Cannot get parameters";
-			return -1;
-		}
-		strncpy(parameters, tok, MAX_LINE - 1);
+		/* Parameters are optional, as some commands don't take any. */
+		s += len;
+		s += strspn(s, " \t");
+		strncpy(parameters, s, MAX_LINE - 1);
 	}
 
 	/* Parsing of parameters.
@@ -116,6 +204,14 @@ int fiu_rc_string(const char *cmd, char **const error)
 	double probability = -1;
 	char *func_name = NULL;
 	int func_pos_in_stack = -1;
+	char *path = NULL;
+	unsigned int burst = 0;
+	size_t min_size = 0, min_total = 0;
+	char *when = NULL;
+	long tid = 0;
+	char *thread_name = NULL, *tag = NULL;
+	int dist = FIU_DELAY_FIXED;
+	double delay = -1, delay_param = 0;
 
 	{
 		/* Different tokens that we accept as parameters */
@@ -126,6 +222,18 @@ int fiu_rc_string(const char *cmd, char **const error)
 			OPT_PROBABILITY,
 			OPT_FUNC_NAME,
 			OPT_POS_IN_STACK,
+			OPT_PATH,
+			OPT_BURST,
+			OPT_MINSIZE,
+			OPT_MINTOTAL,
+			OPT_WHEN,
+			OPT_TID,
+			OPT_THREAD,
+			OPT_TAG,
+			OPT_DIST,
+			OPT_DELAY,
+			OPT_MAX,
+			OPT_SIGMA,
 			FLAG_ONETIME,
 		};
 		char *const token[] = {[OPT_NAME] = "name",
@@ -134,13 +242,25 @@ int fiu_rc_string(const char *cmd, char **const error)
 		                       [OPT_PROBABILITY] = "probability",
 		                       [OPT_FUNC_NAME] = "func_name",
 		                       [OPT_POS_IN_STACK] = "pos_in_stack",
+		                       [OPT_PATH] = "path",
+		                       [OPT_BURST] = "burst",
+		                       [OPT_MINSIZE] = "minsize",
+		                       [OPT_MINTOTAL] = "mintotal",
+		                       [OPT_WHEN] = "when",
+		                       [OPT_TID] = "tid",
+		                       [OPT_THREAD] = "thread",
+		                       [OPT_TAG] = "tag",
+		                       [OPT_DIST] = "dist",
+		                       [OPT_DELAY] = "delay",
+		                       [OPT_MAX] = "max",
+		                       [OPT_SIGMA] = "sigma",
 		                       [FLAG_ONETIME] = "onetime",
 		                       NULL};
 
 		char *value;
 		char *opts = parameters;
 		while (*opts != '\0') {
-			switch (getsubopt(&opts, token, &value)) {
+			switch (parse_param(next_param(&opts), token, &value)) {
 			case OPT_NAME:
 				fp_name = value;
 				break;
@@ -159,6 +279,44 @@ int fiu_rc_string(const char *cmd, char **const error)
 			case OPT_POS_IN_STACK:
 				func_pos_in_stack = atoi(value);
 				break;
+			case OPT_PATH:
+				path = value;
+				break;
+			case OPT_BURST:
+				burst = strtoul(value, NULL, 10);
+				break;
+			case OPT_MINSIZE:
+				min_size = parse_size(value);
+				break;
+			case OPT_MINTOTAL:
+				min_total = parse_size(value);
+				break;
+			case OPT_WHEN:
+				when = value;
+				break;
+			case OPT_TID:
+				tid = strtol(value, NULL, 10);
+				break;
+			case OPT_THREAD:
+				thread_name = value;
+				break;
+			case OPT_TAG:
+				tag = value;
+				break;
+			case OPT_DIST:
+				dist = delay_dist_from_name(value);
+				if (dist < 0) {
+					*error = "Unknown distribution";
+					return -1;
+				}
+				break;
+			case OPT_DELAY:
+				delay = strtod(value, NULL);
+				break;
+			case OPT_MAX:
+			case OPT_SIGMA:
+				delay_param = strtod(value, NULL);
+				break;
 			case FLAG_ONETIME:
 				flags |= FIU_ONETIME;
 				break;
@@ -170,29 +328,143 @@ int fiu_rc_string(const char *cmd, char **const error)
 	}
 
 	/* Excecute the command */
+	if (strcmp(command, "ping") == 0) {
+		return 0;
+	} else if (strcmp(command, "list") == 0) {
+		*error = "Error in list";
+		if (out == NULL)
+			return -1;
+		return dump_enabled_fails(out, out_arg);
+	}
+
+	if (fp_name == NULL) {
+		*error = "Missing name";
+		return -1;
+	}
+
 	if (strcmp(command, "disable") == 0) {
 		*error = "Error in disable";
 		return fiu_disable(fp_name);
-	} else if (strcmp(command, "enable") == 0) {
+	}
+
+	/* The restrictions and the burst must be in place from the start, so
+	 * the point never fails for other paths or sizes, nor just once. */
+	int r;
+	pf_next_path(path);
+	pf_next_burst(burst);
+	pf_next_size(min_size, min_total);
+	pf_next_predicate(when);
+	pf_next_threads(tid, thread_name, tag);
+
+	if (strcmp(command, "enable") == 0) {
 		*error = "Error in enable";
-		return fiu_enable(fp_name, failnum, failinfo, flags);
+		r = fiu_enable(fp_name, failnum, failinfo, flags);
 	} else if (strcmp(command, "enable_random") == 0) {
 		*error = "Error in enable_random";
-		return fiu_enable_random(fp_name, failnum, failinfo, flags,
-		                         probability);
+		r = fiu_enable_random(fp_name, failnum, failinfo, flags,
+		                      probability);
 	} else if (strcmp(command, "enable_stack_by_name") == 0) {
 		*error = "Error in enable_stack_by_name";
-		return fiu_enable_stack_by_name(fp_name, failnum, failinfo,
-		                                flags, func_name,
-		                                func_pos_in_stack);
+		r = fiu_enable_stack_by_name(fp_name, failnum, failinfo, flags,
+		                             func_name, func_pos_in_stack);
+	} else if (strcmp(command, "enable_delay") == 0) {
+		*error = "Error in enable_delay";
+		r = fiu_enable_delay(fp_name, flags,
+		                     probability < 0 ? 1 : probability, dist,
+		                     delay, delay_param);
 	} else {
 		*error = "Unknown command";
-		return -1;
+		r = -1;
+	}
+
+	pf_next_path(NULL);
+	pf_next_burst(0);
+	pf_next_size(0, 0);
+	pf_next_predicate(NULL);
+	pf_next_threads(0, NULL, NULL);
+	return r;
+}
+
+size_t rc_append(char *buf, size_t len, size_t n, const char *fmt, ...)
+{
+	va_list ap;
+	int r;
+
+	if (n >= len)
+		return len;
+
+	va_start(ap, fmt);
+	r = vsnprintf(buf + n, len - n, fmt, ap);
+	va_end(ap);
+
+	if (r < 0 || (size_t)r >= len - n)
+		return len;
+	return n + r;
+}
+
+size_t rc_append_value(char *buf, size_t len, size_t n, const char *prefix,
+                       const char *value)
+{
+	n = rc_append(buf, len, n, "%s", prefix);
+
+	for (; *value != '\0'; value++) {
+		/* Lines can't be escaped, they end the command. */
+		if (*value == '\n' || *value == '\r')
+			return len;
+
+		if (*value == ',' || *value == ' ' || *value == '\t' ||
+		    *value == '\\') {
+			if (n + 1 >= len)
+				return len;
+			buf[n++] = '\\';
+		}
+
+		if (n + 1 >= len)
+			return len;
+		buf[n++] = *value;
 	}
+
+	if (n < len)
+		buf[n] = '\0';
+	return n;
+}
+
+int fiu_rc_string(const char *cmd, char **const error)
+{
+	return rc_string(cmd, error, NULL, NULL);
+}
+
+int fiu_rc_list(int (*cb)(const char *line, void *arg), void *arg)
+{
+	return dump_enabled_fails(cb, arg);
+}
+
+unsigned int fiu_rc_list_gen(void)
+{
+	return dump_gen();
+}
+
+/* Output function for rc_string(), writes the line to the fd pointed to by
+ * arg. */
+static int rc_write_line(const char *line, void *arg)
+{
+	int fdw = *(int *)arg;
+	char buf[MAX_LINE + 1];
+	int len;
+
+	len = snprintf(buf, MAX_LINE + 1, "%s\n", line);
+	if (len > MAX_LINE)
+		len = MAX_LINE;
+
+	if (write(fdw, buf, len) != len)
+		return -1;
+
+	return 0;
 }
 
 /* Read remote control directives from fdr and process them, writing the
- * results in fdw. Returns the length of the line read, 0 if EOF, or < 0 on
+ * results in fdw. Commands that produce output (like list) write it before
+ * the result line. Returns the length of the line read, 0 if EOF, or < 0 on
  * error. */
 static int rc_do_command(int fdr, int fdw)
 {
@@ -204,7 +476,7 @@ static int rc_do_command(int fdr, int fdw)
 	if (len <= 0)
 		return len;
 
-	r = fiu_rc_string(buf, &error);
+	r = rc_string(buf, &error, rc_write_line, &fdw);
 	if (r < 0)
 		fprintf(stderr, "libfiu: rc parsing error: %s\n", error);
 
@@ -233,12 +505,20 @@ static char *npipe_path_out = NULL;
 static void *rc_fifo_thread(void *unused)
 {
 	int fdr, fdw, r, errcount;
+	sigset_t sigset;
 
 	/* increment the recursion count so we're not affected by libfiu,
 	 * otherwise we could make the remote control useless by enabling all
 	 * failure points */
 	rec_count++;
 
+	/* If the other end goes away while we are writing (which can happen
+	 * in the middle of a long list), we want write() to return EPIPE
+	 * instead of getting the whole process killed. */
+	sigemptyset(&sigset);
+	sigaddset(&sigset, SIGPIPE);
+	pthread_sigmask(SIG_BLOCK, &sigset, NULL);
+
 	errcount = 0;
 
 reopen:
@@ -279,6 +559,11 @@ reopen:
 
 static void fifo_atexit(void)
 {
+	/* The paths can be NULL in lazy mode, if we forked but the child never
+	 * created its own pipes; see fifo_lazy_atfork_child(). */
+	if (npipe_path_in == NULL)
+		return;
+
 	unlink(npipe_path_in);
 	unlink(npipe_path_out);
 }
@@ -344,3 +629,99 @@ int fiu_rc_fifo(const char *basename)
 
 	return r;
 }
+
+/*
+ * Lazy remote control via named pipes
+ *
+ * Creating the pipes and the thread on every fork() is expensive for
+ * programs that fork a lot (like prefork servers). In lazy mode, they are not
+ * created until the process receives a signal, and a fork() only resets our
+ * state.
+ *
+ * The signal handler can't safely create the thread, so it just leaves a
+ * request in rc_lazy_pending, which the next call to fiu_fail() and friends
+ * picks up (see rc_lazy_start()). So the preload libraries' wrappers make
+ * that call even when none of their points of failure is enabled, the
+ * handler also sets all the bits of the watch masks, which are recomputed
+ * afterwards (see watches_poke()).
+ */
+
+int rc_lazy_pending = 0;
+
+/* Whether this process has created (or is creating) its named pipes. */
+static bool lazy_started = false;
+
+/* Whether the watch masks may have the bits the handler set. */
+static bool lazy_poked = false;
+
+static void fifo_lazy_signal(int signum)
+{
+	__atomic_store_n(&lazy_poked, true, __ATOMIC_RELAXED);
+	__atomic_store_n(&rc_lazy_pending, RC_LAZY_START, __ATOMIC_RELAXED);
+	watches_poke();
+}
+
+void rc_lazy_start(void)
+{
+	int pending;
+
+	pending = __atomic_exchange_n(&rc_lazy_pending, 0, __ATOMIC_RELAXED);
+	if (pending == 0)
+		return;
+
+	/* See rc_fifo_thread(). */
+	rec_count++;
+
+	/* It can be signalled again once it's created, or while another
+	 * thread is at it. */
+	if (pending == RC_LAZY_START &&
+	    !__atomic_exchange_n(&lazy_started, true, __ATOMIC_RELAXED)) {
+		if (_fiu_rc_fifo(npipe_basename) != 0) {
+			perror("libfiu: Error creating the remote control");
+			__atomic_store_n(&lazy_started, false,
+			                 __ATOMIC_RELAXED);
+		}
+	}
+
+	/* If we're signalled again meanwhile, the handler sets it again
+	 * after we clear it. */
+	__atomic_store_n(&lazy_poked, false, __ATOMIC_RELAXED);
+	watches_reset();
+
+	rec_count--;
+}
+
+static void fifo_lazy_atfork_child(void)
+{
+	/* The named pipes and the thread serving them belong to the parent.
+	 * We must not remove its named pipes at exit, so forget about them.
+	 * A request the parent had not served yet is not for us, but the
+	 * watch masks could still have the bits the handler set, so we leave
+	 * one to recompute them. */
+	npipe_path_in = NULL;
+	npipe_path_out = NULL;
+	lazy_started = false;
+	rc_lazy_pending = lazy_poked ? RC_LAZY_RESET : 0;
+}
+
+int fiu_rc_fifo_lazy(const char *basename, int signum)
+{
+	struct sigaction sa;
+
+	npipe_basename = strdup(basename);
+	if (npipe_basename == NULL)
+		return -1;
+
+	/* SA_RESTART so we don't make blocking calls fail with EINTR, which
+	 * could change the behaviour of the program. */
+	memset(&sa, 0, sizeof(sa));
+	sa.sa_handler = fifo_lazy_signal;
+	sa.sa_flags = SA_RESTART;
+	sigemptyset(&sa.sa_mask);
+	if (sigaction(signum, &sa, NULL) != 0)
+		return -1;
+
+	pthread_atfork(NULL, NULL, fifo_lazy_atfork_child);
+
+	return 0;
+}
@@ -1,10 +1,13 @@
 
+#include <errno.h>    /* EINTR */
 #include <limits.h>   /* ULONG_MAX */
+#include <math.h>     /* log(), exp() and friends */
 #include <pthread.h>  /* mutexes */
+#include <stdio.h>    /* snprintf() */
 #include <stdlib.h>   /* malloc() and friends */
 #include <string.h>   /* strcmp() and friends */
 #include <sys/time.h> /* gettimeofday() */
-#include <time.h>     /* gettimeofday() */
+#include <time.h>     /* gettimeofday(), clock_nanosleep() */
 
 /* Enable us, so we get the real prototypes from the headers */
 #define FIU_ENABLE 1
@@ -12,6 +15,8 @@
 #include "fiu-control.h"
 #include "fiu.h"
 #include "internal.h"
+#include "predicate.h"
+#include "threads.h"
 #include "wtable.h"
 
 /* Tracing mode for debugging libfiu itself. */
@@ -34,6 +39,7 @@ enum pf_method {
 	PF_PROB,
 	PF_EXTERNAL,
 	PF_STACK,
+	PF_DELAY,
 };
 
 /* Point of failure information */
@@ -48,6 +54,30 @@ struct pf_info {
 	pthread_mutex_t lock;
 	bool failed_once;
 
+	/* If not NULL, only fail when checked with a path that begins with
+	 * it (see fiu_set_path()). */
+	char *path;
+	unsigned int pathlen;
+
+	/* If > 1, once it fails it keeps failing for this many checks in
+	 * total, counting the first one; burst_left is how many are left
+	 * (see fiu_set_burst()). */
+	unsigned int burst;
+	unsigned int burst_left;
+
+	/* If not 0, only fail for operations of at least min_size bytes, and
+	 * when the caller's total is at least min_total (see fiu_set_size()). */
+	size_t min_size;
+	size_t min_total;
+
+	/* If not NULL, only fail when the arguments of the operation match it
+	 * (see fiu_set_predicate()). */
+	struct predicate *pred;
+
+	/* If not 0, only fail in the threads that match any of the selectors
+	 * in this mask (see fiu_set_threads() and threads.c). */
+	uint64_t threads;
+
 	/* How to decide when this point of failure fails, and the information
 	 * needed to take the decision */
 	enum pf_method method;
@@ -64,9 +94,66 @@ struct pf_info {
 			void *func_end;
 			int func_pos_in_stack;
 		} stack;
+
+		/* To use when method == PF_DELAY */
+		struct delay {
+			float probability;
+			int dist;
+			double usec;
+			double param;
+		} delay;
 	} minfo;
 };
 
+/* Path the next pf created by this thread will be restricted to, see
+ * pf_next_path(). */
+static __thread const char *next_path = NULL;
+
+/* Set (and never cleared) once a point of failure is restricted to a path,
+ * see fiu_paths_used(). */
+static bool paths_used = false;
+
+void pf_next_path(const char *prefix)
+{
+	next_path = prefix;
+}
+
+/* Same, for the burst, see pf_next_burst(). */
+static __thread unsigned int next_burst = 0;
+
+void pf_next_burst(unsigned int count)
+{
+	next_burst = count;
+}
+
+/* Same, for the size restriction, see pf_next_size(). */
+static __thread size_t next_min_size = 0, next_min_total = 0;
+
+void pf_next_size(size_t min_size, size_t min_total)
+{
+	next_min_size = min_size;
+	next_min_total = min_total;
+}
+
+/* Same, for the predicate, see pf_next_predicate(). */
+static __thread const char *next_pred = NULL;
+
+void pf_next_predicate(const char *src)
+{
+	next_pred = src;
+}
+
+/* Same, for the threads, see pf_next_threads(). */
+static __thread long next_tid = 0;
+static __thread const char *next_tname = NULL, *next_tag = NULL;
+
+void pf_next_threads(long tid, const char *name, const char *tag)
+{
+	next_tid = tid;
+	next_tname = name;
+	next_tag = tag;
+}
+
 /* Creates a new pf_info.
  * Only the common fields are filled, the caller should take care of the
  * method-specific ones. For internal use only. */
@@ -88,6 +175,49 @@ static struct pf_info *pf_create(const char *name, int failnum, void *failinfo,
 		goto exit;
 	}
 
+	pf->path = NULL;
+	pf->pathlen = 0;
+	if (next_path != NULL) {
+		pf->path = strdup(next_path);
+		if (pf->path == NULL) {
+			free(pf->name);
+			free(pf);
+			pf = NULL;
+			goto exit;
+		}
+		pf->pathlen = strlen(next_path);
+		__atomic_store_n(&paths_used, true, __ATOMIC_RELEASE);
+	}
+
+	pf->burst = next_burst;
+	pf->burst_left = 0;
+
+	pf->min_size = next_min_size;
+	pf->min_total = next_min_total;
+
+	pf->pred = NULL;
+	if (next_pred != NULL) {
+		pf->pred = predicate_compile(next_pred);
+		if (pf->pred == NULL) {
+			free(pf->path);
+			free(pf->name);
+			free(pf);
+			pf = NULL;
+			goto exit;
+		}
+	}
+
+	if (thread_sels_get(next_tid, next_tname, next_tag, &pf->threads) <
+	    0) {
+		if (pf->pred != NULL)
+			predicate_free(pf->pred);
+		free(pf->path);
+		free(pf->name);
+		free(pf);
+		pf = NULL;
+		goto exit;
+	}
+
 	pf->namelen = strlen(name);
 	pf->failnum = failnum;
 	pf->failinfo = failinfo;
@@ -106,6 +236,10 @@ exit:
 static void pf_free(struct pf_info *pf)
 {
 	free(pf->name);
+	free(pf->path);
+	if (pf->pred != NULL)
+		predicate_free(pf->pred);
+	thread_sels_put(pf->threads);
 	pthread_mutex_destroy(&pf->lock);
 	free(pf);
 }
@@ -115,6 +249,11 @@ static void pf_free(struct pf_info *pf)
 wtable_t *enabled_fails = NULL;
 static pthread_rwlock_t enabled_fails_lock = PTHREAD_RWLOCK_INITIALIZER;
 
+/* Changes every time enabled_fails (or one of its pfs) may have changed,
+ * that is, every time we release the lock after writing; see
+ * fiu_rc_list_gen(). */
+static unsigned int enabled_fails_gen = 0;
+
 #define ef_rlock()                                                             \
 	do {                                                                   \
 		pthread_rwlock_rdlock(&enabled_fails_lock);                    \
@@ -129,6 +268,7 @@ static pthread_rwlock_t enabled_fails_lock = PTHREAD_RWLOCK_INITIALIZER;
 	} while (0)
 #define ef_wunlock()                                                           \
 	do {                                                                   \
+		__atomic_add_fetch(&enabled_fails_gen, 1, __ATOMIC_RELEASE);   \
 		pthread_rwlock_unlock(&enabled_fails_lock);                    \
 	} while (0)
 
@@ -202,9 +342,20 @@ static int should_stack_fail(struct pf_info *pf)
  * sizeof(int) >= 4.
  *
  * To seed it, we use the current microseconds. To prevent seed reuse, we
- * re-seed after each fork (see atfork_child()). */
+ * re-seed after each fork (see atfork_child()).
+ *
+ * We also keep the seed, with a generation number that changes with it, for
+ * fiu_get_prng_seed(). */
 static unsigned int randd_xn = 0xA673F42D;
 static bool randd_xn_manual = false;
+static uint64_t prng_base_seed = 0xA673F42D;
+static unsigned int prng_seed_gen = 0;
+
+static void prng_set_base(uint64_t seed)
+{
+	__atomic_store_n(&prng_base_seed, seed, __ATOMIC_RELAXED);
+	__atomic_add_fetch(&prng_seed_gen, 1, __ATOMIC_RELEASE);
+}
 
 static void prng_seed(void)
 {
@@ -218,6 +369,7 @@ static void prng_seed(void)
 	gettimeofday(&tv, NULL);
 
 	randd_xn = tv.tv_usec;
+	prng_set_base(((uint64_t) tv.tv_sec << 32) ^ tv.tv_usec);
 }
 
 static double randd(void)
@@ -227,11 +379,121 @@ static double randd(void)
 	return (double)randd_xn / UINT_MAX;
 }
 
+/*
+ * Delays (see fiu_enable_delay())
+ */
+
+/* The kernel usually wakes sleepers up a bit late (by up to the timer slack,
+ * which is 50us by default on Linux), so we sleep until this long before the
+ * deadline, and busy-wait the rest. That costs CPU time, so it can be changed
+ * (or turned off, with 0) with the FIU_DELAY_SPIN environment variable, in
+ * microseconds. */
+#define DELAY_SPIN_NS 100000
+static uint64_t delay_spin_ns = DELAY_SPIN_NS;
+
+/* Delays longer than this just sleep, as being late by the timer slack is
+ * not noticeable in them. */
+#define DELAY_SPIN_MAX_NS 10000000
+
+/* Returns how long the given PF_DELAY pf should delay, in nanoseconds. Must
+ * be called with enabled_fails_lock held for reading. */
+static uint64_t pf_delay_ns(struct pf_info *pf)
+{
+	double usec = pf->minfo.delay.usec, u1, u2;
+
+	switch (pf->minfo.delay.dist) {
+	case FIU_DELAY_UNIFORM:
+		usec += (pf->minfo.delay.param - usec) * randd();
+		break;
+	case FIU_DELAY_LOGNORMAL:
+		/* Box-Muller transform, to get a standard normal variable
+		 * out of two uniform ones; u1 must not be 0. */
+		u1 = 1.0 - randd() * (1.0 - 1e-12);
+		u2 = randd();
+		usec *= exp(pf->minfo.delay.param * sqrt(-2.0 * log(u1)) *
+		            cos(2.0 * M_PI * u2));
+		break;
+	default:
+		break;
+	}
+
+	return usec * 1000;
+}
+
+/* Names of the distributions, for the remote control. */
+static const char *const delay_dists[] = {
+	[FIU_DELAY_FIXED] = "fixed",
+	[FIU_DELAY_UNIFORM] = "uniform",
+	[FIU_DELAY_LOGNORMAL] = "lognormal",
+};
+
+const char *delay_dist_name(int dist)
+{
+	if (dist < FIU_DELAY_FIXED || dist > FIU_DELAY_LOGNORMAL)
+		return "unknown";
+	return delay_dists[dist];
+}
+
+int delay_dist_from_name(const char *name)
+{
+	int dist;
+
+	for (dist = FIU_DELAY_FIXED; dist <= FIU_DELAY_LOGNORMAL; dist++) {
+		if (strcmp(name, delay_dists[dist]) == 0)
+			return dist;
+	}
+
+	return -1;
+}
+
+static void timespec_add_ns(struct timespec *ts, uint64_t ns)
+{
+	ns += ts->tv_nsec;
+	ts->tv_sec += ns / 1000000000;
+	ts->tv_nsec = ns % 1000000000;
+}
+
+static bool timespec_before(const struct timespec *a,
+                            const struct timespec *b)
+{
+	return a->tv_sec < b->tv_sec ||
+	       (a->tv_sec == b->tv_sec && a->tv_nsec < b->tv_nsec);
+}
+
+/* Sleeps for the given number of nanoseconds. */
+static void delay(uint64_t ns)
+{
+	struct timespec deadline, wake, now;
+
+	clock_gettime(CLOCK_MONOTONIC, &deadline);
+	wake = deadline;
+	timespec_add_ns(&deadline, ns);
+
+	if (ns > DELAY_SPIN_MAX_NS) {
+		while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME,
+		                       &deadline, NULL) == EINTR)
+			;
+		return;
+	}
+
+	if (ns > delay_spin_ns) {
+		timespec_add_ns(&wake, ns - delay_spin_ns);
+		while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake,
+		                       NULL) == EINTR)
+			;
+	}
+
+	do {
+		clock_gettime(CLOCK_MONOTONIC, &now);
+	} while (timespec_before(&now, &deadline));
+}
+
 /* Function that runs after the process has been forked, at the child. It's
  * registered via pthread_atfork() in fiu_init(). */
 static void atfork_child(void)
 {
 	prng_seed();
+	thread_sels_atfork_child();
 }
 
 /*
@@ -243,7 +505,7 @@ static void atfork_child(void)
  * time without clashes. */
 int fiu_init(unsigned int flags)
 {
-	char *static_seed_from_env;
+	char *static_seed_from_env, *delay_spin_from_env;
 
 	/* Used to avoid re-initialization, protected by enabled_fails_lock */
 	static int initialized = 0;
@@ -271,6 +533,11 @@ int fiu_init(unsigned int flags)
 		fiu_set_prng_seed(atoi(static_seed_from_env));
 	}
 
+	delay_spin_from_env = getenv("FIU_DELAY_SPIN");
+	if (delay_spin_from_env != NULL) {
+		delay_spin_ns = strtoull(delay_spin_from_env, NULL, 10) * 1000;
+	}
+
 	prng_seed();
 
 	initialized = 1;
@@ -285,40 +552,95 @@ void fiu_set_prng_seed(unsigned int seed)
 {
 	randd_xn = seed;
 	randd_xn_manual = true;
+	prng_set_base(seed);
 }
 
-/* Returns the failure status of the given name. Must work well even before
- * fiu_init() is called assuming no points of failure are enabled; although it
- * can (and does) assume fiu_init() will be called before enabling any. */
-int fiu_fail(const char *name)
+uint64_t fiu_get_prng_seed(unsigned int *gen)
 {
-	struct pf_info *pf;
-	int failnum;
+	unsigned int g;
+	uint64_t seed;
+
+	/* Retry if it changed while we were reading it. */
+	do {
+		g = __atomic_load_n(&prng_seed_gen, __ATOMIC_ACQUIRE);
+		seed = __atomic_load_n(&prng_base_seed, __ATOMIC_RELAXED);
+	} while (g != __atomic_load_n(&prng_seed_gen, __ATOMIC_ACQUIRE));
+
+	if (gen != NULL)
+		*gen = g;
+	return seed;
+}
 
-	rec_count++;
+/* Takes one of the failures left in the pf's burst, if any; returns whether
+ * it could. Checks can run concurrently, as they only hold the lock for
+ * reading. */
+static bool pf_burst_take(struct pf_info *pf)
+{
+	unsigned int left = __atomic_load_n(&pf->burst_left, __ATOMIC_RELAXED);
+
+	while (left > 0) {
+		if (__atomic_compare_exchange_n(&pf->burst_left, &left,
+		                                left - 1, true,
+		                                __ATOMIC_RELAXED,
+		                                __ATOMIC_RELAXED))
+			return true;
+	}
 
-	/* We must do this before acquiring the lock and calling any
-	 * (potentially wrapped) functions. */
-	if (rec_count > 1) {
-		rec_count--;
-		return 0;
+	return false;
+}
+
+/* Decides whether the given pf (which can be NULL) fails for the given
+ * operation (see fiu_fail_id_op()), and if it does, returns its failnum and
+ * sets the failinfo. The name is only used for tracing.
+ * PF_DELAY pfs never fail, but set *delay_ns to how long the caller should
+ * sleep, which it must do after releasing the lock (otherwise it is left
+ * untouched).
+ * Must be called with enabled_fails_lock held for reading. */
+static int pf_fail(struct pf_info *pf, const char *name,
+                   const struct fiu_op *op, uint64_t *delay_ns)
+{
+	int failnum;
+
+	/* None found. */
+	if (pf == NULL) {
+		goto exit;
 	}
 
-	ef_rlock();
+	/* Restricted to some threads, and this is not one of them. */
+	if (pf->threads != 0 && !thread_matches(pf->threads)) {
+		goto exit;
+	}
 
-	/* It can happen that someone calls fiu_fail() before fiu_init(); we
-	 * don't want to crash so we just exit. */
-	if (enabled_fails == NULL) {
+	/* Restricted to a path, and this is not it. */
+	if (pf->path != NULL &&
+	    (op->path == NULL ||
+	     strncmp(op->path, pf->path, pf->pathlen) != 0)) {
 		goto exit;
 	}
 
-	pf = wtable_get(enabled_fails, name);
+	/* Restricted to big operations, or to when the total is big, and this
+	 * is not one of them. The size goes first, as the total can be
+	 * expensive to get. */
+	if (op->size < pf->min_size ||
+	    (pf->min_total != 0 &&
+	     (op->total == NULL || op->total() < pf->min_total))) {
+		goto exit;
+	}
 
-	/* None found. */
-	if (pf == NULL) {
+	/* Restricted to operations whose arguments match a predicate, and
+	 * this is not one of them. */
+	if (pf->pred != NULL &&
+	    !predicate_eval(pf->pred, op->args, op->nargs)) {
 		goto exit;
 	}
 
+	/* In the middle of a burst, fail regardless of the method. */
+	if (pf->burst > 1 && pf_burst_take(pf)) {
+		trace("FIU  Failing %s on %s (burst)\n", name, pf->name);
+		pthread_setspecific(last_failinfo_key, pf->failinfo);
+		return pf->failnum;
+	}
+
 	if (pf->flags & FIU_ONETIME) {
 		pthread_mutex_lock(&pf->lock);
 		if (pf->failed_once) {
@@ -346,6 +668,14 @@ int fiu_fail(const char *name)
 		if (should_stack_fail(pf))
 			goto exit_fail;
 		break;
+	case PF_DELAY:
+		if (pf->minfo.delay.probability > randd()) {
+			trace("FIU  Delaying %s on %s\n", name, pf->name);
+			*delay_ns = pf_delay_ns(pf);
+			if (pf->flags & FIU_ONETIME)
+				pf->failed_once = true;
+		}
+		break;
 	default:
 		break;
 	}
@@ -356,9 +686,6 @@ int fiu_fail(const char *name)
 
 exit:
 	trace("FIU  Not failing %s\n", name);
-
-	ef_runlock();
-	rec_count--;
 	return 0;
 
 exit_fail:
@@ -367,22 +694,306 @@ exit_fail:
 	pthread_setspecific(last_failinfo_key, pf->failinfo);
 	failnum = pf->failnum;
 
+	if (pf->burst > 1)
+		__atomic_store_n(&pf->burst_left, pf->burst - 1,
+		                 __ATOMIC_RELAXED);
+
 	if (pf->flags & FIU_ONETIME) {
 		pf->failed_once = true;
 		pthread_mutex_unlock(&pf->lock);
 	}
 
+	return failnum;
+}
+
+/* Returns the failure status of the given name, for an operation on the
+ * given path (which can be NULL). Must work well even before fiu_init() is
+ * called assuming no points of failure are enabled; although it can (and
+ * does) assume fiu_init() will be called before enabling any. */
+int fiu_fail_path(const char *name, const char *path)
+{
+	struct pf_info *pf = NULL;
+	struct fiu_op op = {.path = path};
+	uint64_t delay_ns = 0;
+	int failnum;
+
+	rec_count++;
+
+	/* We must do this before acquiring the lock and calling any
+	 * (potentially wrapped) functions. */
+	if (rec_count > 1) {
+		rec_count--;
+		return 0;
+	}
+
+	if (__atomic_load_n(&rc_lazy_pending, __ATOMIC_RELAXED))
+		rc_lazy_start();
+
+	ef_rlock();
+
+	/* It can happen that someone calls fiu_fail() before fiu_init(); we
+	 * don't want to crash so we just don't look it up. */
+	if (enabled_fails != NULL)
+		pf = wtable_get(enabled_fails, name);
+
+	failnum = pf_fail(pf, name, &op, &delay_ns);
+
 	ef_runlock();
+
+	if (delay_ns)
+		delay(delay_ns);
+
 	rec_count--;
 	return failnum;
 }
 
+int fiu_fail(const char *name)
+{
+	return fiu_fail_path(name, NULL);
+}
+
 /* Returns the information associated with the last fail. */
 void *fiu_failinfo(void)
 {
 	return pthread_getspecific(last_failinfo_key);
 }
 
+/*
+ * Watches (see fiu_watch())
+ *
+ * They are kept in a list protected by enabled_fails_lock. Enabling a point
+ * of failure can only set bits, so we just match the new name against the
+ * watched ones. Disabling can clear any number of bits, so we recompute the
+ * masks from scratch, which is fine as it is not a frequent operation.
+ *
+ * Along with the masks, we keep the pf each watched name resolves to, so
+ * fiu_fail_id() doesn't need to look it up. They're updated at the same
+ * time, also with the lock held for writing, so they never point to a pf
+ * that was freed.
+ *
+ * We also keep a copy of their min_size, which fiu_fail_id_op() reads
+ * without taking the lock, so the operations too small to fail (most of
+ * them, usually) are skipped right away. It is checked again with the lock
+ * held, so a stale value can only delay a change for a moment.
+ *
+ * Likewise, we keep how many arguments their predicates look at (see
+ * fiu_watch_nargs()), so the callers only work out the ones that are needed.
+ */
+
+struct fiu_watch {
+	const char *const *names;
+	unsigned int n;
+	uint64_t *mask;
+	struct pf_info **pfs;
+	size_t *min_size;
+	unsigned int *nargs;
+	struct fiu_watch *next;
+};
+
+static struct fiu_watch *watches = NULL;
+
+/* Updates the copies of the min_size and the predicate's number of
+ * arguments of the pf the i-th name resolves to. */
+static void watch_copy_pf(struct fiu_watch *w, unsigned int i)
+{
+	struct pf_info *pf = w->pfs[i];
+
+	__atomic_store_n(&w->min_size[i], pf != NULL ? pf->min_size : 0,
+	                 __ATOMIC_RELAXED);
+	__atomic_store_n(&w->nargs[i],
+	                 pf != NULL && pf->pred != NULL ?
+	                 predicate_nargs(pf->pred) : 0,
+	                 __ATOMIC_RELAXED);
+}
+
+/* Recomputes the mask of the given watch from the enabled points of failure.
+ * Must be called with enabled_fails_lock held for writing. */
+static void watch_recompute(struct fiu_watch *w)
+{
+	unsigned int i, word;
+	uint64_t bits;
+
+	for (word = 0; word * 64 < w->n; word++) {
+		bits = 0;
+		for (i = word * 64; i < w->n && i < (word + 1) * 64; i++) {
+			w->pfs[i] = NULL;
+			if (w->names[i] != NULL && enabled_fails != NULL)
+				w->pfs[i] = wtable_get(enabled_fails,
+				                       w->names[i]);
+			if (w->pfs[i] != NULL)
+				bits |= (uint64_t)1 << (i % 64);
+			watch_copy_pf(w, i);
+		}
+		__atomic_store_n(&w->mask[word], bits, __ATOMIC_RELAXED);
+	}
+}
+
+static void watches_recompute(void)
+{
+	struct fiu_watch *w;
+
+	for (w = watches; w != NULL; w = w->next)
+		watch_recompute(w);
+}
+
+/* The list is only added to, and the nodes are never freed, so it can be
+ * walked from a signal handler. */
+void watches_poke(void)
+{
+	struct fiu_watch *w;
+	unsigned int i;
+
+	for (w = __atomic_load_n(&watches, __ATOMIC_ACQUIRE); w != NULL;
+	     w = w->next) {
+		for (i = 0; i < (w->n + 63) / 64; i++)
+			__atomic_store_n(&w->mask[i], ~(uint64_t)0,
+			                 __ATOMIC_RELAXED);
+	}
+}
+
+void watches_reset(void)
+{
+	rec_count++;
+	ef_wlock();
+	watches_recompute();
+	ef_wunlock();
+	rec_count--;
+}
+
+/* Sets the bits of the watched names that match the given (just enabled)
+ * name. Must be called with enabled_fails_lock held for writing. */
+static void watches_add(const char *name)
+{
+	struct fiu_watch *w;
+	unsigned int i;
+
+	for (w = watches; w != NULL; w = w->next) {
+		for (i = 0; i < w->n; i++) {
+			if (w->names[i] == NULL ||
+			    !wtable_matches(name, w->names[i]))
+				continue;
+
+			/* The new pf is not necessarily the one the name
+			 * resolves to (a more specific one can take
+			 * precedence), so we look it up. */
+			w->pfs[i] = wtable_get(enabled_fails, w->names[i]);
+			watch_copy_pf(w, i);
+			__atomic_fetch_or(&w->mask[i / 64],
+			                  (uint64_t)1 << (i % 64),
+			                  __ATOMIC_RELAXED);
+		}
+	}
+}
+
+struct fiu_watch *fiu_watch_ids(const char *const *names, unsigned int n,
+                                uint64_t *mask)
+{
+	struct fiu_watch *w;
+
+	rec_count++;
+
+	w = malloc(sizeof(struct fiu_watch));
+	if (w == NULL) {
+		rec_count--;
+		return NULL;
+	}
+
+	w->pfs = calloc(n > 0 ? n : 1, sizeof(struct pf_info *));
+	w->min_size = calloc(n > 0 ? n : 1, sizeof(size_t));
+	w->nargs = calloc(n > 0 ? n : 1, sizeof(unsigned int));
+	if (w->pfs == NULL || w->min_size == NULL || w->nargs == NULL) {
+		free(w->pfs);
+		free(w->min_size);
+		free(w->nargs);
+		free(w);
+		rec_count--;
+		return NULL;
+	}
+
+	w->names = names;
+	w->n = n;
+	w->mask = mask;
+
+	ef_wlock();
+	w->next = watches;
+	__atomic_store_n(&watches, w, __ATOMIC_RELEASE);
+	watches_recompute();
+	ef_wunlock();
+
+	rec_count--;
+	return w;
+}
+
+int fiu_watch(const char *const *names, unsigned int n, uint64_t *mask)
+{
+	return fiu_watch_ids(names, n, mask) != NULL ? 0 : -1;
+}
+
+unsigned int fiu_watch_nargs(struct fiu_watch *w, unsigned int id)
+{
+	if (w == NULL || id >= w->n)
+		return 0;
+
+	return __atomic_load_n(&w->nargs[id], __ATOMIC_RELAXED);
+}
+
+/* Like fiu_fail_path(), but takes the pf from the watch instead of looking
+ * it up by name, and checks all the restrictions. */
+int fiu_fail_id_op(struct fiu_watch *w, unsigned int id,
+                   const struct fiu_op *op)
+{
+	uint64_t delay_ns = 0;
+	int failnum;
+
+	rec_count++;
+
+	/* See fiu_fail(). */
+	if (rec_count > 1) {
+		rec_count--;
+		return 0;
+	}
+
+	if (__atomic_load_n(&rc_lazy_pending, __ATOMIC_RELAXED))
+		rc_lazy_start();
+
+	/* Too small to fail, we don't need the lock to know; see the comment
+	 * on the watches above. */
+	if (w == NULL || id >= w->n ||
+	    op->size < __atomic_load_n(&w->min_size[id], __ATOMIC_RELAXED)) {
+		rec_count--;
+		return 0;
+	}
+
+	ef_rlock();
+	failnum = pf_fail(w->pfs[id], w->names[id], op, &delay_ns);
+	ef_runlock();
+
+	if (delay_ns)
+		delay(delay_ns);
+
+	rec_count--;
+	return failnum;
+}
+
+int fiu_fail_id_size(struct fiu_watch *w, unsigned int id, const char *path,
+                     size_t size, size_t (*total)(void))
+{
+	struct fiu_op op = {.path = path, .size = size, .total = total};
+
+	return fiu_fail_id_op(w, id, &op);
+}
+
+int fiu_fail_id_path(struct fiu_watch *w, unsigned int id, const char *path)
+{
+	return fiu_fail_id_size(w, id, path, 0, NULL);
+}
+
+int fiu_fail_id(struct fiu_watch *w, unsigned int id)
+{
+	return fiu_fail_id_path(w, id, NULL);
+}
+
+
 /*
  * Control API
  */
@@ -397,6 +1008,8 @@ static int insert_pf(struct pf_info *pf)
 
 	ef_wlock();
 	success = wtable_set(enabled_fails, pf->name, pf);
+	if (success)
+		watches_add(pf->name);
 	ef_wunlock();
 
 	rec_count--;
@@ -494,6 +1107,34 @@ int fiu_enable_stack_by_name(const char *name, int failnum, void *failinfo,
 	                        func_pos_in_stack);
 }
 
+/* Makes the given name delay the caller, see pf_delay_ns(). */
+int fiu_enable_delay(const char *name, unsigned int flags, float probability,
+                     int dist, double usec, double param)
+{
+	struct pf_info *pf;
+
+	if (usec < 0)
+		return -1;
+	if (dist == FIU_DELAY_UNIFORM && param < usec)
+		return -1;
+	if (dist == FIU_DELAY_LOGNORMAL && param < 0)
+		return -1;
+	if (dist != FIU_DELAY_FIXED && dist != FIU_DELAY_UNIFORM &&
+	    dist != FIU_DELAY_LOGNORMAL)
+		return -1;
+
+	/* failnum is never returned, but must be != 0 like in the others. */
+	pf = pf_create(name, 1, NULL, flags, PF_DELAY);
+	if (pf == NULL)
+		return -1;
+
+	pf->minfo.delay.probability = probability;
+	pf->minfo.delay.dist = dist;
+	pf->minfo.delay.usec = usec;
+	pf->minfo.delay.param = param;
+	return insert_pf(pf);
+}
+
 /* Makes the given name NOT fail. */
 int fiu_disable(const char *name)
 {
@@ -504,8 +1145,333 @@ int fiu_disable(const char *name)
 	/* Just find the point of failure and remove it. */
 	ef_wlock();
 	success = wtable_del(enabled_fails, name);
+	if (success)
+		watches_recompute();
 	ef_wunlock();
 
 	rec_count--;
 	return success ? 0 : -1;
 }
+
+/* Restricts the given point of failure to the given path prefix. */
+int fiu_set_path(const char *name, const char *prefix)
+{
+	struct pf_info *pf;
+	char *path = NULL;
+	int r = -1;
+
+	rec_count++;
+
+	if (prefix != NULL) {
+		path = strdup(prefix);
+		if (path == NULL)
+			goto exit;
+		__atomic_store_n(&paths_used, true, __ATOMIC_RELEASE);
+	}
+
+	ef_wlock();
+	pf = NULL;
+	if (enabled_fails != NULL)
+		pf = wtable_get_exact(enabled_fails, name);
+	if (pf != NULL) {
+		/* The old path can't be in use, as checks hold the lock for
+		 * reading. */
+		free(pf->path);
+		pf->path = path;
+		pf->pathlen = path ? strlen(path) : 0;
+		path = NULL;
+		r = 0;
+	}
+	ef_wunlock();
+
+	free(path);
+
+exit:
+	rec_count--;
+	return r;
+}
+
+/* Tells if any point of failure was ever restricted to a path. */
+int fiu_paths_used(void)
+{
+	return __atomic_load_n(&paths_used, __ATOMIC_ACQUIRE);
+}
+
+/* Makes the given point of failure fail in bursts. */
+int fiu_set_burst(const char *name, unsigned int count)
+{
+	struct pf_info *pf;
+	int r = -1;
+
+	rec_count++;
+
+	ef_wlock();
+	pf = NULL;
+	if (enabled_fails != NULL)
+		pf = wtable_get_exact(enabled_fails, name);
+	if (pf != NULL) {
+		pf->burst = count;
+		pf->burst_left = 0;
+		r = 0;
+	}
+	ef_wunlock();
+
+	rec_count--;
+	return r;
+}
+
+/* Restricts the given point of failure to big operations. */
+int fiu_set_size(const char *name, size_t min_size, size_t min_total)
+{
+	struct pf_info *pf;
+	int r = -1;
+
+	rec_count++;
+
+	ef_wlock();
+	pf = NULL;
+	if (enabled_fails != NULL)
+		pf = wtable_get_exact(enabled_fails, name);
+	if (pf != NULL) {
+		pf->min_size = min_size;
+		pf->min_total = min_total;
+		watches_recompute();
+		r = 0;
+	}
+	ef_wunlock();
+
+	rec_count--;
+	return r;
+}
+
+/* Restricts the given point of failure to operations whose arguments match
+ * the given predicate. */
+int fiu_set_predicate(const char *name, const char *src)
+{
+	struct pf_info *pf;
+	struct predicate *pred = NULL;
+	int r = -1;
+
+	rec_count++;
+
+	if (src != NULL) {
+		pred = predicate_compile(src);
+		if (pred == NULL)
+			goto exit;
+	}
+
+	ef_wlock();
+	pf = NULL;
+	if (enabled_fails != NULL)
+		pf = wtable_get_exact(enabled_fails, name);
+	if (pf != NULL) {
+		/* Like the path, the old one can't be in use. */
+		if (pf->pred != NULL)
+			predicate_free(pf->pred);
+		pf->pred = pred;
+		pred = NULL;
+		watches_recompute();
+		r = 0;
+	}
+	ef_wunlock();
+
+	if (pred != NULL)
+		predicate_free(pred);
+
+exit:
+	rec_count--;
+	return r;
+}
+
+/* Restricts the given point of failure to some threads. */
+int fiu_set_threads(const char *name, long tid, const char *thread_name,
+                    const char *tag)
+{
+	struct pf_info *pf;
+	uint64_t threads;
+	int r = -1;
+
+	rec_count++;
+
+	if (thread_sels_get(tid, thread_name, tag, &threads) < 0)
+		goto exit;
+
+	ef_wlock();
+	pf = NULL;
+	if (enabled_fails != NULL)
+		pf = wtable_get_exact(enabled_fails, name);
+	if (pf != NULL) {
+		/* Swap them, so we release the old ones below. */
+		uint64_t old = pf->threads;
+		pf->threads = threads;
+		threads = old;
+		r = 0;
+	}
+	ef_wunlock();
+
+	thread_sels_put(threads);
+
+exit:
+	rec_count--;
+	return r;
+}
+
+/*
+ * Listing of the enabled points of failure
+ */
+
+/* How many points we collect each time we take the lock. */
+#define DUMP_CHUNK 32
+
+struct dump_chunk {
+	int count;
+	char lines[DUMP_CHUNK][MAX_LINE];
+};
+
+/* Writes into buf the remote control command that describes the given pf.
+ * Points enabled with the external and stack methods can't be re-created
+ * from the remote control, so the commands for them are only descriptive.
+ * Returns false if the command doesn't fit, as a truncated one could
+ * describe a different point of failure (for example, if it lost the path
+ * restriction). */
+static bool pf_to_cmd(struct pf_info *pf, char *buf, size_t len)
+{
+	size_t n;
+	const char *cmd = "enable";
+
+	switch (pf->method) {
+	case PF_PROB:
+		cmd = "enable_random";
+		break;
+	case PF_EXTERNAL:
+		cmd = "enable_external";
+		break;
+	case PF_STACK:
+		cmd = "enable_stack";
+		break;
+	case PF_DELAY:
+		cmd = "enable_delay";
+		break;
+	default:
+		break;
+	}
+
+	n = rc_append(buf, len, 0, "%s", cmd);
+	n = rc_append_value(buf, len, n, " name=", pf->name);
+	n = rc_append(buf, len, n, ",failnum=%d,failinfo=%lu", pf->failnum,
+	              (unsigned long)pf->failinfo);
+
+	switch (pf->method) {
+	case PF_PROB:
+		n = rc_append(buf, len, n, ",probability=%.17g",
+		              pf->minfo.probability);
+		break;
+	case PF_STACK:
+		n = rc_append(buf, len, n, ",func=%p,pos_in_stack=%d",
+		              pf->minfo.stack.func_start,
+		              pf->minfo.stack.func_pos_in_stack);
+		break;
+	case PF_DELAY:
+		n = rc_append(buf, len, n,
+		              ",probability=%.17g,dist=%s,delay=%.17g",
+		              pf->minfo.delay.probability,
+		              delay_dist_name(pf->minfo.delay.dist),
+		              pf->minfo.delay.usec);
+		if (pf->minfo.delay.dist == FIU_DELAY_UNIFORM)
+			n = rc_append(buf, len, n, ",max=%.17g",
+			              pf->minfo.delay.param);
+		else if (pf->minfo.delay.dist == FIU_DELAY_LOGNORMAL)
+			n = rc_append(buf, len, n, ",sigma=%.17g",
+			              pf->minfo.delay.param);
+		break;
+	default:
+		break;
+	}
+
+	if (pf->path != NULL)
+		n = rc_append_value(buf, len, n, ",path=", pf->path);
+
+	if (pf->burst > 1)
+		n = rc_append(buf, len, n, ",burst=%u", pf->burst);
+
+	if (pf->min_size != 0)
+		n = rc_append(buf, len, n, ",minsize=%zu", pf->min_size);
+
+	if (pf->min_total != 0)
+		n = rc_append(buf, len, n, ",mintotal=%zu", pf->min_total);
+
+	if (pf->pred != NULL)
+		n = rc_append_value(buf, len, n, ",when=",
+		                    predicate_source(pf->pred));
+
+	if (pf->threads != 0)
+		n = thread_sels_describe(pf->threads, buf, len, n);
+
+	if (pf->flags & FIU_ONETIME)
+		n = rc_append(buf, len, n, ",onetime");
+
+	return n < len;
+}
+
+/* wtable_iter() callback, collects the given pf into the dump_chunk. */
+static bool dump_pf(const char *key, void *value, void *arg)
+{
+	struct dump_chunk *chunk = arg;
+
+	if (chunk->count >= DUMP_CHUNK)
+		return false;
+
+	if (pf_to_cmd(value, chunk->lines[chunk->count], MAX_LINE))
+		chunk->count++;
+	return true;
+}
+
+/* Calls cb for each enabled point of failure. We only hold the lock while
+ * collecting each chunk, so a slow cb (for example, one writing to a pipe)
+ * does not block the rest of the process. As a consequence, this is not an
+ * atomic snapshot: points enabled or disabled while the dump is in progress
+ * may or may not show up. */
+int dump_enabled_fails(int (*cb)(const char *line, void *arg), void *arg)
+{
+	struct wtable_cursor cursor = {false, 0};
+	struct dump_chunk *chunk;
+	bool done;
+	int i, r = 0;
+
+	rec_count++;
+
+	chunk = malloc(sizeof(struct dump_chunk));
+	if (chunk == NULL) {
+		rec_count--;
+		return -1;
+	}
+
+	do {
+		chunk->count = 0;
+
+		ef_rlock();
+		if (enabled_fails == NULL)
+			done = true;
+		else
+			done = wtable_iter(enabled_fails, &cursor, dump_pf,
+			                   chunk);
+		ef_runlock();
+
+		for (i = 0; i < chunk->count; i++) {
+			if (cb(chunk->lines[i], arg) < 0) {
+				r = -1;
+				goto exit;
+			}
+		}
+	} while (!done);
+
+exit:
+	free(chunk);
+	rec_count--;
+	return r;
+}
+
+unsigned int dump_gen(void)
+{
+	return __atomic_load_n(&enabled_fails_gen, __ATOMIC_ACQUIRE);
+}
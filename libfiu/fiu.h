@@ -44,12 +44,29 @@ int fiu_init(unsigned int flags);
 void fiu_set_prng_seed(unsigned int seed);
 
 /** Returns the failure status of the given point of failure.
+ *
+ * Names can contain any character. Only the names given to fiu_enable() and
+ * friends (see fiu-control.h) can have wildcards: a trailing '*', or '*' and
+ * '?' anywhere in the ones that begin with "glob:".
  *
  * @param name  Point of failure name.
  * @returns  The failure status (0 means it should not fail).
  */
 int fiu_fail(const char *name);
 
+/** Returns the failure status of the given point of failure, for an
+ * operation on the given path.
+ *
+ * It's like fiu_fail(), but points of failure restricted to a path prefix
+ * (see fiu_set_path()) will only fail if the path begins with it. They never
+ * fail when checked with fiu_fail(), or with a NULL path.
+ *
+ * @param name  Point of failure name.
+ * @param path  Path the operation is on, or NULL if it's not known.
+ * @returns  The failure status (0 means it should not fail).
+ */
+int fiu_fail_path(const char *name, const char *path);
+
 /** Returns the information associated with the last failure.
  *
  * Please note that this function is thread-safe and thread-local, so the
@@ -60,15 +77,61 @@ int fiu_fail(const char *name);
  */
 void *fiu_failinfo(void);
 
+/** Tags the calling thread.
+ *
+ * Points of failure can be restricted to the threads with a given tag (see
+ * fiu_set_threads()), to fail only in threads that do some kind of work. A
+ * thread can have many tags.
+ *
+ * @param tag  Tag to add the thread to.
+ * @returns  0 if success, < 0 if error.
+ */
+int fiu_thread_tag(const char *tag);
+
+/** Removes a tag from the calling thread, see fiu_thread_tag(). Removing a
+ * tag the thread doesn't have does nothing.
+ *
+ * @param tag  Tag to remove the thread from.
+ * @returns  0 if success, < 0 if error.
+ */
+int fiu_thread_untag(const char *tag);
+
+/* The names of the points of failure are recorded in the binary, in the
+ * "fiu_points" section, so they can be listed without running it (see
+ * fiu-ls(1)). Each record is just the name, ending with a \0; the POSIX
+ * preload library records its own in the same way.
+ * Only the names given as string literals can be recorded, the others are
+ * left out; this needs GCC, and it's not done for C++. */
+#if defined __GNUC__ && defined __ELF__ && !defined FIU_NO_CATALOG
+#define _FIU_CATALOG_ATTR                                                      \
+	__attribute__((section("fiu_points"), used, aligned(1)))
+#endif
+
+#if defined _FIU_CATALOG_ATTR && !defined __clang__ && !defined __cplusplus
+#define _fiu_catalog(name)                                                     \
+	static const char _fiu_catalog_name[] _FIU_CATALOG_ATTR =              \
+	    __builtin_choose_expr(__builtin_constant_p(name), name, "")
+#else
+#define _fiu_catalog(name)                                                     \
+	do {                                                                   \
+	} while (0)
+#endif
+
 /** Performs the given action when the given point of failure fails. Mostly
  * used in the following macros. */
 #define fiu_do_on(name, action)                                                \
 	do {                                                                   \
+		_fiu_catalog(name);                                            \
 		if (fiu_fail(name)) {                                          \
 			action;                                                \
 		}                                                              \
 	} while (0)
 
+/** Marks a place where latency can be injected with fiu_enable_delay(). The
+ * delay happens within fiu_fail(), so this just checks the point and ignores
+ * the result. */
+#define fiu_delay_on(name) fiu_do_on(name, )
+
 /** Exits the program when the given point of failure fails. */
 #define fiu_exit_on(name) fiu_do_on(name, exit(EXIT_FAILURE))
 
@@ -87,8 +150,12 @@ void *fiu_failinfo(void);
 #define fiu_init(flags) 0
 #define fiu_set_prng_seed(seed)
 #define fiu_fail(name) 0
+#define fiu_fail_path(name, path) 0
 #define fiu_failinfo() NULL
+#define fiu_thread_tag(tag) 0
+#define fiu_thread_untag(tag) 0
 #define fiu_do_on(name, action)
+#define fiu_delay_on(name)
 #define fiu_exit_on(name)
 #define fiu_return_on(name, retval)
 
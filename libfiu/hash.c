@@ -329,6 +329,32 @@ bool hash_del(struct hash *h, const char *key)
 	return true;
 }
 
+/* Iterates over the entries of the table, calling f(key, value, arg) on each
+ * of them, starting at the slot *pos (which should be 0 on the first call).
+ *
+ * If f returns false, the iteration stops and *pos is left pointing to that
+ * entry, so it will be visited again when resuming. This allows the caller to
+ * walk the table in chunks, potentially modifying it in between; in that
+ * case, entries may be missed or visited twice.
+ *
+ * Returns true if the end of the table was reached, false otherwise. */
+bool hash_iter(struct hash *h, size_t *pos,
+               bool (*f)(const char *key, void *value, void *arg), void *arg)
+{
+	struct entry *entry;
+
+	for (; *pos < h->table_size; (*pos)++) {
+		entry = h->entries + *pos;
+		if (entry->in_use != IN_USE)
+			continue;
+
+		if (!f(entry->key, entry->value, arg))
+			return false;
+	}
+
+	return true;
+}
+
 /* Generic, simple cache.
  *
  * It is implemented using a hash table and manipulating it directly when
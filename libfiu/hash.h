@@ -16,6 +16,8 @@ void hash_free(hash_t *h);
 void *hash_get(hash_t *h, const char *key);
 bool hash_set(hash_t *h, const char *key, void *value);
 bool hash_del(hash_t *h, const char *key);
+bool hash_iter(hash_t *h, size_t *pos,
+               bool (*f)(const char *key, void *value, void *arg), void *arg);
 
 /* Generic cache. */
 
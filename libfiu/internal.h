@@ -4,9 +4,78 @@
 #ifndef _INTERNAL_H
 #define _INTERNAL_H
 
+#include <stddef.h> /* size_t */
+
 /* Recursion count, used both in fiu.c and fiu-rc.c */
 extern __thread int rec_count;
 
+/* Max length of a line containing a control directive */
+#define MAX_LINE 512
+
+/* Makes the points of failure this thread enables from now on be restricted
+ * to the given path prefix (see fiu_set_path()); NULL goes back to normal.
+ * Used by the remote control, so the restriction applies from the start. */
+void pf_next_path(const char *prefix);
+
+/* Same, for the burst (see fiu_set_burst()); 0 goes back to normal. */
+void pf_next_burst(unsigned int count);
+
+/* Same, for the size restriction (see fiu_set_size()); 0, 0 goes back to
+ * normal. */
+void pf_next_size(size_t min_size, size_t min_total);
+
+/* Same, for the predicate (see fiu_set_predicate()); NULL goes back to
+ * normal. The enable fails if it's not valid. */
+void pf_next_predicate(const char *src);
+
+/* Same, for the threads (see fiu_set_threads()); 0, NULL, NULL goes back to
+ * normal. */
+void pf_next_threads(long tid, const char *name, const char *tag);
+
+/* Lazy remote control requests, set from the signal handler (see
+ * fiu-rc.c): RC_LAZY_START to create the remote control, RC_LAZY_RESET to
+ * just recompute the watch masks. fiu_fail() and friends call
+ * rc_lazy_start() when it's set, before taking any lock. */
+#define RC_LAZY_START 1
+#define RC_LAZY_RESET 2
+extern int rc_lazy_pending;
+void rc_lazy_start(void);
+
+/* Sets all the bits of the watch masks, so the wrappers call
+ * fiu_fail_id_op() even if none of their points is enabled; and recomputes
+ * them. See fiu-rc.c. watches_poke() is async-signal-safe. */
+void watches_poke(void);
+void watches_reset(void);
+
+/* Converts between the delay distributions (FIU_DELAY_*) and their names in
+ * the remote control. delay_dist_from_name() returns -1 if the name is
+ * unknown. */
+const char *delay_dist_name(int dist);
+int delay_dist_from_name(const char *name);
+
+/* Append to the remote control command being written in buf, of size len,
+ * which is n characters long so far, and return its new length. If it
+ * doesn't fit, they return len (and so do the ones after them), so the
+ * caller only needs to check it at the end. rc_append() works like
+ * snprintf(); rc_append_value() appends the prefix as is and then the
+ * value, escaped as the parameter values need to be (see fiu-rc.c). Values
+ * with newlines can't be escaped, and don't fit either. */
+size_t rc_append(char *buf, size_t len, size_t n, const char *fmt, ...);
+size_t rc_append_value(char *buf, size_t len, size_t n, const char *prefix,
+                       const char *value);
+
+/* Calls cb(line, arg) for each enabled point of failure, where line is a
+ * remote control command describing it (see fiu-rc.c), except for the
+ * ones whose command doesn't fit in MAX_LINE. The points are collected in
+ * small chunks, and the lock is not held while calling cb.
+ * Stops and returns -1 if cb returns < 0, otherwise returns 0. */
+int dump_enabled_fails(int (*cb)(const char *line, void *arg), void *arg);
+
+/* Returns a number that changes every time the output of
+ * dump_enabled_fails() may. */
+unsigned int dump_gen(void);
+
+
 /* Gets a stack trace. The pointers are stored in the given buffer, which must
  * be of the given size. The number of entries is returned.
  * It's a wrapper around glibc's backtrace(). */
@@ -0,0 +1,219 @@
+
+/*
+ * Predicates over the arguments of an operation.
+ *
+ * They restrict points of failure to some operations (see
+ * fiu_set_predicate()), like "writes to file descriptor 7 of more than 4096
+ * bytes". The source looks like:
+ *
+ *   arg1==7&&arg3>4096
+ *
+ * where argN is the N-th argument (counting from 1) of the operation, as
+ * given by the caller; and the comparisons are ==, !=, <, <=, >, >= and &
+ * (true if any of the bits are set), always between an argument and a
+ * number (in decimal, or in hex or octal with the C prefixes). They can be
+ * combined with && and ||, the former having precedence, but there are no
+ * parentheses. There are no spaces either, so they can be given to the
+ * remote control.
+ *
+ * They're compiled once, when the point of failure is enabled, to a list of
+ * comparisons grouped by the ||s, so evaluating one is just a short loop.
+ */
+
+#include <errno.h>   /* errno */
+#include <stdbool.h> /* for bool */
+#include <stdint.h>  /* for int64_t */
+#include <stdlib.h>  /* for malloc(), strtoll() */
+#include <string.h>  /* for strlen(), strncmp() */
+
+#include "predicate.h"
+
+/* Maximum number of comparisons in a predicate. */
+#define MAX_INSNS 16
+
+enum insn_op {
+	OP_EQ = 1,
+	OP_NE,
+	OP_LT,
+	OP_LE,
+	OP_GT,
+	OP_GE,
+	OP_BITS,
+};
+
+struct insn {
+	enum insn_op op;
+
+	/* Position of the argument, counting from 0. */
+	unsigned int arg;
+
+	/* Whether it's the last one of a group of &&s. */
+	bool last;
+
+	int64_t value;
+};
+
+struct predicate {
+	unsigned int n;
+	struct insn code[MAX_INSNS];
+	char src[];
+};
+
+/* Operators, longest first so that "<=" is not taken as "<". */
+static const struct {
+	const char *s;
+	enum insn_op op;
+} ops[] = {
+	{"==", OP_EQ}, {"!=", OP_NE}, {"<=", OP_LE}, {">=", OP_GE},
+	{"<", OP_LT},  {">", OP_GT},  {"&", OP_BITS}, {NULL, 0},
+};
+
+/* Parses one comparison at *s, advancing it past it. */
+static bool parse_insn(const char **s, struct insn *insn)
+{
+	unsigned long n;
+	char *end;
+	int i;
+
+	if (strncmp(*s, "arg", 3) != 0)
+		return false;
+
+	errno = 0;
+	n = strtoul(*s + 3, &end, 10);
+	if (end == *s + 3 || n < 1 || n > 255 || errno != 0)
+		return false;
+	insn->arg = n - 1;
+	*s = end;
+
+	for (i = 0; ops[i].s != NULL; i++) {
+		if (strncmp(*s, ops[i].s, strlen(ops[i].s)) == 0)
+			break;
+	}
+	if (ops[i].s == NULL)
+		return false;
+	insn->op = ops[i].op;
+	*s += strlen(ops[i].s);
+
+	/* Both signed and unsigned numbers, so for example 0xffffffffffffffff
+	 * is -1. */
+	errno = 0;
+	if (**s == '-')
+		insn->value = strtoll(*s, &end, 0);
+	else
+		insn->value = (int64_t) strtoull(*s, &end, 0);
+	if (end == *s || errno != 0)
+		return false;
+	*s = end;
+
+	return true;
+}
+
+struct predicate *predicate_compile(const char *src)
+{
+	struct predicate *p;
+	const char *s = src;
+	size_t len = strlen(src);
+
+	p = malloc(sizeof(struct predicate) + len + 1);
+	if (p == NULL)
+		return NULL;
+	memcpy(p->src, src, len + 1);
+	p->n = 0;
+
+	for (;;) {
+		if (p->n >= MAX_INSNS || !parse_insn(&s, &p->code[p->n]))
+			goto error;
+		p->code[p->n].last = false;
+		p->n++;
+
+		if (*s == '\0') {
+			break;
+		} else if (strncmp(s, "&&", 2) == 0) {
+			s += 2;
+		} else if (strncmp(s, "||", 2) == 0) {
+			p->code[p->n - 1].last = true;
+			s += 2;
+		} else {
+			goto error;
+		}
+	}
+	p->code[p->n - 1].last = true;
+
+	return p;
+
+error:
+	free(p);
+	return NULL;
+}
+
+void predicate_free(struct predicate *p)
+{
+	free(p);
+}
+
+const char *predicate_source(const struct predicate *p)
+{
+	return p->src;
+}
+
+unsigned int predicate_nargs(const struct predicate *p)
+{
+	unsigned int i, n = 0;
+
+	for (i = 0; i < p->n; i++) {
+		if (p->code[i].arg >= n)
+			n = p->code[i].arg + 1;
+	}
+
+	return n;
+}
+
+static bool insn_eval(const struct insn *insn, const int64_t *args,
+                      unsigned int nargs)
+{
+	int64_t a;
+
+	if (insn->arg >= nargs)
+		return false;
+	a = args[insn->arg];
+
+	switch (insn->op) {
+	case OP_EQ:
+		return a == insn->value;
+	case OP_NE:
+		return a != insn->value;
+	case OP_LT:
+		return a < insn->value;
+	case OP_LE:
+		return a <= insn->value;
+	case OP_GT:
+		return a > insn->value;
+	case OP_GE:
+		return a >= insn->value;
+	case OP_BITS:
+		return (a & insn->value) != 0;
+	}
+
+	return false;
+}
+
+bool predicate_eval(const struct predicate *p, const int64_t *args,
+                    unsigned int nargs)
+{
+	bool ok = true;
+	unsigned int i;
+
+	/* A group is true if all of its comparisons are, and the predicate if
+	 * any of the groups is. */
+	for (i = 0; i < p->n; i++) {
+		if (ok)
+			ok = insn_eval(&p->code[i], args, nargs);
+		if (p->code[i].last) {
+			if (ok)
+				return true;
+			ok = true;
+		}
+	}
+
+	return false;
+}
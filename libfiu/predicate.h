@@ -0,0 +1,32 @@
+
+/* Predicates over the arguments of an operation.
+ *
+ * See predicate.c for more information. */
+
+#ifndef _PREDICATE_H
+#define _PREDICATE_H
+
+#include <stdbool.h> /* for bool */
+#include <stdint.h>  /* for int64_t */
+
+struct predicate;
+
+/* Compiles the given source, returns NULL if it's not valid (or if we run
+ * out of memory). */
+struct predicate *predicate_compile(const char *src);
+
+void predicate_free(struct predicate *p);
+
+/* Evaluates the predicate against the given arguments. Comparisons with
+ * arguments that are not there are false. */
+bool predicate_eval(const struct predicate *p, const int64_t *args,
+                    unsigned int nargs);
+
+/* Returns how many arguments the predicate looks at, that is, one more than
+ * the position of the last one. */
+unsigned int predicate_nargs(const struct predicate *p);
+
+/* Returns the source the predicate was compiled from. */
+const char *predicate_source(const struct predicate *p);
+
+#endif
@@ -0,0 +1,375 @@
+
+/*
+ * Restricting points of failure to some threads.
+ *
+ * Points of failure can be restricted to the threads with a given thread ID,
+ * a given name (as set with pthread_setname_np(); it can have wildcards,
+ * like the names of the points of failure), or a given tag (set with
+ * fiu_thread_tag()). See fiu_set_threads().
+ *
+ * Each of them is a selector, and takes one bit of a 64-bit mask; points of
+ * failure keep the mask of their selectors. Each thread keeps the bits of the
+ * selectors it matches in thread_bits, so checking is just an and; they are
+ * recomputed by the thread itself when the selectors change, which is
+ * noticed by the change in thread_sels_gen.
+ *
+ * Thread names are read when the bits are recomputed, so a thread that
+ * changes its name after that is not noticed until the selectors change
+ * again; tags are the way to go for threads that change roles.
+ *
+ * Selectors are released when nothing uses them anymore: for tags, that
+ * means no point of failure and no thread, so they count both. Threads
+ * release their tags when they exit.
+ */
+
+/* For syscall() and prctl() */
+#define _GNU_SOURCE 1
+
+#include <pthread.h> /* mutexes */
+#include <stdint.h>  /* for uint64_t */
+#include <stdlib.h>  /* malloc() and friends */
+#include <string.h>  /* strcmp() and friends */
+
+#ifdef __linux__
+#include <sys/prctl.h>   /* prctl(PR_GET_NAME) */
+#include <sys/syscall.h> /* SYS_gettid */
+#include <unistd.h>      /* syscall() */
+#endif
+
+/* Enable us, so we get the real prototypes from the headers */
+#define FIU_ENABLE 1
+
+#include "fiu.h"
+#include "internal.h"
+#include "threads.h"
+#include "wtable.h"
+
+#define MAX_SELS 64
+
+enum sel_kind {
+	SEL_FREE = 0,
+	SEL_TID,
+	SEL_NAME,
+	SEL_TAG,
+};
+
+struct thread_sel {
+	enum sel_kind kind;
+	long tid;
+	char *str;
+
+	/* How many points of failure use it, and for tags, how many threads
+	 * have it (in their thread_tags). */
+	unsigned int refs;
+	unsigned int threads;
+};
+
+/* The selectors, protected by sels_lock. */
+static struct thread_sel sels[MAX_SELS];
+static pthread_mutex_t sels_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* Changes each time a selector is taken or released, so threads know they
+ * have to recompute their bits. Starts at 1 so they do it the first time. */
+unsigned int thread_sels_gen = 1;
+
+__thread uint64_t thread_bits = 0;
+__thread unsigned int thread_bits_gen = 0;
+
+/* Bits of the tags of the calling thread. */
+static __thread uint64_t thread_tags = 0;
+
+/* Key used only for its destructor, which releases the tags of the threads
+ * that exit with some; see thread_tag(). */
+static pthread_key_t tags_key;
+static pthread_once_t tags_key_once = PTHREAD_ONCE_INIT;
+
+static long own_tid(void)
+{
+#if defined __linux__ && defined SYS_gettid
+	return syscall(SYS_gettid);
+#else
+	return 0;
+#endif
+}
+
+/* Gets the name of the calling thread into buf, which must be at least 16
+ * bytes long. */
+static void own_name(char *buf)
+{
+	buf[0] = '\0';
+#if defined __linux__ && defined PR_GET_NAME
+	prctl(PR_GET_NAME, buf, 0, 0, 0);
+#endif
+}
+
+/* Finds the selector, and if create is true, takes a free one for it if
+ * there is none. Returns its index, or -1 if it's not there (or there are
+ * none left, or we run out of memory).
+ * Must be called with sels_lock held. */
+static int sel_find(enum sel_kind kind, long tid, const char *str,
+                    bool create)
+{
+	int i, free_i = -1;
+
+	for (i = 0; i < MAX_SELS; i++) {
+		if (sels[i].kind == SEL_FREE) {
+			if (free_i < 0)
+				free_i = i;
+			continue;
+		}
+		if (sels[i].kind != kind)
+			continue;
+		if (kind == SEL_TID ? sels[i].tid == tid
+		                    : strcmp(sels[i].str, str) == 0)
+			return i;
+	}
+
+	if (!create || free_i < 0)
+		return -1;
+
+	sels[free_i].str = NULL;
+	if (str != NULL) {
+		sels[free_i].str = strdup(str);
+		if (sels[free_i].str == NULL)
+			return -1;
+	}
+	sels[free_i].kind = kind;
+	sels[free_i].tid = tid;
+	sels[free_i].refs = 0;
+	sels[free_i].threads = 0;
+	__atomic_add_fetch(&thread_sels_gen, 1, __ATOMIC_RELEASE);
+
+	return free_i;
+}
+
+/* Releases the selector if nothing uses it anymore.
+ * Must be called with sels_lock held. */
+static void sel_release(int i)
+{
+	if (sels[i].refs > 0 || sels[i].threads > 0)
+		return;
+
+	free(sels[i].str);
+	sels[i].str = NULL;
+	sels[i].kind = SEL_FREE;
+	__atomic_add_fetch(&thread_sels_gen, 1, __ATOMIC_RELEASE);
+}
+
+/* Must be called with sels_lock held. */
+static void sels_put(uint64_t mask)
+{
+	int i;
+
+	for (i = 0; i < MAX_SELS; i++) {
+		if (!(mask & ((uint64_t)1 << i)))
+			continue;
+		sels[i].refs--;
+		sel_release(i);
+	}
+}
+
+/* Removes the given tags from the calling thread.
+ * Must be called with sels_lock held. */
+static void tags_put(uint64_t mask)
+{
+	int i;
+
+	for (i = 0; i < MAX_SELS; i++) {
+		if (!(mask & thread_tags & ((uint64_t)1 << i)))
+			continue;
+		thread_tags &= ~((uint64_t)1 << i);
+		sels[i].threads--;
+		sel_release(i);
+	}
+}
+
+int thread_sels_get(long tid, const char *name, const char *tag,
+                    uint64_t *mask)
+{
+	const struct {
+		enum sel_kind kind;
+		const char *str;
+	} wanted[] = {
+		{SEL_TID, NULL},
+		{SEL_NAME, name},
+		{SEL_TAG, tag},
+	};
+	unsigned int i;
+	int r = 0, s;
+
+	rec_count++;
+	pthread_mutex_lock(&sels_lock);
+
+	*mask = 0;
+	for (i = 0; i < sizeof(wanted) / sizeof(wanted[0]); i++) {
+		if (wanted[i].kind == SEL_TID ? tid == 0
+		                              : wanted[i].str == NULL)
+			continue;
+
+		s = sel_find(wanted[i].kind, tid, wanted[i].str, true);
+		if (s < 0) {
+			sels_put(*mask);
+			*mask = 0;
+			r = -1;
+			break;
+		}
+		sels[s].refs++;
+		*mask |= (uint64_t)1 << s;
+	}
+
+	pthread_mutex_unlock(&sels_lock);
+	rec_count--;
+	return r;
+}
+
+void thread_sels_put(uint64_t mask)
+{
+	if (mask == 0)
+		return;
+
+	rec_count++;
+	pthread_mutex_lock(&sels_lock);
+	sels_put(mask);
+	pthread_mutex_unlock(&sels_lock);
+	rec_count--;
+}
+
+size_t thread_sels_describe(uint64_t mask, char *buf, size_t len, size_t n)
+{
+	int i;
+
+	pthread_mutex_lock(&sels_lock);
+	for (i = 0; i < MAX_SELS; i++) {
+		if (!(mask & ((uint64_t)1 << i)))
+			continue;
+
+		switch (sels[i].kind) {
+		case SEL_TID:
+			n = rc_append(buf, len, n, ",tid=%ld", sels[i].tid);
+			break;
+		case SEL_NAME:
+			n = rc_append_value(buf, len, n, ",thread=",
+			                    sels[i].str);
+			break;
+		case SEL_TAG:
+			n = rc_append_value(buf, len, n, ",tag=", sels[i].str);
+			break;
+		default:
+			break;
+		}
+	}
+	pthread_mutex_unlock(&sels_lock);
+
+	return n;
+}
+
+void thread_bits_update(void)
+{
+	char name[17] = {0};
+	uint64_t bits;
+	long tid;
+	int i;
+
+	tid = own_tid();
+	own_name(name);
+
+	pthread_mutex_lock(&sels_lock);
+
+	/* Read it with the lock held, so if it changes while we're at it we
+	 * come back next time. */
+	thread_bits_gen = __atomic_load_n(&thread_sels_gen, __ATOMIC_ACQUIRE);
+
+	bits = thread_tags;
+	for (i = 0; i < MAX_SELS; i++) {
+		if (sels[i].kind == SEL_TID && sels[i].tid == tid)
+			bits |= (uint64_t)1 << i;
+		else if (sels[i].kind == SEL_NAME &&
+		         wtable_matches(sels[i].str, name))
+			bits |= (uint64_t)1 << i;
+	}
+	thread_bits = bits;
+
+	pthread_mutex_unlock(&sels_lock);
+}
+
+/* Releases the tags of an exiting thread. */
+static void tags_key_destructor(void *value)
+{
+	(void)value;
+
+	rec_count++;
+	pthread_mutex_lock(&sels_lock);
+	tags_put(thread_tags);
+	pthread_mutex_unlock(&sels_lock);
+	rec_count--;
+}
+
+static void tags_key_create(void)
+{
+	pthread_key_create(&tags_key, tags_key_destructor);
+}
+
+/* Adds or removes the calling thread from the given tag. Removing a tag the
+ * thread doesn't have does nothing. */
+static int thread_tag(const char *tag, bool add)
+{
+	int s, r = 0;
+
+	if (tag == NULL)
+		return -1;
+
+	rec_count++;
+
+	/* The value is never used, it just has to be non-NULL for the
+	 * destructor to run. */
+	if (add) {
+		pthread_once(&tags_key_once, tags_key_create);
+		pthread_setspecific(tags_key, (void *)1);
+	}
+
+	pthread_mutex_lock(&sels_lock);
+
+	s = sel_find(SEL_TAG, 0, tag, add);
+	if (s < 0) {
+		r = add ? -1 : 0;
+	} else if (add) {
+		if (!(thread_tags & ((uint64_t)1 << s))) {
+			thread_tags |= (uint64_t)1 << s;
+			sels[s].threads++;
+		}
+	} else {
+		tags_put((uint64_t)1 << s);
+	}
+
+	pthread_mutex_unlock(&sels_lock);
+	rec_count--;
+
+	/* Recompute the bits next time. */
+	thread_bits_gen = 0;
+	return r;
+}
+
+void thread_sels_atfork_child(void)
+{
+	int i;
+
+	/* Only the calling thread survives the fork, so it's the only one
+	 * that can have tags now. */
+	pthread_mutex_init(&sels_lock, NULL);
+	for (i = 0; i < MAX_SELS; i++) {
+		if (sels[i].kind != SEL_TAG)
+			continue;
+		sels[i].threads = (thread_tags >> i) & 1;
+		sel_release(i);
+	}
+}
+
+int fiu_thread_tag(const char *tag)
+{
+	return thread_tag(tag, true);
+}
+
+int fiu_thread_untag(const char *tag)
+{
+	return thread_tag(tag, false);
+}
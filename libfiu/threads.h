@@ -0,0 +1,49 @@
+
+/* Restricting points of failure to some threads.
+ *
+ * See threads.c for more information. */
+
+#ifndef _THREADS_H
+#define _THREADS_H
+
+#include <stdbool.h> /* for bool */
+#include <stddef.h>  /* for size_t */
+#include <stdint.h>  /* for uint64_t */
+
+/* Gets the selectors for the given thread ID, thread name and tag (0 or NULL
+ * for the ones not wanted), and puts in *mask their bits. Returns 0 if
+ * success, -1 if there are too many selectors in use or we run out of
+ * memory. */
+int thread_sels_get(long tid, const char *name, const char *tag,
+                    uint64_t *mask);
+
+/* Releases the selectors in the mask, as returned by thread_sels_get(). */
+void thread_sels_put(uint64_t mask);
+
+/* Appends to the remote control command in buf the parameters that
+ * describe the selectors in the mask (like ",tid=12"). Works like
+ * rc_append(). */
+size_t thread_sels_describe(uint64_t mask, char *buf, size_t len, size_t n);
+
+/* Forgets the tags of the threads that didn't survive the fork; to be
+ * called at the child. */
+void thread_sels_atfork_child(void);
+
+/* Membership bits of the calling thread, and the generation of the
+ * selectors they were computed for; see thread_matches(). */
+extern __thread uint64_t thread_bits;
+extern __thread unsigned int thread_bits_gen;
+extern unsigned int thread_sels_gen;
+
+void thread_bits_update(void);
+
+/* Does the calling thread match any of the selectors in the mask? */
+static inline bool thread_matches(uint64_t mask)
+{
+	if (thread_bits_gen !=
+	    __atomic_load_n(&thread_sels_gen, __ATOMIC_ACQUIRE))
+		thread_bits_update();
+	return (thread_bits & mask) != 0;
+}
+
+#endif
@@ -5,15 +5,30 @@
  * This is a simple key-value table that associates a key (\0-terminated
  * string) with a value (void *).
  *
- * The keys can end in a wildcard ('*'), and then a lookup will match them as
- * expected.
+ * The keys can contain wildcards, and then a lookup will match them as
+ * expected. A key that ends in '*' matches all the ones that begin with the
+ * rest of it; any other '*' or '?' in it is a literal character. A key that
+ * begins with "glob:" (GLOB_PREFIX) is a glob pattern instead, matched
+ * against the whole of the rest: in it, '*' matches any sequence of
+ * characters (including none, and including '/'), and '?' matches any single
+ * character.
  *
- * The current implementation is a very simple dynamic array, which is good
- * enough for a small number of elements (< 100), but we should optimize this
- * in the future, in particular to speed up lookups.
+ * The wildcarded keys are kept in a simple dynamic array. To look them up,
+ * they are all compiled together into a DFA, so a lookup walks the key only
+ * once no matter how many of them there are. The DFA is built by the first
+ * lookup after the table changes, and it is complete and never changes once
+ * it's there, so lookups can share it without locking. If it would be too
+ * big, lookups fall back to matching the keys one by one.
  *
- * If more than one entry matches, we do not guarantee any order, although
- * this may change in the future.
+ * Lookups can run at the same time as other lookups, but not as changes to
+ * the table; the callers take care of that (see fiu.c).
+ *
+ * If more than one entry matches, the first one in the array wins, but the
+ * order of the array is not something the callers can rely on.
+ *
+ * Most lookups are usually for keys that are not in the table, so in front of
+ * all that there is a Bloom filter, which can tell most of them apart with a
+ * pass over the key and a couple of bit tests.
  */
 
 #include <stdbool.h>   /* for bool */
@@ -47,12 +62,25 @@ struct wtable {
 	/* And we keep a cache of lookups into the wildcards array. */
 	cache_t *wcache;
 
+	/* DFA for the wildcards (see below). NULL if it hasn't been built
+	 * since the last change, DFA_NONE if it's too big. */
+	struct dfa *dfa;
+
+	/* Bloom filter of the keys (see below), NULL if it's not in use. */
+	uint64_t *bloom;
+	size_t bloom_bits;
+	size_t bloom_count;
+	uint64_t bloom_plens;
+
 	void (*destructor)(void *);
 };
 
 /* Minimum table size. */
 #define MIN_SIZE 10
 
+static void dfa_invalidate(struct wtable *t);
+static void bloom_rebuild(struct wtable *t);
+
 struct wtable *wtable_create(void (*destructor)(void *))
 {
 	struct wtable *t = malloc(sizeof(struct wtable));
@@ -61,6 +89,8 @@ struct wtable *wtable_create(void (*destructor)(void *))
 
 	t->wildcards = NULL;
 	t->wcache = NULL;
+	t->dfa = NULL;
+	t->bloom = NULL;
 
 	t->finals = hash_create(destructor);
 	if (t->finals == NULL)
@@ -79,6 +109,7 @@ struct wtable *wtable_create(void (*destructor)(void *))
 	t->ws_size = MIN_SIZE;
 	t->ws_used_count = 0;
 	t->destructor = destructor;
+	bloom_rebuild(t);
 
 	return t;
 
@@ -99,6 +130,8 @@ void wtable_free(struct wtable *t)
 
 	hash_free(t->finals);
 	cache_free(t->wcache);
+	dfa_invalidate(t);
+	free(t->bloom);
 
 	for (i = 0; i < t->ws_size; i++) {
 		entry = t->wildcards + i;
@@ -112,31 +145,65 @@ void wtable_free(struct wtable *t)
 	free(t);
 }
 
-/* Return the last position where s1 and s2 match. */
-static unsigned int strlast(const char *s1, const char *s2)
-{
-	unsigned int i = 0;
-
-	while (*s1 != '\0' && *s2 != '\0' && *s1 == *s2) {
-		i++;
-		s1++;
-		s2++;
-	}
+/* Prefix of the keys that are glob patterns. */
+#define GLOB_PREFIX "glob:"
+#define GLOB_PREFIX_LEN (sizeof(GLOB_PREFIX) - 1)
 
-	return i;
+/* True if s is a glob pattern, False otherwise. */
+static bool is_glob(const char *s)
+{
+	return strncmp(s, GLOB_PREFIX, GLOB_PREFIX_LEN) == 0;
 }
 
 /* True if s is a wildcarded string, False otherwise. */
 static bool is_wildcard(const char *s, size_t len)
 {
-	/* Note we only support wildcards at the end of the string for now. */
-	return s[len - 1] == '*';
+	return is_glob(s) || (len > 0 && s[len - 1] == '*');
+}
+
+/* True if the character in position i of the wildcarded string s (which is
+ * len long) is a wildcard, False if it's a literal character. */
+static bool is_wildcard_char(const char *s, size_t len, size_t i)
+{
+	if (is_glob(s))
+		return i >= GLOB_PREFIX_LEN && (s[i] == '*' || s[i] == '?');
+	return i == len - 1;
+}
+
+/* Matches the glob pattern p against s. A '*' is matched against as little
+ * as possible, and if the rest doesn't match we go back and make it take one
+ * more character; only the last '*' seen needs to be retried, which keeps
+ * this linear in practice. */
+static bool glob_matches(const char *p, const char *s)
+{
+	const char *star = NULL, *star_s = NULL;
+
+	while (*s != '\0') {
+		if (*p == '*') {
+			star = p++;
+			star_s = s;
+		} else if (*p == '?' || *p == *s) {
+			p++;
+			s++;
+		} else if (star != NULL) {
+			p = star + 1;
+			s = ++star_s;
+		} else {
+			return false;
+		}
+	}
+
+	while (*p == '*')
+		p++;
+
+	return *p == '\0';
 }
 
 /* Checks if ws matches s.
  *
  * ws is a "wildcard string", which can end in a '*', in which case we compare
- * only up to that position, to do a wildcard matching.
+ * only up to that position, or be a glob pattern, in which case we match it
+ * as such.
  */
 static bool ws_matches_s(const char *ws, size_t ws_len, const char *s,
                          size_t s_len, bool exact)
@@ -149,12 +216,19 @@ static bool ws_matches_s(const char *ws, size_t ws_len, const char *s,
 		if (ws_len != s_len)
 			return false;
 		return strcmp(ws, s) == 0;
+	} else if (is_glob(ws)) {
+		return glob_matches(ws + GLOB_PREFIX_LEN, s);
 	} else {
 		/* Inexact match */
-		return strlast(ws, s) >= ws_len - 1;
+		return s_len >= ws_len - 1 && memcmp(ws, s, ws_len - 1) == 0;
 	}
 }
 
+bool wtable_matches(const char *key, const char *s)
+{
+	return ws_matches_s(key, strlen(key), s, strlen(s), false);
+}
+
 /* Find the entry matching the given key.
  *
  * If exact == true, then the key must match exactly (no wildcard matching).
@@ -194,22 +268,612 @@ static struct wentry *wildcards_find_entry(struct wtable *t, const char *key,
 	return NULL;
 }
 
+/*
+ * DFA for the wildcarded keys.
+ *
+ * All the keys are laid out one after the other (without the prefix of the
+ * glob patterns), each followed by a '\0', and every character of them is a
+ * position of an NFA: being at a position means that the key matched up to
+ * there, and being at its '\0' means that it matched entirely. A DFA state is
+ * the set of positions we can be at, kept as a sorted list.
+ *
+ * Stepping from a position over a character moves forward if it's a '?' or
+ * the same character, and stays if it's a '*'; being at a '*' also means
+ * being right after it, as it can match nothing. Only the characters that are
+ * wildcards (see is_wildcard_char()) behave like that, the rest are matched
+ * literally, so we keep which ones they are.
+ *
+ * The characters that don't appear in any of the keys all behave the same, so
+ * the transitions are per class of characters: each one that appears in a
+ * key gets its own class, and the rest share class 0.
+ *
+ * The DFA is built in one go, with all its states and transitions, by the
+ * first lookup that needs it. It's built privately and then published with a
+ * compare-and-swap, so concurrent lookups can each build one, but only one of
+ * them is kept. From then on it's only read. If it has too many states, it
+ * is not built, and lookups are done the slow way until the table changes.
+ *
+ * The state lists are sorted, and the positions follow the order of the
+ * wildcards array, so the first '\0' in a state is the one of the entry that
+ * comes first, which is the one that wins.
+ */
+
+/* Limits on the number of states, and on the total length of their lists. */
+#define DFA_MAX_STATES 32768
+#define DFA_MAX_POOL (1 << 20)
+
+
+struct dstate {
+	/* The list of positions, in the pool, and its hash. */
+	size_t off;
+	uint32_t len;
+	uint32_t hash;
+
+	/* Entry that matches if the key ends here, or NULL. */
+	struct wentry *accept;
+};
+
+struct dfa {
+	/* The keys, the positions that are wildcards, and the entry each
+	 * '\0' belongs to. */
+	char *pchars;
+	bool *pwild;
+	struct wentry **pentries;
+	uint32_t npos;
+
+	/* Class of each character, and a character of each class. */
+	uint8_t cls[256];
+	uint8_t rep[256];
+	unsigned int ncls;
+
+	struct dstate *states;
+	unsigned int nstates;
+	unsigned int states_size;
+
+	/* Transitions, ncls per state (-1 only while it's being built). */
+	int32_t *next;
+
+	/* Pool where the state lists are kept. */
+	uint32_t *pool;
+	size_t pool_used;
+	size_t pool_size;
+
+	/* Index of the states by their lists, -1 for empty buckets. It has
+	 * twice as many buckets as there is room for states. */
+	int32_t *buckets;
+
+	/* Scratch space to build a list in, npos long. */
+	uint32_t *scratch;
+};
+
+/* What t->dfa is set to when it would be too big. */
+static struct dfa dfa_none;
+#define DFA_NONE (&dfa_none)
+
+static void dfa_free(struct dfa *d)
+{
+	if (d == NULL)
+		return;
+
+	free(d->pchars);
+	free(d->pwild);
+	free(d->pentries);
+	free(d->states);
+	free(d->next);
+	free(d->pool);
+	free(d->buckets);
+	free(d->scratch);
+	free(d);
+}
+
+static uint32_t list_hash(const uint32_t *l, uint32_t len)
+{
+	uint32_t h = 2166136261u;
+	uint32_t i;
+
+	for (i = 0; i < len; i++)
+		h = (h ^ l[i]) * 16777619u;
+
+	return h;
+}
+
+/* Returns the bucket for the given list: the one of the state that has it,
+ * or the empty one where it would go. */
+static int32_t *dfa_bucket(struct dfa *d, uint32_t hash, const uint32_t *l,
+                           uint32_t len)
+{
+	size_t nbuckets = d->states_size * 2;
+	size_t b = hash % nbuckets;
+	struct dstate *st;
+
+	while (d->buckets[b] >= 0) {
+		st = d->states + d->buckets[b];
+		if (st->hash == hash && st->len == len &&
+		    memcmp(d->pool + st->off, l, len * sizeof(*l)) == 0)
+			break;
+		b = (b + 1) % nbuckets;
+	}
+
+	return d->buckets + b;
+}
+
+/* Doubles the room for states. */
+static bool dfa_grow(struct dfa *d)
+{
+	struct dstate *new_states;
+	int32_t *new_next, *new_buckets;
+	unsigned int i;
+
+	new_states = realloc(d->states,
+			sizeof(struct dstate) * d->states_size * 2);
+	if (new_states == NULL)
+		return false;
+	d->states = new_states;
+
+	new_next = realloc(d->next,
+			sizeof(int32_t) * d->ncls * d->states_size * 2);
+	if (new_next == NULL)
+		return false;
+	d->next = new_next;
+
+	new_buckets = malloc(sizeof(int32_t) * d->states_size * 4);
+	if (new_buckets == NULL)
+		return false;
+	free(d->buckets);
+	d->buckets = new_buckets;
+	d->states_size *= 2;
+
+	memset(d->buckets, 0xff, sizeof(int32_t) * d->states_size * 2);
+	for (i = 0; i < d->nstates; i++) {
+		*dfa_bucket(d, d->states[i].hash,
+				d->pool + d->states[i].off,
+				d->states[i].len) = i;
+	}
+
+	return true;
+}
+
+/* Returns the index of the state with the given list, adding it if it's not
+ * there, or -1 if we're over the limits. */
+static int dfa_add_state(struct dfa *d, const uint32_t *l, uint32_t len)
+{
+	uint32_t hash, i;
+	int32_t s, *b;
+	struct dstate *st;
+	uint32_t *new_pool;
+	size_t new_pool_size;
+
+	hash = list_hash(l, len);
+	b = dfa_bucket(d, hash, l, len);
+	if (*b >= 0)
+		return *b;
+
+	if (d->nstates >= DFA_MAX_STATES || d->pool_used + len > DFA_MAX_POOL)
+		return -1;
+
+	if (d->pool_used + len > d->pool_size) {
+		new_pool_size = d->pool_size * 2;
+		while (d->pool_used + len > new_pool_size)
+			new_pool_size *= 2;
+		if (new_pool_size > DFA_MAX_POOL)
+			new_pool_size = DFA_MAX_POOL;
+
+		new_pool = realloc(d->pool, sizeof(uint32_t) * new_pool_size);
+		if (new_pool == NULL)
+			return -1;
+		d->pool = new_pool;
+		d->pool_size = new_pool_size;
+	}
+
+	if (d->nstates == d->states_size) {
+		if (!dfa_grow(d))
+			return -1;
+		b = dfa_bucket(d, hash, l, len);
+	}
+
+	s = d->nstates++;
+	st = d->states + s;
+	st->off = d->pool_used;
+	st->len = len;
+	st->hash = hash;
+	st->accept = NULL;
+	for (i = 0; i < len; i++) {
+		if (d->pchars[l[i]] == '\0') {
+			st->accept = d->pentries[l[i]];
+			break;
+		}
+	}
+
+	memcpy(d->pool + d->pool_used, l, len * sizeof(*l));
+	d->pool_used += len;
+
+	for (i = 0; i < d->ncls; i++)
+		d->next[s * d->ncls + i] = -1;
+
+	*b = s;
+	return s;
+}
+
+/* Adds the position to the list, and the ones right after it if it's a '*'.
+ * The positions must come in order (see dfa_step()). */
+static void add_closure(struct dfa *d, uint32_t *l, uint32_t *len, uint32_t p)
+{
+	for (;;) {
+		if (*len == 0 || p > l[*len - 1])
+			l[(*len)++] = p;
+		if (!d->pwild[p] || d->pchars[p] != '*')
+			break;
+		p++;
+	}
+}
+
+/* Adds the initial state (state 0). */
+static bool dfa_start(struct dfa *d)
+{
+	uint32_t p, len = 0;
+
+	memset(d->buckets, 0xff, sizeof(int32_t) * d->states_size * 2);
+
+	/* The start of each key. */
+	for (p = 0; p < d->npos; p++) {
+		if (p == 0 || d->pchars[p - 1] == '\0')
+			add_closure(d, d->scratch, &len, p);
+	}
+
+	return dfa_add_state(d, d->scratch, len) == 0;
+}
+
+/* Computes the transition from state s over the given class. Returns the new
+ * state, or -1 if we're over the limits. */
+static int dfa_step(struct dfa *d, int s, unsigned int cl)
+{
+	const uint32_t *l;
+	uint32_t i, len = 0, p;
+	unsigned char c = d->rep[cl];
+	char pc;
+	int n;
+
+	l = d->pool + d->states[s].off;
+	for (i = 0; i < d->states[s].len; i++) {
+		p = l[i];
+		pc = d->pchars[p];
+		if (d->pwild[p] && pc == '*')
+			add_closure(d, d->scratch, &len, p);
+		else if (d->pwild[p] || (pc != '\0' && pc == (char) c))
+			add_closure(d, d->scratch, &len, p + 1);
+	}
+
+	n = dfa_add_state(d, d->scratch, len);
+	if (n >= 0)
+		d->next[s * d->ncls + cl] = n;
+	return n;
+}
+
+/* Builds the DFA for the current wildcards. Returns NULL on errors, or if it
+ * would be too big. */
+static struct dfa *dfa_build(struct wtable *t)
+{
+	struct dfa *d;
+	struct wentry *entry;
+	size_t i, j, start;
+	uint32_t p;
+	unsigned char c;
+	unsigned int s, cl;
+
+	d = malloc(sizeof(struct dfa));
+	if (d == NULL)
+		return NULL;
+	memset(d, 0, sizeof(struct dfa));
+
+	for (i = 0; i < t->ws_size; i++) {
+		entry = t->wildcards + i;
+		if (!entry->in_use)
+			continue;
+		d->npos += entry->key_len + 1;
+		if (is_glob(entry->key))
+			d->npos -= GLOB_PREFIX_LEN;
+	}
+	if (d->npos == 0 || d->npos > DFA_MAX_POOL)
+		goto error;
+
+	d->pchars = malloc(d->npos);
+	d->pwild = malloc(sizeof(bool) * d->npos);
+	d->pentries = malloc(sizeof(struct wentry *) * d->npos);
+	d->scratch = malloc(sizeof(uint32_t) * d->npos);
+	d->pool_size = d->npos * 4;
+	if (d->pool_size > DFA_MAX_POOL)
+		d->pool_size = DFA_MAX_POOL;
+	d->pool = malloc(sizeof(uint32_t) * d->pool_size);
+	if (!d->pchars || !d->pwild || !d->pentries || !d->scratch ||
+	    !d->pool)
+		goto error;
+
+	/* Lay out the keys, and give a class to their characters. */
+	d->ncls = 1;
+	p = 0;
+	for (i = 0; i < t->ws_size; i++) {
+		entry = t->wildcards + i;
+		if (!entry->in_use)
+			continue;
+
+		start = is_glob(entry->key) ? GLOB_PREFIX_LEN : 0;
+		for (j = start; j <= entry->key_len; j++) {
+			c = entry->key[j];
+			d->pchars[p] = c;
+			d->pwild[p] = c != '\0' &&
+			              is_wildcard_char(entry->key,
+			                               entry->key_len, j);
+			d->pentries[p] = entry;
+			p++;
+
+			if (c == '\0' || d->pwild[p - 1] || d->cls[c])
+				continue;
+			d->cls[c] = d->ncls;
+			d->rep[d->ncls] = c;
+			d->ncls++;
+		}
+	}
+
+	/* The characters that don't appear in the keys (or only as
+	 * wildcards) are in class 0. If there are none, class 0 is never used,
+	 * and its character is left as '\0'. */
+	for (i = 1; i < 256; i++) {
+		if (d->cls[i] == 0) {
+			d->rep[0] = i;
+			break;
+		}
+	}
+
+	d->states_size = 64;
+	d->states = malloc(sizeof(struct dstate) * d->states_size);
+	d->next = malloc(sizeof(int32_t) * d->ncls * d->states_size);
+	d->buckets = malloc(sizeof(int32_t) * d->states_size * 2);
+	if (!d->states || !d->next || !d->buckets)
+		goto error;
+
+	if (!dfa_start(d))
+		goto error;
+
+	/* Compute every transition of every state, including the ones that
+	 * are added along the way. */
+	for (s = 0; s < d->nstates; s++) {
+		for (cl = 0; cl < d->ncls; cl++) {
+			if (dfa_step(d, s, cl) < 0)
+				goto error;
+		}
+	}
+
+	return d;
+
+error:
+	dfa_free(d);
+	return NULL;
+}
+
+/* Looks the key up in the DFA, building it if needed. Returns true and sets
+ * *entry (to NULL if nothing matched) if it could be done, or false if the
+ * caller has to walk the array instead. */
+static bool dfa_find_entry(struct wtable *t, const char *key,
+                           struct wentry **entry)
+{
+	struct dfa *d, *expected = NULL;
+	const unsigned char *k;
+	int s;
+
+	d = __atomic_load_n(&t->dfa, __ATOMIC_ACQUIRE);
+	if (d == NULL) {
+		d = dfa_build(t);
+		if (d == NULL)
+			d = DFA_NONE;
+
+		/* Another lookup may have built it in the meantime; keep
+		 * theirs. */
+		if (!__atomic_compare_exchange_n(&t->dfa, &expected, d, false,
+		                                 __ATOMIC_ACQ_REL,
+		                                 __ATOMIC_ACQUIRE)) {
+			if (d != DFA_NONE)
+				dfa_free(d);
+			d = expected;
+		}
+	}
+
+	if (d == DFA_NONE)
+		return false;
+
+	s = 0;
+	for (k = (const unsigned char *) key; *k != '\0'; k++) {
+		s = d->next[s * d->ncls + d->cls[*k]];
+
+		/* Nothing can match from here on. */
+		if (d->states[s].len == 0)
+			break;
+	}
+
+	*entry = d->states[s].accept;
+	return true;
+}
+
+/* Throws the DFA away, must be called whenever the wildcards change (with
+ * no lookups running, like any other change). */
+static void dfa_invalidate(struct wtable *t)
+{
+	if (t->dfa != DFA_NONE)
+		dfa_free(t->dfa);
+	t->dfa = NULL;
+}
+
+
+/*
+ * Bloom filter.
+ *
+ * It has the final keys, and the prefixes of the wildcarded ones up to their
+ * first wildcard (any key they match must begin with it; the prefix of the
+ * glob patterns is not part of it). It's too expensive
+ * to hash every prefix of the key being looked up, so we keep a mask of the
+ * lengths the wildcarded prefixes have (bloom_plens, with the ones over 63
+ * cut down to 63), and only check those.
+ *
+ * The hash is FNV-1a, which can be computed a character at a time, so a
+ * single pass over the key gives the hashes of all its prefixes. Each key
+ * sets two bits, taken from the low and the high half of the hash.
+ *
+ * Keys are added to it as they are added to the table, and it is rebuilt
+ * (with a size that depends on the number of keys) when they are removed,
+ * or when there are too many for its size. If we can't allocate it, it is
+ * not used, and all lookups go through.
+ */
+
+/* Bits per key, and minimum size (in bits). */
+#define BLOOM_BITS_PER_KEY 16
+#define BLOOM_MIN_BITS 512
+
+#define BLOOM_SEED 14695981039346656037ULL
+
+static inline uint64_t bloom_step(uint64_t h, unsigned char c)
+{
+	return (h ^ c) * 1099511628211ULL;
+}
+
+static inline void bloom_set(struct wtable *t, uint64_t h)
+{
+	size_t b1 = h & (t->bloom_bits - 1);
+	size_t b2 = (h >> 32) & (t->bloom_bits - 1);
+
+	t->bloom[b1 / 64] |= (uint64_t)1 << (b1 % 64);
+	t->bloom[b2 / 64] |= (uint64_t)1 << (b2 % 64);
+}
+
+static inline bool bloom_test(struct wtable *t, uint64_t h)
+{
+	size_t b1 = h & (t->bloom_bits - 1);
+	size_t b2 = (h >> 32) & (t->bloom_bits - 1);
+
+	return (t->bloom[b1 / 64] & ((uint64_t)1 << (b1 % 64))) &&
+	       (t->bloom[b2 / 64] & ((uint64_t)1 << (b2 % 64)));
+}
+
+/* Adds the key to the filter, which must have room for it. */
+static void bloom_add(struct wtable *t, const char *key)
+{
+	uint64_t h = BLOOM_SEED;
+	size_t i, len = strlen(key), start;
+
+	if (!is_wildcard(key, len)) {
+		for (i = 0; key[i] != '\0'; i++)
+			h = bloom_step(h, key[i]);
+	} else {
+		start = is_glob(key) ? GLOB_PREFIX_LEN : 0;
+		for (i = start; i - start < 63 && key[i] != '\0' &&
+		     !is_wildcard_char(key, len, i); i++)
+			h = bloom_step(h, key[i]);
+		t->bloom_plens |= (uint64_t)1 << (i - start);
+	}
+
+	bloom_set(t, h);
+	t->bloom_count++;
+}
+
+static bool bloom_count_key(const char *key, void *value, void *arg)
+{
+	(*(size_t *) arg)++;
+	return true;
+}
+
+static bool bloom_add_key(const char *key, void *value, void *arg)
+{
+	bloom_add(arg, key);
+	return true;
+}
+
+/* Builds the filter from scratch, with the keys in the table. */
+static void bloom_rebuild(struct wtable *t)
+{
+	size_t nkeys = t->ws_used_count, bits, pos = 0, i;
+
+	hash_iter(t->finals, &pos, bloom_count_key, &nkeys);
+
+	bits = BLOOM_MIN_BITS;
+	while (bits < (nkeys + 1) * BLOOM_BITS_PER_KEY)
+		bits *= 2;
+
+	free(t->bloom);
+	t->bloom = calloc(bits / 64, sizeof(uint64_t));
+	if (t->bloom == NULL)
+		return;
+	t->bloom_bits = bits;
+	t->bloom_count = 0;
+	t->bloom_plens = 0;
+
+	pos = 0;
+	hash_iter(t->finals, &pos, bloom_add_key, t);
+	for (i = 0; i < t->ws_size; i++) {
+		if (t->wildcards[i].in_use)
+			bloom_add(t, t->wildcards[i].key);
+	}
+}
+
+/* Updates the filter after the key was added to the table. */
+static void bloom_update(struct wtable *t, const char *key)
+{
+	if (t->bloom == NULL ||
+	    (t->bloom_count + 1) * BLOOM_BITS_PER_KEY > t->bloom_bits)
+		bloom_rebuild(t);
+	else
+		bloom_add(t, key);
+}
+
+/* Checks the key against the filter, and tells if it may be one of the final
+ * keys, and if it may match one of the wildcarded ones. */
+static void bloom_check(struct wtable *t, const char *key, bool *final,
+                        bool *wildcard)
+{
+	uint64_t h = BLOOM_SEED;
+	size_t i;
+
+	if (t->bloom == NULL) {
+		*final = *wildcard = true;
+		return;
+	}
+
+	*wildcard = t->bloom_plens & 1;
+	for (i = 0; key[i] != '\0'; i++) {
+		h = bloom_step(h, key[i]);
+		if (!*wildcard && i < 63 &&
+		    (t->bloom_plens & ((uint64_t)1 << (i + 1))))
+			*wildcard = bloom_test(t, h);
+	}
+
+	*final = bloom_test(t, h);
+}
+
+
 void *wtable_get(struct wtable *t, const char *key)
 {
 	void *value;
 	struct wentry *entry;
+	bool maybe_final, maybe_wildcard;
+
+	/* Rule out most of the keys that are not in the table. */
+	bloom_check(t, key, &maybe_final, &maybe_wildcard);
 
 	/* Do an exact lookup first. */
-	value = hash_get(t->finals, key);
-	if (value)
-		return value;
+	if (maybe_final) {
+		value = hash_get(t->finals, key);
+		if (value)
+			return value;
+	}
+
+	if (!maybe_wildcard)
+		return NULL;
 
 	/* Then see if we can find it in the wcache */
 	if (cache_get(t->wcache, key, &value))
 		return value;
 
-	/* And then walk the wildcards array. */
-	entry = wildcards_find_entry(t, key, false, NULL);
+	/* And then match the wildcards, walking the array if the DFA can't be
+	 * used. */
+	if (!dfa_find_entry(t, key, &entry))
+		entry = wildcards_find_entry(t, key, false, NULL);
 	if (entry) {
 		cache_set(t->wcache, key, entry->value);
 		return entry->value;
@@ -221,6 +885,17 @@ void *wtable_get(struct wtable *t, const char *key)
 	return NULL;
 }
 
+void *wtable_get_exact(struct wtable *t, const char *key)
+{
+	struct wentry *entry;
+
+	if (!is_wildcard(key, strlen(key)))
+		return hash_get(t->finals, key);
+
+	entry = wildcards_find_entry(t, key, true, NULL);
+	return entry ? entry->value : NULL;
+}
+
 /* Set on our wildcards table.
  * For internal use only.
  * It uses the key as-is (it won't copy it), and it won't resize the array
@@ -308,11 +983,17 @@ bool wtable_set(struct wtable *t, const char *key, void *value)
 		 * removing only the negative hits, but it's also more
 		 * expensive */
 		cache_invalidate(t->wcache);
+		dfa_invalidate(t);
 
-		return wildcards_set(t, strdup(key), value);
+		if (!wildcards_set(t, strdup(key), value))
+			return false;
 	} else {
-		return hash_set(t->finals, key, value);
+		if (!hash_set(t->finals, key, value))
+			return false;
 	}
+
+	bloom_update(t, key);
+	return true;
 }
 
 bool wtable_del(struct wtable *t, const char *key)
@@ -348,9 +1029,44 @@ bool wtable_del(struct wtable *t, const char *key)
 		 * removing only the positive hits, but it's also more
 		 * expensive */
 		cache_invalidate(t->wcache);
-
-		return true;
+		dfa_invalidate(t);
 	} else {
-		return hash_del(t->finals, key);
+		if (!hash_del(t->finals, key))
+			return false;
 	}
+
+	bloom_rebuild(t);
+	return true;
+}
+
+/* Iterates over the entries of the table, final ones first and then the
+ * wildcarded ones, calling f(key, value, arg) on each.
+ *
+ * The semantics are the same as hash_iter(): if f returns false the iteration
+ * stops, and it can be resumed later by calling again with the same cursor.
+ * Returns true if all the entries were visited, false otherwise. */
+bool wtable_iter(struct wtable *t, struct wtable_cursor *cursor,
+                 bool (*f)(const char *key, void *value, void *arg),
+                 void *arg)
+{
+	struct wentry *entry;
+
+	if (!cursor->in_wildcards) {
+		if (!hash_iter(t->finals, &cursor->pos, f, arg))
+			return false;
+
+		cursor->in_wildcards = true;
+		cursor->pos = 0;
+	}
+
+	for (; cursor->pos < t->ws_size; cursor->pos++) {
+		entry = t->wildcards + cursor->pos;
+		if (!entry->in_use)
+			continue;
+
+		if (!f(entry->key, entry->value, arg))
+			return false;
+	}
+
+	return true;
 }
@@ -9,7 +9,8 @@
 #ifndef _WTABLE_H
 #define _WTABLE_H
 
-#include <stdbool.h> /* for bool */
+#include <stdbool.h>   /* for bool */
+#include <sys/types.h> /* for size_t */
 
 typedef struct wtable wtable_t;
 
@@ -17,7 +18,27 @@ wtable_t *wtable_create(void (*destructor)(void *));
 void wtable_free(wtable_t *t);
 
 void *wtable_get(wtable_t *t, const char *key);
+
+/* Gets the value stored under exactly the given key (which may contain
+ * wildcards), without matching it against the other keys. */
+void *wtable_get_exact(wtable_t *t, const char *key);
+
 bool wtable_set(wtable_t *t, const char *key, void *value);
 bool wtable_del(wtable_t *t, const char *key);
 
+/* Checks if the given key (which may contain wildcards) matches s, with the
+ * same semantics as wtable_get(). */
+bool wtable_matches(const char *key, const char *s);
+
+/* Position within a table, used by wtable_iter(). Must be zeroed before the
+ * first call. */
+struct wtable_cursor {
+	bool in_wildcards;
+	size_t pos;
+};
+
+bool wtable_iter(wtable_t *t, struct wtable_cursor *cursor,
+                 bool (*f)(const char *key, void *value, void *arg),
+                 void *arg);
+
 #endif
@@ -0,0 +1,15 @@
+
+#ifndef _BUILD_ENV_H
+#define _BUILD_ENV_H
+
+/*
+ * Constants taken from the build environment
+ */
+
+/* libc's soname, used for dlopen()ing the C library */
+#define LIBC_SONAME "libc.so.6"
+
+/* Whether 64-bit functions can be defined alongside the base ones */
+#define LIBFIU_CAN_DEFINE_64BIT_FUNCTIONS 1
+
+#endif
@@ -2,8 +2,15 @@
 #include "codegen.h"
 #include "build-env.h"
 #include <dlfcn.h>
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/time.h>
 
 /* Recursion counter, per-thread */
@@ -40,18 +47,316 @@ void *libc_symbol(const char *symbol)
 #endif
 }
 
+size_t mem_total(void)
+{
+#if defined __GLIBC__ && \
+	(__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+	struct mallinfo2 mi = mallinfo2();
+
+	return mi.arena + mi.hblkhd;
+#elif defined __GLIBC__
+	/* The fields are ints, so this wraps around past 2 GiB; better than
+	 * nothing. */
+	struct mallinfo mi = mallinfo();
+
+	return (unsigned int) mi.arena + (unsigned int) mi.hblkhd;
+#else
+	return 0;
+#endif
+}
+
+size_t mul_size(size_t a, size_t b)
+{
+	if (b != 0 && a > SIZE_MAX / b)
+		return SIZE_MAX;
+	return a * b;
+}
+
+/*
+ * Paths of the file descriptors
+ *
+ * The open() wrappers record the path each file descriptor was opened with,
+ * so the points of failure of the functions that take a file descriptor can
+ * be restricted to paths (see fiu_set_path()); close(), dup() and friends
+ * keep it up to date.
+ *
+ * Most of the time no point of failure is restricted to a path, so nothing
+ * is recorded until one is (see fiu_paths_used()); the file descriptors
+ * opened before that have no path, and those points never fail for them.
+ * Forgetting a path is always done, as it's cheap when there is none.
+ *
+ * The table is indexed by the file descriptor, in chunks that are allocated
+ * as they are needed and never freed, so a lookup is just two loads and
+ * never takes a lock. File descriptors beyond the last chunk are not
+ * tracked.
+ *
+ * Paths that are replaced are not freed right away, but the next time the
+ * entry changes, so a thread that is reading a file descriptor while another
+ * closes it (which is a bug, but one that would only give EBADF without us)
+ * is very unlikely to see a freed path.
+ */
+
+#define FD_CHUNK_BITS 10
+#define FD_CHUNK (1 << FD_CHUNK_BITS)
+#define FD_MAX_CHUNKS 1024
+
+struct fd_entry {
+	char *path;
+	char *retired;
+};
+
+static struct fd_entry *fd_chunks[FD_MAX_CHUNKS];
+
+static struct fd_entry *fd_entry(int fd, bool create)
+{
+	struct fd_entry *chunk, *expected = NULL;
+	unsigned int n;
+
+	if (fd < 0 || fd >= FD_CHUNK * FD_MAX_CHUNKS)
+		return NULL;
+
+	n = fd >> FD_CHUNK_BITS;
+	chunk = __atomic_load_n(&fd_chunks[n], __ATOMIC_ACQUIRE);
+	if (chunk == NULL) {
+		if (!create)
+			return NULL;
+
+		chunk = calloc(FD_CHUNK, sizeof(struct fd_entry));
+		if (chunk == NULL)
+			return NULL;
+
+		if (!__atomic_compare_exchange_n(&fd_chunks[n], &expected,
+					chunk, false, __ATOMIC_ACQ_REL,
+					__ATOMIC_ACQUIRE)) {
+			/* Someone else got there first. */
+			free(chunk);
+			chunk = expected;
+		}
+	}
+
+	return &chunk[fd & (FD_CHUNK - 1)];
+}
+
+/* Frees the previously retired path of the entry, and retires this one. */
+static void fd_entry_retire(struct fd_entry *e, char *path)
+{
+	free(__atomic_exchange_n(&e->retired, path, __ATOMIC_ACQ_REL));
+}
+
+const char *fd_path(int fd)
+{
+	struct fd_entry *e = fd_entry(fd, false);
+
+	if (e == NULL)
+		return NULL;
+	return __atomic_load_n(&e->path, __ATOMIC_ACQUIRE);
+}
+
+/* Tells if the paths have to be recorded; the answer is cached once it's
+ * yes, as it can't change back. */
+static bool fd_paths_used(void)
+{
+	static bool used = false;
+
+	if (__atomic_load_n(&used, __ATOMIC_RELAXED))
+		return true;
+	if (!fiu_paths_used())
+		return false;
+	__atomic_store_n(&used, true, __ATOMIC_RELAXED);
+	return true;
+}
+
+void fd_path_set(int fd, const char *path)
+{
+	struct fd_entry *e;
+	char *p = NULL;
+
+	if (path != NULL && !fd_paths_used())
+		return;
+
+	rec_inc();
+
+	e = fd_entry(fd, path != NULL);
+	if (e != NULL) {
+		if (path != NULL)
+			p = strdup(path);
+		fd_entry_retire(e, __atomic_exchange_n(&e->path, p,
+					__ATOMIC_ACQ_REL));
+	}
+
+	rec_dec();
+}
+
+char *fd_path_take(int fd)
+{
+	struct fd_entry *e = fd_entry(fd, false);
+
+	if (e == NULL)
+		return NULL;
+	return __atomic_exchange_n(&e->path, NULL, __ATOMIC_ACQ_REL);
+}
+
+void fd_path_put(int fd, char *path, bool still_open)
+{
+	struct fd_entry *e;
+	char *expected = NULL;
+
+	if (path == NULL)
+		return;
+
+	rec_inc();
+
+	e = fd_entry(fd, true);
+	if (e == NULL) {
+		free(path);
+	} else if (!still_open || !__atomic_compare_exchange_n(&e->path,
+				&expected, path, false, __ATOMIC_ACQ_REL,
+				__ATOMIC_ACQUIRE)) {
+		/* Closed, or reused by someone else in the meantime. */
+		fd_entry_retire(e, path);
+	}
+
+	rec_dec();
+}
+
+void fd_path_copy(int oldfd, int newfd)
+{
+	fd_path_set(newfd, fd_path(oldfd));
+}
+
+
+size_t reduce_iov(const struct iovec *iov, size_t cnt, struct iovec *copy)
+{
+	size_t total = 0, cut, i;
+
+	if (cnt > REDUCE_IOV_MAX)
+		cnt = REDUCE_IOV_MAX;
+
+	for (i = 0; i < cnt; i++)
+		total += iov[i].iov_len;
+	if (total == 0)
+		return 0;
+
+	/* Like mkwrap_body_reduce(), keep at least one byte. */
+	cut = total - prng_next() % total;
+
+	for (i = 0; i < cnt && cut > 0; i++) {
+		copy[i] = iov[i];
+		if (copy[i].iov_len > cut)
+			copy[i].iov_len = cut;
+		cut -= copy[i].iov_len;
+	}
+
+	return i;
+}
+
+
+/* Pseudorandom number generator for the wrappers, used to pick the errno and
+ * the reduce amounts.
+ *
+ * Each thread has its own state, so failing wrappers don't contend on the
+ * global lock random() uses. The state is derived from libfiu's seed (see
+ * fiu_get_prng_seed()) and the order in which the thread first needed it, so
+ * when the seed is set with FIU_PRNG_SEED or fiu_set_prng_seed(), the results
+ * can be reproduced, as long as the program creates its threads in a
+ * deterministic order. Otherwise, libfiu takes the seed from the clock, and
+ * changes it after each fork() so the children don't repeat the parent's
+ * choices.
+ *
+ * Whenever libfiu's seed changes, the threads start over from the new one,
+ * and are numbered again from 0; prng_threads keeps the generation of the
+ * seed in the high half, and the number of threads seeded from it in the low
+ * half. */
+static uint64_t prng_threads = 0;
+
+static __thread uint64_t prng_state;
+static __thread unsigned int prng_gen = 0;
+
+/* SplitMix64, see http://xoshiro.di.unimi.it/splitmix64.c. Fast, and good
+ * enough even for consecutive seeds, which is what we give it. */
+static uint64_t splitmix64(uint64_t *x)
+{
+	uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return z ^ (z >> 31);
+}
+
+/* Returns the number of this thread among the ones seeded in the given
+ * generation. */
+static uint64_t prng_thread_number(unsigned int gen)
+{
+	uint64_t old, new;
+
+	old = __atomic_load_n(&prng_threads, __ATOMIC_RELAXED);
+	for (;;) {
+		if ((old >> 32) == gen)
+			new = old + 1;
+		else
+			new = ((uint64_t) gen << 32) + 1;
+
+		if (__atomic_compare_exchange_n(&prng_threads, &old, new,
+					false, __ATOMIC_RELAXED,
+					__ATOMIC_RELAXED))
+			return (new - 1) & 0xFFFFFFFF;
+	}
+}
+
+unsigned long prng_next(void)
+{
+	unsigned int gen;
+	uint64_t x;
+
+	x = fiu_get_prng_seed(&gen);
+	if (gen != prng_gen) {
+		/* Start each thread at an unrelated point of the sequence,
+		 * instead of just a few steps apart. */
+		x ^= prng_thread_number(gen);
+		prng_state = splitmix64(&x);
+		prng_gen = gen;
+	}
+
+	return splitmix64(&prng_state) >> 1;
+}
+
+/*
+ * Resolving the original functions
+ *
+ * They are resolved lazily, by the first call to each wrapper (see
+ * mkwrap_init()). With LD_BIND_NOW, like the dynamic linker does, they are
+ * all resolved at startup instead, in a single pass over the table of init
+ * functions, so that nothing is looked up later on (in a signal handler, for
+ * example).
+ */
+
+#ifdef FIU_BIND_TABLE
+/* Built by the linker from the "fiu_syms" sections; weak in case there are
+ * none. */
+extern void (*__start_fiu_syms[])(void)
+	__attribute__((weak, visibility("hidden")));
+extern void (*__stop_fiu_syms[])(void)
+	__attribute__((weak, visibility("hidden")));
+
+static void constructor_attr(201) _fiu_bind_now(void)
+{
+	void (**init)(void);
+	const char *bind_now = getenv("LD_BIND_NOW");
+
+	if (bind_now == NULL || *bind_now == '\0' || __start_fiu_syms == NULL)
+		return;
+
+	for (init = __start_fiu_syms; init < __stop_fiu_syms; init++)
+		(*init)();
+}
+#endif
+
 /* this runs after all function-specific constructors */
 static void constructor_attr(250) _fiu_init_final(void)
 {
-	struct timeval tv;
-
 	rec_inc();
 
 	fiu_init(0);
 
-	/* since we use random() in the wrappers, we need to seed it */
-	gettimeofday(&tv, NULL);
-	srandom(tv.tv_usec);
-
 	rec_dec();
 }
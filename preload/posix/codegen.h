@@ -4,7 +4,11 @@
 
 #include "build-env.h"
 #include <fiu.h>		/* fiu_* */
-#include <stdlib.h>		/* NULL, random() */
+#include <fiu-control.h>	/* fiu_watch() */
+#include <stdbool.h>		/* bool */
+#include <stdint.h>		/* uint64_t */
+#include <stdlib.h>		/* NULL */
+#include <sys/uio.h>		/* struct iovec */
 
 /* Recursion counter, per-thread */
 extern int __thread _fiu_called;
@@ -12,9 +16,44 @@ extern int __thread _fiu_called;
 /* Get a symbol from libc */
 void *libc_symbol(const char *symbol);
 
+/* Get a pseudorandom number, from a per-thread generator */
+unsigned long prng_next(void);
+
 /* Record internally an error for a stream */
 void set_ferror(void * stream);
 
+/* Paths of the file descriptors, see codegen.c. fd_path() returns NULL if
+ * the path is not known; fd_path_set() with a NULL path forgets it. */
+const char *fd_path(int fd);
+void fd_path_set(int fd, const char *path);
+void fd_path_copy(int oldfd, int newfd);
+
+/* For close(): fd_path_take() removes the path from the table, and gives it
+ * to the caller, which must then give it back with fd_path_put(), telling
+ * whether the file descriptor is still open. */
+char *fd_path_take(int fd);
+void fd_path_put(int fd, char *path, bool still_open);
+
+/* Forgets about the io_uring instance behind the file descriptor, if any,
+ * when it's closed (see linux.aio.custom.c). */
+void uring_close(int fd);
+
+/* The memory the allocator got from the system, for the points of failure
+ * restricted to a minimum total (see fiu_set_size()). Only known with glibc,
+ * it returns 0 elsewhere. */
+size_t mem_total(void);
+
+/* a * b, or SIZE_MAX if it overflows; for the sizes of calloc() and
+ * friends. */
+size_t mul_size(size_t a, size_t b);
+
+/* For the vector I/O functions: copies the first entries of iov into copy,
+ * cutting them at a random byte, and returns how many it copied (0 if there
+ * is nothing to cut). copy must have room for REDUCE_IOV_MAX entries; the
+ * entries beyond that are always cut. */
+#define REDUCE_IOV_MAX 64
+size_t reduce_iov(const struct iovec *iov, size_t cnt, struct iovec *copy);
+
 /* Some compilers support constructor priorities. Since we don't rely on them,
  * but use them for clarity purposes, use a macro so libfiu builds on systems
  * where they're not supported.
@@ -73,39 +112,137 @@ void set_ferror(void * stream);
 #endif
 
 
+/*
+ * Watched points of failure
+ *
+ * Each module has a table with the names of its points of failure, and
+ * libfiu keeps a bit mask of which ones are covered by an enabled point of
+ * failure (see fiu_watch()). Wrappers check their bits first, and if none is
+ * set they call the original function right away instead of going through
+ * fiu_fail(), which is what happens most of the time.
+ *
+ * The position of a name in the table is its ID, which is known at compile
+ * time. When the bits are set, the wrappers check the points by ID (see
+ * fiu_watch_ids()), so libfiu doesn't need to look them up by name.
+ */
+
+/* Defines the module's mask and registers it with libfiu. Assumes
+ * _fiu_watch_names[] was properly defined. */
+#define mkwrap_watch()						\
+	static uint64_t _fiu_watch_mask[			\
+		(sizeof(_fiu_watch_names) / sizeof(char *) + 63) / 64]; \
+								\
+	static struct fiu_watch *_fiu_watch = NULL;		\
+								\
+	static void constructor_attr(202) _fiu_watch_init(void) \
+	{							\
+		rec_inc();					\
+		_fiu_watch = fiu_watch_ids(_fiu_watch_names,	\
+			sizeof(_fiu_watch_names) / sizeof(char *), \
+			_fiu_watch_mask);			\
+		rec_dec();					\
+	}
+
+/* Records the module's points of failure in the binary, like fiu_do_on()
+ * does (see fiu.h). Takes a string literal with all the names, each one
+ * ending with \0. */
+#ifdef _FIU_CATALOG_ATTR
+#define mkwrap_catalog(NAMES) \
+	static const char _fiu_catalog[] _FIU_CATALOG_ATTR = NAMES;
+#else
+#define mkwrap_catalog(NAMES)
+#endif
+
+/* Checks the point of failure with the given ID, like fiu_fail(). The path
+ * the wrapper operates on, if any, is in _fiu_path (see mkwrap_body_path()),
+ * for the points of failure restricted to paths (see fiu_set_path()); the
+ * size of the operation, if any, in _fiu_size (see mkwrap_body_size()), for
+ * the ones restricted to sizes (see fiu_set_size()); and its arguments in
+ * _fiu_args (see mkwrap_body_args()), for the ones restricted by a
+ * predicate (see fiu_set_predicate()). */
+#define mkwrap_fail(FIU_ID)						\
+	fiu_fail_id_op(_fiu_watch, FIU_ID, &(struct fiu_op) {		\
+		.path = _fiu_path, .size = _fiu_size,			\
+		.total = mem_total, .args = _fiu_args,			\
+		.nargs = _fiu_nargs })
+
+/* Checks if any of the given bits of the module's mask is set. */
+#define mkwrap_watched(WORD, BITS) \
+	(__atomic_load_n(&_fiu_watch_mask[WORD], __ATOMIC_RELAXED) & (BITS))
+
+
 /*
  * Wrapper generator macros
  */
 
-/* Generates the init part of the wrapped function */
+/* Generates the init part of the wrapped function.
+ *
+ * The pointer to the original function is shared by all threads: it is
+ * resolved by the first caller, and only read afterwards. If more than one
+ * thread resolves it at the same time, they all store the same value. It is
+ * always accessed atomically (see mkwrap_orig()), so that is not a data race.
+ *
+ * Most processes only call a few of the wrapped functions, so resolving them
+ * lazily saves looking up the rest at startup. When LD_BIND_NOW is set, they
+ * are all resolved in one pass by a single constructor instead (see
+ * codegen.c), which walks the table of init functions the linker builds from
+ * the "fiu_syms" entries below. Where that table can't be built, each one
+ * gets its own constructor, as before.
+ *
+ * The "in init" counter is per-thread instead, as it is what prevents a
+ * thread from recursing into the wrapper while resolving the symbol (dlsym()
+ * can call malloc(), for example). */
+#if defined __GNUC__ && defined __ELF__
+  #define FIU_BIND_TABLE 1
+  #define _fiu_init_attr
+  #define mkwrap_bind(NAME) \
+	static void (*_fiu_bind_##NAME)(void)			\
+		__attribute__((section("fiu_syms"), used)) =	\
+		_fiu_init_##NAME;
+#else
+  #define _fiu_init_attr constructor_attr(201)
+  #define mkwrap_bind(NAME)
+#endif
+
+/* Loads the pointer to the original function, NULL if not resolved yet. */
+#define mkwrap_orig(NAME) \
+	__atomic_load_n(&_fiu_orig_##NAME, __ATOMIC_ACQUIRE)
+
 #define mkwrap_init(RTYPE, NAME, PARAMS, PARAMST) \
-	static __thread RTYPE (*_fiu_orig_##NAME) PARAMS = NULL;		\
+	static RTYPE (*_fiu_orig_##NAME) PARAMS = NULL;		\
 								\
 	static __thread int _fiu_in_init_##NAME = 0;			\
 								\
-	static void constructor_attr(201) _fiu_init_##NAME(void) \
+	static void _fiu_init_attr _fiu_init_##NAME(void)	\
 	{							\
 		rec_inc();					\
 		_fiu_in_init_##NAME++;				\
 								\
-		_fiu_orig_##NAME = (RTYPE (*) PARAMST)		\
-				libc_symbol(#NAME);		\
+		__atomic_store_n(&_fiu_orig_##NAME,		\
+			(RTYPE (*) PARAMST) libc_symbol(#NAME),	\
+			__ATOMIC_RELEASE);			\
 								\
 		_fiu_in_init_##NAME--;				\
 		rec_dec();					\
-	}
+	}							\
+								\
+	mkwrap_bind(NAME)
 
 /* Generates the definition part of the wrapped function. */
 #define mkwrap_def(RTYPE, NAME, PARAMS) \
 	RTYPE NAME PARAMS					\
 	{ 							\
 		RTYPE r;					\
-		int fstatus;
+		int fstatus;					\
+		const char *_fiu_path = NULL;			\
+		size_t _fiu_size = 0;				\
+		const int64_t *_fiu_args = NULL;		\
+		unsigned int _fiu_nargs = 0;
 
 /* Generate the first part of the body, which checks the recursion status */
 #define mkwrap_body_called(NAME, PARAMSN, ON_ERR) \
 		if (_fiu_called) {				\
-			if (_fiu_orig_##NAME == NULL) {		\
+			if (mkwrap_orig(NAME) == NULL) {	\
 				if (_fiu_in_init_##NAME) {	\
 					printd("fail on init\n"); \
 					return ON_ERR;		\
@@ -115,7 +252,7 @@ void set_ferror(void * stream);
 				}				\
 			}					\
 			printd("orig\n");			\
-			return (*_fiu_orig_##NAME) PARAMSN;	\
+			return (*mkwrap_orig(NAME)) PARAMSN;	\
 		}						\
 								\
 		printd("fiu\n");				\
@@ -129,11 +266,67 @@ void set_ferror(void * stream);
 	mkwrap_def(RTYPE, NAME, PARAMS) \
 	mkwrap_body_called(NAME, PARAMSN, ON_ERR)
 
+/* Generates a body part that calls the original function and returns, if
+ * none of the given watched points of failure is enabled. Should come before
+ * the other body generators. */
+#define mkwrap_body_gate(NAME, PARAMSN, WORD, BITS)		\
+								\
+		if (!mkwrap_watched(WORD, BITS)) {		\
+			if (mkwrap_orig(NAME) == NULL)		\
+				_fiu_init_##NAME();		\
+								\
+			printd("not watched, calling orig\n");	\
+			r = (*mkwrap_orig(NAME)) PARAMSN;	\
+			goto exit;				\
+		}
+
+/* Generates a body part that sets the path the function operates on, given
+ * either directly or as fd_path(fd). Should come right after the gate. */
+#define mkwrap_body_path(PATH)					\
+								\
+		_fiu_path = (PATH);
+
+/* Generates a body part that sets the size of the operation. Should come
+ * right after the gate, too. */
+#define mkwrap_body_size(SIZE)					\
+								\
+		_fiu_size = (SIZE);
+
+/* Generates a body part that records the arguments of the function, each
+ * one converted to an int64_t (see mkwrap_fail()). Should come right after
+ * the gate, too, so they're only recorded when they may be needed. */
+#define mkwrap_body_args(...)					\
+								\
+		int64_t _fiu_args_v[] = { __VA_ARGS__ };	\
+		_fiu_args = _fiu_args_v;			\
+		_fiu_nargs = sizeof(_fiu_args_v) / sizeof(int64_t);
+
+/* Checks if the predicate of the point of failure with the given ID looks
+ * at the argument in the given position (see fiu_watch_nargs()). */
+#define mkwrap_arg_needed(FIU_ID, POS) \
+	(fiu_watch_nargs(_fiu_watch, FIU_ID) > (POS))
+
+/* Generates a body part that sets the argument in the given position, left
+ * as a placeholder in mkwrap_body_args(), to EXPR; but only if NEEDED (made
+ * of mkwrap_arg_needed()), otherwise the arguments stop before it. For the
+ * ones that read memory from the caller, so an invalid pointer makes the
+ * function fail with EFAULT as usual instead of crashing here, unless a
+ * predicate asks for it. */
+#define mkwrap_body_arg_lazy(POS, NEEDED, EXPR)			\
+								\
+		if (NEEDED)					\
+			_fiu_args_v[POS] = (EXPR);		\
+		else if (_fiu_nargs > (POS))			\
+			_fiu_nargs = (POS);
+
+/* The body generators below take the ID of the point of failure in the
+ * module's _fiu_watch_names[] (see mkwrap_fail()). */
+
 /* Generates the body of the function for normal, non-errno usage. The return
  * value is taken from failinfo. */
-#define mkwrap_body_failinfo(FIU_NAME, RTYPE)			\
+#define mkwrap_body_failinfo(FIU_ID, RTYPE)			\
 								\
-		fstatus = fiu_fail(FIU_NAME);			\
+		fstatus = mkwrap_fail(FIU_ID);			\
 		if (fstatus != 0) {				\
 			r = (RTYPE) fiu_failinfo();		\
 			printd("failing\n");			\
@@ -142,9 +335,9 @@ void set_ferror(void * stream);
 
 /* Generates the body of the function for normal, non-errno usage. The return
  * value is hardcoded. */
-#define mkwrap_body_hardcoded(FIU_NAME, FAIL_RET)		\
+#define mkwrap_body_hardcoded(FIU_ID, FAIL_RET)		\
 								\
-		fstatus = fiu_fail(FIU_NAME);			\
+		fstatus = mkwrap_fail(FIU_ID);			\
 		if (fstatus != 0) {				\
 			r = FAIL_RET;				\
 			printd("failing\n");			\
@@ -154,14 +347,14 @@ void set_ferror(void * stream);
 /* Generates the body of the function for functions that affect errno. The
  * return value is hardcoded. Assumes int valid_errnos[] exist was properly
  * defined. */
-#define mkwrap_body_errno(FIU_NAME, FAIL_RET) \
+#define mkwrap_body_errno(FIU_ID, FAIL_RET) \
 								\
-		fstatus = fiu_fail(FIU_NAME);			\
+		fstatus = mkwrap_fail(FIU_ID);			\
 		if (fstatus != 0) {				\
 			void *finfo = fiu_failinfo();		\
 			if (finfo == NULL) {			\
-				errno = valid_errnos[random() % \
-					sizeof(valid_errnos) / sizeof(int)]; \
+				errno = valid_errnos[prng_next() % \
+					(sizeof(valid_errnos) / sizeof(int))]; \
 			} else {				\
 				errno = (long) finfo;		\
 			}					\
@@ -171,14 +364,14 @@ void set_ferror(void * stream);
 		}
 
 /* As mkwrap_body_errno, but calls set_ferror for the given stream. */
-#define mkwrap_body_errno_ferror(FIU_NAME, FAIL_RET, STREAM) \
+#define mkwrap_body_errno_ferror(FIU_ID, FAIL_RET, STREAM) \
 								\
-		fstatus = fiu_fail(FIU_NAME);			\
+		fstatus = mkwrap_fail(FIU_ID);			\
 		if (fstatus != 0) {				\
 			void *finfo = fiu_failinfo();		\
 			if (finfo == NULL) {			\
-				errno = valid_errnos[random() % \
-					sizeof(valid_errnos) / sizeof(int)]; \
+				errno = valid_errnos[prng_next() % \
+					(sizeof(valid_errnos) / sizeof(int))]; \
 			} else {				\
 				errno = (long) finfo;		\
 			}					\
@@ -188,26 +381,78 @@ void set_ferror(void * stream);
 			goto exit;				\
 		}
 
+/* Generates a body part that makes the function return RET right away,
+ * setting errno to ERRNO (unless it's 0), when the given point of failure is
+ * enabled. It's for the results that are not errors, but that callers must
+ * be ready for and rarely see, like a wakeup without events, or EAGAIN on a
+ * socket that was reported as ready. */
+#define mkwrap_body_spurious(FIU_ID, RET, ERRNO)		\
+								\
+		fstatus = mkwrap_fail(FIU_ID);			\
+		if (fstatus != 0) {				\
+			if (ERRNO != 0)				\
+				errno = ERRNO;			\
+			r = RET;				\
+			printd("spurious\n");			\
+			goto exit;				\
+		}
+
 /* Generates a body part that will reduce the CNT parameter in a random
  * amount when the given point of failure is enabled. Can be combined with the
- * other body generators. */
-#define mkwrap_body_reduce(FIU_NAME, CNT)			\
+ * other body generators. A CNT of 0 is left alone, as there is nothing to
+ * reduce. */
+#define mkwrap_body_reduce(FIU_ID, CNT)			\
+								\
+		fstatus = mkwrap_fail(FIU_ID);			\
+		if (fstatus != 0 && CNT > 0) {			\
+			printd("reducing\n");			\
+			CNT -= prng_next() % CNT;		\
+		}
+
+/* Like mkwrap_body_reduce(), but for functions that take an array of CNT
+ * iovecs: the transfer is cut at a random byte, usually in the middle of one
+ * of the buffers, as the kernel does. The caller's array is left alone, and a
+ * truncated copy in the stack is used instead (see reduce_iov()). */
+#define mkwrap_body_reduce_iov(FIU_ID, IOV, CNT)		\
 								\
-		fstatus = fiu_fail(FIU_NAME);			\
+		struct iovec _fiu_iov[REDUCE_IOV_MAX];		\
+		fstatus = mkwrap_fail(FIU_ID);			\
 		if (fstatus != 0) {				\
+			size_t _fiu_cnt;			\
 			printd("reducing\n");			\
-			CNT -= random() % CNT;			\
+			_fiu_cnt = reduce_iov(IOV, CNT, _fiu_iov); \
+			if (_fiu_cnt > 0) {			\
+				IOV = _fiu_iov;			\
+				CNT = _fiu_cnt;			\
+			}					\
 		}
 
 #define mkwrap_bottom(NAME, PARAMSN)				\
 								\
-		if (_fiu_orig_##NAME == NULL)			\
+		if (mkwrap_orig(NAME) == NULL)			\
+			_fiu_init_##NAME();			\
+								\
+		printd("calling orig\n");			\
+		r = (*mkwrap_orig(NAME)) PARAMSN;		\
+								\
+	exit:							\
+		rec_dec();					\
+		return r;					\
+	}
+
+/* Like mkwrap_bottom(), but runs the given code before returning, whether
+ * the function failed or not. It can look at r, and is used to keep track of
+ * the file descriptors' paths. */
+#define mkwrap_bottom_after(NAME, PARAMSN, ...)		\
+								\
+		if (mkwrap_orig(NAME) == NULL)			\
 			_fiu_init_##NAME();			\
 								\
 		printd("calling orig\n");			\
-		r = (*_fiu_orig_##NAME) PARAMSN;		\
+		r = (*mkwrap_orig(NAME)) PARAMSN;		\
 								\
 	exit:							\
+		__VA_ARGS__					\
 		rec_dec();					\
 		return r;					\
 	}
@@ -1,21 +1,57 @@
 
 include: <errno.h>
 include: <stdlib.h>
+include: <stdint.h>
 
 fiu name base: libc/mm/
 
+# All of them pass the size they allocate, so their points of failure can be
+# restricted to big allocations (see fiu_set_size()).
 
 void *malloc(size_t size);
 	on error: NULL
 	valid errnos: ENOMEM
+	size: size
 
 void *calloc(size_t nmemb, size_t size);
 	on error: NULL
 	valid errnos: ENOMEM
+	size: mul_size(nmemb, size)
 
 void *realloc(void *ptr, size_t size);
 	on error: NULL
 	valid errnos: ENOMEM
+	size: size
+
+# posix_memalign() returns the error instead of setting errno.
+int posix_memalign(void **memptr, size_t alignment, size_t size);
+	on error: ENOMEM
+	size: size
+
+# Not declared with our _XOPEN_SOURCE, but C11 has it.
+void *aligned_alloc(size_t alignment, size_t size);
+	on error: NULL
+	valid errnos: ENOMEM
+	size: size
+
+# Not declared either, and removed from POSIX, but still around.
+void *valloc(size_t size);
+	on error: NULL
+	valid errnos: ENOMEM
+	size: size
+
+# Obsolete and GNU extension, respectively; also not declared.
+v: #ifdef __GLIBC__
+void *memalign(size_t alignment, size_t size);
+	on error: NULL
+	valid errnos: ENOMEM
+	size: size
+
+void *reallocarray(void *ptr, size_t nmemb, size_t size);
+	on error: NULL
+	valid errnos: ENOMEM
+	size: mul_size(nmemb, size)
+v: #endif
 
 # Note we don't wrap free() as it does not return anything.
 
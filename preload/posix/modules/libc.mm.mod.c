@@ -0,0 +1,165 @@
+
+/*
+ * AUTOGENERATED FILE - DO NOT EDIT
+ *
+ * This file was automatically generated by libfiu, do not edit it directly,
+ * but see libfiu's "preload" directory.
+ */
+
+#include "codegen.h"
+
+static const char *const _fiu_watch_names[] = {
+	/*  0 */ "libc/mm/malloc",
+	/*  1 */ "libc/mm/calloc",
+	/*  2 */ "libc/mm/realloc",
+	/*  3 */ "libc/mm/posix_memalign",
+	/*  4 */ "libc/mm/aligned_alloc",
+	/*  5 */ "libc/mm/valloc",
+	/*  6 */ "libc/mm/memalign",
+	/*  7 */ "libc/mm/reallocarray",
+};
+mkwrap_watch()
+
+mkwrap_catalog(
+	"libc/mm/malloc\0"
+	"libc/mm/calloc\0"
+	"libc/mm/realloc\0"
+	"libc/mm/posix_memalign\0"
+	"libc/mm/aligned_alloc\0"
+	"libc/mm/valloc\0"
+	"libc/mm/memalign\0"
+	"libc/mm/reallocarray\0"
+)
+
+
+#include <errno.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+
+// All of them pass the size they allocate, so their points of failure can be 
+// restricted to big allocations (see fiu_set_size()). 
+
+
+/* Wrapper for malloc() */
+mkwrap_top(void *, malloc, (size_t size), (size), (size_t ), (NULL))
+mkwrap_body_gate(malloc, (size), 0, 0x1ULL)
+mkwrap_body_size(size)
+mkwrap_body_args(size)
+	static const int valid_errnos[] = {
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	};
+mkwrap_body_errno(0 /* libc/mm/malloc */, NULL)
+mkwrap_bottom(malloc, (size))
+
+
+
+/* Wrapper for calloc() */
+mkwrap_top(void *, calloc, (size_t nmemb, size_t size), (nmemb, size), (size_t , size_t ), (NULL))
+mkwrap_body_gate(calloc, (nmemb, size), 0, 0x2ULL)
+mkwrap_body_size(mul_size(nmemb, size))
+mkwrap_body_args(nmemb, size)
+	static const int valid_errnos[] = {
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	};
+mkwrap_body_errno(1 /* libc/mm/calloc */, NULL)
+mkwrap_bottom(calloc, (nmemb, size))
+
+
+
+// posix_memalign() returns the error instead of setting errno. 
+/* Wrapper for realloc() */
+mkwrap_top(void *, realloc, (void *ptr, size_t size), (ptr, size), (void *, size_t ), (NULL))
+mkwrap_body_gate(realloc, (ptr, size), 0, 0x4ULL)
+mkwrap_body_size(size)
+mkwrap_body_args((intptr_t) ptr, size)
+	static const int valid_errnos[] = {
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	};
+mkwrap_body_errno(2 /* libc/mm/realloc */, NULL)
+mkwrap_bottom(realloc, (ptr, size))
+
+
+
+// Not declared with our _XOPEN_SOURCE, but C11 has it. 
+/* Wrapper for posix_memalign() */
+mkwrap_top(int , posix_memalign, (void **memptr, size_t alignment, size_t size), (memptr, alignment, size), (void **, size_t , size_t ), (ENOMEM))
+mkwrap_body_gate(posix_memalign, (memptr, alignment, size), 0, 0x8ULL)
+mkwrap_body_size(size)
+mkwrap_body_args((intptr_t) memptr, alignment, size)
+mkwrap_body_hardcoded(3 /* libc/mm/posix_memalign */, ENOMEM)
+mkwrap_bottom(posix_memalign, (memptr, alignment, size))
+
+
+
+// Not declared either, and removed from POSIX, but still around. 
+/* Wrapper for aligned_alloc() */
+mkwrap_top(void *, aligned_alloc, (size_t alignment, size_t size), (alignment, size), (size_t , size_t ), (NULL))
+mkwrap_body_gate(aligned_alloc, (alignment, size), 0, 0x10ULL)
+mkwrap_body_size(size)
+mkwrap_body_args(alignment, size)
+	static const int valid_errnos[] = {
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	};
+mkwrap_body_errno(4 /* libc/mm/aligned_alloc */, NULL)
+mkwrap_bottom(aligned_alloc, (alignment, size))
+
+
+
+// Obsolete and GNU extension, respectively; also not declared. 
+/* Wrapper for valloc() */
+mkwrap_top(void *, valloc, (size_t size), (size), (size_t ), (NULL))
+mkwrap_body_gate(valloc, (size), 0, 0x20ULL)
+mkwrap_body_size(size)
+mkwrap_body_args(size)
+	static const int valid_errnos[] = {
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	};
+mkwrap_body_errno(5 /* libc/mm/valloc */, NULL)
+mkwrap_bottom(valloc, (size))
+
+
+#ifdef __GLIBC__
+
+/* Wrapper for memalign() */
+mkwrap_top(void *, memalign, (size_t alignment, size_t size), (alignment, size), (size_t , size_t ), (NULL))
+mkwrap_body_gate(memalign, (alignment, size), 0, 0x40ULL)
+mkwrap_body_size(size)
+mkwrap_body_args(alignment, size)
+	static const int valid_errnos[] = {
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	};
+mkwrap_body_errno(6 /* libc/mm/memalign */, NULL)
+mkwrap_bottom(memalign, (alignment, size))
+
+
+/* Wrapper for reallocarray() */
+mkwrap_top(void *, reallocarray, (void *ptr, size_t nmemb, size_t size), (ptr, nmemb, size), (void *, size_t , size_t ), (NULL))
+mkwrap_body_gate(reallocarray, (ptr, nmemb, size), 0, 0x80ULL)
+mkwrap_body_size(mul_size(nmemb, size))
+mkwrap_body_args((intptr_t) ptr, nmemb, size)
+	static const int valid_errnos[] = {
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	};
+mkwrap_body_errno(7 /* libc/mm/reallocarray */, NULL)
+mkwrap_bottom(reallocarray, (ptr, nmemb, size))
+
+
+#endif
+
+// Note we don't wrap free() as it does not return anything. 
+
@@ -0,0 +1,62 @@
+
+/*
+ * AUTOGENERATED FILE - DO NOT EDIT
+ *
+ * This file was automatically generated by libfiu, do not edit it directly,
+ * but see libfiu's "preload" directory.
+ */
+
+#include "codegen.h"
+
+static const char *const _fiu_watch_names[] = {
+	/*  0 */ "libc/str/strdup",
+	/*  1 */ "libc/str/strndup",
+};
+mkwrap_watch()
+
+mkwrap_catalog(
+	"libc/str/strdup\0"
+	"libc/str/strndup\0"
+)
+
+
+#include <string.h>
+#include <errno.h>
+#include <stdlib.h>
+
+
+// glibc, when _GNU_SOURCE is defined, can have macros for strdup/strndup, so 
+// we need to avoid those. 
+
+#ifndef strdup
+/* Wrapper for strdup() */
+mkwrap_top(char *, strdup, (const char *s), (s), (const char *), (NULL))
+mkwrap_body_gate(strdup, (s), 0, 0x1ULL)
+mkwrap_body_args((intptr_t) s)
+	static const int valid_errnos[] = {
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	};
+mkwrap_body_errno(0 /* libc/str/strdup */, NULL)
+mkwrap_bottom(strdup, (s))
+
+
+#endif
+
+#ifndef strndup
+/* Wrapper for strndup() */
+mkwrap_top(char *, strndup, (const char *s, size_t n), (s, n), (const char *, size_t ), (NULL))
+mkwrap_body_gate(strndup, (s, n), 0, 0x2ULL)
+mkwrap_body_args((intptr_t) s, n)
+	static const int valid_errnos[] = {
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	};
+mkwrap_body_errno(1 /* libc/str/strndup */, NULL)
+mkwrap_bottom(strndup, (s, n))
+
+
+#endif
+
@@ -0,0 +1,710 @@
+
+/*
+ * Custom wrappers for io_uring and Linux native AIO.
+ *
+ * Neither have libc wrappers: programs use liburing and libaio, or call
+ * syscall() directly. We wrap the functions those libraries export
+ * (io_uring_setup(), io_uring_enter(), io_uring_enter2(), io_submit() and
+ * io_getevents()), and syscall() for the same system calls, and make the
+ * system calls ourselves. Recent liburing versions make the system calls
+ * inline when submitting, without going through any of them, so programs
+ * using that can't be intercepted this way.
+ *
+ * Besides making the calls themselves fail, we inject errors and short
+ * transfers in the individual operations, with one point of failure per
+ * opcode:
+ *
+ *  - For io_uring, when an operation is submitted, its SQE is rewritten in
+ *    place: short transfers just reduce its length, and errors turn it into
+ *    a NOP (so, as with the other wrappers, the operation doesn't happen).
+ *    NOPs complete within io_uring_enter(), so before returning we look for
+ *    their CQEs and set the error as their result.
+ *    To do that we map the rings ourselves when they're created. Rings with
+ *    a kernel submission thread (IORING_SETUP_SQPOLL), polled I/O, or memory
+ *    allocated by the program are not supported, as their submissions don't
+ *    go through io_uring_enter() or we can't see them.
+ *
+ *  - For AIO, the results are rewritten in the events io_getevents()
+ *    returns; the opcode is taken from the iocb each one points to.
+ *
+ * When none of the points is enabled, the wrappers make the system call
+ * right away, without looking at the rings.
+ */
+
+#define _GNU_SOURCE
+
+#include "codegen.h"
+
+#ifdef __linux__
+#include <linux/version.h>
+#endif
+
+#if defined __linux__ && LINUX_VERSION_CODE >= KERNEL_VERSION(5, 6, 0)
+
+#include <errno.h>
+#include <linux/aio_abi.h>
+#include <linux/io_uring.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <time.h>
+
+/* Newer flags we need to know about, if the headers are older. */
+#ifndef IORING_SETUP_NO_MMAP
+#define IORING_SETUP_NO_MMAP (1U << 14)
+#endif
+#ifndef IORING_SETUP_NO_SQARRAY
+#define IORING_SETUP_NO_SQARRAY (1U << 16)
+#endif
+#ifndef IOSQE_BUFFER_SELECT
+#define IOSQE_BUFFER_SELECT (1U << 5)
+#endif
+#ifndef IOSQE_CQE_SKIP_SUCCESS
+#define IOSQE_CQE_SKIP_SUCCESS (1U << 6)
+#endif
+#ifndef IORING_ENTER_REGISTERED_RING
+#define IORING_ENTER_REGISTERED_RING (1U << 4)
+#endif
+
+/* Rings with flags beyond these (or with any of the unsupported ones) are
+ * not tracked, as they may change the layout of the rings. */
+#define URING_KNOWN_FLAGS ((IORING_SETUP_NO_SQARRAY << 1) - 1)
+#define URING_UNSUPPORTED_FLAGS \
+	(IORING_SETUP_SQPOLL | IORING_SETUP_IOPOLL | IORING_SETUP_NO_MMAP)
+
+
+/* Points of failure, see mkwrap_watch(). */
+static const char *const _fiu_watch_names[] = {
+	/*  0 */ "linux/uring/setup",
+	/*  1 */ "linux/uring/enter",
+	/*  2 */ "linux/uring/readv",
+	/*  3 */ "linux/uring/readv/reduce",
+	/*  4 */ "linux/uring/writev",
+	/*  5 */ "linux/uring/writev/reduce",
+	/*  6 */ "linux/uring/fsync",
+	/*  7 */ "linux/uring/read_fixed",
+	/*  8 */ "linux/uring/read_fixed/reduce",
+	/*  9 */ "linux/uring/write_fixed",
+	/* 10 */ "linux/uring/write_fixed/reduce",
+	/* 11 */ "linux/uring/sendmsg",
+	/* 12 */ "linux/uring/recvmsg",
+	/* 13 */ "linux/uring/accept",
+	/* 14 */ "linux/uring/connect",
+	/* 15 */ "linux/uring/fallocate",
+	/* 16 */ "linux/uring/openat",
+	/* 17 */ "linux/uring/close",
+	/* 18 */ "linux/uring/statx",
+	/* 19 */ "linux/uring/read",
+	/* 20 */ "linux/uring/read/reduce",
+	/* 21 */ "linux/uring/write",
+	/* 22 */ "linux/uring/write/reduce",
+	/* 23 */ "linux/uring/send",
+	/* 24 */ "linux/uring/send/reduce",
+	/* 25 */ "linux/uring/recv",
+	/* 26 */ "linux/uring/recv/reduce",
+	/* 27 */ "linux/aio/submit",
+	/* 28 */ "linux/aio/getevents",
+	/* 29 */ "linux/aio/pread",
+	/* 30 */ "linux/aio/pread/reduce",
+	/* 31 */ "linux/aio/pwrite",
+	/* 32 */ "linux/aio/pwrite/reduce",
+	/* 33 */ "linux/aio/fsync",
+	/* 34 */ "linux/aio/fdsync",
+	/* 35 */ "linux/aio/preadv",
+	/* 36 */ "linux/aio/preadv/reduce",
+	/* 37 */ "linux/aio/pwritev",
+	/* 38 */ "linux/aio/pwritev/reduce",
+};
+mkwrap_watch()
+
+/* The same names, for the catalog. */
+mkwrap_catalog(
+	"linux/uring/setup\0"
+	"linux/uring/enter\0"
+	"linux/uring/readv\0"
+	"linux/uring/readv/reduce\0"
+	"linux/uring/writev\0"
+	"linux/uring/writev/reduce\0"
+	"linux/uring/fsync\0"
+	"linux/uring/read_fixed\0"
+	"linux/uring/read_fixed/reduce\0"
+	"linux/uring/write_fixed\0"
+	"linux/uring/write_fixed/reduce\0"
+	"linux/uring/sendmsg\0"
+	"linux/uring/recvmsg\0"
+	"linux/uring/accept\0"
+	"linux/uring/connect\0"
+	"linux/uring/fallocate\0"
+	"linux/uring/openat\0"
+	"linux/uring/close\0"
+	"linux/uring/statx\0"
+	"linux/uring/read\0"
+	"linux/uring/read/reduce\0"
+	"linux/uring/write\0"
+	"linux/uring/write/reduce\0"
+	"linux/uring/send\0"
+	"linux/uring/send/reduce\0"
+	"linux/uring/recv\0"
+	"linux/uring/recv/reduce\0"
+	"linux/aio/submit\0"
+	"linux/aio/getevents\0"
+	"linux/aio/pread\0"
+	"linux/aio/pread/reduce\0"
+	"linux/aio/pwrite\0"
+	"linux/aio/pwrite/reduce\0"
+	"linux/aio/fsync\0"
+	"linux/aio/fdsync\0"
+	"linux/aio/preadv\0"
+	"linux/aio/preadv/reduce\0"
+	"linux/aio/pwritev\0"
+	"linux/aio/pwritev/reduce\0"
+)
+
+/* Bits of io_uring_enter() and of the io_uring operations, and of the AIO
+ * ones. */
+#define URING_BITS (((1ULL << 27) - 1) & ~0x1ULL)
+#define AIO_BITS (((1ULL << 39) - 1) & ~((1ULL << 27) - 1))
+
+/* None of these operate on a path we know of, nor have a size or arguments
+ * (see mkwrap_fail()). */
+static const char *const _fiu_path = NULL;
+static const size_t _fiu_size = 0;
+static const int64_t *const _fiu_args = NULL;
+static const unsigned int _fiu_nargs = 0;
+
+#define NELEMS(a) (sizeof(a) / sizeof((a)[0]))
+
+static const int setup_errnos[] = { EMFILE, ENFILE, ENOMEM };
+static const int enter_errnos[] = { EAGAIN, EBUSY, EINTR };
+static const int submit_errnos[] = { EAGAIN };
+static const int getevents_errnos[] = { EINTR };
+
+static const int read_errnos[] = { EIO, EINTR, EAGAIN };
+static const int write_errnos[] = { EIO, EINTR, EAGAIN, ENOSPC, EDQUOT };
+static const int sync_errnos[] = { EIO, ENOSPC, EDQUOT };
+static const int net_errnos[] = { ECONNRESET, EPIPE, ETIMEDOUT, ENOBUFS, EINTR };
+static const int accept_errnos[] = { ECONNABORTED, EMFILE, ENFILE, ENOBUFS };
+static const int connect_errnos[] = { ECONNREFUSED, ENETUNREACH, ETIMEDOUT };
+static const int open_errnos[] = { EACCES, EMFILE, ENFILE, ENOENT, ENOSPC };
+static const int close_errnos[] = { EIO, EINTR };
+static const int statx_errnos[] = { EACCES, ENOENT, ENOMEM };
+
+/* What to do for each opcode: the ID of the point of failure (0 if there is
+ * none), the one of its /reduce point (0 if there is none), and the errnos
+ * to pick from. */
+struct aio_op {
+	unsigned int id;
+	unsigned int reduce_id;
+	const int *errnos;
+	unsigned int nerrnos;
+};
+
+#define OP(ID, REDUCE_ID, ERRNOS) { ID, REDUCE_ID, ERRNOS, NELEMS(ERRNOS) }
+
+static const struct aio_op uring_ops[] = {
+	[IORING_OP_READV] = OP(2, 3, read_errnos),
+	[IORING_OP_WRITEV] = OP(4, 5, write_errnos),
+	[IORING_OP_FSYNC] = OP(6, 0, sync_errnos),
+	[IORING_OP_READ_FIXED] = OP(7, 8, read_errnos),
+	[IORING_OP_WRITE_FIXED] = OP(9, 10, write_errnos),
+	[IORING_OP_SENDMSG] = OP(11, 0, net_errnos),
+	[IORING_OP_RECVMSG] = OP(12, 0, net_errnos),
+	[IORING_OP_ACCEPT] = OP(13, 0, accept_errnos),
+	[IORING_OP_CONNECT] = OP(14, 0, connect_errnos),
+	[IORING_OP_FALLOCATE] = OP(15, 0, sync_errnos),
+	[IORING_OP_OPENAT] = OP(16, 0, open_errnos),
+	[IORING_OP_CLOSE] = OP(17, 0, close_errnos),
+	[IORING_OP_STATX] = OP(18, 0, statx_errnos),
+	[IORING_OP_READ] = OP(19, 20, read_errnos),
+	[IORING_OP_WRITE] = OP(21, 22, write_errnos),
+	[IORING_OP_SEND] = OP(23, 24, net_errnos),
+	[IORING_OP_RECV] = OP(25, 26, net_errnos),
+};
+
+static const struct aio_op aio_ops[] = {
+	[IOCB_CMD_PREAD] = OP(29, 30, read_errnos),
+	[IOCB_CMD_PWRITE] = OP(31, 32, write_errnos),
+	[IOCB_CMD_FSYNC] = OP(33, 0, sync_errnos),
+	[IOCB_CMD_FDSYNC] = OP(34, 0, sync_errnos),
+	[IOCB_CMD_PREADV] = OP(35, 36, read_errnos),
+	[IOCB_CMD_PWRITEV] = OP(37, 38, write_errnos),
+};
+
+/* Picks the errno for a point that has just failed, like
+ * mkwrap_body_errno(). */
+static int pick_errno(const int *errnos, unsigned int n)
+{
+	void *finfo = fiu_failinfo();
+
+	if (finfo != NULL)
+		return (long) finfo;
+	return errnos[prng_next() % n];
+}
+
+
+/* The original syscall(), which we use to make all the system calls. */
+mkwrap_init(long, syscall, (long number, ...), (long, ...))
+
+/* Makes a system call; returns -errno on errors, like the kernel (and
+ * liburing and libaio) do. */
+static long sys(long n, long a, long b, long c, long d, long e, long f)
+{
+	long r;
+
+	if (mkwrap_orig(syscall) == NULL)
+		_fiu_init_syscall();
+
+	r = (*mkwrap_orig(syscall))(n, a, b, c, d, e, f);
+	return r == -1 ? -errno : r;
+}
+
+
+/*
+ * io_uring
+ */
+
+/* Our view of a ring, see uring_track(). */
+struct uring {
+	unsigned int flags;
+	unsigned int sq_entries;
+
+	void *sq_ring, *cq_ring, *sqes;
+	size_t sq_ring_size, cq_ring_size, sqes_size;
+
+	unsigned int *sq_head, *sq_tail, *sq_mask, *sq_array;
+	unsigned int *cq_head, *cq_tail, *cq_mask;
+	char *cqes;
+	size_t sqe_size, cqe_size;
+};
+
+/* Rings by file descriptor; rings with larger file descriptors are not
+ * tracked. */
+#define URING_MAX_FD 4096
+static struct uring *urings[URING_MAX_FD];
+
+static void uring_free(struct uring *u)
+{
+	if (u->sqes != NULL && u->sqes != MAP_FAILED)
+		munmap(u->sqes, u->sqes_size);
+	if (u->cq_ring != NULL && u->cq_ring != MAP_FAILED &&
+			u->cq_ring != u->sq_ring)
+		munmap(u->cq_ring, u->cq_ring_size);
+	if (u->sq_ring != NULL && u->sq_ring != MAP_FAILED)
+		munmap(u->sq_ring, u->sq_ring_size);
+	free(u);
+}
+
+/* Maps the rings of a new io_uring instance, the same way liburing does. */
+static void uring_track(int fd, struct io_uring_params *p)
+{
+	struct uring *u;
+	char *sq, *cq;
+
+	if (fd < 0 || fd >= URING_MAX_FD)
+		return;
+	if (p->flags & (URING_UNSUPPORTED_FLAGS | ~URING_KNOWN_FLAGS))
+		return;
+	if (!(p->features & IORING_FEAT_SINGLE_MMAP))
+		return;
+
+	u = calloc(1, sizeof(struct uring));
+	if (u == NULL)
+		return;
+
+	u->flags = p->flags;
+	u->sq_entries = p->sq_entries;
+	u->sqe_size = sizeof(struct io_uring_sqe);
+	u->cqe_size = sizeof(struct io_uring_cqe);
+#ifdef IORING_SETUP_SQE128
+	if (p->flags & IORING_SETUP_SQE128)
+		u->sqe_size *= 2;
+	if (p->flags & IORING_SETUP_CQE32)
+		u->cqe_size *= 2;
+#endif
+
+	u->sq_ring_size = p->sq_off.array + p->sq_entries * sizeof(unsigned);
+	u->cq_ring_size = p->cq_off.cqes + p->cq_entries * u->cqe_size;
+	if (u->cq_ring_size > u->sq_ring_size)
+		u->sq_ring_size = u->cq_ring_size;
+	u->cq_ring_size = u->sq_ring_size;
+
+	u->sq_ring = mmap(NULL, u->sq_ring_size, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+	if (u->sq_ring == MAP_FAILED)
+		goto error;
+	u->cq_ring = u->sq_ring;
+
+	u->sqes_size = p->sq_entries * u->sqe_size;
+	u->sqes = mmap(NULL, u->sqes_size, PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+	if (u->sqes == MAP_FAILED)
+		goto error;
+
+	sq = u->sq_ring;
+	cq = u->cq_ring;
+	u->sq_head = (unsigned int *) (sq + p->sq_off.head);
+	u->sq_tail = (unsigned int *) (sq + p->sq_off.tail);
+	u->sq_mask = (unsigned int *) (sq + p->sq_off.ring_mask);
+	u->sq_array = (unsigned int *) (sq + p->sq_off.array);
+	u->cq_head = (unsigned int *) (cq + p->cq_off.head);
+	u->cq_tail = (unsigned int *) (cq + p->cq_off.tail);
+	u->cq_mask = (unsigned int *) (cq + p->cq_off.ring_mask);
+	u->cqes = cq + p->cq_off.cqes;
+
+	u = __atomic_exchange_n(&urings[fd], u, __ATOMIC_ACQ_REL);
+	if (u != NULL)
+		uring_free(u);
+	return;
+
+error:
+	uring_free(u);
+}
+
+void uring_close(int fd)
+{
+	struct uring *u;
+
+	if (fd < 0 || fd >= URING_MAX_FD)
+		return;
+	if (__atomic_load_n(&urings[fd], __ATOMIC_RELAXED) == NULL)
+		return;
+
+	u = __atomic_exchange_n(&urings[fd], NULL, __ATOMIC_ACQ_REL);
+	if (u != NULL)
+		uring_free(u);
+}
+
+/* Errors injected in a single io_uring_enter() call, see uring_enter(). If
+ * there are more, the rest of the operations are left alone. */
+#define URING_MAX_ERRORS 64
+
+struct uring_error {
+	__u64 user_data;
+	__s32 res;
+};
+
+/* Looks at the SQEs about to be submitted, reducing their lengths or turning
+ * them into NOPs as the points of failure say. Returns the number of errors
+ * injected, which are stored in errors. */
+static unsigned int uring_inject(struct uring *u, unsigned int to_submit,
+		struct uring_error *errors)
+{
+	unsigned int head, tail, mask, i, idx, nerrors = 0;
+	const struct aio_op *op;
+	struct io_uring_sqe *sqe;
+
+	head = __atomic_load_n(u->sq_head, __ATOMIC_ACQUIRE);
+	tail = __atomic_load_n(u->sq_tail, __ATOMIC_ACQUIRE);
+	mask = *u->sq_mask;
+	if (tail - head < to_submit)
+		to_submit = tail - head;
+
+	for (i = head; i != head + to_submit; i++) {
+		if (u->flags & IORING_SETUP_NO_SQARRAY)
+			idx = i & mask;
+		else
+			idx = u->sq_array[i & mask];
+		if (idx >= u->sq_entries)
+			continue;
+
+		sqe = (struct io_uring_sqe *) ((char *) u->sqes +
+				idx * u->sqe_size);
+		if (sqe->opcode >= NELEMS(uring_ops))
+			continue;
+		op = &uring_ops[sqe->opcode];
+		if (op->id == 0)
+			continue;
+
+		if (nerrors < URING_MAX_ERRORS && mkwrap_fail(op->id)) {
+			errors[nerrors].user_data = sqe->user_data;
+			errors[nerrors].res =
+				-pick_errno(op->errnos, op->nerrnos);
+			nerrors++;
+
+			/* Keep the flags that affect other requests (like
+			 * links), but drop the ones NOPs don't take, or that
+			 * would delay or hide their completion. */
+			sqe->opcode = IORING_OP_NOP;
+			sqe->flags &= ~(IOSQE_ASYNC | IOSQE_BUFFER_SELECT |
+					IOSQE_CQE_SKIP_SUCCESS);
+			sqe->rw_flags = 0;
+			continue;
+		}
+
+		if (op->reduce_id && sqe->len > 0 &&
+				mkwrap_fail(op->reduce_id)) {
+			sqe->len -= prng_next() % sqe->len;
+		}
+	}
+
+	return nerrors;
+}
+
+/* Sets the results of the CQEs for the errors we injected, which were posted
+ * after the CQ tail was at from. This assumes that, as usual, completions are
+ * only reaped by the thread that submits them, or after io_uring_enter()
+ * returns; another thread reaping them at the same time could see the NOP's
+ * result before we fix it (see doc/posix.rst). */
+static void uring_fix_cqes(struct uring *u, unsigned int from,
+		struct uring_error *errors, unsigned int nerrors)
+{
+	unsigned int head, tail, mask, i, j;
+	struct io_uring_cqe *cqe;
+
+	head = __atomic_load_n(u->cq_head, __ATOMIC_ACQUIRE);
+	tail = __atomic_load_n(u->cq_tail, __ATOMIC_ACQUIRE);
+	mask = *u->cq_mask;
+
+	/* Skip the ones that were already reaped. */
+	if ((int) (head - from) > 0)
+		from = head;
+
+	for (i = from; i != tail && nerrors > 0; i++) {
+		cqe = (struct io_uring_cqe *) (u->cqes +
+				(i & mask) * u->cqe_size);
+		for (j = 0; j < nerrors; j++) {
+			if (errors[j].user_data != cqe->user_data)
+				continue;
+
+			cqe->res = errors[j].res;
+			errors[j] = errors[--nerrors];
+			break;
+		}
+	}
+}
+
+static long uring_setup(unsigned int entries, struct io_uring_params *p)
+{
+	long r;
+
+	if (_fiu_called)
+		return sys(__NR_io_uring_setup, entries, (long) p, 0, 0, 0, 0);
+
+	rec_inc();
+
+	if (mkwrap_watched(0, 0x1ULL) &&
+			mkwrap_fail(0 /* linux/uring/setup */)) {
+		r = -pick_errno(setup_errnos, NELEMS(setup_errnos));
+		goto exit;
+	}
+
+	r = sys(__NR_io_uring_setup, entries, (long) p, 0, 0, 0, 0);
+	if (r >= 0)
+		uring_track(r, p);
+
+exit:
+	rec_dec();
+	return r;
+}
+
+static long uring_enter(unsigned int fd, unsigned int to_submit,
+		unsigned int min_complete, unsigned int flags, void *arg,
+		size_t argsz)
+{
+	struct uring_error errors[URING_MAX_ERRORS];
+	unsigned int nerrors = 0, cq_tail = 0;
+	struct uring *u = NULL;
+	long r;
+
+	if (_fiu_called || !mkwrap_watched(0, URING_BITS))
+		return sys(__NR_io_uring_enter, fd, to_submit, min_complete,
+				flags, (long) arg, argsz);
+
+	rec_inc();
+
+	if (mkwrap_fail(1 /* linux/uring/enter */)) {
+		r = -pick_errno(enter_errnos, NELEMS(enter_errnos));
+		goto exit;
+	}
+
+	/* With a registered ring, fd is not the ring's file descriptor. */
+	if (fd < URING_MAX_FD && !(flags & IORING_ENTER_REGISTERED_RING))
+		u = __atomic_load_n(&urings[fd], __ATOMIC_ACQUIRE);
+
+	if (u != NULL && to_submit > 0) {
+		cq_tail = __atomic_load_n(u->cq_tail, __ATOMIC_ACQUIRE);
+		nerrors = uring_inject(u, to_submit, errors);
+	}
+
+	r = sys(__NR_io_uring_enter, fd, to_submit, min_complete, flags,
+			(long) arg, argsz);
+
+	if (nerrors > 0)
+		uring_fix_cqes(u, cq_tail, errors, nerrors);
+
+exit:
+	rec_dec();
+	return r;
+}
+
+
+/*
+ * Linux native AIO
+ */
+
+static long aio_submit(aio_context_t ctx, long nr, struct iocb **iocbs)
+{
+	long r;
+
+	if (_fiu_called || !mkwrap_watched(0, AIO_BITS))
+		return sys(__NR_io_submit, ctx, nr, (long) iocbs, 0, 0, 0);
+
+	rec_inc();
+
+	if (mkwrap_fail(27 /* linux/aio/submit */))
+		r = -pick_errno(submit_errnos, NELEMS(submit_errnos));
+	else
+		r = sys(__NR_io_submit, ctx, nr, (long) iocbs, 0, 0, 0);
+
+	rec_dec();
+	return r;
+}
+
+static long aio_getevents(aio_context_t ctx, long min_nr, long nr,
+		struct io_event *events, struct timespec *timeout)
+{
+	const struct aio_op *op;
+	struct iocb *iocb;
+	long r, i;
+
+	if (_fiu_called || !mkwrap_watched(0, AIO_BITS))
+		return sys(__NR_io_getevents, ctx, min_nr, nr, (long) events,
+				(long) timeout, 0);
+
+	rec_inc();
+
+	if (mkwrap_fail(28 /* linux/aio/getevents */)) {
+		r = -pick_errno(getevents_errnos, NELEMS(getevents_errnos));
+		goto exit;
+	}
+
+	r = sys(__NR_io_getevents, ctx, min_nr, nr, (long) events,
+			(long) timeout, 0);
+
+	for (i = 0; i < r; i++) {
+		iocb = (struct iocb *) (uintptr_t) events[i].obj;
+		if (iocb == NULL || iocb->aio_lio_opcode >= NELEMS(aio_ops))
+			continue;
+		op = &aio_ops[iocb->aio_lio_opcode];
+		if (op->id == 0)
+			continue;
+
+		if (mkwrap_fail(op->id)) {
+			events[i].res = -pick_errno(op->errnos, op->nerrnos);
+		} else if (op->reduce_id && events[i].res > 0 &&
+				mkwrap_fail(op->reduce_id)) {
+			events[i].res -= prng_next() % events[i].res;
+		}
+	}
+
+exit:
+	rec_dec();
+	return r;
+}
+
+
+/*
+ * Entry points
+ */
+
+/* The ones liburing and libaio export. Like them, they return -errno on
+ * errors. */
+
+int io_uring_setup(unsigned int entries, struct io_uring_params *p)
+{
+	return uring_setup(entries, p);
+}
+
+int io_uring_enter(unsigned int fd, unsigned int to_submit,
+		unsigned int min_complete, unsigned int flags, sigset_t *sig)
+{
+	return uring_enter(fd, to_submit, min_complete, flags, sig, _NSIG / 8);
+}
+
+int io_uring_enter2(unsigned int fd, unsigned int to_submit,
+		unsigned int min_complete, unsigned int flags, sigset_t *sig,
+		size_t sz)
+{
+	return uring_enter(fd, to_submit, min_complete, flags, sig, sz);
+}
+
+int io_submit(aio_context_t ctx, long nr, struct iocb **iocbs)
+{
+	return aio_submit(ctx, nr, iocbs);
+}
+
+int io_getevents(aio_context_t ctx, long min_nr, long nr,
+		struct io_event *events, struct timespec *timeout)
+{
+	return aio_getevents(ctx, min_nr, nr, events, timeout);
+}
+
+/* syscall(), for the programs that make the system calls themselves. The
+ * other system calls are passed through, and so are these (except for the
+ * setup, so we can track the rings) while none of their points of failure
+ * are enabled. We always take 6 arguments, the most any system call has,
+ * like libc does. */
+long syscall(long number, ...)
+{
+	long a[6], r;
+	va_list l;
+	int i;
+
+	va_start(l, number);
+	for (i = 0; i < 6; i++)
+		a[i] = va_arg(l, long);
+	va_end(l);
+
+	if (mkwrap_orig(syscall) == NULL) {
+		if (_fiu_in_init_syscall) {
+			errno = ENOSYS;
+			return -1;
+		}
+		_fiu_init_syscall();
+	}
+
+	switch (number) {
+	case __NR_io_uring_setup:
+		r = uring_setup(a[0], (struct io_uring_params *) a[1]);
+		break;
+	case __NR_io_uring_enter:
+		if (!mkwrap_watched(0, URING_BITS))
+			goto orig;
+		r = uring_enter(a[0], a[1], a[2], a[3], (void *) a[4], a[5]);
+		break;
+	case __NR_io_submit:
+		if (!mkwrap_watched(0, AIO_BITS))
+			goto orig;
+		r = aio_submit(a[0], a[1], (struct iocb **) a[2]);
+		break;
+	case __NR_io_getevents:
+		if (!mkwrap_watched(0, AIO_BITS))
+			goto orig;
+		r = aio_getevents(a[0], a[1], a[2], (struct io_event *) a[3],
+				(struct timespec *) a[4]);
+		break;
+	default:
+		goto orig;
+	}
+
+	if (r < 0) {
+		errno = -r;
+		return -1;
+	}
+	return r;
+
+orig:
+	return (*mkwrap_orig(syscall))(number, a[0], a[1], a[2], a[3], a[4],
+			a[5]);
+}
+
+#else
+
+/* Without io_uring there is nothing to track. */
+void uring_close(int fd)
+{
+}
+
+#endif
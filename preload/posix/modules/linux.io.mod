@@ -14,3 +14,67 @@ int sync_file_range(int fd, off_t offset, off_t nbytes, \
 
 v: #endif
 
+# dup3() is linux-only; like dup(), it copies the path of the file descriptor.
+v: #ifdef __linux__
+
+int dup3(int oldfd, int newfd, int flags);
+	on error: -1
+	valid errnos: EBADF EBUSY EINTR EINVAL EMFILE
+	fd path: oldfd
+	after: if (r >= 0) fd_path_copy(oldfd, r);
+
+v: #endif
+
+
+# Event notification, used by event loops along with accept4() and the
+# receiving functions. epoll_wait() can return spuriously without events, and
+# accept4() with EAGAIN, as they do when another thread got there first.
+v: #ifdef __linux__
+
+include: <signal.h>
+include: <sys/epoll.h>
+include: <sys/eventfd.h>
+include: <sys/socket.h>
+
+fiu name base: linux/io/epoll/
+
+int epoll_create1(int flags);
+	on error: -1
+	valid errnos: EINVAL EMFILE ENFILE ENOMEM
+	after: if (r >= 0) fd_path_set(r, NULL);
+
+int epoll_ctl(int epfd, int op, int fd, struct epoll_event *event);
+	on error: -1
+	valid errnos: EBADF EEXIST EINVAL ELOOP ENOENT ENOMEM ENOSPC EPERM
+
+int epoll_wait(int epfd, struct epoll_event *events, int maxevents, \
+		int timeout);
+	on error: -1
+	valid errnos: EBADF EFAULT EINTR EINVAL
+	spurious: 0
+
+int epoll_pwait(int epfd, struct epoll_event *events, int maxevents, \
+		int timeout, const sigset_t *sigmask);
+	on error: -1
+	valid errnos: EBADF EFAULT EINTR EINVAL
+	spurious: 0
+
+fiu name base: linux/io/eventfd/
+
+int eventfd(unsigned int initval, int flags);
+	on error: -1
+	valid errnos: EINVAL EMFILE ENFILE ENODEV ENOMEM
+	after: if (r >= 0) fd_path_set(r, NULL);
+
+# Its declaration needs _GNU_SOURCE, see linux.zc.mod.
+fiu name base: posix/io/net/
+
+int accept4(int socket, struct sockaddr *address, socklen_t *address_len, \
+		int flags);
+	on error: -1
+	valid errnos: EAGAIN EBADF ECONNABORTED EINTR EINVAL EMFILE ENFILE \
+		ENOTSOCK EOPNOTSUPP ENOBUFS ENOMEM EPROTO
+	spurious: -1 EAGAIN
+	after: if (r >= 0) fd_path_set(r, NULL);
+
+v: #endif
@@ -0,0 +1,303 @@
+
+/*
+ * AUTOGENERATED FILE - DO NOT EDIT
+ *
+ * This file was automatically generated by libfiu, do not edit it directly,
+ * but see libfiu's "preload" directory.
+ */
+
+#include "codegen.h"
+
+static const char *const _fiu_watch_names[] = {
+	/*  0 */ "linux/io/sync_file_range",
+	/*  1 */ "linux/io/dup3",
+	/*  2 */ "linux/io/epoll/epoll_create1",
+	/*  3 */ "linux/io/epoll/epoll_ctl",
+	/*  4 */ "linux/io/epoll/epoll_wait",
+	/*  5 */ "linux/io/epoll/epoll_wait/spurious",
+	/*  6 */ "linux/io/epoll/epoll_pwait",
+	/*  7 */ "linux/io/epoll/epoll_pwait/spurious",
+	/*  8 */ "linux/io/eventfd/eventfd",
+	/*  9 */ "posix/io/net/accept4",
+	/* 10 */ "posix/io/net/accept4/spurious",
+};
+mkwrap_watch()
+
+mkwrap_catalog(
+	"linux/io/sync_file_range\0"
+	"linux/io/dup3\0"
+	"linux/io/epoll/epoll_create1\0"
+	"linux/io/epoll/epoll_ctl\0"
+	"linux/io/epoll/epoll_wait\0"
+	"linux/io/epoll/epoll_wait/spurious\0"
+	"linux/io/epoll/epoll_pwait\0"
+	"linux/io/epoll/epoll_pwait/spurious\0"
+	"linux/io/eventfd/eventfd\0"
+	"posix/io/net/accept4\0"
+	"posix/io/net/accept4/spurious\0"
+)
+
+
+#include <fcntl.h>
+#include <errno.h>
+
+
+// sync_file_range() is linux-only, and depends on _FILE_OFFSET_BITS==64. 
+#if defined __linux__ && _FILE_OFFSET_BITS == 64
+
+
+/* Wrapper for sync_file_range() */
+mkwrap_top(int , sync_file_range, (int fd, off_t offset, off_t nbytes, 		unsigned int flags), (fd, offset, nbytes, flags), (int , off_t , off_t , unsigned int ), (-1))
+mkwrap_body_gate(sync_file_range, (fd, offset, nbytes, flags), 0, 0x1ULL)
+mkwrap_body_args(fd, offset, nbytes, flags)
+	static const int valid_errnos[] = {
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef ENOSPC
+		ENOSPC,
+	  #endif
+	};
+mkwrap_body_errno(0 /* linux/io/sync_file_range */, -1)
+mkwrap_bottom(sync_file_range, (fd, offset, nbytes, flags))
+
+
+#endif
+
+// dup3() is linux-only; like dup(), it copies the path of the file descriptor. 
+#ifdef __linux__
+
+
+/* Wrapper for dup3() */
+mkwrap_top(int , dup3, (int oldfd, int newfd, int flags), (oldfd, newfd, flags), (int , int , int ), (-1))
+mkwrap_body_gate(dup3, (oldfd, newfd, flags), 0, 0x2ULL)
+mkwrap_body_path(fd_path(oldfd))
+mkwrap_body_args(oldfd, newfd, flags)
+	static const int valid_errnos[] = {
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EBUSY
+		EBUSY,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef EMFILE
+		EMFILE,
+	  #endif
+	};
+mkwrap_body_errno(1 /* linux/io/dup3 */, -1)
+mkwrap_bottom_after(dup3, (oldfd, newfd, flags), if (r >= 0) fd_path_copy(oldfd, r);)
+
+
+#endif
+
+
+// Event notification, used by event loops along with accept4() and the 
+// receiving functions. epoll_wait() can return spuriously without events, and 
+// accept4() with EAGAIN, as they do when another thread got there first. 
+#ifdef __linux__
+
+#include <signal.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+
+
+
+/* Wrapper for epoll_create1() */
+mkwrap_top(int , epoll_create1, (int flags), (flags), (int ), (-1))
+mkwrap_body_gate(epoll_create1, (flags), 0, 0x4ULL)
+mkwrap_body_args(flags)
+	static const int valid_errnos[] = {
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef EMFILE
+		EMFILE,
+	  #endif
+	  #ifdef ENFILE
+		ENFILE,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	};
+mkwrap_body_errno(2 /* linux/io/epoll/epoll_create1 */, -1)
+mkwrap_bottom_after(epoll_create1, (flags), if (r >= 0) fd_path_set(r, NULL);)
+
+
+
+/* Wrapper for epoll_ctl() */
+mkwrap_top(int , epoll_ctl, (int epfd, int op, int fd, struct epoll_event *event), (epfd, op, fd, event), (int , int , int , struct epoll_event *), (-1))
+mkwrap_body_gate(epoll_ctl, (epfd, op, fd, event), 0, 0x8ULL)
+mkwrap_body_args(epfd, op, fd, (intptr_t) event)
+	static const int valid_errnos[] = {
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EEXIST
+		EEXIST,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef ELOOP
+		ELOOP,
+	  #endif
+	  #ifdef ENOENT
+		ENOENT,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef ENOSPC
+		ENOSPC,
+	  #endif
+	  #ifdef EPERM
+		EPERM,
+	  #endif
+	};
+mkwrap_body_errno(3 /* linux/io/epoll/epoll_ctl */, -1)
+mkwrap_bottom(epoll_ctl, (epfd, op, fd, event))
+
+
+
+/* Wrapper for epoll_wait() */
+mkwrap_top(int , epoll_wait, (int epfd, struct epoll_event *events, int maxevents, 		int timeout), (epfd, events, maxevents, timeout), (int , struct epoll_event *, int , int ), (-1))
+mkwrap_body_gate(epoll_wait, (epfd, events, maxevents, timeout), 0, 0x30ULL)
+mkwrap_body_args(epfd, (intptr_t) events, maxevents, timeout)
+	static const int valid_errnos[] = {
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EFAULT
+		EFAULT,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	};
+mkwrap_body_errno(4 /* linux/io/epoll/epoll_wait */, -1)
+mkwrap_body_spurious(5 /* linux/io/epoll/epoll_wait/spurious */, 0, 0)
+mkwrap_bottom(epoll_wait, (epfd, events, maxevents, timeout))
+
+
+
+/* Wrapper for epoll_pwait() */
+mkwrap_top(int , epoll_pwait, (int epfd, struct epoll_event *events, int maxevents, 		int timeout, const sigset_t *sigmask), (epfd, events, maxevents, timeout, sigmask), (int , struct epoll_event *, int , int , const sigset_t *), (-1))
+mkwrap_body_gate(epoll_pwait, (epfd, events, maxevents, timeout, sigmask), 0, 0xc0ULL)
+mkwrap_body_args(epfd, (intptr_t) events, maxevents, timeout, (intptr_t) sigmask)
+	static const int valid_errnos[] = {
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EFAULT
+		EFAULT,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	};
+mkwrap_body_errno(6 /* linux/io/epoll/epoll_pwait */, -1)
+mkwrap_body_spurious(7 /* linux/io/epoll/epoll_pwait/spurious */, 0, 0)
+mkwrap_bottom(epoll_pwait, (epfd, events, maxevents, timeout, sigmask))
+
+
+
+
+// Its declaration needs _GNU_SOURCE, see linux.zc.mod. 
+/* Wrapper for eventfd() */
+mkwrap_top(int , eventfd, (unsigned int initval, int flags), (initval, flags), (unsigned int , int ), (-1))
+mkwrap_body_gate(eventfd, (initval, flags), 0, 0x100ULL)
+mkwrap_body_args(initval, flags)
+	static const int valid_errnos[] = {
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef EMFILE
+		EMFILE,
+	  #endif
+	  #ifdef ENFILE
+		ENFILE,
+	  #endif
+	  #ifdef ENODEV
+		ENODEV,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	};
+mkwrap_body_errno(8 /* linux/io/eventfd/eventfd */, -1)
+mkwrap_bottom_after(eventfd, (initval, flags), if (r >= 0) fd_path_set(r, NULL);)
+
+
+
+
+/* Wrapper for accept4() */
+mkwrap_top(int , accept4, (int socket, struct sockaddr *address, socklen_t *address_len, 		int flags), (socket, address, address_len, flags), (int , struct sockaddr *, socklen_t *, int ), (-1))
+mkwrap_body_gate(accept4, (socket, address, address_len, flags), 0, 0x600ULL)
+mkwrap_body_args(socket, (intptr_t) address, (intptr_t) address_len, flags)
+	static const int valid_errnos[] = {
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef ECONNABORTED
+		ECONNABORTED,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef EMFILE
+		EMFILE,
+	  #endif
+	  #ifdef ENFILE
+		ENFILE,
+	  #endif
+	  #ifdef ENOTSOCK
+		ENOTSOCK,
+	  #endif
+	  #ifdef EOPNOTSUPP
+		EOPNOTSUPP,
+	  #endif
+	  #ifdef ENOBUFS
+		ENOBUFS,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef EPROTO
+		EPROTO,
+	  #endif
+	};
+mkwrap_body_errno(9 /* posix/io/net/accept4 */, -1)
+mkwrap_body_spurious(10 /* posix/io/net/accept4/spurious */, -1, EAGAIN)
+mkwrap_bottom_after(accept4, (socket, address, address_len, flags), if (r >= 0) fd_path_set(r, NULL);)
+
+
+#endif
@@ -0,0 +1,48 @@
+
+# Linux zero-copy I/O
+
+include: <sys/types.h>
+include: <sys/uio.h>
+include: <errno.h>
+
+v: #ifdef __linux__
+
+include: <sys/sendfile.h>
+
+fiu name base: linux/io/zc/
+
+ssize_t sendfile(int out_fd, int in_fd, off_t *offset, size_t count);
+	on error: -1
+	valid errnos: EAGAIN EBADF EFAULT EINVAL EIO ENOMEM EOVERFLOW ESPIPE
+	reduce: count
+	fd path: in_fd
+	variants: off64_t
+
+# These are only declared with _GNU_SOURCE, which we can't define this late;
+# the wrappers' definitions work just as well without their declarations.
+
+ssize_t splice(int fd_in, off64_t *off_in, int fd_out, off64_t *off_out, \
+		size_t len, unsigned int flags);
+	on error: -1
+	valid errnos: EAGAIN EBADF EINVAL ENOMEM ESPIPE
+	reduce: len
+
+ssize_t tee(int fd_in, int fd_out, size_t len, unsigned int flags);
+	on error: -1
+	valid errnos: EAGAIN EINVAL ENOMEM
+	reduce: len
+
+ssize_t vmsplice(int fd, const struct iovec *iov, size_t nr_segs, \
+		unsigned int flags);
+	on error: -1
+	valid errnos: EAGAIN EBADF EINVAL ENOMEM
+	reduce iov: iov nr_segs
+
+ssize_t copy_file_range(int fd_in, off64_t *off_in, int fd_out, \
+		off64_t *off_out, size_t len, unsigned int flags);
+	on error: -1
+	valid errnos: EBADF EFBIG EINVAL EIO EISDIR ENOMEM ENOSPC EXDEV
+	reduce: len
+	fd path: fd_in
+
+v: #endif
@@ -0,0 +1,239 @@
+
+/*
+ * AUTOGENERATED FILE - DO NOT EDIT
+ *
+ * This file was automatically generated by libfiu, do not edit it directly,
+ * but see libfiu's "preload" directory.
+ */
+
+#include "codegen.h"
+
+static const char *const _fiu_watch_names[] = {
+	/*  0 */ "linux/io/zc/sendfile",
+	/*  1 */ "linux/io/zc/sendfile/reduce",
+	/*  2 */ "linux/io/zc/splice",
+	/*  3 */ "linux/io/zc/splice/reduce",
+	/*  4 */ "linux/io/zc/tee",
+	/*  5 */ "linux/io/zc/tee/reduce",
+	/*  6 */ "linux/io/zc/vmsplice",
+	/*  7 */ "linux/io/zc/vmsplice/reduce",
+	/*  8 */ "linux/io/zc/copy_file_range",
+	/*  9 */ "linux/io/zc/copy_file_range/reduce",
+};
+mkwrap_watch()
+
+mkwrap_catalog(
+	"linux/io/zc/sendfile\0"
+	"linux/io/zc/sendfile/reduce\0"
+	"linux/io/zc/splice\0"
+	"linux/io/zc/splice/reduce\0"
+	"linux/io/zc/tee\0"
+	"linux/io/zc/tee/reduce\0"
+	"linux/io/zc/vmsplice\0"
+	"linux/io/zc/vmsplice/reduce\0"
+	"linux/io/zc/copy_file_range\0"
+	"linux/io/zc/copy_file_range/reduce\0"
+)
+
+
+// Linux zero-copy I/O 
+
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <errno.h>
+
+#ifdef __linux__
+
+#include <sys/sendfile.h>
+
+
+
+// These are only declared with _GNU_SOURCE, which we can't define this late; 
+// the wrappers' definitions work just as well without their declarations. 
+
+/* Wrapper for sendfile() */
+mkwrap_top(ssize_t , sendfile, (int out_fd, int in_fd, off_t *offset, size_t count), (out_fd, in_fd, offset, count), (int , int , off_t *, size_t ), (-1))
+mkwrap_body_gate(sendfile, (out_fd, in_fd, offset, count), 0, 0x3ULL)
+mkwrap_body_path(fd_path(in_fd))
+mkwrap_body_args(out_fd, in_fd, (intptr_t) offset, count)
+mkwrap_body_reduce(1 /* linux/io/zc/sendfile/reduce */, count)
+	static const int valid_errnos[] = {
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EFAULT
+		EFAULT,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef EOVERFLOW
+		EOVERFLOW,
+	  #endif
+	  #ifdef ESPIPE
+		ESPIPE,
+	  #endif
+	};
+mkwrap_body_errno(0 /* linux/io/zc/sendfile */, -1)
+mkwrap_bottom(sendfile, (out_fd, in_fd, offset, count))
+
+
+#ifdef __GLIBC__
+#if LIBFIU_CAN_DEFINE_64BIT_FUNCTIONS
+/* Wrapper for sendfile64() */
+mkwrap_top(ssize_t , sendfile64, (int out_fd, int in_fd, off64_t *offset, size_t count), (out_fd, in_fd, offset, count), (int , int , off64_t *, size_t ), (-1))
+mkwrap_body_gate(sendfile64, (out_fd, in_fd, offset, count), 0, 0x3ULL)
+mkwrap_body_path(fd_path(in_fd))
+mkwrap_body_args(out_fd, in_fd, (intptr_t) offset, count)
+mkwrap_body_reduce(1 /* linux/io/zc/sendfile/reduce */, count)
+	static const int valid_errnos[] = {
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EFAULT
+		EFAULT,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef EOVERFLOW
+		EOVERFLOW,
+	  #endif
+	  #ifdef ESPIPE
+		ESPIPE,
+	  #endif
+	};
+mkwrap_body_errno(0 /* linux/io/zc/sendfile */, -1)
+mkwrap_bottom(sendfile64, (out_fd, in_fd, offset, count))
+
+
+#endif  // LIBFIU_CAN_DEFINE_64BIT_FUNCTIONS
+#endif  // __GLIBC__
+
+/* Wrapper for splice() */
+mkwrap_top(ssize_t , splice, (int fd_in, off64_t *off_in, int fd_out, off64_t *off_out, 		size_t len, unsigned int flags), (fd_in, off_in, fd_out, off_out, len, flags), (int , off64_t *, int , off64_t *, size_t , unsigned int ), (-1))
+mkwrap_body_gate(splice, (fd_in, off_in, fd_out, off_out, len, flags), 0, 0xcULL)
+mkwrap_body_args(fd_in, (intptr_t) off_in, fd_out, (intptr_t) off_out, len, flags)
+mkwrap_body_reduce(3 /* linux/io/zc/splice/reduce */, len)
+	static const int valid_errnos[] = {
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef ESPIPE
+		ESPIPE,
+	  #endif
+	};
+mkwrap_body_errno(2 /* linux/io/zc/splice */, -1)
+mkwrap_bottom(splice, (fd_in, off_in, fd_out, off_out, len, flags))
+
+
+
+/* Wrapper for tee() */
+mkwrap_top(ssize_t , tee, (int fd_in, int fd_out, size_t len, unsigned int flags), (fd_in, fd_out, len, flags), (int , int , size_t , unsigned int ), (-1))
+mkwrap_body_gate(tee, (fd_in, fd_out, len, flags), 0, 0x30ULL)
+mkwrap_body_args(fd_in, fd_out, len, flags)
+mkwrap_body_reduce(5 /* linux/io/zc/tee/reduce */, len)
+	static const int valid_errnos[] = {
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	};
+mkwrap_body_errno(4 /* linux/io/zc/tee */, -1)
+mkwrap_bottom(tee, (fd_in, fd_out, len, flags))
+
+
+
+/* Wrapper for vmsplice() */
+mkwrap_top(ssize_t , vmsplice, (int fd, const struct iovec *iov, size_t nr_segs, 		unsigned int flags), (fd, iov, nr_segs, flags), (int , const struct iovec *, size_t , unsigned int ), (-1))
+mkwrap_body_gate(vmsplice, (fd, iov, nr_segs, flags), 0, 0xc0ULL)
+mkwrap_body_args(fd, (intptr_t) iov, nr_segs, flags)
+mkwrap_body_reduce_iov(7 /* linux/io/zc/vmsplice/reduce */, iov, nr_segs)
+	static const int valid_errnos[] = {
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	};
+mkwrap_body_errno(6 /* linux/io/zc/vmsplice */, -1)
+mkwrap_bottom(vmsplice, (fd, iov, nr_segs, flags))
+
+
+
+/* Wrapper for copy_file_range() */
+mkwrap_top(ssize_t , copy_file_range, (int fd_in, off64_t *off_in, int fd_out, 		off64_t *off_out, size_t len, unsigned int flags), (fd_in, off_in, fd_out, off_out, len, flags), (int , off64_t *, int , off64_t *, size_t , unsigned int ), (-1))
+mkwrap_body_gate(copy_file_range, (fd_in, off_in, fd_out, off_out, len, flags), 0, 0x300ULL)
+mkwrap_body_path(fd_path(fd_in))
+mkwrap_body_args(fd_in, (intptr_t) off_in, fd_out, (intptr_t) off_out, len, flags)
+mkwrap_body_reduce(9 /* linux/io/zc/copy_file_range/reduce */, len)
+	static const int valid_errnos[] = {
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EFBIG
+		EFBIG,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef EISDIR
+		EISDIR,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef ENOSPC
+		ENOSPC,
+	  #endif
+	  #ifdef EXDEV
+		EXDEV,
+	  #endif
+	};
+mkwrap_body_errno(8 /* linux/io/zc/copy_file_range */, -1)
+mkwrap_bottom(copy_file_range, (fd_in, off_in, fd_out, off_out, len, flags))
+
+
+#endif
@@ -14,12 +14,45 @@
 #include <errno.h>
 #include <stdarg.h>
 #include <stdio.h>
+#include <stdbool.h>
 #include <stdint.h>
 #include <pthread.h>
 
 
+/* Points of failure of the wrappers below, see mkwrap_watch(). The position
+ * in the table is the ID the wrappers use, and the bit they check. ferror(),
+ * clearerr() and fclose() only skip the failure check, as they must keep the
+ * ferror state consistent even when nothing is enabled. */
+static const char *const _fiu_watch_names[] = {
+	/*  0 */ "posix/io/oc/open",
+	/*  1 */ "posix/stdio/sp/fprintf",
+	/*  2 */ "posix/stdio/sp/printf",
+	/*  3 */ "posix/stdio/sp/dprintf",
+	/*  4 */ "posix/stdio/sp/fscanf",
+	/*  5 */ "posix/stdio/sp/scanf",
+	/*  6 */ "posix/stdio/error/ferror",
+	/*  7 */ "posix/stdio/oc/fclose",
+	/*  8 */ "posix/io/oc/close",
+};
+mkwrap_watch()
+
+/* The same names, for the catalog. */
+mkwrap_catalog(
+	"posix/io/oc/open\0"
+	"posix/stdio/sp/fprintf\0"
+	"posix/stdio/sp/printf\0"
+	"posix/stdio/sp/dprintf\0"
+	"posix/stdio/sp/fscanf\0"
+	"posix/stdio/sp/scanf\0"
+	"posix/stdio/error/ferror\0"
+	"posix/stdio/oc/fclose\0"
+	"posix/io/oc/close\0"
+)
+
+
 /* Wrapper for open(), we can't generate it because it has a variable number
- * of arguments */
+ * of arguments. It also records the path of the new file descriptor, see
+ * fd_path(). */
 mkwrap_init(int, open, (const char *pathname, int flags, ...),
 		(const char *, int, ...))
 
@@ -27,6 +60,10 @@ int open(const char *pathname, int flags, ...)
 {
 	int r;
 	int fstatus;
+	const char *_fiu_path = pathname;
+	size_t _fiu_size = 0;
+	const int64_t *_fiu_args = NULL;
+	unsigned int _fiu_nargs = 0;
 
 	/* Differences from the generated code begin here */
 
@@ -54,6 +91,8 @@ int open(const char *pathname, int flags, ...)
 /* Use the normal macros to complete the function, now that we have
  * set mode to something */
 mkwrap_body_called(open, (pathname, flags, mode), -1)
+mkwrap_body_gate(open, (pathname, flags, mode), 0, 0x1ULL)
+mkwrap_body_args((intptr_t) pathname, flags, mode)
 
 	static const int valid_errnos[] = {
 	  #ifdef EACCESS
@@ -96,8 +135,9 @@ mkwrap_body_called(open, (pathname, flags, mode), -1)
 		EROFS
 	  #endif
 	};
-mkwrap_body_errno("posix/io/oc/open", -1)
-mkwrap_bottom(open, (pathname, flags, mode))
+mkwrap_body_errno(0 /* posix/io/oc/open */, -1)
+mkwrap_bottom_after(open, (pathname, flags, mode),
+	if (r >= 0) fd_path_set(r, pathname);)
 
 
 /* The 64-bit variant for glibc.
@@ -112,6 +152,10 @@ int open64(const char *pathname, int flags, ...)
 {
 	int r;
 	int fstatus;
+	const char *_fiu_path = pathname;
+	size_t _fiu_size = 0;
+	const int64_t *_fiu_args = NULL;
+	unsigned int _fiu_nargs = 0;
 
 	/* Differences from the generated code begin here */
 
@@ -139,6 +183,8 @@ int open64(const char *pathname, int flags, ...)
 /* Use the normal macros to complete the function, now that we have
  * set mode to something */
 mkwrap_body_called(open, (pathname, flags, mode), -1)
+mkwrap_body_gate(open64, (pathname, flags, mode), 0, 0x1ULL)
+mkwrap_body_args((intptr_t) pathname, flags, mode)
 
 	static const int valid_errnos[] = {
 	  #ifdef EACCESS
@@ -181,39 +227,84 @@ mkwrap_body_called(open, (pathname, flags, mode), -1)
 		EROFS
 	  #endif
 	};
-mkwrap_body_errno("posix/io/oc/open", -1)
-mkwrap_bottom(open64, (pathname, flags, mode))
+mkwrap_body_errno(0 /* posix/io/oc/open */, -1)
+mkwrap_bottom_after(open64, (pathname, flags, mode),
+	if (r >= 0) fd_path_set(r, pathname);)
 
 #endif  // LIBFIU_CAN_DEFINE_64BIT_FUNCTIONS
 #endif  // __GLIBC__
 
+
+/* Wrapper for close(), which forgets the path of the file descriptor (and
+ * the io_uring instance, if it is one).
+ * The path is taken out of the table before closing, so it doesn't get mixed
+ * up with the one of a file descriptor that another thread opens right after
+ * we close this one; if closing fails and the file descriptor is still open,
+ * it is put back. */
+mkwrap_top(int, close, (int fd), (fd), (int), -1)
+	char *path = fd_path_take(fd);
+
+mkwrap_body_gate(close, (fd), 0, 0x100ULL)
+mkwrap_body_path(path)
+mkwrap_body_args(fd)
+
+	static const int valid_errnos[] = {
+	  #ifdef EBADFD
+		EBADFD,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	};
+mkwrap_body_errno(8 /* posix/io/oc/close */, -1)
+mkwrap_bottom_after(close, (fd),
+	fd_path_put(fd, path, r != 0 && fcntl(fd, F_GETFD) != -1);
+	if (r == 0) uring_close(fd);)
+
+
 /*
  * To simulate ferror() properly, we need to keep track of which FILE * have
  * we returned a failure for.
  *
- * To do that, we keep a set of FILE *. This set is implemented using a hash
- * table, for convenience.
+ * ferror() and fclose() have to check it every time, so we keep them in a
+ * set that can be looked up without locking: a fixed open addressing table,
+ * with linear probing. Changes are rare (they only happen when something
+ * fails, or when a stream is closed after that), so they are serialized with
+ * a mutex, and published with atomic stores for the lookups.
+ *
+ * Removed slots are marked as deleted instead of empty, so lookups can always
+ * stop at the first empty slot; inserting reuses deleted slots. When the
+ * removed slot is at the end of a run (the next one is empty), no lookup has
+ * to go through it anymore, so it and the deleted slots right before it are
+ * made empty again. That keeps the runs from growing with the streams that
+ * come and go.
  *
- * An alternative would be to have a static array, but then lookups would
- * scale linearly with the number of files we're expected to fail, and (most
- * importantly) require a new data type just for this.
+ * Most of the time nothing has failed, so we don't even look at the table
+ * until something has been inserted.
+ *
+ * The table should be large enough for any reasonable number of streams
+ * failing at the same time, but if it fills up we fall back to a hash table,
+ * so we don't lose track of any.
  */
-static hash_t *ferror_hash_table;
-static pthread_mutex_t ferror_hash_table_mutex = PTHREAD_MUTEX_INITIALIZER;
-static pthread_once_t ferror_hash_table_is_initialized = PTHREAD_ONCE_INIT;
 
-static void _fiu_init_ferror_hash_table(void)
-{
-	rec_inc();
-	pthread_mutex_lock(&ferror_hash_table_mutex);
+#define FERROR_SLOTS_BITS 10
+#define FERROR_SLOTS (1 << FERROR_SLOTS_BITS)
 
-	// Create the hash table. No need for a value destructor, as our values
-	// are not pointers but static values.
-	ferror_hash_table = hash_create(NULL);
+#define FERROR_EMPTY ((uintptr_t) 0)
+#define FERROR_DELETED ((uintptr_t) 1)
 
-	pthread_mutex_unlock(&ferror_hash_table_mutex);
-	rec_dec();
-}
+static uintptr_t ferror_slots[FERROR_SLOTS];
+
+/* Set once something is inserted in the table, or in the fallback hash. */
+static bool ferror_used = false;
+static bool ferror_overflowed = false;
+
+/* Protects the changes to the table, and the fallback hash table. */
+static pthread_mutex_t ferror_lock = PTHREAD_MUTEX_INITIALIZER;
+static hash_t *ferror_hash_table;
 
 /* Our hash table uses character keys, to convert stream to keys we just get
  * the hexadecimal representation via PRIxPTR (%p is implementation
@@ -225,68 +316,168 @@ static void stream_to_key(void *stream, char key[STREAM_KEY_SIZE])
 	snprintf(key, STREAM_KEY_SIZE, "%" PRIxPTR, (uintptr_t) stream);
 }
 
-void set_ferror(void * stream)
+/* Position where the search for the given stream starts (Fibonacci
+ * hashing, as the low bits of the pointers are usually all the same). */
+static unsigned int ferror_slot(uintptr_t stream)
+{
+	return ((uint64_t) stream * 0x9E3779B97F4A7C15ULL) >>
+		(64 - FERROR_SLOTS_BITS);
+}
+
+/* Finds the slot of the given stream, returns -1 if it's not in the table. */
+static int ferror_find(void *stream)
+{
+	uintptr_t s;
+	unsigned int i, n;
+
+	i = ferror_slot((uintptr_t) stream);
+	for (n = 0; n < FERROR_SLOTS; n++) {
+		s = __atomic_load_n(&ferror_slots[i], __ATOMIC_ACQUIRE);
+		if (s == (uintptr_t) stream)
+			return i;
+		if (s == FERROR_EMPTY)
+			break;
+		i = (i + 1) % FERROR_SLOTS;
+	}
+
+	return -1;
+}
+
+/* Looks the stream up in the fallback hash table, with ferror_lock held. */
+static bool ferror_hash_get(void *stream)
 {
 	char key[STREAM_KEY_SIZE];
+
+	if (ferror_hash_table == NULL)
+		return false;
+
 	stream_to_key(stream, key);
+	return hash_get(ferror_hash_table, key) != NULL;
+}
 
-	pthread_once(&ferror_hash_table_is_initialized,
-			_fiu_init_ferror_hash_table);
+static int get_ferror(void * stream)
+{
+	int r;
 
-	pthread_mutex_lock(&ferror_hash_table_mutex);
+	if (!__atomic_load_n(&ferror_used, __ATOMIC_ACQUIRE))
+		return 0;
 
-	// Use a dummy the value; we don't care about it, we only need to be able to
-	// distinguish it from NULL.
-	hash_set(ferror_hash_table, key, (void *) 0xDEAD);
+	if (ferror_find(stream) >= 0)
+		return 1;
+
+	if (!__atomic_load_n(&ferror_overflowed, __ATOMIC_ACQUIRE))
+		return 0;
 
-	pthread_mutex_unlock(&ferror_hash_table_mutex);
+	rec_inc();
+	pthread_mutex_lock(&ferror_lock);
+	r = ferror_hash_get(stream);
+	pthread_mutex_unlock(&ferror_lock);
+	rec_dec();
+
+	return r;
 }
 
-static int get_ferror(void * stream)
+void set_ferror(void * stream)
 {
 	char key[STREAM_KEY_SIZE];
-	stream_to_key(stream, key);
-
-	pthread_once(&ferror_hash_table_is_initialized,
-			_fiu_init_ferror_hash_table);
+	uintptr_t s;
+	unsigned int i, n;
 
-	pthread_mutex_lock(&ferror_hash_table_mutex);
+	rec_inc();
+	pthread_mutex_lock(&ferror_lock);
+
+	__atomic_store_n(&ferror_used, true, __ATOMIC_RELEASE);
+
+	if (ferror_find(stream) >= 0 || ferror_hash_get(stream))
+		goto exit;
+
+	i = ferror_slot((uintptr_t) stream);
+	for (n = 0; n < FERROR_SLOTS; n++) {
+		s = __atomic_load_n(&ferror_slots[i], __ATOMIC_ACQUIRE);
+		if (s == FERROR_EMPTY || s == FERROR_DELETED) {
+			__atomic_store_n(&ferror_slots[i], (uintptr_t) stream,
+					__ATOMIC_RELEASE);
+			goto exit;
+		}
+		i = (i + 1) % FERROR_SLOTS;
+	}
 
-	void *value = hash_get(ferror_hash_table, key);
+	if (ferror_hash_table == NULL) {
+		// No need for a value destructor, as our values are not
+		// pointers but static values.
+		ferror_hash_table = hash_create(NULL);
+	}
 
-	pthread_mutex_unlock(&ferror_hash_table_mutex);
+	// Use a dummy the value; we don't care about it, we only need to be
+	// able to distinguish it from NULL.
+	stream_to_key(stream, key);
+	hash_set(ferror_hash_table, key, (void *) 0xDEAD);
+	__atomic_store_n(&ferror_overflowed, true, __ATOMIC_RELEASE);
 
-	return value != NULL;
+exit:
+	pthread_mutex_unlock(&ferror_lock);
+	rec_dec();
 }
 
 static void clear_ferror(void * stream)
 {
 	char key[STREAM_KEY_SIZE];
-	stream_to_key(stream, key);
+	bool overflowed;
+	int i;
+
+	if (!__atomic_load_n(&ferror_used, __ATOMIC_ACQUIRE))
+		return;
 
-	pthread_once(&ferror_hash_table_is_initialized,
-			_fiu_init_ferror_hash_table);
+	/* Most streams are not in the table, check without locking first. */
+	overflowed = __atomic_load_n(&ferror_overflowed, __ATOMIC_ACQUIRE);
+	if (ferror_find(stream) < 0 && !overflowed)
+		return;
 
-	pthread_mutex_lock(&ferror_hash_table_mutex);
+	rec_inc();
+	pthread_mutex_lock(&ferror_lock);
+
+	i = ferror_find(stream);
+	if (i >= 0) {
+		__atomic_store_n(&ferror_slots[i], FERROR_DELETED,
+				__ATOMIC_RELEASE);
+
+		/* If this was the end of a run, reclaim the deleted slots at
+		 * the end of it. */
+		if (__atomic_load_n(&ferror_slots[(i + 1) % FERROR_SLOTS],
+					__ATOMIC_ACQUIRE) == FERROR_EMPTY) {
+			while (__atomic_load_n(&ferror_slots[i],
+						__ATOMIC_ACQUIRE) == FERROR_DELETED) {
+				__atomic_store_n(&ferror_slots[i], FERROR_EMPTY,
+						__ATOMIC_RELEASE);
+				i = (i + FERROR_SLOTS - 1) % FERROR_SLOTS;
+			}
+		}
+	}
 
-	hash_del(ferror_hash_table, key);
+	if (overflowed && ferror_hash_table != NULL) {
+		stream_to_key(stream, key);
+		hash_del(ferror_hash_table, key);
+	}
 
-	pthread_mutex_unlock(&ferror_hash_table_mutex);
+	pthread_mutex_unlock(&ferror_lock);
+	rec_dec();
 }
 
 
 /* Wrapper for ferror() */
 mkwrap_top(int, ferror, (FILE *stream), (stream), (FILE *), 1)
-mkwrap_body_hardcoded("posix/stdio/error/ferror", 1)
+	if (mkwrap_watched(0, 0x40ULL)) {
+	mkwrap_body_hardcoded(6 /* posix/stdio/error/ferror */, 1)
+	}
 
 	/* The following is like mkwrap_bottom(), but has an additional check to
 	 * return 1 if we previously returned an error for this file, so the
 	 * semantics are consistent. */
-	if (_fiu_orig_ferror == NULL)
+	if (mkwrap_orig(ferror) == NULL)
 		_fiu_init_ferror();
 
 	printd("calling orig\n");
-	r = (*_fiu_orig_ferror) (stream);
+	r = (*mkwrap_orig(ferror)) (stream);
 
 	if (r == 0 && get_ferror(stream)) {
 		printd("ferror fixed\n");
@@ -308,11 +499,11 @@ void clearerr (FILE *stream)
 {
 	rec_inc();
 
-	if (_fiu_orig_clearerr == NULL)
+	if (mkwrap_orig(clearerr) == NULL)
 			_fiu_init_clearerr();
 
 	printd("calling orig\n");
-	(*_fiu_orig_clearerr) (stream);
+	(*mkwrap_orig(clearerr)) (stream);
 
 	printd("fixing internal state\n");
 	clear_ferror(stream);
@@ -321,8 +512,12 @@ void clearerr (FILE *stream)
 }
 
 
-/* Custom wrapper for fclose() that clears ferror_hash_table. */
+/* Custom wrapper for fclose() that clears ferror_hash_table, and forgets the
+ * path of the stream's file descriptor (if it was opened with open(), as in
+ * fdopen()), as it gets closed within libc. */
 mkwrap_top(int , fclose, (FILE *stream), (stream), (FILE *), (EOF))
+	int fd = -1;
+
 	static const int valid_errnos[] = {
 	  #ifdef EAGAIN
 		EAGAIN,
@@ -355,13 +550,16 @@ mkwrap_top(int , fclose, (FILE *stream), (stream), (FILE *), (EOF))
 		ENXIO,
 	  #endif
 	};
-mkwrap_body_errno("posix/stdio/oc/fclose", EOF)
+	if (mkwrap_watched(0, 0x80ULL)) {
+	mkwrap_body_errno(7 /* posix/stdio/oc/fclose */, EOF)
+	}
 
 /* We need a custom injection of clear_ferror here to prevent stale entries in
  * ferror_hash_table. */
 	clear_ferror(stream);
+	fd = fileno(stream);
 
-mkwrap_bottom(fclose, (stream))
+mkwrap_bottom_after(fclose, (stream), if (r == 0) fd_path_set(fd, NULL);)
 
 
 /*
@@ -392,10 +590,14 @@ mkwrap_bottom(fclose, (stream))
 	{ 							\
 		RTYPE r;					\
 		int fstatus;					\
+		const char *_fiu_path = NULL;			\
+		size_t _fiu_size = 0;				\
+		const int64_t *_fiu_args = NULL;		\
+		unsigned int _fiu_nargs = 0;			\
 		va_list arguments;				\
 								\
 		if (_fiu_called) {				\
-			if (_fiu_orig_##NVNAME == NULL) {	\
+			if (mkwrap_orig(NVNAME) == NULL) {	\
 				if (_fiu_in_init_##NVNAME) {	\
 					printd("fail on init\n"); \
 					return ON_ERR;		\
@@ -406,7 +608,7 @@ mkwrap_bottom(fclose, (stream))
 			}					\
 			printd("orig\n");			\
 			va_start(arguments, LASTPN);		\
-			r = (*_fiu_orig_##NVNAME) PARAMSN;	\
+			r = (*mkwrap_orig(NVNAME)) PARAMSN;	\
 			va_end(arguments);			\
 								\
 			return r;				\
@@ -418,6 +620,26 @@ mkwrap_bottom(fclose, (stream))
 		rec_inc();
 
 
+/* Like mkwrap_body_gate(), for variadic functions. */
+#define mkwrap_variadic_gate( \
+		NVNAME /* non-variadic name */, \
+		PARAMSN /* parameter names only, with "arguments" for va part */, \
+		LASTPN /* last parameter name */, \
+		WORD, BITS /* watch mask bits, see mkwrap_body_gate() */ \
+		) \
+								\
+		if (!mkwrap_watched(WORD, BITS)) {		\
+			if (mkwrap_orig(NVNAME) == NULL)	\
+				_fiu_init_##NVNAME();		\
+								\
+			printd("not watched, calling orig\n");	\
+			va_start(arguments, LASTPN);		\
+			r = (*mkwrap_orig(NVNAME)) PARAMSN;	\
+			va_end(arguments);			\
+			goto exit;				\
+		}
+
+
 #define mkwrap_variadic_bottom( \
 		NAME /* variadic name */, \
 		NVNAME /* non-variadic name */, \
@@ -425,12 +647,12 @@ mkwrap_bottom(fclose, (stream))
 		LASTPN /* last parameter name */ \
 		) \
 								\
-		if (_fiu_orig_##NVNAME == NULL)			\
+		if (mkwrap_orig(NVNAME) == NULL)		\
 			_fiu_init_##NVNAME();			\
 								\
 		printd("calling orig\n");			\
 		va_start(arguments, LASTPN);			\
-		r = (*_fiu_orig_##NVNAME) PARAMSN;		\
+		r = (*mkwrap_orig(NVNAME)) PARAMSN;		\
 		va_end(arguments);				\
 								\
 	exit:							\
@@ -448,6 +670,7 @@ mkwrap_variadic_def_and_body_called(int, fprintf, vfprintf,
 	(FILE *restrict stream, const char *restrict format, ...),
 	(stream, format, arguments),
 	format, -1)
+mkwrap_variadic_gate(vfprintf, (stream, format, arguments), format, 0, 0x2ULL)
 
 	static const int valid_errnos[] = {
 	  #ifdef EAGAIN
@@ -485,7 +708,7 @@ mkwrap_variadic_def_and_body_called(int, fprintf, vfprintf,
 	  #endif
 	};
 
-mkwrap_body_errno_ferror("posix/stdio/sp/fprintf", -1, stream)
+mkwrap_body_errno_ferror(1 /* posix/stdio/sp/fprintf */, -1, stream)
 mkwrap_variadic_bottom(fprintf, vfprintf, (stream, format, arguments), format)
 
 
@@ -498,6 +721,7 @@ mkwrap_variadic_def_and_body_called(int, printf, vprintf,
 	(const char *restrict format, ...),
 	(format, arguments),
 	format, -1)
+mkwrap_variadic_gate(vprintf, (format, arguments), format, 0, 0x4ULL)
 
 	static const int valid_errnos[] = {
 	  #ifdef EAGAIN
@@ -535,7 +759,7 @@ mkwrap_variadic_def_and_body_called(int, printf, vprintf,
 	  #endif
 	};
 
-mkwrap_body_errno_ferror("posix/stdio/sp/printf", -1, stdout)
+mkwrap_body_errno_ferror(2 /* posix/stdio/sp/printf */, -1, stdout)
 mkwrap_variadic_bottom(printf, vprintf, (format, arguments), format)
 
 
@@ -548,6 +772,7 @@ mkwrap_variadic_def_and_body_called(int, dprintf, vdprintf,
 	(int fildes, const char *restrict format, ...),
 	(fildes, format, arguments),
 	format, -1)
+mkwrap_variadic_gate(vdprintf, (fildes, format, arguments), format, 0, 0x8ULL)
 
 	static const int valid_errnos[] = {
 	  #ifdef EAGAIN
@@ -585,7 +810,7 @@ mkwrap_variadic_def_and_body_called(int, dprintf, vdprintf,
 	  #endif
 	};
 
-mkwrap_body_errno("posix/stdio/sp/dprintf", -1)
+mkwrap_body_errno(3 /* posix/stdio/sp/dprintf */, -1)
 mkwrap_variadic_bottom(dprintf, vdprintf, (fildes, format, arguments), format)
 
 
@@ -598,6 +823,7 @@ mkwrap_variadic_def_and_body_called(int, fscanf, vfscanf,
 	(FILE *restrict stream, const char *restrict format, ...),
 	(stream, format, arguments),
 	format, EOF)
+mkwrap_variadic_gate(vfscanf, (stream, format, arguments), format, 0, 0x10ULL)
 
 	static const int valid_errnos[] = {
 	  #ifdef EAGAIN
@@ -629,7 +855,7 @@ mkwrap_variadic_def_and_body_called(int, fscanf, vfscanf,
 	  #endif
 	};
 
-mkwrap_body_errno_ferror("posix/stdio/sp/fscanf", EOF, stream)
+mkwrap_body_errno_ferror(4 /* posix/stdio/sp/fscanf */, EOF, stream)
 mkwrap_variadic_bottom(fscanf, vfscanf, (stream, format, arguments), format)
 
 
@@ -642,6 +868,7 @@ mkwrap_variadic_def_and_body_called(int, scanf, vscanf,
 	(const char *restrict format, ...),
 	(format, arguments),
 	format, EOF)
+mkwrap_variadic_gate(vscanf, (format, arguments), format, 0, 0x20ULL)
 
 	static const int valid_errnos[] = {
 	  #ifdef EAGAIN
@@ -670,5 +897,5 @@ mkwrap_variadic_def_and_body_called(int, scanf, vscanf,
 	  #endif
 	};
 
-mkwrap_body_errno_ferror("posix/stdio/sp/scanf", EOF, stdin)
+mkwrap_body_errno_ferror(5 /* posix/stdio/sp/scanf */, EOF, stdin)
 mkwrap_variadic_bottom(scanf, vscanf, (format, arguments), format)
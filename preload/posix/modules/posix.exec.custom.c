@@ -0,0 +1,309 @@
+
+/*
+ * Custom wrappers for execve() and friends.
+ *
+ * Besides the usual point of failure, when FIU_EXEC_INHERIT is set in the
+ * environment they make the new program start with the points of failure
+ * that are enabled at the time of the call, not just with the ones it was
+ * started with: they put the commands that describe them (see fiu_rc_list())
+ * in its FIU_ENABLE, replacing the one there, which the fiu-run preload
+ * library applies at startup. This way the points enabled later with
+ * fiu-ctrl are not lost when a process runs a helper.
+ *
+ * Points enabled with fiu_enable_external() and fiu_enable_stack() can't be
+ * passed on, and are left out.
+ *
+ * Only execve(), execv(), execvp() and (with glibc) execvpe() are wrapped;
+ * the execl*() family calls execve() from within the libc, so we don't see
+ * those.
+ *
+ * Most programs exec right after forking, and in a child forked from a
+ * multithreaded parent, another thread could have held libfiu's lock or the
+ * allocator's at the time of the fork; so the exec wrappers must not need
+ * them. The commands are kept in a buffer that is only listed again when the
+ * points of failure change (see fiu_rc_list_gen()), and we bring it up to
+ * date before each fork, so the child inherits one it can use as is. The new
+ * environment is built in memory from mmap() for the same reason.
+ */
+
+#define _GNU_SOURCE
+
+#include "codegen.h"
+
+#include <errno.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+static const char *const _fiu_watch_names[] = {
+	/*  0 */ "posix/proc/exec",
+};
+mkwrap_watch()
+
+mkwrap_catalog("posix/proc/exec\0")
+
+static const int valid_errnos[] = {
+	E2BIG, EACCES, ENOENT, ENOEXEC, ENOMEM, ETXTBSY,
+};
+
+/* Buffer the commands are collected into, see cmds_add(). */
+struct cmds {
+	char *buf;
+	size_t len;
+	size_t size;
+};
+
+/* Appends the given string to the buffer. Returns 0 if success, -1 if we run
+ * out of memory. */
+static int cmds_add(struct cmds *c, const char *s, size_t len)
+{
+	char *p;
+
+	if (c->len + len + 1 > c->size) {
+		p = realloc(c->buf, (c->len + len + 1) * 2);
+		if (p == NULL)
+			return -1;
+		c->buf = p;
+		c->size = (c->len + len + 1) * 2;
+	}
+
+	memcpy(c->buf + c->len, s, len);
+	c->len += len;
+	c->buf[c->len] = '\0';
+	return 0;
+}
+
+/* fiu_rc_list() callback, adds the command to the buffer, ending it with a
+ * newline as FIU_ENABLE expects. */
+static int add_cmd(const char *line, void *arg)
+{
+	struct cmds *c = arg;
+
+	if (strncmp(line, "enable_external ", 16) == 0 ||
+			strncmp(line, "enable_stack ", 13) == 0)
+		return 0;
+
+	if (cmds_add(c, line, strlen(line)) < 0 || cmds_add(c, "\n", 1) < 0)
+		return -1;
+	return 0;
+}
+
+/* Whether FIU_EXEC_INHERIT was set at startup. */
+static bool inherit = false;
+
+/* The FIU_ENABLE variable for the new programs, and the fiu_rc_list_gen()
+ * it was listed at. Protected by env_lock. */
+static struct cmds env_var = { NULL, 0, 0 };
+static unsigned int env_var_gen = 0;
+static pthread_mutex_t env_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* Lists the points of failure again into env_var, if they changed since it
+ * was done. Must be called with env_lock held. On errors, env_var is left
+ * as it was. */
+static void env_var_update(void)
+{
+	static const char var[] = "FIU_ENABLE=";
+	struct cmds c = { NULL, 0, 0 };
+	unsigned int gen;
+
+	/* Take it first, so if they change while we list them we do it
+	 * again next time. */
+	gen = fiu_rc_list_gen();
+	if (env_var.buf != NULL && gen == env_var_gen)
+		return;
+
+	if (cmds_add(&c, var, sizeof(var) - 1) < 0 ||
+			fiu_rc_list(add_cmd, &c) < 0) {
+		free(c.buf);
+		return;
+	}
+
+	free(env_var.buf);
+	env_var = c;
+	env_var_gen = gen;
+}
+
+/* Before forking, we bring env_var up to date for the child, and hold the
+ * lock so no other thread is in the middle of it. */
+static void atfork_prepare(void)
+{
+	rec_inc();
+	pthread_mutex_lock(&env_lock);
+	env_var_update();
+}
+
+static void atfork_parent(void)
+{
+	pthread_mutex_unlock(&env_lock);
+	rec_dec();
+}
+
+/* The child takes env_var as it was listed before the fork; changes made
+ * meanwhile by other threads of the parent are lost, as they would be if
+ * they came right after the fork. Only the ones the child makes itself
+ * make it list the points again. */
+static void atfork_child(void)
+{
+	env_var_gen = fiu_rc_list_gen();
+	pthread_mutex_unlock(&env_lock);
+	rec_dec();
+}
+
+static void constructor_attr(202) _fiu_exec_init(void)
+{
+	const char *s;
+
+	rec_inc();
+	s = getenv("FIU_EXEC_INHERIT");
+	inherit = s != NULL && *s != '\0';
+	if (inherit)
+		pthread_atfork(atfork_prepare, atfork_parent, atfork_child);
+	rec_dec();
+}
+
+/* Returns a copy of envp with FIU_ENABLE describing the points of failure
+ * enabled right now, or NULL if they're not to be inherited (or on errors,
+ * in which case the program runs with the original one). The copy is a
+ * single block from mmap(), starting with its size, to be released with
+ * env_free(). */
+static char **exec_env(char *const *envp)
+{
+	static const char var[] = "FIU_ENABLE=";
+	size_t n, i, k, size;
+	size_t *block;
+	char **env, *p;
+
+	if (!inherit)
+		return NULL;
+
+	for (n = 0; envp != NULL && envp[n] != NULL; n++)
+		;
+
+	pthread_mutex_lock(&env_lock);
+	env_var_update();
+	if (env_var.buf == NULL) {
+		pthread_mutex_unlock(&env_lock);
+		return NULL;
+	}
+
+	size = sizeof(size_t) + (n + 2) * sizeof(char *) + env_var.len + 1;
+	block = mmap(NULL, size, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (block == MAP_FAILED) {
+		pthread_mutex_unlock(&env_lock);
+		return NULL;
+	}
+
+	*block = size;
+	env = (char **) (block + 1);
+	p = (char *) (env + n + 2);
+	memcpy(p, env_var.buf, env_var.len + 1);
+	pthread_mutex_unlock(&env_lock);
+
+	for (i = 0, k = 0; i < n; i++) {
+		if (strncmp(envp[i], var, sizeof(var) - 1) != 0)
+			env[k++] = envp[i];
+	}
+
+	env[k++] = p;
+	env[k] = NULL;
+	return env;
+}
+
+/* Releases an environment returned by exec_env(), if any. */
+static void env_free(char **env)
+{
+	size_t *block;
+
+	if (env == NULL)
+		return;
+
+	block = (size_t *) env - 1;
+	munmap(block, *block);
+}
+
+/* Generates the part of the exec wrappers' body that checks the point of
+ * failure and, if it doesn't fail, builds the new environment from ENVP
+ * into _fiu_env (see exec_env()). The rest of the parameters are the
+ * arguments, for the predicates. */
+#define mkwrap_body_exec(FIRST, ENVP, ...)			\
+								\
+		char **_fiu_env = NULL;				\
+								\
+		if (mkwrap_watched(0, 0x1ULL)) {		\
+			mkwrap_body_path(FIRST)			\
+			mkwrap_body_args(__VA_ARGS__)		\
+			mkwrap_body_errno(0 /* posix/proc/exec */, -1) \
+		}						\
+								\
+		_fiu_env = exec_env(ENVP);
+
+
+mkwrap_top(int, execve,
+		(const char *pathname, char *const argv[], char *const envp[]),
+		(pathname, argv, envp),
+		(const char *, char *const *, char *const *), -1)
+mkwrap_body_exec(pathname, envp,
+		(intptr_t) pathname, (intptr_t) argv, (intptr_t) envp)
+
+	if (_fiu_env != NULL)
+		envp = _fiu_env;
+
+mkwrap_bottom_after(execve, (pathname, argv, envp), env_free(_fiu_env);)
+
+
+#ifdef __GLIBC__
+mkwrap_top(int, execvpe,
+		(const char *file, char *const argv[], char *const envp[]),
+		(file, argv, envp),
+		(const char *, char *const *, char *const *), -1)
+mkwrap_body_exec(file, envp,
+		(intptr_t) file, (intptr_t) argv, (intptr_t) envp)
+
+	if (_fiu_env != NULL)
+		envp = _fiu_env;
+
+mkwrap_bottom_after(execvpe, (file, argv, envp), env_free(_fiu_env);)
+#endif
+
+
+/* The ones that take the environment from environ. Instead of changing it
+ * (which other threads could be using), when there is a new environment
+ * they call the original ENVNAME, their counterpart that takes it as the
+ * last parameter. */
+#define mkwrap_exec_environ(NAME, PARAMS, PARAMSN, PARAMST, FIRST,	\
+		ENVNAME, ENVPARAMSN)					\
+	mkwrap_top(int, NAME, PARAMS, PARAMSN, PARAMST, -1)		\
+	mkwrap_body_exec(FIRST, environ, (intptr_t) FIRST, (intptr_t) argv) \
+								\
+		if (_fiu_env != NULL) {				\
+			if (mkwrap_orig(ENVNAME) == NULL)	\
+				_fiu_init_##ENVNAME();		\
+								\
+			r = (*mkwrap_orig(ENVNAME)) ENVPARAMSN;	\
+			goto exit;				\
+		}						\
+								\
+	mkwrap_bottom_after(NAME, PARAMSN, env_free(_fiu_env);)
+
+mkwrap_exec_environ(execv, (const char *pathname, char *const argv[]),
+		(pathname, argv), (const char *, char *const *), pathname,
+		execve, (pathname, argv, _fiu_env))
+
+/* Without execvpe() there's nothing to pass the new environment to, so the
+ * points of failure are not inherited through execvp(). */
+#ifdef __GLIBC__
+mkwrap_exec_environ(execvp, (const char *file, char *const argv[]),
+		(file, argv), (const char *, char *const *), file,
+		execvpe, (file, argv, _fiu_env))
+#else
+mkwrap_top(int, execvp, (const char *file, char *const argv[]),
+		(file, argv), (const char *, char *const *), -1)
+mkwrap_body_gate(execvp, (file, argv), 0, 0x1ULL)
+mkwrap_body_path(file)
+mkwrap_body_args((intptr_t) file, (intptr_t) argv)
+mkwrap_body_errno(0 /* posix/proc/exec */, -1)
+mkwrap_bottom(execvp, (file, argv))
+#endif
@@ -14,11 +14,20 @@ include: <errno.h>
 
 fiu name base: posix/io/oc/
 
-# open() has its own custom wrapper
+# open() and close() have their own custom wrappers, as they keep track of
+# the file descriptors' paths (see codegen.c); dup() and dup2() copy them.
 
-int close(int fd);
+int dup(int oldfd);
 	on error: -1
-	valid errnos: EBADFD EINTR EIO
+	valid errnos: EBADF EMFILE
+	fd path: oldfd
+	after: if (r >= 0) fd_path_copy(oldfd, r);
+
+int dup2(int oldfd, int newfd);
+	on error: -1
+	valid errnos: EBADF EBUSY EINTR EMFILE
+	fd path: oldfd
+	after: if (r >= 0) fd_path_copy(oldfd, r);
 
 
 fiu name base: posix/io/sync/
@@ -26,10 +35,12 @@ fiu name base: posix/io/sync/
 int fsync(int fd);
 	on error: -1
 	valid errnos: EBADFD EIO EROFS EINVAL
+	fd path: fd
 
 int fdatasync(int fd);
 	on error: -1
 	valid errnos: EBADFD EIO EROFS EINVAL
+	fd path: fd
 
 
 fiu name base: posix/io/rw/
@@ -38,22 +49,26 @@ ssize_t read(int fd, void *buf, size_t count);
 	on error: -1
 	valid errnos: EBADFD EFAULT EINTR EINVAL EIO EISDIR
 	reduce: count
+	fd path: fd
 
 ssize_t pread(int fd, void *buf, size_t count, off_t offset);
 	on error: -1
 	valid errnos: EBADFD EFAULT EINTR EINVAL EIO EISDIR EOVERFLOW ENXIO
 	reduce: count
+	fd path: fd
 	variants: off64_t
 
 ssize_t readv(int fd, const struct iovec *iov, int iovcnt);
 	on error: -1
 	valid errnos: EBADFD EFAULT EINTR EINVAL EIO EISDIR
-	reduce: iovcnt
+	reduce iov: iov iovcnt
+	fd path: fd
 
 ssize_t preadv(int fd, const struct iovec *iov, int iovcnt, off_t offset);
 	on error: -1
 	valid errnos: EBADFD EFAULT EINTR EINVAL EIO EISDIR EOVERFLOW ENXIO
-	reduce: iovcnt
+	reduce iov: iov iovcnt
+	fd path: fd
 	variants: off64_t
 
 
@@ -61,24 +76,28 @@ ssize_t write(int fd, const void *buf, size_t count);
 	on error: -1
 	valid errnos: EBADFD EDQUOT EFAULT EFBIG EINTR EINVAL EIO ENOSPC
 	reduce: count
+	fd path: fd
 
 ssize_t pwrite(int fd, const void *buf, size_t count, off_t offset);
 	on error: -1
 	valid errnos: EBADFD EDQUOT EFAULT EFBIG EINTR EINVAL EIO ENOSPC \
 		EOVERFLOW ENXIO
 	reduce: count
+	fd path: fd
 	variants: off64_t
 
 ssize_t writev(int fd, const struct iovec *iov, int iovcnt);
 	on error: -1
 	valid errnos: EBADFD EDQUOT EFAULT EFBIG EINTR EINVAL EIO ENOSPC
-	reduce: iovcnt
+	reduce iov: iov iovcnt
+	fd path: fd
 
 ssize_t pwritev(int fd, const struct iovec *iov, int iovcnt, off_t offset);
 	on error: -1
 	valid errnos: EBADFD EDQUOT EFAULT EFBIG EINTR EINVAL EIO ENOSPC \
 		EOVERFLOW ENXIO
-	reduce: iovcnt
+	reduce iov: iov iovcnt
+	fd path: fd
 	variants: off64_t
 
 
@@ -86,12 +105,14 @@ int truncate(const char *path, off_t length);
 	on error: -1
 	valid errnos: EACCES EFAULT EFBIG EINTR EINVAL EIO EISDIR ELOOP \
 		ENAMETOOLONG ENOENT ENOTDIR EPERM EROFS ETXTBSY
+	path: path
 	variants: off64_t
 
 int ftruncate(int fd, off_t length);
 	on error: -1
 	valid errnos: EACCES EBADF EFAULT EFBIG EINTR EINVAL EIO EISDIR ELOOP \
 		ENAMETOOLONG ENOENT ENOTDIR EPERM EROFS ETXTBSY
+	fd path: fd
 	variants: off64_t
 
 
@@ -102,10 +123,12 @@ include: <dirent.h>
 DIR *opendir(const char *name);
 	on error: NULL
 	valid errnos: EACCES EBADF EMFILE ENFILE ENOENT ENOMEM ENOTDIR
+	path: name
 
 DIR *fdopendir(int fd);
 	on error: NULL
 	valid errnos: EACCES EBADF EMFILE ENFILE ENOENT ENOMEM ENOTDIR
+	fd path: fd
 
 struct dirent *readdir(DIR *dirp);
 	on error: NULL
@@ -119,14 +142,16 @@ int closedir(DIR *dirp);
 	valid errnos: EBADF
 
 int unlink(const char *pathname);
-        on error: -1
+	on error: -1
 	valid errnos: EACCES EBUSY EFAULT EIO EISDIR ELOOP ENAMETOOLONG ENOENT \
 		ENOMEM ENOTDIR EPERM EROFS
+	path: pathname
 
 int rename(const char *oldpath, const char *newpath);
 	on error: -1
 	valid errnos: EACCES EBUSY EFAULT EINVAL EISDIR ELOOP EMLINK ENAMETOOLONG \
 		ENOENT ENOMEM ENOSPC ENOTDIR ENOTEMPTY EPERM EROFS EXDEV
+	path: oldpath
 
 
 # NOTE: These are commented because stat() and friends are usually defined as
@@ -163,9 +188,15 @@ int socket(int domain, int type, int protocol);
 	on error: -1
 	valid errnos: EAFNOSUPPORT EMFILE ENFILE EPROTONOSUPPORT EPROTOTYPE \
 		EACCES ENOBUFS ENOMEM
+	after: if (r >= 0) fd_path_set(r, NULL);
 
+# The address family is given as an extra argument (arg4), for the predicates
+# (see fiu_set_predicate()); -1 if there is no address. It is only read when
+# the predicate looks at it, so otherwise a bad pointer still fails with
+# EFAULT instead of crashing here.
 int bind(int socket, const struct sockaddr *address, socklen_t address_len);
 	on error: -1
+	arg: address != NULL ? address->sa_family : -1
 	valid errnos: EADDRINUSE EADDRNOTAVAIL EAFNOSUPPORT EBADF EINVAL ENOTSOCK \
 		EOPNOTSUPP EACCES EDESTADDRREQ EIO ELOOP ENAMETOOLONG ENOENT \
 		ENOTDIR EROFS EACCES EINVAL EISCONN ELOOP ENAMETOOLONG \
@@ -180,9 +211,13 @@ int accept(int socket, struct sockaddr *restrict address, socklen_t *restrict ad
 	on error: -1
 	valid errnos:  EAGAIN EBADF ECONNABORTED EINTR EINVAL EMFILE ENFILE \
 		ENOTSOCK EOPNOTSUPP ENOBUFS ENOMEM EPROTO
+	spurious: -1 EAGAIN
+	after: if (r >= 0) fd_path_set(r, NULL);
 
+# Like bind(), arg4 is the address family.
 int connect(int socket, const struct sockaddr *address, socklen_t address_len);
 	on error: -1
+	arg: address != NULL ? address->sa_family : -1
 	valid errnos:  EADDRNOTAVAIL EAFNOSUPPORT EALREADY EBADF ECONNREFUSED \
 		EINPROGRESS EINTR EISCONN ENETUNREACH ENOTSOCK EPROTOTYPE \
 		ETIMEDOUT EIO ELOOP ENAMETOOLONG ENOENT ENOTDIR EACCES \
@@ -193,16 +228,19 @@ ssize_t recv(int socket, void *buffer, size_t length, int flags);
 	on error: -1
 	valid errnos:  EAGAIN EBADF ECONNRESET EINTR EINVAL ENOTCONN ENOTSOCK \
 		EOPNOTSUPP ETIMEDOUT EIO ENOBUFS ENOMEM
+	spurious: -1 EAGAIN
 
 ssize_t recvfrom(int socket, void *restrict buffer, size_t length, int flags, struct sockaddr *restrict address, socklen_t *restrict address_len);
 	on error: -1
 	valid errnos:  EAGAIN EBADF ECONNRESET EINTR EINVAL ENOTCONN ENOTSOCK \
 		EOPNOTSUPP ETIMEDOUT EIO ENOBUFS ENOMEM
+	spurious: -1 EAGAIN
 
 ssize_t recvmsg(int socket, struct msghdr *message, int flags);
 	on error: -1
 	valid errnos:  EAGAIN EBADF ECONNRESET EINTR EINVAL EMSGSIZE ENOTCONN \
 		ENOTSOCK EOPNOTSUPP ETIMEDOUT EIO ENOBUFS ENOMEM
+	spurious: -1 EAGAIN
 
 ssize_t send(int socket, const void *buffer, size_t length, int flags);
 	on error: -1
@@ -210,8 +248,10 @@ ssize_t send(int socket, const void *buffer, size_t length, int flags);
 		ENOTCONN ENOTSOCK EOPNOTSUPP EPIPE EACCES EIO ENETDOWN \
 		ENETUNREACH ENOBUFS
 
+# And arg7 here.
 ssize_t sendto(int socket, const void *message, size_t length, int flags, const struct sockaddr *dest_addr, socklen_t dest_len);
 	on error: -1
+	arg: dest_addr != NULL ? dest_addr->sa_family : -1
 	valid errnos:  EAFNOSUPPORT EAGAIN EBADF ECONNRESET EINTR EMSGSIZE \
 		ENOTCONN ENOTSOCK EOPNOTSUPP EPIPE EIO ELOOP ENAMETOOLONG \
 		ENOENT ENOTDIR EACCES EDESTADDRREQ EHOSTUNREACH EINVAL EIO \
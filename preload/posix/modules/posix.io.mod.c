@@ -0,0 +1,1944 @@
+
+/*
+ * AUTOGENERATED FILE - DO NOT EDIT
+ *
+ * This file was automatically generated by libfiu, do not edit it directly,
+ * but see libfiu's "preload" directory.
+ */
+
+#include "codegen.h"
+
+static const char *const _fiu_watch_names[] = {
+	/*  0 */ "posix/io/oc/dup",
+	/*  1 */ "posix/io/oc/dup2",
+	/*  2 */ "posix/io/sync/fsync",
+	/*  3 */ "posix/io/sync/fdatasync",
+	/*  4 */ "posix/io/rw/read",
+	/*  5 */ "posix/io/rw/read/reduce",
+	/*  6 */ "posix/io/rw/pread",
+	/*  7 */ "posix/io/rw/pread/reduce",
+	/*  8 */ "posix/io/rw/readv",
+	/*  9 */ "posix/io/rw/readv/reduce",
+	/* 10 */ "posix/io/rw/preadv",
+	/* 11 */ "posix/io/rw/preadv/reduce",
+	/* 12 */ "posix/io/rw/write",
+	/* 13 */ "posix/io/rw/write/reduce",
+	/* 14 */ "posix/io/rw/pwrite",
+	/* 15 */ "posix/io/rw/pwrite/reduce",
+	/* 16 */ "posix/io/rw/writev",
+	/* 17 */ "posix/io/rw/writev/reduce",
+	/* 18 */ "posix/io/rw/pwritev",
+	/* 19 */ "posix/io/rw/pwritev/reduce",
+	/* 20 */ "posix/io/rw/truncate",
+	/* 21 */ "posix/io/rw/ftruncate",
+	/* 22 */ "posix/io/dir/opendir",
+	/* 23 */ "posix/io/dir/fdopendir",
+	/* 24 */ "posix/io/dir/readdir",
+	/* 25 */ "posix/io/dir/readdir_r",
+	/* 26 */ "posix/io/dir/closedir",
+	/* 27 */ "posix/io/dir/unlink",
+	/* 28 */ "posix/io/dir/rename",
+	/* 29 */ "posix/io/net/socket",
+	/* 30 */ "posix/io/net/bind",
+	/* 31 */ "posix/io/net/listen",
+	/* 32 */ "posix/io/net/accept",
+	/* 33 */ "posix/io/net/accept/spurious",
+	/* 34 */ "posix/io/net/connect",
+	/* 35 */ "posix/io/net/recv",
+	/* 36 */ "posix/io/net/recv/spurious",
+	/* 37 */ "posix/io/net/recvfrom",
+	/* 38 */ "posix/io/net/recvfrom/spurious",
+	/* 39 */ "posix/io/net/recvmsg",
+	/* 40 */ "posix/io/net/recvmsg/spurious",
+	/* 41 */ "posix/io/net/send",
+	/* 42 */ "posix/io/net/sendto",
+	/* 43 */ "posix/io/net/sendmsg",
+	/* 44 */ "posix/io/net/shutdown",
+	/* 45 */ "posix/io/net/select",
+	/* 46 */ "posix/io/net/pselect",
+	/* 47 */ "posix/io/net/poll",
+};
+mkwrap_watch()
+
+mkwrap_catalog(
+	"posix/io/oc/dup\0"
+	"posix/io/oc/dup2\0"
+	"posix/io/sync/fsync\0"
+	"posix/io/sync/fdatasync\0"
+	"posix/io/rw/read\0"
+	"posix/io/rw/read/reduce\0"
+	"posix/io/rw/pread\0"
+	"posix/io/rw/pread/reduce\0"
+	"posix/io/rw/readv\0"
+	"posix/io/rw/readv/reduce\0"
+	"posix/io/rw/preadv\0"
+	"posix/io/rw/preadv/reduce\0"
+	"posix/io/rw/write\0"
+	"posix/io/rw/write/reduce\0"
+	"posix/io/rw/pwrite\0"
+	"posix/io/rw/pwrite/reduce\0"
+	"posix/io/rw/writev\0"
+	"posix/io/rw/writev/reduce\0"
+	"posix/io/rw/pwritev\0"
+	"posix/io/rw/pwritev/reduce\0"
+	"posix/io/rw/truncate\0"
+	"posix/io/rw/ftruncate\0"
+	"posix/io/dir/opendir\0"
+	"posix/io/dir/fdopendir\0"
+	"posix/io/dir/readdir\0"
+	"posix/io/dir/readdir_r\0"
+	"posix/io/dir/closedir\0"
+	"posix/io/dir/unlink\0"
+	"posix/io/dir/rename\0"
+	"posix/io/net/socket\0"
+	"posix/io/net/bind\0"
+	"posix/io/net/listen\0"
+	"posix/io/net/accept\0"
+	"posix/io/net/accept/spurious\0"
+	"posix/io/net/connect\0"
+	"posix/io/net/recv\0"
+	"posix/io/net/recv/spurious\0"
+	"posix/io/net/recvfrom\0"
+	"posix/io/net/recvfrom/spurious\0"
+	"posix/io/net/recvmsg\0"
+	"posix/io/net/recvmsg/spurious\0"
+	"posix/io/net/send\0"
+	"posix/io/net/sendto\0"
+	"posix/io/net/sendmsg\0"
+	"posix/io/net/shutdown\0"
+	"posix/io/net/select\0"
+	"posix/io/net/pselect\0"
+	"posix/io/net/poll\0"
+)
+
+
+// Posix I/O 
+
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/select.h>
+#include <poll.h>
+#include <fcntl.h>
+#include <errno.h>
+
+
+
+// open() and close() have their own custom wrappers, as they keep track of 
+// the file descriptors' paths (see codegen.c); dup() and dup2() copy them. 
+
+
+/* Wrapper for dup() */
+mkwrap_top(int , dup, (int oldfd), (oldfd), (int ), (-1))
+mkwrap_body_gate(dup, (oldfd), 0, 0x1ULL)
+mkwrap_body_path(fd_path(oldfd))
+mkwrap_body_args(oldfd)
+	static const int valid_errnos[] = {
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EMFILE
+		EMFILE,
+	  #endif
+	};
+mkwrap_body_errno(0 /* posix/io/oc/dup */, -1)
+mkwrap_bottom_after(dup, (oldfd), if (r >= 0) fd_path_copy(oldfd, r);)
+
+
+
+
+/* Wrapper for dup2() */
+mkwrap_top(int , dup2, (int oldfd, int newfd), (oldfd, newfd), (int , int ), (-1))
+mkwrap_body_gate(dup2, (oldfd, newfd), 0, 0x2ULL)
+mkwrap_body_path(fd_path(oldfd))
+mkwrap_body_args(oldfd, newfd)
+	static const int valid_errnos[] = {
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EBUSY
+		EBUSY,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EMFILE
+		EMFILE,
+	  #endif
+	};
+mkwrap_body_errno(1 /* posix/io/oc/dup2 */, -1)
+mkwrap_bottom_after(dup2, (oldfd, newfd), if (r >= 0) fd_path_copy(oldfd, r);)
+
+
+
+
+/* Wrapper for fsync() */
+mkwrap_top(int , fsync, (int fd), (fd), (int ), (-1))
+mkwrap_body_gate(fsync, (fd), 0, 0x4ULL)
+mkwrap_body_path(fd_path(fd))
+mkwrap_body_args(fd)
+	static const int valid_errnos[] = {
+	  #ifdef EBADFD
+		EBADFD,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef EROFS
+		EROFS,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	};
+mkwrap_body_errno(2 /* posix/io/sync/fsync */, -1)
+mkwrap_bottom(fsync, (fd))
+
+
+
+
+/* Wrapper for fdatasync() */
+mkwrap_top(int , fdatasync, (int fd), (fd), (int ), (-1))
+mkwrap_body_gate(fdatasync, (fd), 0, 0x8ULL)
+mkwrap_body_path(fd_path(fd))
+mkwrap_body_args(fd)
+	static const int valid_errnos[] = {
+	  #ifdef EBADFD
+		EBADFD,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef EROFS
+		EROFS,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	};
+mkwrap_body_errno(3 /* posix/io/sync/fdatasync */, -1)
+mkwrap_bottom(fdatasync, (fd))
+
+
+
+
+/* Wrapper for read() */
+mkwrap_top(ssize_t , read, (int fd, void *buf, size_t count), (fd, buf, count), (int , void *, size_t ), (-1))
+mkwrap_body_gate(read, (fd, buf, count), 0, 0x30ULL)
+mkwrap_body_path(fd_path(fd))
+mkwrap_body_args(fd, (intptr_t) buf, count)
+mkwrap_body_reduce(5 /* posix/io/rw/read/reduce */, count)
+	static const int valid_errnos[] = {
+	  #ifdef EBADFD
+		EBADFD,
+	  #endif
+	  #ifdef EFAULT
+		EFAULT,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef EISDIR
+		EISDIR,
+	  #endif
+	};
+mkwrap_body_errno(4 /* posix/io/rw/read */, -1)
+mkwrap_bottom(read, (fd, buf, count))
+
+
+
+/* Wrapper for pread() */
+mkwrap_top(ssize_t , pread, (int fd, void *buf, size_t count, off_t offset), (fd, buf, count, offset), (int , void *, size_t , off_t ), (-1))
+mkwrap_body_gate(pread, (fd, buf, count, offset), 0, 0xc0ULL)
+mkwrap_body_path(fd_path(fd))
+mkwrap_body_args(fd, (intptr_t) buf, count, offset)
+mkwrap_body_reduce(7 /* posix/io/rw/pread/reduce */, count)
+	static const int valid_errnos[] = {
+	  #ifdef EBADFD
+		EBADFD,
+	  #endif
+	  #ifdef EFAULT
+		EFAULT,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef EISDIR
+		EISDIR,
+	  #endif
+	  #ifdef EOVERFLOW
+		EOVERFLOW,
+	  #endif
+	  #ifdef ENXIO
+		ENXIO,
+	  #endif
+	};
+mkwrap_body_errno(6 /* posix/io/rw/pread */, -1)
+mkwrap_bottom(pread, (fd, buf, count, offset))
+
+
+#ifdef __GLIBC__
+#if LIBFIU_CAN_DEFINE_64BIT_FUNCTIONS
+/* Wrapper for pread64() */
+mkwrap_top(ssize_t , pread64, (int fd, void *buf, size_t count, off64_t offset), (fd, buf, count, offset), (int , void *, size_t , off64_t ), (-1))
+mkwrap_body_gate(pread64, (fd, buf, count, offset), 0, 0xc0ULL)
+mkwrap_body_path(fd_path(fd))
+mkwrap_body_args(fd, (intptr_t) buf, count, offset)
+mkwrap_body_reduce(7 /* posix/io/rw/pread/reduce */, count)
+	static const int valid_errnos[] = {
+	  #ifdef EBADFD
+		EBADFD,
+	  #endif
+	  #ifdef EFAULT
+		EFAULT,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef EISDIR
+		EISDIR,
+	  #endif
+	  #ifdef EOVERFLOW
+		EOVERFLOW,
+	  #endif
+	  #ifdef ENXIO
+		ENXIO,
+	  #endif
+	};
+mkwrap_body_errno(6 /* posix/io/rw/pread */, -1)
+mkwrap_bottom(pread64, (fd, buf, count, offset))
+
+
+#endif  // LIBFIU_CAN_DEFINE_64BIT_FUNCTIONS
+#endif  // __GLIBC__
+
+/* Wrapper for readv() */
+mkwrap_top(ssize_t , readv, (int fd, const struct iovec *iov, int iovcnt), (fd, iov, iovcnt), (int , const struct iovec *, int ), (-1))
+mkwrap_body_gate(readv, (fd, iov, iovcnt), 0, 0x300ULL)
+mkwrap_body_path(fd_path(fd))
+mkwrap_body_args(fd, (intptr_t) iov, iovcnt)
+mkwrap_body_reduce_iov(9 /* posix/io/rw/readv/reduce */, iov, iovcnt)
+	static const int valid_errnos[] = {
+	  #ifdef EBADFD
+		EBADFD,
+	  #endif
+	  #ifdef EFAULT
+		EFAULT,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef EISDIR
+		EISDIR,
+	  #endif
+	};
+mkwrap_body_errno(8 /* posix/io/rw/readv */, -1)
+mkwrap_bottom(readv, (fd, iov, iovcnt))
+
+
+
+
+/* Wrapper for preadv() */
+mkwrap_top(ssize_t , preadv, (int fd, const struct iovec *iov, int iovcnt, off_t offset), (fd, iov, iovcnt, offset), (int , const struct iovec *, int , off_t ), (-1))
+mkwrap_body_gate(preadv, (fd, iov, iovcnt, offset), 0, 0xc00ULL)
+mkwrap_body_path(fd_path(fd))
+mkwrap_body_args(fd, (intptr_t) iov, iovcnt, offset)
+mkwrap_body_reduce_iov(11 /* posix/io/rw/preadv/reduce */, iov, iovcnt)
+	static const int valid_errnos[] = {
+	  #ifdef EBADFD
+		EBADFD,
+	  #endif
+	  #ifdef EFAULT
+		EFAULT,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef EISDIR
+		EISDIR,
+	  #endif
+	  #ifdef EOVERFLOW
+		EOVERFLOW,
+	  #endif
+	  #ifdef ENXIO
+		ENXIO,
+	  #endif
+	};
+mkwrap_body_errno(10 /* posix/io/rw/preadv */, -1)
+mkwrap_bottom(preadv, (fd, iov, iovcnt, offset))
+
+
+#ifdef __GLIBC__
+#if LIBFIU_CAN_DEFINE_64BIT_FUNCTIONS
+/* Wrapper for preadv64() */
+mkwrap_top(ssize_t , preadv64, (int fd, const struct iovec *iov, int iovcnt, off64_t offset), (fd, iov, iovcnt, offset), (int , const struct iovec *, int , off64_t ), (-1))
+mkwrap_body_gate(preadv64, (fd, iov, iovcnt, offset), 0, 0xc00ULL)
+mkwrap_body_path(fd_path(fd))
+mkwrap_body_args(fd, (intptr_t) iov, iovcnt, offset)
+mkwrap_body_reduce_iov(11 /* posix/io/rw/preadv/reduce */, iov, iovcnt)
+	static const int valid_errnos[] = {
+	  #ifdef EBADFD
+		EBADFD,
+	  #endif
+	  #ifdef EFAULT
+		EFAULT,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef EISDIR
+		EISDIR,
+	  #endif
+	  #ifdef EOVERFLOW
+		EOVERFLOW,
+	  #endif
+	  #ifdef ENXIO
+		ENXIO,
+	  #endif
+	};
+mkwrap_body_errno(10 /* posix/io/rw/preadv */, -1)
+mkwrap_bottom(preadv64, (fd, iov, iovcnt, offset))
+
+
+#endif  // LIBFIU_CAN_DEFINE_64BIT_FUNCTIONS
+#endif  // __GLIBC__
+
+/* Wrapper for write() */
+mkwrap_top(ssize_t , write, (int fd, const void *buf, size_t count), (fd, buf, count), (int , const void *, size_t ), (-1))
+mkwrap_body_gate(write, (fd, buf, count), 0, 0x3000ULL)
+mkwrap_body_path(fd_path(fd))
+mkwrap_body_args(fd, (intptr_t) buf, count)
+mkwrap_body_reduce(13 /* posix/io/rw/write/reduce */, count)
+	static const int valid_errnos[] = {
+	  #ifdef EBADFD
+		EBADFD,
+	  #endif
+	  #ifdef EDQUOT
+		EDQUOT,
+	  #endif
+	  #ifdef EFAULT
+		EFAULT,
+	  #endif
+	  #ifdef EFBIG
+		EFBIG,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ENOSPC
+		ENOSPC,
+	  #endif
+	};
+mkwrap_body_errno(12 /* posix/io/rw/write */, -1)
+mkwrap_bottom(write, (fd, buf, count))
+
+
+
+/* Wrapper for pwrite() */
+mkwrap_top(ssize_t , pwrite, (int fd, const void *buf, size_t count, off_t offset), (fd, buf, count, offset), (int , const void *, size_t , off_t ), (-1))
+mkwrap_body_gate(pwrite, (fd, buf, count, offset), 0, 0xc000ULL)
+mkwrap_body_path(fd_path(fd))
+mkwrap_body_args(fd, (intptr_t) buf, count, offset)
+mkwrap_body_reduce(15 /* posix/io/rw/pwrite/reduce */, count)
+	static const int valid_errnos[] = {
+	  #ifdef EBADFD
+		EBADFD,
+	  #endif
+	  #ifdef EDQUOT
+		EDQUOT,
+	  #endif
+	  #ifdef EFAULT
+		EFAULT,
+	  #endif
+	  #ifdef EFBIG
+		EFBIG,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ENOSPC
+		ENOSPC,
+	  #endif
+	  #ifdef EOVERFLOW
+		EOVERFLOW,
+	  #endif
+	  #ifdef ENXIO
+		ENXIO,
+	  #endif
+	};
+mkwrap_body_errno(14 /* posix/io/rw/pwrite */, -1)
+mkwrap_bottom(pwrite, (fd, buf, count, offset))
+
+
+#ifdef __GLIBC__
+#if LIBFIU_CAN_DEFINE_64BIT_FUNCTIONS
+/* Wrapper for pwrite64() */
+mkwrap_top(ssize_t , pwrite64, (int fd, const void *buf, size_t count, off64_t offset), (fd, buf, count, offset), (int , const void *, size_t , off64_t ), (-1))
+mkwrap_body_gate(pwrite64, (fd, buf, count, offset), 0, 0xc000ULL)
+mkwrap_body_path(fd_path(fd))
+mkwrap_body_args(fd, (intptr_t) buf, count, offset)
+mkwrap_body_reduce(15 /* posix/io/rw/pwrite/reduce */, count)
+	static const int valid_errnos[] = {
+	  #ifdef EBADFD
+		EBADFD,
+	  #endif
+	  #ifdef EDQUOT
+		EDQUOT,
+	  #endif
+	  #ifdef EFAULT
+		EFAULT,
+	  #endif
+	  #ifdef EFBIG
+		EFBIG,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ENOSPC
+		ENOSPC,
+	  #endif
+	  #ifdef EOVERFLOW
+		EOVERFLOW,
+	  #endif
+	  #ifdef ENXIO
+		ENXIO,
+	  #endif
+	};
+mkwrap_body_errno(14 /* posix/io/rw/pwrite */, -1)
+mkwrap_bottom(pwrite64, (fd, buf, count, offset))
+
+
+#endif  // LIBFIU_CAN_DEFINE_64BIT_FUNCTIONS
+#endif  // __GLIBC__
+
+/* Wrapper for writev() */
+mkwrap_top(ssize_t , writev, (int fd, const struct iovec *iov, int iovcnt), (fd, iov, iovcnt), (int , const struct iovec *, int ), (-1))
+mkwrap_body_gate(writev, (fd, iov, iovcnt), 0, 0x30000ULL)
+mkwrap_body_path(fd_path(fd))
+mkwrap_body_args(fd, (intptr_t) iov, iovcnt)
+mkwrap_body_reduce_iov(17 /* posix/io/rw/writev/reduce */, iov, iovcnt)
+	static const int valid_errnos[] = {
+	  #ifdef EBADFD
+		EBADFD,
+	  #endif
+	  #ifdef EDQUOT
+		EDQUOT,
+	  #endif
+	  #ifdef EFAULT
+		EFAULT,
+	  #endif
+	  #ifdef EFBIG
+		EFBIG,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ENOSPC
+		ENOSPC,
+	  #endif
+	};
+mkwrap_body_errno(16 /* posix/io/rw/writev */, -1)
+mkwrap_bottom(writev, (fd, iov, iovcnt))
+
+
+
+
+/* Wrapper for pwritev() */
+mkwrap_top(ssize_t , pwritev, (int fd, const struct iovec *iov, int iovcnt, off_t offset), (fd, iov, iovcnt, offset), (int , const struct iovec *, int , off_t ), (-1))
+mkwrap_body_gate(pwritev, (fd, iov, iovcnt, offset), 0, 0xc0000ULL)
+mkwrap_body_path(fd_path(fd))
+mkwrap_body_args(fd, (intptr_t) iov, iovcnt, offset)
+mkwrap_body_reduce_iov(19 /* posix/io/rw/pwritev/reduce */, iov, iovcnt)
+	static const int valid_errnos[] = {
+	  #ifdef EBADFD
+		EBADFD,
+	  #endif
+	  #ifdef EDQUOT
+		EDQUOT,
+	  #endif
+	  #ifdef EFAULT
+		EFAULT,
+	  #endif
+	  #ifdef EFBIG
+		EFBIG,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ENOSPC
+		ENOSPC,
+	  #endif
+	  #ifdef EOVERFLOW
+		EOVERFLOW,
+	  #endif
+	  #ifdef ENXIO
+		ENXIO,
+	  #endif
+	};
+mkwrap_body_errno(18 /* posix/io/rw/pwritev */, -1)
+mkwrap_bottom(pwritev, (fd, iov, iovcnt, offset))
+
+
+#ifdef __GLIBC__
+#if LIBFIU_CAN_DEFINE_64BIT_FUNCTIONS
+/* Wrapper for pwritev64() */
+mkwrap_top(ssize_t , pwritev64, (int fd, const struct iovec *iov, int iovcnt, off64_t offset), (fd, iov, iovcnt, offset), (int , const struct iovec *, int , off64_t ), (-1))
+mkwrap_body_gate(pwritev64, (fd, iov, iovcnt, offset), 0, 0xc0000ULL)
+mkwrap_body_path(fd_path(fd))
+mkwrap_body_args(fd, (intptr_t) iov, iovcnt, offset)
+mkwrap_body_reduce_iov(19 /* posix/io/rw/pwritev/reduce */, iov, iovcnt)
+	static const int valid_errnos[] = {
+	  #ifdef EBADFD
+		EBADFD,
+	  #endif
+	  #ifdef EDQUOT
+		EDQUOT,
+	  #endif
+	  #ifdef EFAULT
+		EFAULT,
+	  #endif
+	  #ifdef EFBIG
+		EFBIG,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ENOSPC
+		ENOSPC,
+	  #endif
+	  #ifdef EOVERFLOW
+		EOVERFLOW,
+	  #endif
+	  #ifdef ENXIO
+		ENXIO,
+	  #endif
+	};
+mkwrap_body_errno(18 /* posix/io/rw/pwritev */, -1)
+mkwrap_bottom(pwritev64, (fd, iov, iovcnt, offset))
+
+
+#endif  // LIBFIU_CAN_DEFINE_64BIT_FUNCTIONS
+#endif  // __GLIBC__
+
+/* Wrapper for truncate() */
+mkwrap_top(int , truncate, (const char *path, off_t length), (path, length), (const char *, off_t ), (-1))
+mkwrap_body_gate(truncate, (path, length), 0, 0x100000ULL)
+mkwrap_body_path(path)
+mkwrap_body_args((intptr_t) path, length)
+	static const int valid_errnos[] = {
+	  #ifdef EACCES
+		EACCES,
+	  #endif
+	  #ifdef EFAULT
+		EFAULT,
+	  #endif
+	  #ifdef EFBIG
+		EFBIG,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef EISDIR
+		EISDIR,
+	  #endif
+	  #ifdef ELOOP
+		ELOOP,
+	  #endif
+	  #ifdef ENAMETOOLONG
+		ENAMETOOLONG,
+	  #endif
+	  #ifdef ENOENT
+		ENOENT,
+	  #endif
+	  #ifdef ENOTDIR
+		ENOTDIR,
+	  #endif
+	  #ifdef EPERM
+		EPERM,
+	  #endif
+	  #ifdef EROFS
+		EROFS,
+	  #endif
+	  #ifdef ETXTBSY
+		ETXTBSY,
+	  #endif
+	};
+mkwrap_body_errno(20 /* posix/io/rw/truncate */, -1)
+mkwrap_bottom(truncate, (path, length))
+
+
+#ifdef __GLIBC__
+#if LIBFIU_CAN_DEFINE_64BIT_FUNCTIONS
+/* Wrapper for truncate64() */
+mkwrap_top(int , truncate64, (const char *path, off64_t length), (path, length), (const char *, off64_t ), (-1))
+mkwrap_body_gate(truncate64, (path, length), 0, 0x100000ULL)
+mkwrap_body_path(path)
+mkwrap_body_args((intptr_t) path, length)
+	static const int valid_errnos[] = {
+	  #ifdef EACCES
+		EACCES,
+	  #endif
+	  #ifdef EFAULT
+		EFAULT,
+	  #endif
+	  #ifdef EFBIG
+		EFBIG,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef EISDIR
+		EISDIR,
+	  #endif
+	  #ifdef ELOOP
+		ELOOP,
+	  #endif
+	  #ifdef ENAMETOOLONG
+		ENAMETOOLONG,
+	  #endif
+	  #ifdef ENOENT
+		ENOENT,
+	  #endif
+	  #ifdef ENOTDIR
+		ENOTDIR,
+	  #endif
+	  #ifdef EPERM
+		EPERM,
+	  #endif
+	  #ifdef EROFS
+		EROFS,
+	  #endif
+	  #ifdef ETXTBSY
+		ETXTBSY,
+	  #endif
+	};
+mkwrap_body_errno(20 /* posix/io/rw/truncate */, -1)
+mkwrap_bottom(truncate64, (path, length))
+
+
+#endif  // LIBFIU_CAN_DEFINE_64BIT_FUNCTIONS
+#endif  // __GLIBC__
+
+
+/* Wrapper for ftruncate() */
+mkwrap_top(int , ftruncate, (int fd, off_t length), (fd, length), (int , off_t ), (-1))
+mkwrap_body_gate(ftruncate, (fd, length), 0, 0x200000ULL)
+mkwrap_body_path(fd_path(fd))
+mkwrap_body_args(fd, length)
+	static const int valid_errnos[] = {
+	  #ifdef EACCES
+		EACCES,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EFAULT
+		EFAULT,
+	  #endif
+	  #ifdef EFBIG
+		EFBIG,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef EISDIR
+		EISDIR,
+	  #endif
+	  #ifdef ELOOP
+		ELOOP,
+	  #endif
+	  #ifdef ENAMETOOLONG
+		ENAMETOOLONG,
+	  #endif
+	  #ifdef ENOENT
+		ENOENT,
+	  #endif
+	  #ifdef ENOTDIR
+		ENOTDIR,
+	  #endif
+	  #ifdef EPERM
+		EPERM,
+	  #endif
+	  #ifdef EROFS
+		EROFS,
+	  #endif
+	  #ifdef ETXTBSY
+		ETXTBSY,
+	  #endif
+	};
+mkwrap_body_errno(21 /* posix/io/rw/ftruncate */, -1)
+mkwrap_bottom(ftruncate, (fd, length))
+
+
+#ifdef __GLIBC__
+#if LIBFIU_CAN_DEFINE_64BIT_FUNCTIONS
+/* Wrapper for ftruncate64() */
+mkwrap_top(int , ftruncate64, (int fd, off64_t length), (fd, length), (int , off64_t ), (-1))
+mkwrap_body_gate(ftruncate64, (fd, length), 0, 0x200000ULL)
+mkwrap_body_path(fd_path(fd))
+mkwrap_body_args(fd, length)
+	static const int valid_errnos[] = {
+	  #ifdef EACCES
+		EACCES,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EFAULT
+		EFAULT,
+	  #endif
+	  #ifdef EFBIG
+		EFBIG,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef EISDIR
+		EISDIR,
+	  #endif
+	  #ifdef ELOOP
+		ELOOP,
+	  #endif
+	  #ifdef ENAMETOOLONG
+		ENAMETOOLONG,
+	  #endif
+	  #ifdef ENOENT
+		ENOENT,
+	  #endif
+	  #ifdef ENOTDIR
+		ENOTDIR,
+	  #endif
+	  #ifdef EPERM
+		EPERM,
+	  #endif
+	  #ifdef EROFS
+		EROFS,
+	  #endif
+	  #ifdef ETXTBSY
+		ETXTBSY,
+	  #endif
+	};
+mkwrap_body_errno(21 /* posix/io/rw/ftruncate */, -1)
+mkwrap_bottom(ftruncate64, (fd, length))
+
+
+#endif  // LIBFIU_CAN_DEFINE_64BIT_FUNCTIONS
+#endif  // __GLIBC__
+
+#include <dirent.h>
+
+
+/* Wrapper for opendir() */
+mkwrap_top(DIR *, opendir, (const char *name), (name), (const char *), (NULL))
+mkwrap_body_gate(opendir, (name), 0, 0x400000ULL)
+mkwrap_body_path(name)
+mkwrap_body_args((intptr_t) name)
+	static const int valid_errnos[] = {
+	  #ifdef EACCES
+		EACCES,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EMFILE
+		EMFILE,
+	  #endif
+	  #ifdef ENFILE
+		ENFILE,
+	  #endif
+	  #ifdef ENOENT
+		ENOENT,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef ENOTDIR
+		ENOTDIR,
+	  #endif
+	};
+mkwrap_body_errno(22 /* posix/io/dir/opendir */, NULL)
+mkwrap_bottom(opendir, (name))
+
+
+
+/* Wrapper for fdopendir() */
+mkwrap_top(DIR *, fdopendir, (int fd), (fd), (int ), (NULL))
+mkwrap_body_gate(fdopendir, (fd), 0, 0x800000ULL)
+mkwrap_body_path(fd_path(fd))
+mkwrap_body_args(fd)
+	static const int valid_errnos[] = {
+	  #ifdef EACCES
+		EACCES,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EMFILE
+		EMFILE,
+	  #endif
+	  #ifdef ENFILE
+		ENFILE,
+	  #endif
+	  #ifdef ENOENT
+		ENOENT,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef ENOTDIR
+		ENOTDIR,
+	  #endif
+	};
+mkwrap_body_errno(23 /* posix/io/dir/fdopendir */, NULL)
+mkwrap_bottom(fdopendir, (fd))
+
+
+
+/* Wrapper for readdir() */
+mkwrap_top(struct dirent *, readdir, (DIR *dirp), (dirp), (DIR *), (NULL))
+mkwrap_body_gate(readdir, (dirp), 0, 0x1000000ULL)
+mkwrap_body_args((intptr_t) dirp)
+	static const int valid_errnos[] = {
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	};
+mkwrap_body_errno(24 /* posix/io/dir/readdir */, NULL)
+mkwrap_bottom(readdir, (dirp))
+
+
+
+/* Wrapper for readdir_r() */
+mkwrap_top(int , readdir_r, (DIR *dirp, struct dirent *entry, struct dirent **result), (dirp, entry, result), (DIR *, struct dirent *, struct dirent **), (1))
+mkwrap_body_gate(readdir_r, (dirp, entry, result), 0, 0x2000000ULL)
+mkwrap_body_args((intptr_t) dirp, (intptr_t) entry, (intptr_t) result)
+mkwrap_body_hardcoded(25 /* posix/io/dir/readdir_r */, 1)
+mkwrap_bottom(readdir_r, (dirp, entry, result))
+
+
+
+/* Wrapper for closedir() */
+mkwrap_top(int , closedir, (DIR *dirp), (dirp), (DIR *), (-1))
+mkwrap_body_gate(closedir, (dirp), 0, 0x4000000ULL)
+mkwrap_body_args((intptr_t) dirp)
+	static const int valid_errnos[] = {
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	};
+mkwrap_body_errno(26 /* posix/io/dir/closedir */, -1)
+mkwrap_bottom(closedir, (dirp))
+
+
+
+/* Wrapper for unlink() */
+mkwrap_top(int , unlink, (const char *pathname), (pathname), (const char *), (-1))
+mkwrap_body_gate(unlink, (pathname), 0, 0x8000000ULL)
+mkwrap_body_path(pathname)
+mkwrap_body_args((intptr_t) pathname)
+	static const int valid_errnos[] = {
+	  #ifdef EACCES
+		EACCES,
+	  #endif
+	  #ifdef EBUSY
+		EBUSY,
+	  #endif
+	  #ifdef EFAULT
+		EFAULT,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef EISDIR
+		EISDIR,
+	  #endif
+	  #ifdef ELOOP
+		ELOOP,
+	  #endif
+	  #ifdef ENAMETOOLONG
+		ENAMETOOLONG,
+	  #endif
+	  #ifdef ENOENT
+		ENOENT,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef ENOTDIR
+		ENOTDIR,
+	  #endif
+	  #ifdef EPERM
+		EPERM,
+	  #endif
+	  #ifdef EROFS
+		EROFS,
+	  #endif
+	};
+mkwrap_body_errno(27 /* posix/io/dir/unlink */, -1)
+mkwrap_bottom(unlink, (pathname))
+
+
+
+
+// NOTE: These are commented because stat() and friends are usually defined as 
+// either macros or inline functions within one of the standard headers, which 
+// makes overriding them this way much harder. 
+//  
+// fiu name base: posix/io/stat/ 
+//  
+// v: #ifndef stat 
+// int stat(const char *path, struct stat *buf); 
+// on error: -1 
+// valid errnos: EACCES EBADF EFAULT ELOOP ENAMETOOLONG ENOENT ENOMEM #		ENOTDIR EOVERFLOW 
+// v: #endif 
+//  
+// v: #ifndef fstat 
+// int fstat(int fd, struct stat *buf); 
+// on error: -1 
+// valid errnos: EACCES EBADF EFAULT ELOOP ENAMETOOLONG ENOENT ENOMEM #		ENOTDIR EOVERFLOW 
+// v: #endif 
+//  
+// v: #ifndef lstat 
+// int lstat(const char *path, struct stat *buf); 
+// on error: -1 
+// valid errnos: EACCES EBADF EFAULT ELOOP ENAMETOOLONG ENOENT ENOMEM #		ENOTDIR EOVERFLOW 
+// v: #endif 
+
+
+/* Wrapper for rename() */
+mkwrap_top(int , rename, (const char *oldpath, const char *newpath), (oldpath, newpath), (const char *, const char *), (-1))
+mkwrap_body_gate(rename, (oldpath, newpath), 0, 0x10000000ULL)
+mkwrap_body_path(oldpath)
+mkwrap_body_args((intptr_t) oldpath, (intptr_t) newpath)
+	static const int valid_errnos[] = {
+	  #ifdef EACCES
+		EACCES,
+	  #endif
+	  #ifdef EBUSY
+		EBUSY,
+	  #endif
+	  #ifdef EFAULT
+		EFAULT,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef EISDIR
+		EISDIR,
+	  #endif
+	  #ifdef ELOOP
+		ELOOP,
+	  #endif
+	  #ifdef EMLINK
+		EMLINK,
+	  #endif
+	  #ifdef ENAMETOOLONG
+		ENAMETOOLONG,
+	  #endif
+	  #ifdef ENOENT
+		ENOENT,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef ENOSPC
+		ENOSPC,
+	  #endif
+	  #ifdef ENOTDIR
+		ENOTDIR,
+	  #endif
+	  #ifdef ENOTEMPTY
+		ENOTEMPTY,
+	  #endif
+	  #ifdef EPERM
+		EPERM,
+	  #endif
+	  #ifdef EROFS
+		EROFS,
+	  #endif
+	  #ifdef EXDEV
+		EXDEV,
+	  #endif
+	};
+mkwrap_body_errno(28 /* posix/io/dir/rename */, -1)
+mkwrap_bottom(rename, (oldpath, newpath))
+
+
+
+
+// The address family is given as an extra argument (arg4), for the predicates 
+// (see fiu_set_predicate()); -1 if there is no address. It is only read when 
+// the predicate looks at it, so otherwise a bad pointer still fails with 
+// EFAULT instead of crashing here. 
+/* Wrapper for socket() */
+mkwrap_top(int , socket, (int domain, int type, int protocol), (domain, type, protocol), (int , int , int ), (-1))
+mkwrap_body_gate(socket, (domain, type, protocol), 0, 0x20000000ULL)
+mkwrap_body_args(domain, type, protocol)
+	static const int valid_errnos[] = {
+	  #ifdef EAFNOSUPPORT
+		EAFNOSUPPORT,
+	  #endif
+	  #ifdef EMFILE
+		EMFILE,
+	  #endif
+	  #ifdef ENFILE
+		ENFILE,
+	  #endif
+	  #ifdef EPROTONOSUPPORT
+		EPROTONOSUPPORT,
+	  #endif
+	  #ifdef EPROTOTYPE
+		EPROTOTYPE,
+	  #endif
+	  #ifdef EACCES
+		EACCES,
+	  #endif
+	  #ifdef ENOBUFS
+		ENOBUFS,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	};
+mkwrap_body_errno(29 /* posix/io/net/socket */, -1)
+mkwrap_bottom_after(socket, (domain, type, protocol), if (r >= 0) fd_path_set(r, NULL);)
+
+
+
+/* Wrapper for bind() */
+mkwrap_top(int , bind, (int socket, const struct sockaddr *address, socklen_t address_len), (socket, address, address_len), (int , const struct sockaddr *, socklen_t ), (-1))
+mkwrap_body_gate(bind, (socket, address, address_len), 0, 0x40000000ULL)
+mkwrap_body_args(socket, (intptr_t) address, address_len, 0)
+mkwrap_body_arg_lazy(3, mkwrap_arg_needed(30 /* posix/io/net/bind */, 3), address != NULL ? address->sa_family : -1)
+	static const int valid_errnos[] = {
+	  #ifdef EADDRINUSE
+		EADDRINUSE,
+	  #endif
+	  #ifdef EADDRNOTAVAIL
+		EADDRNOTAVAIL,
+	  #endif
+	  #ifdef EAFNOSUPPORT
+		EAFNOSUPPORT,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef ENOTSOCK
+		ENOTSOCK,
+	  #endif
+	  #ifdef EOPNOTSUPP
+		EOPNOTSUPP,
+	  #endif
+	  #ifdef EACCES
+		EACCES,
+	  #endif
+	  #ifdef EDESTADDRREQ
+		EDESTADDRREQ,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ELOOP
+		ELOOP,
+	  #endif
+	  #ifdef ENAMETOOLONG
+		ENAMETOOLONG,
+	  #endif
+	  #ifdef ENOENT
+		ENOENT,
+	  #endif
+	  #ifdef ENOTDIR
+		ENOTDIR,
+	  #endif
+	  #ifdef EROFS
+		EROFS,
+	  #endif
+	  #ifdef EACCES
+		EACCES,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef EISCONN
+		EISCONN,
+	  #endif
+	  #ifdef ELOOP
+		ELOOP,
+	  #endif
+	  #ifdef ENAMETOOLONG
+		ENAMETOOLONG,
+	  #endif
+	  #ifdef ENOBUFS
+		ENOBUFS,
+	  #endif
+	};
+mkwrap_body_errno(30 /* posix/io/net/bind */, -1)
+mkwrap_bottom(bind, (socket, address, address_len))
+
+
+
+/* Wrapper for listen() */
+mkwrap_top(int , listen, (int socket, int backlog), (socket, backlog), (int , int ), (-1))
+mkwrap_body_gate(listen, (socket, backlog), 0, 0x80000000ULL)
+mkwrap_body_args(socket, backlog)
+	static const int valid_errnos[] = {
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EDESTADDRREQ
+		EDESTADDRREQ,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef ENOTSOCK
+		ENOTSOCK,
+	  #endif
+	  #ifdef EOPNOTSUPP
+		EOPNOTSUPP,
+	  #endif
+	  #ifdef EACCES
+		EACCES,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef ENOBUFS
+		ENOBUFS,
+	  #endif
+	};
+mkwrap_body_errno(31 /* posix/io/net/listen */, -1)
+mkwrap_bottom(listen, (socket, backlog))
+
+
+
+// Like bind(), arg4 is the address family. 
+/* Wrapper for accept() */
+mkwrap_top(int , accept, (int socket, struct sockaddr *restrict address, socklen_t *restrict address_len), (socket, address, address_len), (int , struct sockaddr *restrict , socklen_t *restrict ), (-1))
+mkwrap_body_gate(accept, (socket, address, address_len), 0, 0x300000000ULL)
+mkwrap_body_args(socket, (intptr_t) address, (intptr_t) address_len)
+	static const int valid_errnos[] = {
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef ECONNABORTED
+		ECONNABORTED,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef EMFILE
+		EMFILE,
+	  #endif
+	  #ifdef ENFILE
+		ENFILE,
+	  #endif
+	  #ifdef ENOTSOCK
+		ENOTSOCK,
+	  #endif
+	  #ifdef EOPNOTSUPP
+		EOPNOTSUPP,
+	  #endif
+	  #ifdef ENOBUFS
+		ENOBUFS,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef EPROTO
+		EPROTO,
+	  #endif
+	};
+mkwrap_body_errno(32 /* posix/io/net/accept */, -1)
+mkwrap_body_spurious(33 /* posix/io/net/accept/spurious */, -1, EAGAIN)
+mkwrap_bottom_after(accept, (socket, address, address_len), if (r >= 0) fd_path_set(r, NULL);)
+
+
+
+/* Wrapper for connect() */
+mkwrap_top(int , connect, (int socket, const struct sockaddr *address, socklen_t address_len), (socket, address, address_len), (int , const struct sockaddr *, socklen_t ), (-1))
+mkwrap_body_gate(connect, (socket, address, address_len), 0, 0x400000000ULL)
+mkwrap_body_args(socket, (intptr_t) address, address_len, 0)
+mkwrap_body_arg_lazy(3, mkwrap_arg_needed(34 /* posix/io/net/connect */, 3), address != NULL ? address->sa_family : -1)
+	static const int valid_errnos[] = {
+	  #ifdef EADDRNOTAVAIL
+		EADDRNOTAVAIL,
+	  #endif
+	  #ifdef EAFNOSUPPORT
+		EAFNOSUPPORT,
+	  #endif
+	  #ifdef EALREADY
+		EALREADY,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef ECONNREFUSED
+		ECONNREFUSED,
+	  #endif
+	  #ifdef EINPROGRESS
+		EINPROGRESS,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EISCONN
+		EISCONN,
+	  #endif
+	  #ifdef ENETUNREACH
+		ENETUNREACH,
+	  #endif
+	  #ifdef ENOTSOCK
+		ENOTSOCK,
+	  #endif
+	  #ifdef EPROTOTYPE
+		EPROTOTYPE,
+	  #endif
+	  #ifdef ETIMEDOUT
+		ETIMEDOUT,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ELOOP
+		ELOOP,
+	  #endif
+	  #ifdef ENAMETOOLONG
+		ENAMETOOLONG,
+	  #endif
+	  #ifdef ENOENT
+		ENOENT,
+	  #endif
+	  #ifdef ENOTDIR
+		ENOTDIR,
+	  #endif
+	  #ifdef EACCES
+		EACCES,
+	  #endif
+	  #ifdef EADDRINUSE
+		EADDRINUSE,
+	  #endif
+	  #ifdef ECONNRESET
+		ECONNRESET,
+	  #endif
+	  #ifdef EHOSTUNREACH
+		EHOSTUNREACH,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef ELOOP
+		ELOOP,
+	  #endif
+	  #ifdef ENAMETOOLONG
+		ENAMETOOLONG,
+	  #endif
+	  #ifdef ENETDOWN
+		ENETDOWN,
+	  #endif
+	  #ifdef ENOBUFS
+		ENOBUFS,
+	  #endif
+	  #ifdef EOPNOTSUPP
+		EOPNOTSUPP,
+	  #endif
+	};
+mkwrap_body_errno(34 /* posix/io/net/connect */, -1)
+mkwrap_bottom(connect, (socket, address, address_len))
+
+
+
+/* Wrapper for recv() */
+mkwrap_top(ssize_t , recv, (int socket, void *buffer, size_t length, int flags), (socket, buffer, length, flags), (int , void *, size_t , int ), (-1))
+mkwrap_body_gate(recv, (socket, buffer, length, flags), 0, 0x1800000000ULL)
+mkwrap_body_args(socket, (intptr_t) buffer, length, flags)
+	static const int valid_errnos[] = {
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef ECONNRESET
+		ECONNRESET,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef ENOTCONN
+		ENOTCONN,
+	  #endif
+	  #ifdef ENOTSOCK
+		ENOTSOCK,
+	  #endif
+	  #ifdef EOPNOTSUPP
+		EOPNOTSUPP,
+	  #endif
+	  #ifdef ETIMEDOUT
+		ETIMEDOUT,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ENOBUFS
+		ENOBUFS,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	};
+mkwrap_body_errno(35 /* posix/io/net/recv */, -1)
+mkwrap_body_spurious(36 /* posix/io/net/recv/spurious */, -1, EAGAIN)
+mkwrap_bottom(recv, (socket, buffer, length, flags))
+
+
+
+/* Wrapper for recvfrom() */
+mkwrap_top(ssize_t , recvfrom, (int socket, void *restrict buffer, size_t length, int flags, struct sockaddr *restrict address, socklen_t *restrict address_len), (socket, buffer, length, flags, address, address_len), (int , void *restrict , size_t , int , struct sockaddr *restrict , socklen_t *restrict ), (-1))
+mkwrap_body_gate(recvfrom, (socket, buffer, length, flags, address, address_len), 0, 0x6000000000ULL)
+mkwrap_body_args(socket, (intptr_t) buffer, length, flags, (intptr_t) address, (intptr_t) address_len)
+	static const int valid_errnos[] = {
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef ECONNRESET
+		ECONNRESET,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef ENOTCONN
+		ENOTCONN,
+	  #endif
+	  #ifdef ENOTSOCK
+		ENOTSOCK,
+	  #endif
+	  #ifdef EOPNOTSUPP
+		EOPNOTSUPP,
+	  #endif
+	  #ifdef ETIMEDOUT
+		ETIMEDOUT,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ENOBUFS
+		ENOBUFS,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	};
+mkwrap_body_errno(37 /* posix/io/net/recvfrom */, -1)
+mkwrap_body_spurious(38 /* posix/io/net/recvfrom/spurious */, -1, EAGAIN)
+mkwrap_bottom(recvfrom, (socket, buffer, length, flags, address, address_len))
+
+
+
+/* Wrapper for recvmsg() */
+mkwrap_top(ssize_t , recvmsg, (int socket, struct msghdr *message, int flags), (socket, message, flags), (int , struct msghdr *, int ), (-1))
+mkwrap_body_gate(recvmsg, (socket, message, flags), 0, 0x18000000000ULL)
+mkwrap_body_args(socket, (intptr_t) message, flags)
+	static const int valid_errnos[] = {
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef ECONNRESET
+		ECONNRESET,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef EMSGSIZE
+		EMSGSIZE,
+	  #endif
+	  #ifdef ENOTCONN
+		ENOTCONN,
+	  #endif
+	  #ifdef ENOTSOCK
+		ENOTSOCK,
+	  #endif
+	  #ifdef EOPNOTSUPP
+		EOPNOTSUPP,
+	  #endif
+	  #ifdef ETIMEDOUT
+		ETIMEDOUT,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ENOBUFS
+		ENOBUFS,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	};
+mkwrap_body_errno(39 /* posix/io/net/recvmsg */, -1)
+mkwrap_body_spurious(40 /* posix/io/net/recvmsg/spurious */, -1, EAGAIN)
+mkwrap_bottom(recvmsg, (socket, message, flags))
+
+
+
+// And arg7 here. 
+/* Wrapper for send() */
+mkwrap_top(ssize_t , send, (int socket, const void *buffer, size_t length, int flags), (socket, buffer, length, flags), (int , const void *, size_t , int ), (-1))
+mkwrap_body_gate(send, (socket, buffer, length, flags), 0, 0x20000000000ULL)
+mkwrap_body_args(socket, (intptr_t) buffer, length, flags)
+	static const int valid_errnos[] = {
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef ECONNRESET
+		ECONNRESET,
+	  #endif
+	  #ifdef EDESTADDRREQ
+		EDESTADDRREQ,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EMSGSIZE
+		EMSGSIZE,
+	  #endif
+	  #ifdef ENOTCONN
+		ENOTCONN,
+	  #endif
+	  #ifdef ENOTSOCK
+		ENOTSOCK,
+	  #endif
+	  #ifdef EOPNOTSUPP
+		EOPNOTSUPP,
+	  #endif
+	  #ifdef EPIPE
+		EPIPE,
+	  #endif
+	  #ifdef EACCES
+		EACCES,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ENETDOWN
+		ENETDOWN,
+	  #endif
+	  #ifdef ENETUNREACH
+		ENETUNREACH,
+	  #endif
+	  #ifdef ENOBUFS
+		ENOBUFS,
+	  #endif
+	};
+mkwrap_body_errno(41 /* posix/io/net/send */, -1)
+mkwrap_bottom(send, (socket, buffer, length, flags))
+
+
+
+/* Wrapper for sendto() */
+mkwrap_top(ssize_t , sendto, (int socket, const void *message, size_t length, int flags, const struct sockaddr *dest_addr, socklen_t dest_len), (socket, message, length, flags, dest_addr, dest_len), (int , const void *, size_t , int , const struct sockaddr *, socklen_t ), (-1))
+mkwrap_body_gate(sendto, (socket, message, length, flags, dest_addr, dest_len), 0, 0x40000000000ULL)
+mkwrap_body_args(socket, (intptr_t) message, length, flags, (intptr_t) dest_addr, dest_len, 0)
+mkwrap_body_arg_lazy(6, mkwrap_arg_needed(42 /* posix/io/net/sendto */, 6), dest_addr != NULL ? dest_addr->sa_family : -1)
+	static const int valid_errnos[] = {
+	  #ifdef EAFNOSUPPORT
+		EAFNOSUPPORT,
+	  #endif
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef ECONNRESET
+		ECONNRESET,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EMSGSIZE
+		EMSGSIZE,
+	  #endif
+	  #ifdef ENOTCONN
+		ENOTCONN,
+	  #endif
+	  #ifdef ENOTSOCK
+		ENOTSOCK,
+	  #endif
+	  #ifdef EOPNOTSUPP
+		EOPNOTSUPP,
+	  #endif
+	  #ifdef EPIPE
+		EPIPE,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ELOOP
+		ELOOP,
+	  #endif
+	  #ifdef ENAMETOOLONG
+		ENAMETOOLONG,
+	  #endif
+	  #ifdef ENOENT
+		ENOENT,
+	  #endif
+	  #ifdef ENOTDIR
+		ENOTDIR,
+	  #endif
+	  #ifdef EACCES
+		EACCES,
+	  #endif
+	  #ifdef EDESTADDRREQ
+		EDESTADDRREQ,
+	  #endif
+	  #ifdef EHOSTUNREACH
+		EHOSTUNREACH,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef EISCONN
+		EISCONN,
+	  #endif
+	  #ifdef ENETDOWN
+		ENETDOWN,
+	  #endif
+	  #ifdef ENETUNREACH
+		ENETUNREACH,
+	  #endif
+	  #ifdef ENOBUFS
+		ENOBUFS,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef ELOOP
+		ELOOP,
+	  #endif
+	  #ifdef ENAMETOOLONG
+		ENAMETOOLONG,
+	  #endif
+	};
+mkwrap_body_errno(42 /* posix/io/net/sendto */, -1)
+mkwrap_bottom(sendto, (socket, message, length, flags, dest_addr, dest_len))
+
+
+
+/* Wrapper for sendmsg() */
+mkwrap_top(ssize_t , sendmsg, (int socket, const struct msghdr *message, int flags), (socket, message, flags), (int , const struct msghdr *, int ), (-1))
+mkwrap_body_gate(sendmsg, (socket, message, flags), 0, 0x80000000000ULL)
+mkwrap_body_args(socket, (intptr_t) message, flags)
+	static const int valid_errnos[] = {
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EAFNOSUPPORT
+		EAFNOSUPPORT,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef ECONNRESET
+		ECONNRESET,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef EMSGSIZE
+		EMSGSIZE,
+	  #endif
+	  #ifdef ENOTCONN
+		ENOTCONN,
+	  #endif
+	  #ifdef ENOTSOCK
+		ENOTSOCK,
+	  #endif
+	  #ifdef EOPNOTSUPP
+		EOPNOTSUPP,
+	  #endif
+	  #ifdef EPIPE
+		EPIPE,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ELOOP
+		ELOOP,
+	  #endif
+	  #ifdef ENAMETOOLONG
+		ENAMETOOLONG,
+	  #endif
+	  #ifdef ENOENT
+		ENOENT,
+	  #endif
+	  #ifdef ENOTDIR
+		ENOTDIR,
+	  #endif
+	  #ifdef EACCES
+		EACCES,
+	  #endif
+	  #ifdef EDESTADDRREQ
+		EDESTADDRREQ,
+	  #endif
+	  #ifdef EHOSTUNREACH
+		EHOSTUNREACH,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef EISCONN
+		EISCONN,
+	  #endif
+	  #ifdef ENETDOWN
+		ENETDOWN,
+	  #endif
+	  #ifdef ENETUNREACH
+		ENETUNREACH,
+	  #endif
+	  #ifdef ENOBUFS
+		ENOBUFS,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef ELOOP
+		ELOOP,
+	  #endif
+	  #ifdef ENAMETOOLONG
+		ENAMETOOLONG,
+	  #endif
+	};
+mkwrap_body_errno(43 /* posix/io/net/sendmsg */, -1)
+mkwrap_bottom(sendmsg, (socket, message, flags))
+
+
+
+/* Wrapper for shutdown() */
+mkwrap_top(int , shutdown, (int socket, int how), (socket, how), (int , int ), (-1))
+mkwrap_body_gate(shutdown, (socket, how), 0, 0x100000000000ULL)
+mkwrap_body_args(socket, how)
+	static const int valid_errnos[] = {
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef ENOTCONN
+		ENOTCONN,
+	  #endif
+	  #ifdef ENOTSOCK
+		ENOTSOCK,
+	  #endif
+	  #ifdef ENOBUFS
+		ENOBUFS,
+	  #endif
+	};
+mkwrap_body_errno(44 /* posix/io/net/shutdown */, -1)
+mkwrap_bottom(shutdown, (socket, how))
+
+
+
+/* Wrapper for select() */
+mkwrap_top(int , select, (int nfds, fd_set *readfds, fd_set *writefds, fd_set *exceptfds, 		struct timeval *timeout), (nfds, readfds, writefds, exceptfds, timeout), (int , fd_set *, fd_set *, fd_set *, struct timeval *), (-1))
+mkwrap_body_gate(select, (nfds, readfds, writefds, exceptfds, timeout), 0, 0x200000000000ULL)
+mkwrap_body_args(nfds, (intptr_t) readfds, (intptr_t) writefds, (intptr_t) exceptfds, (intptr_t) timeout)
+	static const int valid_errnos[] = {
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	};
+mkwrap_body_errno(45 /* posix/io/net/select */, -1)
+mkwrap_bottom(select, (nfds, readfds, writefds, exceptfds, timeout))
+
+
+
+/* Wrapper for pselect() */
+mkwrap_top(int , pselect, (int nfds, fd_set *readfds, fd_set *writefds, fd_set *exceptfds, 		const struct timespec *timeout, const sigset_t *sigmask), (nfds, readfds, writefds, exceptfds, timeout, sigmask), (int , fd_set *, fd_set *, fd_set *, const struct timespec *, const sigset_t *), (-1))
+mkwrap_body_gate(pselect, (nfds, readfds, writefds, exceptfds, timeout, sigmask), 0, 0x400000000000ULL)
+mkwrap_body_args(nfds, (intptr_t) readfds, (intptr_t) writefds, (intptr_t) exceptfds, (intptr_t) timeout, (intptr_t) sigmask)
+	static const int valid_errnos[] = {
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	};
+mkwrap_body_errno(46 /* posix/io/net/pselect */, -1)
+mkwrap_bottom(pselect, (nfds, readfds, writefds, exceptfds, timeout, sigmask))
+
+
+
+
+/* Wrapper for poll() */
+mkwrap_top(int , poll, (struct pollfd *fds, nfds_t nfds, int timeout), (fds, nfds, timeout), (struct pollfd *, nfds_t , int ), (-1))
+mkwrap_body_gate(poll, (fds, nfds, timeout), 0, 0x800000000000ULL)
+mkwrap_body_args((intptr_t) fds, nfds, timeout)
+	static const int valid_errnos[] = {
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EFAULT
+		EFAULT,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	};
+mkwrap_body_errno(47 /* posix/io/net/poll */, -1)
+mkwrap_bottom(poll, (fds, nfds, timeout))
+
+
@@ -0,0 +1,311 @@
+
+/*
+ * AUTOGENERATED FILE - DO NOT EDIT
+ *
+ * This file was automatically generated by libfiu, do not edit it directly,
+ * but see libfiu's "preload" directory.
+ */
+
+#include "codegen.h"
+
+static const char *const _fiu_watch_names[] = {
+	/*  0 */ "posix/mm/mmap",
+	/*  1 */ "posix/mm/munmap",
+	/*  2 */ "posix/mm/msync",
+	/*  3 */ "posix/mm/mprotect",
+	/*  4 */ "posix/mm/madvise",
+	/*  5 */ "posix/mm/mlock",
+	/*  6 */ "posix/mm/munlock",
+	/*  7 */ "posix/mm/mlockall",
+	/*  8 */ "posix/mm/munlockall",
+};
+mkwrap_watch()
+
+mkwrap_catalog(
+	"posix/mm/mmap\0"
+	"posix/mm/munmap\0"
+	"posix/mm/msync\0"
+	"posix/mm/mprotect\0"
+	"posix/mm/madvise\0"
+	"posix/mm/mlock\0"
+	"posix/mm/munlock\0"
+	"posix/mm/mlockall\0"
+	"posix/mm/munlockall\0"
+)
+
+
+#include <unistd.h>
+#include <errno.h>
+#include <sys/mman.h>
+
+
+
+#ifdef _POSIX_MAPPED_FILES
+
+
+/* Wrapper for mmap() */
+mkwrap_top(void *, mmap, (void *addr, size_t length, int prot, int flags, int fd, 		off_t offset), (addr, length, prot, flags, fd, offset), (void *, size_t , int , int , int , off_t ), (MAP_FAILED))
+mkwrap_body_gate(mmap, (addr, length, prot, flags, fd, offset), 0, 0x1ULL)
+mkwrap_body_args((intptr_t) addr, length, prot, flags, fd, offset)
+	static const int valid_errnos[] = {
+	  #ifdef EACCES
+		EACCES,
+	  #endif
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef ENFILE
+		ENFILE,
+	  #endif
+	  #ifdef ENODEV
+		ENODEV,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef EPERM
+		EPERM,
+	  #endif
+	  #ifdef ETXTBSY
+		ETXTBSY,
+	  #endif
+	};
+mkwrap_body_errno(0 /* posix/mm/mmap */, MAP_FAILED)
+mkwrap_bottom(mmap, (addr, length, prot, flags, fd, offset))
+
+
+
+
+/* Wrapper for munmap() */
+mkwrap_top(int , munmap, (void *addr, size_t length), (addr, length), (void *, size_t ), (0))
+mkwrap_body_gate(munmap, (addr, length), 0, 0x2ULL)
+mkwrap_body_args((intptr_t) addr, length)
+	static const int valid_errnos[] = {
+	  #ifdef EACCES
+		EACCES,
+	  #endif
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef ENFILE
+		ENFILE,
+	  #endif
+	  #ifdef ENODEV
+		ENODEV,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef EPERM
+		EPERM,
+	  #endif
+	  #ifdef ETXTBSY
+		ETXTBSY,
+	  #endif
+	};
+mkwrap_body_errno(1 /* posix/mm/munmap */, 0)
+mkwrap_bottom(munmap, (addr, length))
+
+
+
+// glibc's mprotect() does not use const in the first argument, as the standard 
+// says it should 
+/* Wrapper for msync() */
+mkwrap_top(int , msync, (void *addr, size_t length, int flags), (addr, length, flags), (void *, size_t , int ), (-1))
+mkwrap_body_gate(msync, (addr, length, flags), 0, 0x4ULL)
+mkwrap_body_args((intptr_t) addr, length, flags)
+	static const int valid_errnos[] = {
+	  #ifdef EBUSY
+		EBUSY,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	};
+mkwrap_body_errno(2 /* posix/mm/msync */, -1)
+mkwrap_bottom(msync, (addr, length, flags))
+
+
+#ifdef __GLIBC__
+/* Wrapper for mprotect() */
+mkwrap_top(int , mprotect, (void *addr, size_t len, int prot), (addr, len, prot), (void *, size_t , int ), (-1))
+mkwrap_body_gate(mprotect, (addr, len, prot), 0, 0x8ULL)
+mkwrap_body_args((intptr_t) addr, len, prot)
+	static const int valid_errnos[] = {
+	  #ifdef EACCES
+		EACCES,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	};
+mkwrap_body_errno(3 /* posix/mm/mprotect */, -1)
+mkwrap_bottom(mprotect, (addr, len, prot))
+
+
+#else
+/* Wrapper for mprotect() */
+mkwrap_top(int , mprotect, (const void *addr, size_t len, int prot), (addr, len, prot), (const void *, size_t , int ), (-1))
+mkwrap_body_gate(mprotect, (addr, len, prot), 0, 0x8ULL)
+mkwrap_body_args((intptr_t) addr, len, prot)
+	static const int valid_errnos[] = {
+	  #ifdef EACCES
+		EACCES,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	};
+mkwrap_body_errno(3 /* posix/mm/mprotect */, -1)
+mkwrap_bottom(mprotect, (addr, len, prot))
+
+
+#endif
+
+
+/* Wrapper for madvise() */
+mkwrap_top(int , madvise, (void *addr, size_t length, int advice), (addr, length, advice), (void *, size_t , int ), (-1))
+mkwrap_body_gate(madvise, (addr, length, advice), 0, 0x10ULL)
+mkwrap_body_args((intptr_t) addr, length, advice)
+	static const int valid_errnos[] = {
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	};
+mkwrap_body_errno(4 /* posix/mm/madvise */, -1)
+mkwrap_bottom(madvise, (addr, length, advice))
+
+
+#else
+#warning "no mmap() (and friends) wrappers available"
+#endif
+
+
+#ifdef _POSIX_MEMLOCK_RANGE
+
+
+/* Wrapper for mlock() */
+mkwrap_top(int , mlock, (const void *addr, size_t len), (addr, len), (const void *, size_t ), (-1))
+mkwrap_body_gate(mlock, (addr, len), 0, 0x20ULL)
+mkwrap_body_args((intptr_t) addr, len)
+	static const int valid_errnos[] = {
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef EPERM
+		EPERM,
+	  #endif
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	};
+mkwrap_body_errno(5 /* posix/mm/mlock */, -1)
+mkwrap_bottom(mlock, (addr, len))
+
+
+
+/* Wrapper for munlock() */
+mkwrap_top(int , munlock, (const void *addr, size_t len), (addr, len), (const void *, size_t ), (-1))
+mkwrap_body_gate(munlock, (addr, len), 0, 0x40ULL)
+mkwrap_body_args((intptr_t) addr, len)
+	static const int valid_errnos[] = {
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef EPERM
+		EPERM,
+	  #endif
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	};
+mkwrap_body_errno(6 /* posix/mm/munlock */, -1)
+mkwrap_bottom(munlock, (addr, len))
+
+
+#else
+#warning "no mlock()/munlock() wrappers available"
+#endif
+
+
+#ifdef _POSIX_MEMLOCK
+
+
+/* Wrapper for mlockall() */
+mkwrap_top(int , mlockall, (int flags), (flags), (int ), (-1))
+mkwrap_body_gate(mlockall, (flags), 0, 0x80ULL)
+mkwrap_body_args(flags)
+	static const int valid_errnos[] = {
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef EPERM
+		EPERM,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	};
+mkwrap_body_errno(7 /* posix/mm/mlockall */, -1)
+mkwrap_bottom(mlockall, (flags))
+
+
+
+/* Wrapper for munlockall() */
+mkwrap_top(int , munlockall, (void), (), (), (-1))
+mkwrap_body_gate(munlockall, (), 0, 0x100ULL)
+	static const int valid_errnos[] = {
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef EPERM
+		EPERM,
+	  #endif
+	};
+mkwrap_body_errno(8 /* posix/mm/munlockall */, -1)
+mkwrap_bottom(munlockall, ())
+
+
+#else
+#warning "no mlockall()/munlockall() wrappers available"
+#endif
+
@@ -0,0 +1,172 @@
+
+/*
+ * AUTOGENERATED FILE - DO NOT EDIT
+ *
+ * This file was automatically generated by libfiu, do not edit it directly,
+ * but see libfiu's "preload" directory.
+ */
+
+#include "codegen.h"
+
+static const char *const _fiu_watch_names[] = {
+	/*  0 */ "posix/proc/fork",
+	/*  1 */ "posix/proc/wait",
+	/*  2 */ "posix/proc/waitpid",
+	/*  3 */ "posix/proc/waitid",
+	/*  4 */ "posix/proc/kill",
+	/*  5 */ "posix/proc/signal",
+	/*  6 */ "posix/proc/sigaction",
+};
+mkwrap_watch()
+
+mkwrap_catalog(
+	"posix/proc/fork\0"
+	"posix/proc/wait\0"
+	"posix/proc/waitpid\0"
+	"posix/proc/waitid\0"
+	"posix/proc/kill\0"
+	"posix/proc/signal\0"
+	"posix/proc/sigaction\0"
+)
+
+
+#include <unistd.h>
+#include <errno.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <signal.h>
+
+
+
+/* Wrapper for fork() */
+mkwrap_top(pid_t , fork, (void), (), (), (-1))
+mkwrap_body_gate(fork, (), 0, 0x1ULL)
+	static const int valid_errnos[] = {
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	};
+mkwrap_body_errno(0 /* posix/proc/fork */, -1)
+mkwrap_bottom(fork, ())
+
+
+
+/* Wrapper for wait() */
+mkwrap_top(pid_t , wait, (int *status), (status), (int *), (-1))
+mkwrap_body_gate(wait, (status), 0, 0x2ULL)
+mkwrap_body_args((intptr_t) status)
+	static const int valid_errnos[] = {
+	  #ifdef ECHILD
+		ECHILD,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	};
+mkwrap_body_errno(1 /* posix/proc/wait */, -1)
+mkwrap_bottom(wait, (status))
+
+
+
+// FreeBSD does not have waitid() 
+/* Wrapper for waitpid() */
+mkwrap_top(pid_t , waitpid, (pid_t pid, int *status, int options), (pid, status, options), (pid_t , int *, int ), (-1))
+mkwrap_body_gate(waitpid, (pid, status, options), 0, 0x4ULL)
+mkwrap_body_args(pid, (intptr_t) status, options)
+	static const int valid_errnos[] = {
+	  #ifdef ECHILD
+		ECHILD,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	};
+mkwrap_body_errno(2 /* posix/proc/waitpid */, -1)
+mkwrap_bottom(waitpid, (pid, status, options))
+
+
+#ifndef __FreeBSD__
+/* Wrapper for waitid() */
+mkwrap_top(int , waitid, (idtype_t idtype, id_t id, siginfo_t *infop, int options), (idtype, id, infop, options), (idtype_t , id_t , siginfo_t *, int ), (-1))
+mkwrap_body_gate(waitid, (idtype, id, infop, options), 0, 0x8ULL)
+mkwrap_body_args(idtype, id, (intptr_t) infop, options)
+	static const int valid_errnos[] = {
+	  #ifdef ECHILD
+		ECHILD,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	};
+mkwrap_body_errno(3 /* posix/proc/waitid */, -1)
+mkwrap_bottom(waitid, (idtype, id, infop, options))
+
+
+#endif
+
+
+// We need to do this typedef because our parser is not smart enough to handle 
+// the function definition without it 
+/* Wrapper for kill() */
+mkwrap_top(int , kill, (pid_t pid, int sig), (pid, sig), (pid_t , int ), (-1))
+mkwrap_body_gate(kill, (pid, sig), 0, 0x10ULL)
+mkwrap_body_args(pid, sig)
+	static const int valid_errnos[] = {
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef EPERM
+		EPERM,
+	  #endif
+	  #ifdef ESRCH
+		ESRCH,
+	  #endif
+	};
+mkwrap_body_errno(4 /* posix/proc/kill */, -1)
+mkwrap_bottom(kill, (pid, sig))
+
+
+typedef void (*sighandler_t)(int);
+
+/* Wrapper for signal() */
+mkwrap_top(sighandler_t , signal, (int signum, sighandler_t handler), (signum, handler), (int , sighandler_t ), (SIG_ERR))
+mkwrap_body_gate(signal, (signum, handler), 0, 0x20ULL)
+mkwrap_body_args(signum, (intptr_t) handler)
+	static const int valid_errnos[] = {
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	};
+mkwrap_body_errno(5 /* posix/proc/signal */, SIG_ERR)
+mkwrap_bottom(signal, (signum, handler))
+
+
+
+/* Wrapper for sigaction() */
+mkwrap_top(int , sigaction, (int signum, const struct sigaction *act, 		struct sigaction *oldact), (signum, act, oldact), (int , const struct sigaction *, struct sigaction *), (-1))
+mkwrap_body_gate(sigaction, (signum, act, oldact), 0, 0x40ULL)
+mkwrap_body_args(signum, (intptr_t) act, (intptr_t) oldact)
+	static const int valid_errnos[] = {
+	  #ifdef EFAULT
+		EFAULT,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	};
+mkwrap_body_errno(6 /* posix/proc/sigaction */, -1)
+mkwrap_bottom(sigaction, (signum, act, oldact))
+
+
@@ -0,0 +1,1687 @@
+
+/*
+ * AUTOGENERATED FILE - DO NOT EDIT
+ *
+ * This file was automatically generated by libfiu, do not edit it directly,
+ * but see libfiu's "preload" directory.
+ */
+
+#include "codegen.h"
+
+static const char *const _fiu_watch_names[] = {
+	/*  0 */ "posix/stdio/oc/fopen",
+	/*  1 */ "posix/stdio/oc/freopen",
+	/*  2 */ "posix/stdio/oc/fdopen",
+	/*  3 */ "posix/stdio/oc/fmemopen",
+	/*  4 */ "posix/stdio/oc/open_memstream",
+	/*  5 */ "posix/stdio/oc/popen",
+	/*  6 */ "posix/stdio/oc/pclose",
+	/*  7 */ "posix/stdio/tmp/tmpfile",
+	/*  8 */ "posix/stdio/tmp/tmpnam",
+	/*  9 */ "posix/stdio/tmp/tempnam",
+	/* 10 */ "posix/stdio/rw/fread",
+	/* 11 */ "posix/stdio/rw/fwrite",
+	/* 12 */ "posix/stdio/seek/fgetpos",
+	/* 13 */ "posix/stdio/seek/ftell",
+	/* 14 */ "posix/stdio/seek/ftello",
+	/* 15 */ "posix/stdio/seek/fseek",
+	/* 16 */ "posix/stdio/seek/fseeko",
+	/* 17 */ "posix/stdio/seek/fsetpos",
+	/* 18 */ "posix/stdio/gp/fgetc",
+	/* 19 */ "posix/stdio/gp/fgets",
+	/* 20 */ "posix/stdio/gp/getc",
+	/* 21 */ "posix/stdio/gp/getchar",
+	/* 22 */ "posix/stdio/gp/gets",
+	/* 23 */ "posix/stdio/gp/fputc",
+	/* 24 */ "posix/stdio/gp/fputs",
+	/* 25 */ "posix/stdio/gp/putc",
+	/* 26 */ "posix/stdio/gp/putchar",
+	/* 27 */ "posix/stdio/gp/puts",
+	/* 28 */ "posix/stdio/gp/ungetc",
+	/* 29 */ "posix/stdio/gp/getdelim",
+	/* 30 */ "posix/stdio/gp/getline",
+	/* 31 */ "posix/stdio/sp/vfprintf",
+	/* 32 */ "posix/stdio/sp/vprintf",
+	/* 33 */ "posix/stdio/sp/vdprintf",
+	/* 34 */ "posix/stdio/sp/vfscanf",
+	/* 35 */ "posix/stdio/sp/vscanf",
+	/* 36 */ "posix/stdio/remove",
+	/* 37 */ "posix/stdio/setvbuf",
+	/* 38 */ "posix/stdio/ftrylockfile",
+	/* 39 */ "posix/stdio/fflush",
+};
+mkwrap_watch()
+
+mkwrap_catalog(
+	"posix/stdio/oc/fopen\0"
+	"posix/stdio/oc/freopen\0"
+	"posix/stdio/oc/fdopen\0"
+	"posix/stdio/oc/fmemopen\0"
+	"posix/stdio/oc/open_memstream\0"
+	"posix/stdio/oc/popen\0"
+	"posix/stdio/oc/pclose\0"
+	"posix/stdio/tmp/tmpfile\0"
+	"posix/stdio/tmp/tmpnam\0"
+	"posix/stdio/tmp/tempnam\0"
+	"posix/stdio/rw/fread\0"
+	"posix/stdio/rw/fwrite\0"
+	"posix/stdio/seek/fgetpos\0"
+	"posix/stdio/seek/ftell\0"
+	"posix/stdio/seek/ftello\0"
+	"posix/stdio/seek/fseek\0"
+	"posix/stdio/seek/fseeko\0"
+	"posix/stdio/seek/fsetpos\0"
+	"posix/stdio/gp/fgetc\0"
+	"posix/stdio/gp/fgets\0"
+	"posix/stdio/gp/getc\0"
+	"posix/stdio/gp/getchar\0"
+	"posix/stdio/gp/gets\0"
+	"posix/stdio/gp/fputc\0"
+	"posix/stdio/gp/fputs\0"
+	"posix/stdio/gp/putc\0"
+	"posix/stdio/gp/putchar\0"
+	"posix/stdio/gp/puts\0"
+	"posix/stdio/gp/ungetc\0"
+	"posix/stdio/gp/getdelim\0"
+	"posix/stdio/gp/getline\0"
+	"posix/stdio/sp/vfprintf\0"
+	"posix/stdio/sp/vprintf\0"
+	"posix/stdio/sp/vdprintf\0"
+	"posix/stdio/sp/vfscanf\0"
+	"posix/stdio/sp/vscanf\0"
+	"posix/stdio/remove\0"
+	"posix/stdio/setvbuf\0"
+	"posix/stdio/ftrylockfile\0"
+	"posix/stdio/fflush\0"
+)
+
+
+// Posix stdio.h I/O 
+
+#include <stdio.h>
+#include <errno.h>
+#include <stdarg.h>
+
+
+
+/* Wrapper for fopen() */
+mkwrap_top(FILE *, fopen, (const char *pathname, const char *mode), (pathname, mode), (const char *, const char *), (NULL))
+mkwrap_body_gate(fopen, (pathname, mode), 0, 0x1ULL)
+mkwrap_body_args((intptr_t) pathname, (intptr_t) mode)
+	static const int valid_errnos[] = {
+	  #ifdef EACCES
+		EACCES,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EISDIR
+		EISDIR,
+	  #endif
+	  #ifdef ELOOP
+		ELOOP,
+	  #endif
+	  #ifdef EMFILE
+		EMFILE,
+	  #endif
+	  #ifdef ENAMETOOLONG
+		ENAMETOOLONG,
+	  #endif
+	  #ifdef ENFILE
+		ENFILE,
+	  #endif
+	  #ifdef ENOENT
+		ENOENT,
+	  #endif
+	  #ifdef ENOTDIR
+		ENOTDIR,
+	  #endif
+	  #ifdef ENOSPC
+		ENOSPC,
+	  #endif
+	  #ifdef ENXIO
+		ENXIO,
+	  #endif
+	  #ifdef EOVERFLOW
+		EOVERFLOW,
+	  #endif
+	  #ifdef EROFS
+		EROFS,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef ETXTBSY
+		ETXTBSY,
+	  #endif
+	};
+mkwrap_body_errno(0 /* posix/stdio/oc/fopen */, NULL)
+mkwrap_bottom(fopen, (pathname, mode))
+
+
+#ifdef __GLIBC__
+#if LIBFIU_CAN_DEFINE_64BIT_FUNCTIONS
+/* Wrapper for fopen64() */
+mkwrap_top(FILE *, fopen64, (const char *pathname, const char *mode), (pathname, mode), (const char *, const char *), (NULL))
+mkwrap_body_gate(fopen64, (pathname, mode), 0, 0x1ULL)
+mkwrap_body_args((intptr_t) pathname, (intptr_t) mode)
+	static const int valid_errnos[] = {
+	  #ifdef EACCES
+		EACCES,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EISDIR
+		EISDIR,
+	  #endif
+	  #ifdef ELOOP
+		ELOOP,
+	  #endif
+	  #ifdef EMFILE
+		EMFILE,
+	  #endif
+	  #ifdef ENAMETOOLONG
+		ENAMETOOLONG,
+	  #endif
+	  #ifdef ENFILE
+		ENFILE,
+	  #endif
+	  #ifdef ENOENT
+		ENOENT,
+	  #endif
+	  #ifdef ENOTDIR
+		ENOTDIR,
+	  #endif
+	  #ifdef ENOSPC
+		ENOSPC,
+	  #endif
+	  #ifdef ENXIO
+		ENXIO,
+	  #endif
+	  #ifdef EOVERFLOW
+		EOVERFLOW,
+	  #endif
+	  #ifdef EROFS
+		EROFS,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef ETXTBSY
+		ETXTBSY,
+	  #endif
+	};
+mkwrap_body_errno(0 /* posix/stdio/oc/fopen */, NULL)
+mkwrap_bottom(fopen64, (pathname, mode))
+
+
+#endif  // LIBFIU_CAN_DEFINE_64BIT_FUNCTIONS
+#endif  // __GLIBC__
+
+// This one needs to be further instrumented. 
+// int fclose(FILE *stream); 
+// on error: EOF 
+// valid errnos: EAGAIN EBADF EFBIG EFBIG EINTR EIO ENOMEM ENOSPC EPIPE ENXIO 
+
+/* Wrapper for freopen() */
+mkwrap_top(FILE *, freopen, (const char *pathname, const char *mode, FILE *stream), (pathname, mode, stream), (const char *, const char *, FILE *), (NULL))
+mkwrap_body_gate(freopen, (pathname, mode, stream), 0, 0x2ULL)
+mkwrap_body_args((intptr_t) pathname, (intptr_t) mode, (intptr_t) stream)
+	static const int valid_errnos[] = {
+	  #ifdef EACCES
+		EACCES,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EISDIR
+		EISDIR,
+	  #endif
+	  #ifdef ELOOP
+		ELOOP,
+	  #endif
+	  #ifdef EMFILE
+		EMFILE,
+	  #endif
+	  #ifdef ENAMETOOLONG
+		ENAMETOOLONG,
+	  #endif
+	  #ifdef ENFILE
+		ENFILE,
+	  #endif
+	  #ifdef ENOENT
+		ENOENT,
+	  #endif
+	  #ifdef ENOTDIR
+		ENOTDIR,
+	  #endif
+	  #ifdef ENOSPC
+		ENOSPC,
+	  #endif
+	  #ifdef ENXIO
+		ENXIO,
+	  #endif
+	  #ifdef EOVERFLOW
+		EOVERFLOW,
+	  #endif
+	  #ifdef EROFS
+		EROFS,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef ENXIO
+		ENXIO,
+	  #endif
+	  #ifdef ETXTBSY
+		ETXTBSY,
+	  #endif
+	};
+mkwrap_body_errno(1 /* posix/stdio/oc/freopen */, NULL)
+mkwrap_bottom(freopen, (pathname, mode, stream))
+
+
+#ifdef __GLIBC__
+#if LIBFIU_CAN_DEFINE_64BIT_FUNCTIONS
+/* Wrapper for freopen64() */
+mkwrap_top(FILE *, freopen64, (const char *pathname, const char *mode, FILE *stream), (pathname, mode, stream), (const char *, const char *, FILE *), (NULL))
+mkwrap_body_gate(freopen64, (pathname, mode, stream), 0, 0x2ULL)
+mkwrap_body_args((intptr_t) pathname, (intptr_t) mode, (intptr_t) stream)
+	static const int valid_errnos[] = {
+	  #ifdef EACCES
+		EACCES,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EISDIR
+		EISDIR,
+	  #endif
+	  #ifdef ELOOP
+		ELOOP,
+	  #endif
+	  #ifdef EMFILE
+		EMFILE,
+	  #endif
+	  #ifdef ENAMETOOLONG
+		ENAMETOOLONG,
+	  #endif
+	  #ifdef ENFILE
+		ENFILE,
+	  #endif
+	  #ifdef ENOENT
+		ENOENT,
+	  #endif
+	  #ifdef ENOTDIR
+		ENOTDIR,
+	  #endif
+	  #ifdef ENOSPC
+		ENOSPC,
+	  #endif
+	  #ifdef ENXIO
+		ENXIO,
+	  #endif
+	  #ifdef EOVERFLOW
+		EOVERFLOW,
+	  #endif
+	  #ifdef EROFS
+		EROFS,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef ENXIO
+		ENXIO,
+	  #endif
+	  #ifdef ETXTBSY
+		ETXTBSY,
+	  #endif
+	};
+mkwrap_body_errno(1 /* posix/stdio/oc/freopen */, NULL)
+mkwrap_bottom(freopen64, (pathname, mode, stream))
+
+
+#endif  // LIBFIU_CAN_DEFINE_64BIT_FUNCTIONS
+#endif  // __GLIBC__
+
+/* Wrapper for fdopen() */
+mkwrap_top(FILE *, fdopen, (int fd, const char *mode), (fd, mode), (int , const char *), (NULL))
+mkwrap_body_gate(fdopen, (fd, mode), 0, 0x4ULL)
+mkwrap_body_args(fd, (intptr_t) mode)
+	static const int valid_errnos[] = {
+	  #ifdef EMFILE
+		EMFILE,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef EMFILE
+		EMFILE,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	};
+mkwrap_body_errno(2 /* posix/stdio/oc/fdopen */, NULL)
+mkwrap_bottom(fdopen, (fd, mode))
+
+
+
+/* Wrapper for fmemopen() */
+mkwrap_top(FILE *, fmemopen, (void *restrict buf, size_t size, const char *restrict mode), (buf, size, mode), (void *restrict , size_t , const char *restrict ), (NULL))
+mkwrap_body_gate(fmemopen, (buf, size, mode), 0, 0x8ULL)
+mkwrap_body_args((intptr_t) buf, size, (intptr_t) mode)
+	static const int valid_errnos[] = {
+	  #ifdef EMFILE
+		EMFILE,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	};
+mkwrap_body_errno(3 /* posix/stdio/oc/fmemopen */, NULL)
+mkwrap_bottom(fmemopen, (buf, size, mode))
+
+
+
+/* Wrapper for open_memstream() */
+mkwrap_top(FILE *, open_memstream, (char **bufp, size_t *sizep), (bufp, sizep), (char **, size_t *), (NULL))
+mkwrap_body_gate(open_memstream, (bufp, sizep), 0, 0x10ULL)
+mkwrap_body_args((intptr_t) bufp, (intptr_t) sizep)
+	static const int valid_errnos[] = {
+	  #ifdef EMFILE
+		EMFILE,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	};
+mkwrap_body_errno(4 /* posix/stdio/oc/open_memstream */, NULL)
+mkwrap_bottom(open_memstream, (bufp, sizep))
+
+
+
+/* Wrapper for popen() */
+mkwrap_top(FILE *, popen, (const char *command, const char *mode), (command, mode), (const char *, const char *), (NULL))
+mkwrap_body_gate(popen, (command, mode), 0, 0x20ULL)
+mkwrap_body_args((intptr_t) command, (intptr_t) mode)
+	static const int valid_errnos[] = {
+	  #ifdef EMFILE
+		EMFILE,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef ENFILE
+		ENFILE,
+	  #endif
+	};
+mkwrap_body_errno(5 /* posix/stdio/oc/popen */, NULL)
+mkwrap_bottom(popen, (command, mode))
+
+
+
+
+/* Wrapper for pclose() */
+mkwrap_top(int , pclose, (FILE *stream), (stream), (FILE *), (-1))
+mkwrap_body_gate(pclose, (stream), 0, 0x40ULL)
+mkwrap_body_args((intptr_t) stream)
+	static const int valid_errnos[] = {
+	  #ifdef ECHILD
+		ECHILD,
+	  #endif
+	};
+mkwrap_body_errno(6 /* posix/stdio/oc/pclose */, -1)
+mkwrap_bottom(pclose, (stream))
+
+
+
+
+/* Wrapper for tmpfile() */
+mkwrap_top(FILE *, tmpfile, (void), (), (), (NULL))
+mkwrap_body_gate(tmpfile, (), 0, 0x80ULL)
+	static const int valid_errnos[] = {
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EMFILE
+		EMFILE,
+	  #endif
+	  #ifdef ENFILE
+		ENFILE,
+	  #endif
+	  #ifdef ENOSPC
+		ENOSPC,
+	  #endif
+	  #ifdef EOVERFLOW
+		EOVERFLOW,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	};
+mkwrap_body_errno(7 /* posix/stdio/tmp/tmpfile */, NULL)
+mkwrap_bottom(tmpfile, ())
+
+
+#ifdef __GLIBC__
+#if LIBFIU_CAN_DEFINE_64BIT_FUNCTIONS
+/* Wrapper for tmpfile64() */
+mkwrap_top(FILE *, tmpfile64, (void), (), (), (NULL))
+mkwrap_body_gate(tmpfile64, (), 0, 0x80ULL)
+	static const int valid_errnos[] = {
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EMFILE
+		EMFILE,
+	  #endif
+	  #ifdef ENFILE
+		ENFILE,
+	  #endif
+	  #ifdef ENOSPC
+		ENOSPC,
+	  #endif
+	  #ifdef EOVERFLOW
+		EOVERFLOW,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	};
+mkwrap_body_errno(7 /* posix/stdio/tmp/tmpfile */, NULL)
+mkwrap_bottom(tmpfile64, ())
+
+
+#endif  // LIBFIU_CAN_DEFINE_64BIT_FUNCTIONS
+#endif  // __GLIBC__
+
+/* Wrapper for tmpnam() */
+mkwrap_top(char *, tmpnam, (char *s), (s), (char *), (NULL))
+mkwrap_body_gate(tmpnam, (s), 0, 0x100ULL)
+mkwrap_body_args((intptr_t) s)
+mkwrap_body_hardcoded(8 /* posix/stdio/tmp/tmpnam */, NULL)
+mkwrap_bottom(tmpnam, (s))
+
+
+
+/* Wrapper for tempnam() */
+mkwrap_top(char *, tempnam, (const char *dir, const char *pfx), (dir, pfx), (const char *, const char *), (NULL))
+mkwrap_body_gate(tempnam, (dir, pfx), 0, 0x200ULL)
+mkwrap_body_args((intptr_t) dir, (intptr_t) pfx)
+	static const int valid_errnos[] = {
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	};
+mkwrap_body_errno(9 /* posix/stdio/tmp/tempnam */, NULL)
+mkwrap_bottom(tempnam, (dir, pfx))
+
+
+
+
+/* Wrapper for fread() */
+mkwrap_top(size_t , fread, (void *restrict ptr, size_t size, size_t nitems, FILE *restrict stream), (ptr, size, nitems, stream), (void *restrict , size_t , size_t , FILE *restrict ), (0))
+mkwrap_body_gate(fread, (ptr, size, nitems, stream), 0, 0x400ULL)
+mkwrap_body_args((intptr_t) ptr, size, nitems, (intptr_t) stream)
+	static const int valid_errnos[] = {
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef EOVERFLOW
+		EOVERFLOW,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef ENXIO
+		ENXIO,
+	  #endif
+	};
+mkwrap_body_errno_ferror(10 /* posix/stdio/rw/fread */, 0, stream)
+mkwrap_bottom(fread, (ptr, size, nitems, stream))
+
+
+
+/* Wrapper for fwrite() */
+mkwrap_top(size_t , fwrite, (const void *restrict ptr, size_t size, size_t nitems, FILE *restrict stream), (ptr, size, nitems, stream), (const void *restrict , size_t , size_t , FILE *restrict ), (0))
+mkwrap_body_gate(fwrite, (ptr, size, nitems, stream), 0, 0x800ULL)
+mkwrap_body_args((intptr_t) ptr, size, nitems, (intptr_t) stream)
+	static const int valid_errnos[] = {
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EFBIG
+		EFBIG,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ENOSPC
+		ENOSPC,
+	  #endif
+	  #ifdef EPIPE
+		EPIPE,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef ENXIO
+		ENXIO,
+	  #endif
+	};
+mkwrap_body_errno_ferror(11 /* posix/stdio/rw/fwrite */, 0, stream)
+mkwrap_bottom(fwrite, (ptr, size, nitems, stream))
+
+
+
+
+/* Wrapper for fgetpos() */
+mkwrap_top(int , fgetpos, (FILE *restrict stream, fpos_t *restrict pos), (stream, pos), (FILE *restrict , fpos_t *restrict ), (-1))
+mkwrap_body_gate(fgetpos, (stream, pos), 0, 0x1000ULL)
+mkwrap_body_args((intptr_t) stream, (intptr_t) pos)
+	static const int valid_errnos[] = {
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EOVERFLOW
+		EOVERFLOW,
+	  #endif
+	  #ifdef ESPIPE
+		ESPIPE,
+	  #endif
+	};
+mkwrap_body_errno(12 /* posix/stdio/seek/fgetpos */, -1)
+mkwrap_bottom(fgetpos, (stream, pos))
+
+
+
+/* Wrapper for ftell() */
+mkwrap_top(long , ftell, (FILE *stream), (stream), (FILE *), (-1))
+mkwrap_body_gate(ftell, (stream), 0, 0x2000ULL)
+mkwrap_body_args((intptr_t) stream)
+	static const int valid_errnos[] = {
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EOVERFLOW
+		EOVERFLOW,
+	  #endif
+	  #ifdef ESPIPE
+		ESPIPE,
+	  #endif
+	};
+mkwrap_body_errno(13 /* posix/stdio/seek/ftell */, -1)
+mkwrap_bottom(ftell, (stream))
+
+
+
+/* Wrapper for ftello() */
+mkwrap_top(off_t , ftello, (FILE *stream), (stream), (FILE *), (-1))
+mkwrap_body_gate(ftello, (stream), 0, 0x4000ULL)
+mkwrap_body_args((intptr_t) stream)
+	static const int valid_errnos[] = {
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EOVERFLOW
+		EOVERFLOW,
+	  #endif
+	  #ifdef ESPIPE
+		ESPIPE,
+	  #endif
+	};
+mkwrap_body_errno(14 /* posix/stdio/seek/ftello */, -1)
+mkwrap_bottom(ftello, (stream))
+
+
+#ifdef __GLIBC__
+#if LIBFIU_CAN_DEFINE_64BIT_FUNCTIONS
+/* Wrapper for ftello64() */
+mkwrap_top(off64_t , ftello64, (FILE *stream), (stream), (FILE *), (-1))
+mkwrap_body_gate(ftello64, (stream), 0, 0x4000ULL)
+mkwrap_body_args((intptr_t) stream)
+	static const int valid_errnos[] = {
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EOVERFLOW
+		EOVERFLOW,
+	  #endif
+	  #ifdef ESPIPE
+		ESPIPE,
+	  #endif
+	};
+mkwrap_body_errno(14 /* posix/stdio/seek/ftello */, -1)
+mkwrap_bottom(ftello64, (stream))
+
+
+#endif  // LIBFIU_CAN_DEFINE_64BIT_FUNCTIONS
+#endif  // __GLIBC__
+
+/* Wrapper for fseek() */
+mkwrap_top(int , fseek, (FILE *stream, long int offset, int whence), (stream, offset, whence), (FILE *, long int , int ), (-1))
+mkwrap_body_gate(fseek, (stream, offset, whence), 0, 0x8000ULL)
+mkwrap_body_args((intptr_t) stream, offset, whence)
+	static const int valid_errnos[] = {
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EFBIG
+		EFBIG,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ENOSPC
+		ENOSPC,
+	  #endif
+	  #ifdef EOVERFLOW
+		EOVERFLOW,
+	  #endif
+	  #ifdef EPIPE
+		EPIPE,
+	  #endif
+	  #ifdef ENXIO
+		ENXIO,
+	  #endif
+	};
+mkwrap_body_errno_ferror(15 /* posix/stdio/seek/fseek */, -1, stream)
+mkwrap_bottom(fseek, (stream, offset, whence))
+
+
+
+/* Wrapper for fseeko() */
+mkwrap_top(int , fseeko, (FILE *stream, off_t offset, int whence), (stream, offset, whence), (FILE *, off_t , int ), (-1))
+mkwrap_body_gate(fseeko, (stream, offset, whence), 0, 0x10000ULL)
+mkwrap_body_args((intptr_t) stream, offset, whence)
+	static const int valid_errnos[] = {
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EFBIG
+		EFBIG,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ENOSPC
+		ENOSPC,
+	  #endif
+	  #ifdef EOVERFLOW
+		EOVERFLOW,
+	  #endif
+	  #ifdef EPIPE
+		EPIPE,
+	  #endif
+	  #ifdef ENXIO
+		ENXIO,
+	  #endif
+	};
+mkwrap_body_errno_ferror(16 /* posix/stdio/seek/fseeko */, -1, stream)
+mkwrap_bottom(fseeko, (stream, offset, whence))
+
+
+#ifdef __GLIBC__
+#if LIBFIU_CAN_DEFINE_64BIT_FUNCTIONS
+/* Wrapper for fseeko64() */
+mkwrap_top(int , fseeko64, (FILE *stream, off64_t offset, int whence), (stream, offset, whence), (FILE *, off64_t , int ), (-1))
+mkwrap_body_gate(fseeko64, (stream, offset, whence), 0, 0x10000ULL)
+mkwrap_body_args((intptr_t) stream, offset, whence)
+	static const int valid_errnos[] = {
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EFBIG
+		EFBIG,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ENOSPC
+		ENOSPC,
+	  #endif
+	  #ifdef EOVERFLOW
+		EOVERFLOW,
+	  #endif
+	  #ifdef EPIPE
+		EPIPE,
+	  #endif
+	  #ifdef ENXIO
+		ENXIO,
+	  #endif
+	};
+mkwrap_body_errno_ferror(16 /* posix/stdio/seek/fseeko */, -1, stream)
+mkwrap_bottom(fseeko64, (stream, offset, whence))
+
+
+#endif  // LIBFIU_CAN_DEFINE_64BIT_FUNCTIONS
+#endif  // __GLIBC__
+
+// void rewind(FILE *stream); 
+// valid errnos: EAGAIN EBADF EFBIG EINTR EINVAL EIO ENOSPC EOVERFLOW EPIPE ENXIO 
+// ferror: stream 
+
+
+/* Wrapper for fsetpos() */
+mkwrap_top(int , fsetpos, (FILE *stream, const fpos_t *pos), (stream, pos), (FILE *, const fpos_t *), (-1))
+mkwrap_body_gate(fsetpos, (stream, pos), 0, 0x20000ULL)
+mkwrap_body_args((intptr_t) stream, (intptr_t) pos)
+	static const int valid_errnos[] = {
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EFBIG
+		EFBIG,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ENOSPC
+		ENOSPC,
+	  #endif
+	  #ifdef EOVERFLOW
+		EOVERFLOW,
+	  #endif
+	  #ifdef EPIPE
+		EPIPE,
+	  #endif
+	  #ifdef ENXIO
+		ENXIO,
+	  #endif
+	};
+mkwrap_body_errno_ferror(17 /* posix/stdio/seek/fsetpos */, -1, stream)
+mkwrap_bottom(fsetpos, (stream, pos))
+
+
+#ifdef __GLIBC__
+#if LIBFIU_CAN_DEFINE_64BIT_FUNCTIONS
+/* Wrapper for fsetpos64() */
+mkwrap_top(int , fsetpos64, (FILE *stream, const fpos64_t *pos), (stream, pos), (FILE *, const fpos64_t *), (-1))
+mkwrap_body_gate(fsetpos64, (stream, pos), 0, 0x20000ULL)
+mkwrap_body_args((intptr_t) stream, (intptr_t) pos)
+	static const int valid_errnos[] = {
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EFBIG
+		EFBIG,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ENOSPC
+		ENOSPC,
+	  #endif
+	  #ifdef EOVERFLOW
+		EOVERFLOW,
+	  #endif
+	  #ifdef EPIPE
+		EPIPE,
+	  #endif
+	  #ifdef ENXIO
+		ENXIO,
+	  #endif
+	};
+mkwrap_body_errno_ferror(17 /* posix/stdio/seek/fsetpos */, -1, stream)
+mkwrap_bottom(fsetpos64, (stream, pos))
+
+
+#endif  // LIBFIU_CAN_DEFINE_64BIT_FUNCTIONS
+#endif  // __GLIBC__
+
+
+/* Wrapper for fgetc() */
+mkwrap_top(int , fgetc, (FILE *stream), (stream), (FILE *), (EOF))
+mkwrap_body_gate(fgetc, (stream), 0, 0x40000ULL)
+mkwrap_body_args((intptr_t) stream)
+	static const int valid_errnos[] = {
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef ENXIO
+		ENXIO,
+	  #endif
+	  #ifdef EOVERFLOW
+		EOVERFLOW,
+	  #endif
+	};
+mkwrap_body_errno_ferror(18 /* posix/stdio/gp/fgetc */, EOF, stream)
+mkwrap_bottom(fgetc, (stream))
+
+
+
+/* Wrapper for fgets() */
+mkwrap_top(char *, fgets, (char *restrict s, int n, FILE *restrict stream), (s, n, stream), (char *restrict , int , FILE *restrict ), (NULL))
+mkwrap_body_gate(fgets, (s, n, stream), 0, 0x80000ULL)
+mkwrap_body_args((intptr_t) s, n, (intptr_t) stream)
+	static const int valid_errnos[] = {
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef ENXIO
+		ENXIO,
+	  #endif
+	  #ifdef EOVERFLOW
+		EOVERFLOW,
+	  #endif
+	};
+mkwrap_body_errno_ferror(19 /* posix/stdio/gp/fgets */, NULL, stream)
+mkwrap_bottom(fgets, (s, n, stream))
+
+
+
+/* Wrapper for getc() */
+mkwrap_top(int , getc, (FILE *stream), (stream), (FILE *), (EOF))
+mkwrap_body_gate(getc, (stream), 0, 0x100000ULL)
+mkwrap_body_args((intptr_t) stream)
+	static const int valid_errnos[] = {
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef ENXIO
+		ENXIO,
+	  #endif
+	  #ifdef EOVERFLOW
+		EOVERFLOW,
+	  #endif
+	};
+mkwrap_body_errno_ferror(20 /* posix/stdio/gp/getc */, EOF, stream)
+mkwrap_bottom(getc, (stream))
+
+
+
+/* Wrapper for getchar() */
+mkwrap_top(int , getchar, (void), (), (), (EOF))
+mkwrap_body_gate(getchar, (), 0, 0x200000ULL)
+	static const int valid_errnos[] = {
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef ENXIO
+		ENXIO,
+	  #endif
+	  #ifdef EOVERFLOW
+		EOVERFLOW,
+	  #endif
+	};
+mkwrap_body_errno_ferror(21 /* posix/stdio/gp/getchar */, EOF, stdin)
+mkwrap_bottom(getchar, ())
+
+
+
+/* Wrapper for gets() */
+mkwrap_top(char *, gets, (char *s), (s), (char *), (NULL))
+mkwrap_body_gate(gets, (s), 0, 0x400000ULL)
+mkwrap_body_args((intptr_t) s)
+	static const int valid_errnos[] = {
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef ENXIO
+		ENXIO,
+	  #endif
+	  #ifdef EOVERFLOW
+		EOVERFLOW,
+	  #endif
+	};
+mkwrap_body_errno_ferror(22 /* posix/stdio/gp/gets */, NULL, stdin)
+mkwrap_bottom(gets, (s))
+
+
+
+/* Wrapper for fputc() */
+mkwrap_top(int , fputc, (int c, FILE *stream), (c, stream), (int , FILE *), (EOF))
+mkwrap_body_gate(fputc, (c, stream), 0, 0x800000ULL)
+mkwrap_body_args(c, (intptr_t) stream)
+	static const int valid_errnos[] = {
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EFBIG
+		EFBIG,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef ENOSPC
+		ENOSPC,
+	  #endif
+	  #ifdef ENXIO
+		ENXIO,
+	  #endif
+	  #ifdef EPIPE
+		EPIPE,
+	  #endif
+	};
+mkwrap_body_errno_ferror(23 /* posix/stdio/gp/fputc */, EOF, stream)
+mkwrap_bottom(fputc, (c, stream))
+
+
+
+// ifndef putc 
+/* Wrapper for fputs() */
+mkwrap_top(int , fputs, (const char *restrict s, FILE *restrict stream), (s, stream), (const char *restrict , FILE *restrict ), (EOF))
+mkwrap_body_gate(fputs, (s, stream), 0, 0x1000000ULL)
+mkwrap_body_args((intptr_t) s, (intptr_t) stream)
+	static const int valid_errnos[] = {
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EFBIG
+		EFBIG,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef ENOSPC
+		ENOSPC,
+	  #endif
+	  #ifdef ENXIO
+		ENXIO,
+	  #endif
+	  #ifdef EPIPE
+		EPIPE,
+	  #endif
+	};
+mkwrap_body_errno_ferror(24 /* posix/stdio/gp/fputs */, EOF, stream)
+mkwrap_bottom(fputs, (s, stream))
+
+
+// endif 
+
+/* Wrapper for putc() */
+mkwrap_top(int , putc, (int c, FILE *stream), (c, stream), (int , FILE *), (EOF))
+mkwrap_body_gate(putc, (c, stream), 0, 0x2000000ULL)
+mkwrap_body_args(c, (intptr_t) stream)
+	static const int valid_errnos[] = {
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EFBIG
+		EFBIG,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef ENOSPC
+		ENOSPC,
+	  #endif
+	  #ifdef ENXIO
+		ENXIO,
+	  #endif
+	  #ifdef EPIPE
+		EPIPE,
+	  #endif
+	};
+mkwrap_body_errno_ferror(25 /* posix/stdio/gp/putc */, EOF, stream)
+mkwrap_bottom(putc, (c, stream))
+
+
+
+/* Wrapper for putchar() */
+mkwrap_top(int , putchar, (int c), (c), (int ), (EOF))
+mkwrap_body_gate(putchar, (c), 0, 0x4000000ULL)
+mkwrap_body_args(c)
+	static const int valid_errnos[] = {
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EFBIG
+		EFBIG,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef ENOSPC
+		ENOSPC,
+	  #endif
+	  #ifdef ENXIO
+		ENXIO,
+	  #endif
+	  #ifdef EPIPE
+		EPIPE,
+	  #endif
+	};
+mkwrap_body_errno_ferror(26 /* posix/stdio/gp/putchar */, EOF, stdout)
+mkwrap_bottom(putchar, (c))
+
+
+
+/* Wrapper for puts() */
+mkwrap_top(int , puts, (const char *s), (s), (const char *), (EOF))
+mkwrap_body_gate(puts, (s), 0, 0x8000000ULL)
+mkwrap_body_args((intptr_t) s)
+	static const int valid_errnos[] = {
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EFBIG
+		EFBIG,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef ENOSPC
+		ENOSPC,
+	  #endif
+	  #ifdef ENXIO
+		ENXIO,
+	  #endif
+	  #ifdef EPIPE
+		EPIPE,
+	  #endif
+	};
+mkwrap_body_errno_ferror(27 /* posix/stdio/gp/puts */, EOF, stdout)
+mkwrap_bottom(puts, (s))
+
+
+
+/* Wrapper for ungetc() */
+mkwrap_top(int , ungetc, (int c, FILE *stream), (c, stream), (int , FILE *), (EOF))
+mkwrap_body_gate(ungetc, (c, stream), 0, 0x10000000ULL)
+mkwrap_body_args(c, (intptr_t) stream)
+mkwrap_body_hardcoded(28 /* posix/stdio/gp/ungetc */, EOF)
+mkwrap_bottom(ungetc, (c, stream))
+
+
+
+/* Wrapper for getdelim() */
+mkwrap_top(ssize_t , getdelim, (char **restrict lineptr, size_t *restrict n, int delimiter, FILE *restrict stream), (lineptr, n, delimiter, stream), (char **restrict , size_t *restrict , int , FILE *restrict ), (-1))
+mkwrap_body_gate(getdelim, (lineptr, n, delimiter, stream), 0, 0x20000000ULL)
+mkwrap_body_args((intptr_t) lineptr, (intptr_t) n, delimiter, (intptr_t) stream)
+	static const int valid_errnos[] = {
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef ENXIO
+		ENXIO,
+	  #endif
+	  #ifdef EOVERFLOW
+		EOVERFLOW,
+	  #endif
+	  #ifdef INVAL
+		INVAL,
+	  #endif
+	};
+mkwrap_body_errno_ferror(29 /* posix/stdio/gp/getdelim */, -1, stream)
+mkwrap_bottom(getdelim, (lineptr, n, delimiter, stream))
+
+
+
+
+/* Wrapper for getline() */
+mkwrap_top(ssize_t , getline, (char **restrict lineptr, size_t *restrict n, FILE *restrict stream), (lineptr, n, stream), (char **restrict , size_t *restrict , FILE *restrict ), (-1))
+mkwrap_body_gate(getline, (lineptr, n, stream), 0, 0x40000000ULL)
+mkwrap_body_args((intptr_t) lineptr, (intptr_t) n, (intptr_t) stream)
+	static const int valid_errnos[] = {
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef ENXIO
+		ENXIO,
+	  #endif
+	  #ifdef EOVERFLOW
+		EOVERFLOW,
+	  #endif
+	  #ifdef INVAL
+		INVAL,
+	  #endif
+	};
+mkwrap_body_errno_ferror(30 /* posix/stdio/gp/getline */, -1, stream)
+mkwrap_bottom(getline, (lineptr, n, stream))
+
+
+
+// Variants with a variable number of arguments need a custom definition. 
+
+// int fprintf(FILE *restrict stream, const char *restrict format, ...); 
+// int printf(const char *restrict format, ...); 
+// int dprintf(int fildes, const char *restrict format, ...); 
+
+
+/* Wrapper for vfprintf() */
+mkwrap_top(int , vfprintf, (FILE *restrict stream, const char *restrict format, va_list ap), (stream, format, ap), (FILE *restrict , const char *restrict , va_list ), (-1))
+mkwrap_body_gate(vfprintf, (stream, format, ap), 0, 0x80000000ULL)
+mkwrap_body_args((intptr_t) stream, (intptr_t) format, 0)
+	static const int valid_errnos[] = {
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EFBIG
+		EFBIG,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef ENOSPC
+		ENOSPC,
+	  #endif
+	  #ifdef ENXIO
+		ENXIO,
+	  #endif
+	  #ifdef EPIPE
+		EPIPE,
+	  #endif
+	  #ifdef EILSEQ
+		EILSEQ,
+	  #endif
+	  #ifdef EOVERFLOW
+		EOVERFLOW,
+	  #endif
+	};
+mkwrap_body_errno_ferror(31 /* posix/stdio/sp/vfprintf */, -1, stream)
+mkwrap_bottom(vfprintf, (stream, format, ap))
+
+
+
+/* Wrapper for vprintf() */
+mkwrap_top(int , vprintf, (const char *restrict format, va_list ap), (format, ap), (const char *restrict , va_list ), (-1))
+mkwrap_body_gate(vprintf, (format, ap), 0, 0x100000000ULL)
+mkwrap_body_args((intptr_t) format, 0)
+	static const int valid_errnos[] = {
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EFBIG
+		EFBIG,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef ENOSPC
+		ENOSPC,
+	  #endif
+	  #ifdef ENXIO
+		ENXIO,
+	  #endif
+	  #ifdef EPIPE
+		EPIPE,
+	  #endif
+	  #ifdef EILSEQ
+		EILSEQ,
+	  #endif
+	  #ifdef EOVERFLOW
+		EOVERFLOW,
+	  #endif
+	};
+mkwrap_body_errno_ferror(32 /* posix/stdio/sp/vprintf */, -1, stdout)
+mkwrap_bottom(vprintf, (format, ap))
+
+
+
+// int fscanf(FILE *restrict stream, const char *restrict format, ...); 
+// int scanf(const char *restrict format, ...); 
+
+/* Wrapper for vdprintf() */
+mkwrap_top(int , vdprintf, (int fildes, const char *restrict format, va_list ap), (fildes, format, ap), (int , const char *restrict , va_list ), (-1))
+mkwrap_body_gate(vdprintf, (fildes, format, ap), 0, 0x200000000ULL)
+mkwrap_body_args(fildes, (intptr_t) format, 0)
+	static const int valid_errnos[] = {
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EFBIG
+		EFBIG,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef ENOSPC
+		ENOSPC,
+	  #endif
+	  #ifdef ENXIO
+		ENXIO,
+	  #endif
+	  #ifdef EPIPE
+		EPIPE,
+	  #endif
+	  #ifdef EILSEQ
+		EILSEQ,
+	  #endif
+	  #ifdef EOVERFLOW
+		EOVERFLOW,
+	  #endif
+	};
+mkwrap_body_errno(33 /* posix/stdio/sp/vdprintf */, -1)
+mkwrap_bottom(vdprintf, (fildes, format, ap))
+
+
+
+/* Wrapper for vfscanf() */
+mkwrap_top(int , vfscanf, (FILE *restrict stream, const char *restrict format, va_list arg), (stream, format, arg), (FILE *restrict , const char *restrict , va_list ), (EOF))
+mkwrap_body_gate(vfscanf, (stream, format, arg), 0, 0x400000000ULL)
+mkwrap_body_args((intptr_t) stream, (intptr_t) format, 0)
+	static const int valid_errnos[] = {
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef ENXIO
+		ENXIO,
+	  #endif
+	  #ifdef EOVERFLOW
+		EOVERFLOW,
+	  #endif
+	  #ifdef EILSEQ
+		EILSEQ,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	};
+mkwrap_body_errno_ferror(34 /* posix/stdio/sp/vfscanf */, EOF, stream)
+mkwrap_bottom(vfscanf, (stream, format, arg))
+
+
+
+/* Wrapper for vscanf() */
+mkwrap_top(int , vscanf, (const char *restrict format, va_list arg), (format, arg), (const char *restrict , va_list ), (EOF))
+mkwrap_body_gate(vscanf, (format, arg), 0, 0x800000000ULL)
+mkwrap_body_args((intptr_t) format, 0)
+	static const int valid_errnos[] = {
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef ENXIO
+		ENXIO,
+	  #endif
+	  #ifdef EOVERFLOW
+		EOVERFLOW,
+	  #endif
+	  #ifdef EILSEQ
+		EILSEQ,
+	  #endif
+	};
+mkwrap_body_errno_ferror(35 /* posix/stdio/sp/vscanf */, EOF, stdin)
+mkwrap_bottom(vscanf, (format, arg))
+
+
+
+// Other functions not worth categorizing 
+
+
+/* Wrapper for remove() */
+mkwrap_top(int , remove, (const char *filename), (filename), (const char *), (-1))
+mkwrap_body_gate(remove, (filename), 0, 0x1000000000ULL)
+mkwrap_body_args((intptr_t) filename)
+	static const int valid_errnos[] = {
+	  #ifdef EACCES
+		EACCES,
+	  #endif
+	  #ifdef EBUSY
+		EBUSY,
+	  #endif
+	  #ifdef EEXIST
+		EEXIST,
+	  #endif
+	  #ifdef ENOTEMPTY
+		ENOTEMPTY,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ELOOP
+		ELOOP,
+	  #endif
+	  #ifdef ENAMETOOLONG
+		ENAMETOOLONG,
+	  #endif
+	  #ifdef ENOENT
+		ENOENT,
+	  #endif
+	  #ifdef ENOTDIR
+		ENOTDIR,
+	  #endif
+	  #ifdef EPERM
+		EPERM,
+	  #endif
+	  #ifdef EROFS
+		EROFS,
+	  #endif
+	  #ifdef ETXTBSY
+		ETXTBSY,
+	  #endif
+	};
+mkwrap_body_errno(36 /* posix/stdio/remove */, -1)
+mkwrap_bottom(remove, (filename))
+
+
+
+/* Wrapper for setvbuf() */
+mkwrap_top(int , setvbuf, (FILE *restrict stream, char *restrict buf, int type, size_t size), (stream, buf, type, size), (FILE *restrict , char *restrict , int , size_t ), (EOF))
+mkwrap_body_gate(setvbuf, (stream, buf, type, size), 0, 0x2000000000ULL)
+mkwrap_body_args((intptr_t) stream, (intptr_t) buf, type, size)
+	static const int valid_errnos[] = {
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	};
+mkwrap_body_errno(37 /* posix/stdio/setvbuf */, EOF)
+mkwrap_bottom(setvbuf, (stream, buf, type, size))
+
+
+
+/* Wrapper for ftrylockfile() */
+mkwrap_top(int , ftrylockfile, (FILE *file), (file), (FILE *), (1))
+mkwrap_body_gate(ftrylockfile, (file), 0, 0x4000000000ULL)
+mkwrap_body_args((intptr_t) file)
+mkwrap_body_hardcoded(38 /* posix/stdio/ftrylockfile */, 1)
+mkwrap_bottom(ftrylockfile, (file))
+
+
+
+
+/* Wrapper for fflush() */
+mkwrap_top(int , fflush, (FILE *stream), (stream), (FILE *), (EOF))
+mkwrap_body_gate(fflush, (stream), 0, 0x8000000000ULL)
+mkwrap_body_args((intptr_t) stream)
+	static const int valid_errnos[] = {
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EFBIG
+		EFBIG,
+	  #endif
+	  #ifdef EINTR
+		EINTR,
+	  #endif
+	  #ifdef EIO
+		EIO,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef ENOSPC
+		ENOSPC,
+	  #endif
+	  #ifdef EPIPE
+		EPIPE,
+	  #endif
+	  #ifdef ENXIO
+		ENXIO,
+	  #endif
+	};
+mkwrap_body_errno_ferror(39 /* posix/stdio/fflush */, EOF, stream)
+mkwrap_bottom(fflush, (stream))
+
+
@@ -0,0 +1,68 @@
+
+/*
+ * AUTOGENERATED FILE - DO NOT EDIT
+ *
+ * This file was automatically generated by libfiu, do not edit it directly,
+ * but see libfiu's "preload" directory.
+ */
+
+#include "codegen.h"
+
+static const char *const _fiu_watch_names[] = {
+	/*  0 */ "posix/mm/mmap",
+};
+mkwrap_watch()
+
+mkwrap_catalog(
+	"posix/mm/mmap\0"
+)
+
+
+#include <unistd.h>
+#include <errno.h>
+#include <sys/mman.h>
+
+
+#if LIBFIU_CAN_DEFINE_64BIT_FUNCTIONS && defined _POSIX_MAPPED_FILES
+
+
+/* Wrapper for mmap64() */
+mkwrap_top(void *, mmap64, (void *addr, size_t length, int prot, int flags, int fd, 		off64_t offset), (addr, length, prot, flags, fd, offset), (void *, size_t , int , int , int , off64_t ), (MAP_FAILED))
+mkwrap_body_gate(mmap64, (addr, length, prot, flags, fd, offset), 0, 0x1ULL)
+mkwrap_body_args((intptr_t) addr, length, prot, flags, fd, offset)
+	static const int valid_errnos[] = {
+	  #ifdef EACCES
+		EACCES,
+	  #endif
+	  #ifdef EAGAIN
+		EAGAIN,
+	  #endif
+	  #ifdef EBADF
+		EBADF,
+	  #endif
+	  #ifdef EINVAL
+		EINVAL,
+	  #endif
+	  #ifdef ENFILE
+		ENFILE,
+	  #endif
+	  #ifdef ENODEV
+		ENODEV,
+	  #endif
+	  #ifdef ENOMEM
+		ENOMEM,
+	  #endif
+	  #ifdef EPERM
+		EPERM,
+	  #endif
+	  #ifdef ETXTBSY
+		ETXTBSY,
+	  #endif
+	};
+mkwrap_body_errno(0 /* posix/mm/mmap */, MAP_FAILED)
+mkwrap_bottom(mmap64, (addr, length, prot, flags, fd, offset))
+
+
+#endif
+
+
@@ -10,13 +10,25 @@
 
 static void __attribute__((constructor)) fiu_run_init(void)
 {
-	char *fiu_fifo_env, *fiu_enable_env;
+	char *fiu_fifo_env, *fiu_lazy_env, *fiu_enable_env;
+	int lazy_signum = 0;
 
 	fiu_init(0);
 
+	/* If set, it's the signal number that will trigger the creation of
+	 * the remote control pipes (see fiu_rc_fifo_lazy()). */
+	fiu_lazy_env = getenv("FIU_CTRL_LAZY");
+	if (fiu_lazy_env && *fiu_lazy_env != '\0')
+		lazy_signum = atoi(fiu_lazy_env);
+
 	fiu_fifo_env = getenv("FIU_CTRL_FIFO");
 	if (fiu_fifo_env && *fiu_fifo_env != '\0') {
-		if (fiu_rc_fifo(fiu_fifo_env) < 0) {
+		if (lazy_signum > 0) {
+			if (fiu_rc_fifo_lazy(fiu_fifo_env, lazy_signum) < 0) {
+				perror("fiu_run_preload: Error setting up lazy "
+				       "RC fifo");
+			}
+		} else if (fiu_rc_fifo(fiu_fifo_env) < 0) {
 			perror("fiu_run_preload: Error opening RC fifo");
 		}
 	}
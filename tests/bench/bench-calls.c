@@ -0,0 +1,280 @@
+
+/*
+ * Measures how long some of the wrapped functions take per call, on 1 to N
+ * threads at the same time, to see the overhead of the POSIX preload library
+ * in each configuration:
+ *
+ *  - native: run without the library.
+ *  - preload: with the library, and nothing enabled.
+ *  - nomatch: with points of failure enabled next to the measured ones (in
+ *    the same modules), but not on them.
+ *  - wildcard: with wildcards covering all the measured ones enabled, that
+ *    never fail, so the calls go all the way through fiu_fail().
+ *
+ * None of the enabled points ever fail, as the libc and the benchmark itself
+ * call other wrapped functions (pthread_create() calls calloc(), for
+ * example).
+ *
+ * The configuration is only used to decide what to enable, running with or
+ * without the library is up to the caller (see the Makefile).
+ *
+ * The results are written as CSV (with a header if -H is given), or as JSON
+ * with -j, one line per function and number of threads.
+ *
+ * Usage: bench-calls [-j] [-H] CONFIG [MAXTHREADS [NCALLS]]
+ */
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <fiu-control.h>
+#include <fiu.h>
+
+static long ncalls = 200000;
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void die(const char *msg)
+{
+	perror(msg);
+	exit(1);
+}
+
+static void *bench_read(void *unused)
+{
+	char buf[64];
+	long i;
+	int fd;
+
+	fd = open("/dev/zero", O_RDONLY);
+	if (fd < 0)
+		die("open");
+	for (i = 0; i < ncalls; i++)
+		if (read(fd, buf, sizeof(buf)) != sizeof(buf))
+			die("read");
+	close(fd);
+	return NULL;
+}
+
+static void *bench_write(void *unused)
+{
+	char buf[64] = {0};
+	long i;
+	int fd;
+
+	fd = open("/dev/null", O_WRONLY);
+	if (fd < 0)
+		die("open");
+	for (i = 0; i < ncalls; i++)
+		if (write(fd, buf, sizeof(buf)) != sizeof(buf))
+			die("write");
+	close(fd);
+	return NULL;
+}
+
+static void *bench_malloc(void *unused)
+{
+	long i;
+	void *p;
+
+	for (i = 0; i < ncalls; i++) {
+		p = malloc(64);
+		if (p == NULL)
+			die("malloc");
+		free(p);
+	}
+	return NULL;
+}
+
+/* Each call is an fopen() and an fclose(). */
+static void *bench_fopen(void *unused)
+{
+	long i;
+	FILE *f;
+
+	for (i = 0; i < ncalls; i++) {
+		f = fopen("/dev/null", "r");
+		if (f == NULL)
+			die("fopen");
+		fclose(f);
+	}
+	return NULL;
+}
+
+static void *bench_fgets(void *unused)
+{
+	char buf[64];
+	long i;
+	FILE *f;
+
+	f = fopen("/dev/zero", "r");
+	if (f == NULL)
+		die("fopen");
+	for (i = 0; i < ncalls; i++)
+		if (fgets(buf, sizeof(buf), f) == NULL)
+			die("fgets");
+	fclose(f);
+	return NULL;
+}
+
+/* Each call is a send() and a recv() of what was sent. */
+static void *bench_sendrecv(void *unused)
+{
+	char buf[64] = {0};
+	int fds[2];
+	long i;
+
+	if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0)
+		die("socketpair");
+	for (i = 0; i < ncalls; i++) {
+		if (send(fds[0], buf, sizeof(buf), 0) != sizeof(buf))
+			die("send");
+		if (recv(fds[1], buf, sizeof(buf), MSG_WAITALL) != sizeof(buf))
+			die("recv");
+	}
+	close(fds[0]);
+	close(fds[1]);
+	return NULL;
+}
+
+static const struct {
+	const char *name;
+	void *(*func)(void *);
+} benches[] = {
+	{"read", bench_read},
+	{"write", bench_write},
+	{"malloc", bench_malloc},
+	{"fopen", bench_fopen},
+	{"fgets", bench_fgets},
+	{"sendrecv", bench_sendrecv},
+};
+
+/* What each configuration enables, see above. */
+static const struct {
+	const char *name;
+	const char *cmds[4];
+} configs[] = {
+	{"native", {NULL}},
+	{"preload", {NULL}},
+	{"nomatch",
+	 {"enable_random name=posix/io/rw/pread,probability=0",
+	  "enable_random name=libc/mm/calloc,probability=0",
+	  "enable_random name=posix/stdio/gp/fgetc,probability=0",
+	  "enable_random name=posix/io/net/sendto,probability=0"}},
+	{"wildcard",
+	 {"enable_random name=posix/*,probability=0",
+	  "enable_random name=libc/*,probability=0", NULL}},
+};
+
+/* Runs the function on the given number of threads at the same time, and
+ * returns how long each call took, in nanoseconds. */
+static double run(void *(*func)(void *), int nthreads)
+{
+	pthread_t threads[nthreads];
+	double start;
+	int i;
+
+	start = now();
+	for (i = 0; i < nthreads; i++)
+		if (pthread_create(&threads[i], NULL, func, NULL) != 0)
+			die("pthread_create");
+	for (i = 0; i < nthreads; i++)
+		pthread_join(threads[i], NULL);
+
+	return (now() - start) * 1e9 / ncalls;
+}
+
+int main(int argc, char **argv)
+{
+	int json = 0, header = 0, maxthreads, nthreads, next, opt;
+	const char *config;
+	char *error;
+	unsigned int b, c, i;
+	double ns;
+
+	while ((opt = getopt(argc, argv, "jH")) != -1) {
+		switch (opt) {
+		case 'j':
+			json = 1;
+			break;
+		case 'H':
+			header = 1;
+			break;
+		default:
+			goto usage;
+		}
+	}
+	if (optind >= argc)
+		goto usage;
+
+	config = argv[optind];
+	maxthreads = sysconf(_SC_NPROCESSORS_ONLN);
+	if (optind + 1 < argc)
+		maxthreads = atoi(argv[optind + 1]);
+	if (optind + 2 < argc)
+		ncalls = atol(argv[optind + 2]);
+	if (maxthreads < 1 || ncalls < 1)
+		goto usage;
+
+	for (c = 0; c < sizeof(configs) / sizeof(configs[0]); c++)
+		if (strcmp(configs[c].name, config) == 0)
+			break;
+	if (c == sizeof(configs) / sizeof(configs[0]))
+		goto usage;
+
+	fiu_init(0);
+	for (i = 0; i < 4 && configs[c].cmds[i] != NULL; i++) {
+		if (fiu_rc_string(configs[c].cmds[i], &error) != 0) {
+			fprintf(stderr, "%s: %s\n", configs[c].cmds[i], error);
+			return 1;
+		}
+	}
+
+	if (header && !json)
+		printf("config,function,threads,calls,ns_per_call\n");
+
+	for (b = 0; b < sizeof(benches) / sizeof(benches[0]); b++) {
+		/* Warm up, so the one-time costs are not counted. */
+		run(benches[b].func, 1);
+
+		for (nthreads = 1; nthreads <= maxthreads; nthreads = next) {
+			ns = run(benches[b].func, nthreads);
+			if (json)
+				printf("{\"config\": \"%s\", \"function\": "
+				       "\"%s\", \"threads\": %d, \"calls\": "
+				       "%ld, \"ns_per_call\": %.1f}\n",
+				       config, benches[b].name, nthreads,
+				       ncalls, ns);
+			else
+				printf("%s,%s,%d,%ld,%.1f\n", config,
+				       benches[b].name, nthreads, ncalls, ns);
+			fflush(stdout);
+
+			/* Double them each time, but always end with
+			 * MAXTHREADS. */
+			next = nthreads * 2;
+			if (nthreads < maxthreads && next > maxthreads)
+				next = maxthreads;
+		}
+	}
+
+	return 0;
+
+usage:
+	fprintf(stderr, "Usage: bench-calls [-j] [-H] "
+	                "native|preload|nomatch|wildcard "
+	                "[MAXTHREADS [NCALLS]]\n");
+	return 1;
+}
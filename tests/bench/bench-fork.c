@@ -0,0 +1,149 @@
+
+/*
+ * Measures the fork-to-ready latency (from the parent calling fork() until
+ * the child runs its own code) of a process with many children, like a
+ * prefork server, with:
+ *
+ *  - none: no remote control.
+ *  - eager: fiu_rc_fifo(), which creates the named pipes and a thread in
+ *    every child.
+ *  - lazy: fiu_rc_fifo_lazy(), which does nothing in the children until
+ *    they're signalled.
+ *
+ * Usage: bench-fork [NCHILDREN]
+ */
+
+#include <fiu-control.h>
+#include <fiu.h>
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int cmp_double(const void *a, const void *b)
+{
+	double da = *(const double *)a, db = *(const double *)b;
+
+	return (da > db) - (da < db);
+}
+
+/* Forks n children and reports the latencies. Runs in its own process, so
+ * the remote control setup does not leak into the next run. */
+static void run(const char *mode, int n, const char *basename)
+{
+	double *ready, *lat, start, total;
+	pid_t *pids;
+	int pfd[2], i;
+	char c;
+
+	fiu_init(0);
+
+	if (strcmp(mode, "eager") == 0) {
+		if (fiu_rc_fifo(basename) != 0) {
+			perror("fiu_rc_fifo");
+			exit(1);
+		}
+	} else if (strcmp(mode, "lazy") == 0) {
+		if (fiu_rc_fifo_lazy(basename, SIGUSR1) != 0) {
+			perror("fiu_rc_fifo_lazy");
+			exit(1);
+		}
+	}
+
+	/* The children write the time they became ready here. */
+	ready = mmap(NULL, sizeof(double) * n, PROT_READ | PROT_WRITE,
+	             MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	lat = malloc(sizeof(double) * n);
+	pids = malloc(sizeof(pid_t) * n);
+	if (ready == MAP_FAILED || lat == NULL || pids == NULL) {
+		perror("allocating");
+		exit(1);
+	}
+
+	/* The children stay alive (like workers would) until we close the
+	 * pipe. */
+	if (pipe(pfd) != 0) {
+		perror("pipe");
+		exit(1);
+	}
+
+	start = now();
+	for (i = 0; i < n; i++) {
+		lat[i] = now();
+		pids[i] = fork();
+		if (pids[i] == 0) {
+			ready[i] = now();
+			close(pfd[1]);
+			while (read(pfd[0], &c, 1) > 0)
+				;
+			exit(0);
+		} else if (pids[i] < 0) {
+			perror("fork");
+			exit(1);
+		}
+	}
+	total = now() - start;
+
+	close(pfd[1]);
+	for (i = 0; i < n; i++)
+		waitpid(pids[i], NULL, 0);
+
+	for (i = 0; i < n; i++)
+		lat[i] = ready[i] - lat[i];
+	qsort(lat, n, sizeof(double), cmp_double);
+
+	printf("%-6s %6d children: total %8.2f ms, fork-to-ready "
+	       "p50 %7.1f us, p99 %7.1f us\n",
+	       mode, n, total * 1000, lat[n / 2] * 1e6,
+	       lat[(int)(n * 0.99)] * 1e6);
+}
+
+int main(int argc, char **argv)
+{
+	const char *modes[] = {"none", "eager", "lazy", NULL};
+	char dir[] = "/tmp/fiu-bench-XXXXXX";
+	char basename[64];
+	int n = 512, i;
+	pid_t pid;
+
+	if (argc > 1)
+		n = atoi(argv[1]);
+	if (n <= 0) {
+		fprintf(stderr, "Usage: bench-fork [NCHILDREN]\n");
+		return 1;
+	}
+
+	if (mkdtemp(dir) == NULL) {
+		perror("mkdtemp");
+		return 1;
+	}
+	snprintf(basename, sizeof(basename), "%s/ctrl", dir);
+
+	for (i = 0; modes[i] != NULL; i++) {
+		fflush(stdout);
+		pid = fork();
+		if (pid == 0) {
+			run(modes[i], n, basename);
+			exit(0);
+		}
+		waitpid(pid, NULL, 0);
+	}
+
+	rmdir(dir);
+
+	return 0;
+}
+
@@ -0,0 +1,134 @@
+
+/*
+ * Measures the startup cost of the POSIX preload library, by running a
+ * trivial program (/bin/true) many times:
+ *
+ *  - native: without the library.
+ *  - preload: with it, resolving the original functions lazily.
+ *  - bindnow: with it and LD_BIND_NOW set, which resolves all of them at
+ *    startup (and makes the dynamic linker bind everything too).
+ *
+ * Usage: bench-startup PRELOAD_LIBRARY [NRUNS]
+ */
+
+#include <spawn.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <time.h>
+
+extern char **environ;
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static int cmp_double(const void *a, const void *b)
+{
+	double da = *(const double *)a, db = *(const double *)b;
+
+	return (da > db) - (da < db);
+}
+
+/* Builds the environment for the children: ours without LD_PRELOAD and
+ * LD_BIND_NOW, plus the given variables (which can be NULL). */
+static char **make_env(char *preload, char *bind_now)
+{
+	char **env;
+	int n = 0, i, j = 0;
+
+	while (environ[n] != NULL)
+		n++;
+
+	env = malloc(sizeof(char *) * (n + 3));
+	if (env == NULL) {
+		perror("malloc");
+		exit(1);
+	}
+
+	for (i = 0; i < n; i++) {
+		if (strncmp(environ[i], "LD_PRELOAD=", 11) == 0 ||
+		    strncmp(environ[i], "LD_BIND_NOW=", 12) == 0)
+			continue;
+		env[j++] = environ[i];
+	}
+	if (preload != NULL)
+		env[j++] = preload;
+	if (bind_now != NULL)
+		env[j++] = bind_now;
+	env[j] = NULL;
+
+	return env;
+}
+
+static void run(const char *mode, char **env, int n)
+{
+	char *argv[] = {"/bin/true", NULL};
+	double *lat, start, total;
+	pid_t pid;
+	int i, status;
+
+	lat = malloc(sizeof(double) * n);
+	if (lat == NULL) {
+		perror("malloc");
+		exit(1);
+	}
+
+	/* One run to warm up the caches. */
+	if (posix_spawn(&pid, argv[0], NULL, NULL, argv, env) != 0) {
+		perror("posix_spawn");
+		exit(1);
+	}
+	waitpid(pid, &status, 0);
+	if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+		fprintf(stderr, "%s: %s failed\n", mode, argv[0]);
+		exit(1);
+	}
+
+	start = now();
+	for (i = 0; i < n; i++) {
+		lat[i] = now();
+		if (posix_spawn(&pid, argv[0], NULL, NULL, argv, env) != 0) {
+			perror("posix_spawn");
+			exit(1);
+		}
+		waitpid(pid, NULL, 0);
+		lat[i] = now() - lat[i];
+	}
+	total = now() - start;
+
+	qsort(lat, n, sizeof(double), cmp_double);
+
+	printf("%-8s %6d runs: %7.1f us/run, p50 %7.1f us, p99 %7.1f us\n",
+	       mode, n, total / n * 1e6, lat[n / 2] * 1e6,
+	       lat[(int)(n * 0.99)] * 1e6);
+
+	free(lat);
+}
+
+int main(int argc, char **argv)
+{
+	char preload[4096];
+	int n = 2000;
+
+	if (argc > 2)
+		n = atoi(argv[2]);
+	if (argc < 2 || n <= 0) {
+		fprintf(stderr, "Usage: bench-startup PRELOAD_LIBRARY "
+		                "[NRUNS]\n");
+		return 1;
+	}
+
+	snprintf(preload, sizeof(preload), "LD_PRELOAD=%s", argv[1]);
+
+	run("native", make_env(NULL, NULL), n);
+	run("preload", make_env(preload, NULL), n);
+	run("bindnow", make_env(preload, "LD_BIND_NOW=1"), n);
+
+	return 0;
+}
@@ -0,0 +1,97 @@
+
+/*
+ * Measures the cost of a stdio-heavy workload (fgets() and fputs() loops,
+ * checking ferror() along the way, and reopening the files every now and
+ * then), on several threads at the same time. It is meant to be run with and
+ * without the POSIX preload library, to see its overhead.
+ *
+ * Usage: bench-stdio LABEL [NTHREADS [NLOOPS]]
+ */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+static int nloops = 200000;
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void *worker(void *unused)
+{
+	FILE *in = NULL, *out = NULL;
+	char buf[128];
+	int i;
+
+	for (i = 0; i < nloops; i++) {
+		if (i % 1000 == 0) {
+			if (in != NULL)
+				fclose(in);
+			if (out != NULL)
+				fclose(out);
+			in = fopen("/dev/zero", "r");
+			out = fopen("/dev/null", "w");
+			if (in == NULL || out == NULL) {
+				perror("fopen");
+				exit(1);
+			}
+		}
+
+		if (fgets(buf, sizeof(buf), in) == NULL || ferror(in)) {
+			fprintf(stderr, "fgets failed\n");
+			exit(1);
+		}
+
+		if (fputs("some line of text\n", out) == EOF || ferror(out)) {
+			fprintf(stderr, "fputs failed\n");
+			exit(1);
+		}
+	}
+
+	fclose(in);
+	fclose(out);
+	return NULL;
+}
+
+int main(int argc, char **argv)
+{
+	int nthreads = 4, i;
+	double start, total;
+	pthread_t *threads;
+
+	if (argc < 2) {
+		fprintf(stderr, "Usage: bench-stdio LABEL [NTHREADS [NLOOPS]]\n");
+		return 1;
+	}
+	if (argc > 2)
+		nthreads = atoi(argv[2]);
+	if (argc > 3)
+		nloops = atoi(argv[3]);
+
+	threads = malloc(sizeof(pthread_t) * nthreads);
+	if (threads == NULL) {
+		perror("malloc");
+		return 1;
+	}
+
+	start = now();
+	for (i = 0; i < nthreads; i++)
+		pthread_create(&threads[i], NULL, worker, NULL);
+	for (i = 0; i < nthreads; i++)
+		pthread_join(threads[i], NULL);
+	total = now() - start;
+
+	printf("%-12s %d threads x %d loops: %8.2f ms, %6.1f ns/loop\n",
+	       argv[1], nthreads, nloops, total * 1000,
+	       total / nloops * 1e9);
+
+	free(threads);
+	return 0;
+}
+
@@ -0,0 +1,89 @@
+
+/*
+ * Measures the cost of creating short-lived threads that use a few wrapped
+ * functions, like a thread-per-connection server would. It is meant to be
+ * run with and without the POSIX preload library, to see its overhead.
+ *
+ * Usage: bench-threads LABEL [NTHREADS]
+ */
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* Uses a handful of different wrapped functions, once each. */
+static void *worker(void *unused)
+{
+	char buf[64];
+	char *p, *s;
+	int fd;
+
+	p = malloc(32);
+	p = realloc(p, 64);
+	s = strdup("something");
+	free(s);
+	free(p);
+	free(calloc(1, 32));
+
+	fd = open("/dev/zero", O_RDONLY);
+	if (fd >= 0) {
+		if (read(fd, buf, sizeof(buf)) < 0)
+			perror("read");
+		close(fd);
+	}
+
+	fd = open("/dev/null", O_WRONLY);
+	if (fd >= 0) {
+		if (write(fd, buf, sizeof(buf)) < 0)
+			perror("write");
+		fsync(fd);
+		close(fd);
+	}
+
+	return NULL;
+}
+
+int main(int argc, char **argv)
+{
+	int n = 20000, i;
+	double start, total;
+	pthread_t thread;
+
+	if (argc < 2) {
+		fprintf(stderr, "Usage: bench-threads LABEL [NTHREADS]\n");
+		return 1;
+	}
+	if (argc > 2)
+		n = atoi(argv[2]);
+
+	/* Warm up, so the process-wide one-time costs are not counted. */
+	worker(NULL);
+
+	start = now();
+	for (i = 0; i < n; i++) {
+		if (pthread_create(&thread, NULL, worker, NULL) != 0) {
+			perror("pthread_create");
+			return 1;
+		}
+		pthread_join(thread, NULL);
+	}
+	total = now() - start;
+
+	printf("%-12s %6d threads: %8.2f ms, %6.2f us/thread\n", argv[1], n,
+	       total * 1000, total / n * 1e6);
+
+	return 0;
+}
+
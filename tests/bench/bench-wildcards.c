@@ -0,0 +1,203 @@
+
+/*
+ * Measures how long fiu_fail() takes to look up names against different sets
+ * of points of failure:
+ *
+ *  - final: no wildcards, like "fin/17".
+ *  - trailing: a '*' at the end, after "none/17/" for example.
+ *  - interior: glob patterns with a '*' in the middle, between "svc-17/"
+ *    and "/write".
+ *  - question: glob patterns with '?' in them, like "shard-17/??????".
+ *  - mixed: all of the above at once.
+ *
+ * Each set has NPATTERNS of each kind, which are enabled with probability 0
+ * so they never fail; a small NPATTERNS shows what lookups cost when only a
+ * few points are enabled. Then a list of names is looked up over and over:
+ * some that match one of the patterns ("hit"), and some that match none
+ * ("miss"). There are many more names than fit in the lookup cache, so this
+ * measures the matching itself; with "-c" only a handful of names are used,
+ * to measure the cache instead.
+ *
+ * Usage: bench-wildcards [-c] [NPATTERNS [NLOOKUPS]]
+ */
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <fiu-control.h>
+#include <fiu.h>
+
+/* Number of different names to look up. */
+static int nnames = 100000;
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static void die(const char *msg)
+{
+	fprintf(stderr, "%s\n", msg);
+	exit(1);
+}
+
+/* Pattern of each kind, and names that match it (hit) and that almost do
+ * (miss), by number. */
+static const struct {
+	const char *name;
+	const char *pattern;
+	const char *hit;
+	const char *miss;
+} kinds[] = {
+	{"final", "fin/%d", "fin/%d", "fin/%d/%d"},
+	{"trailing", "none/%d/*", "none/%d/x/%d", "nonf/%d/x/%d"},
+	{"interior", "glob:svc-%d/*/write", "svc-%d/db%d/write",
+	 "svc-%d/db%d/read"},
+	{"question", "glob:shard-%d/??????", "shard-%d/%06d", "shard-%d/%05d"},
+};
+
+#define NKINDS (sizeof(kinds) / sizeof(kinds[0]))
+
+static void enable_kind(int k, int npatterns)
+{
+	char name[64];
+	int i;
+
+	for (i = 0; i < npatterns; i++) {
+		snprintf(name, sizeof(name), kinds[k].pattern, i);
+		if (fiu_enable_random(name, 1, NULL, 0, 0) != 0)
+			die("fiu_enable_random() failed");
+	}
+}
+
+static void disable_kind(int k, int npatterns)
+{
+	char name[64];
+	int i;
+
+	for (i = 0; i < npatterns; i++) {
+		snprintf(name, sizeof(name), kinds[k].pattern, i);
+		fiu_disable(name);
+	}
+}
+
+/* Builds nnames names that hit (or miss) the patterns of the given kinds,
+ * picking the kind and the pattern at random. */
+static char **make_names(const int *ks, int nks, int npatterns, bool hit)
+{
+	char buf[64], **names;
+	int i, k;
+
+	names = malloc(sizeof(char *) * nnames);
+	if (names == NULL)
+		die("out of memory");
+
+	for (i = 0; i < nnames; i++) {
+		k = ks[rand() % nks];
+		snprintf(buf, sizeof(buf), hit ? kinds[k].hit : kinds[k].miss,
+		         rand() % npatterns, i);
+		names[i] = strdup(buf);
+		if (names[i] == NULL)
+			die("out of memory");
+	}
+
+	return names;
+}
+
+static void free_names(char **names)
+{
+	int i;
+
+	for (i = 0; i < nnames; i++)
+		free(names[i]);
+	free(names);
+}
+
+/* Looks up the names, and returns how long each lookup took, in
+ * nanoseconds. */
+static double run(char **names, long nlookups)
+{
+	double start;
+	long i;
+
+	/* Warm up, so the one-time costs are not counted. */
+	for (i = 0; i < nnames; i++)
+		fiu_fail(names[i]);
+
+	start = now();
+	for (i = 0; i < nlookups; i++)
+		fiu_fail(names[i % nnames]);
+
+	return (now() - start) * 1e9 / nlookups;
+}
+
+int main(int argc, char **argv)
+{
+	int npatterns = 1000, opt, i, k, nks, hit;
+	long nlookups = 1000000;
+	int ks[NKINDS];
+	const char *set;
+	char **names;
+
+	while ((opt = getopt(argc, argv, "c")) != -1) {
+		switch (opt) {
+		case 'c':
+			nnames = 16;
+			break;
+		default:
+			goto usage;
+		}
+	}
+	if (optind < argc)
+		npatterns = atoi(argv[optind]);
+	if (optind + 1 < argc)
+		nlookups = atol(argv[optind + 1]);
+	if (npatterns < 1 || nlookups < 1)
+		goto usage;
+
+	fiu_init(0);
+	srand(1);
+
+	printf("set,patterns,lookups,names,result,ns_per_lookup\n");
+
+	/* Each kind on its own, and then all of them together. */
+	for (k = 0; k <= (int) NKINDS; k++) {
+		if (k < (int) NKINDS) {
+			ks[0] = k;
+			nks = 1;
+			set = kinds[k].name;
+		} else {
+			for (nks = 0; nks < (int) NKINDS; nks++)
+				ks[nks] = nks;
+			set = "mixed";
+		}
+
+		for (i = 0; i < nks; i++)
+			enable_kind(ks[i], npatterns);
+
+		for (hit = 1; hit >= 0; hit--) {
+			names = make_names(ks, nks, npatterns, hit);
+			printf("%s,%d,%ld,%d,%s,%.1f\n", set, npatterns * nks,
+			       nlookups, nnames, hit ? "hit" : "miss",
+			       run(names, nlookups));
+			fflush(stdout);
+			free_names(names);
+		}
+
+		for (i = 0; i < nks; i++)
+			disable_kind(ks[i], npatterns);
+	}
+
+	return 0;
+
+usage:
+	fprintf(stderr, "Usage: bench-wildcards [-c] [NPATTERNS [NLOOKUPS]]\n");
+	return 1;
+}
@@ -0,0 +1,146 @@
+/* AUTOGENERATED FILE - DO NOT EDIT */
+
+
+#include <fiu.h>
+#include <fiu-control.h>
+#include <stdio.h>
+#include <errno.h>
+#include <unistd.h>
+#include <stdio.h>
+#include <fcntl.h>
+
+
+#if defined __linux__
+
+int success(void) {
+	ssize_t r; off64_t off = 0; FILE *f = tmpfile(); int in, out = fileno(tmpfile()); fputs("0123456789", f); fflush(f); in = fileno(f);
+
+	fiu_disable("linux/io/zc/copy_file_range");
+
+	r = copy_file_range(in, &off, out, NULL, 4, 0);
+
+	if (! (r > 0) ) {
+		printf("linux/io/zc/copy_file_range - success condition is false\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static int external_cb_was_called = 0;
+int external_cb(const char *name, int *failnum,
+		void **failinfo, unsigned int *flags) {
+	external_cb_was_called++;
+
+	*failinfo = (void *) EXDEV;
+
+	return *failnum;
+}
+
+int failure(void) {
+	ssize_t r; off64_t off = 0; FILE *f = tmpfile(); int in, out = fileno(tmpfile()); fputs("0123456789", f); fflush(f); in = fileno(f);
+
+	fiu_enable_external("linux/io/zc/copy_file_range", 1, NULL, 0, external_cb);
+
+	r = copy_file_range(in, &off, out, NULL, 4, 0);
+
+	fiu_disable("linux/io/zc/copy_file_range");
+
+	if (external_cb_was_called != 1) {
+		printf("linux/io/zc/copy_file_range - external callback not invoked\n");
+		return -1;
+	}
+
+	if (! (errno == EXDEV) ) {
+		printf("linux/io/zc/copy_file_range - errno not set appropriately: ");
+		printf("errno:%d, cond:errno == EXDEV\n", errno);
+		return -1;
+	}
+
+	if (! (r == -1) ) {
+		printf("linux/io/zc/copy_file_range - failure condition is false\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static int specific_cb_was_called = 0;
+int specific_cb(const char *name, int *failnum,
+		void **failinfo, unsigned int *flags) {
+	specific_cb_was_called++;
+
+	*failinfo = (void *) EXDEV;
+
+	return *failnum;
+}
+
+int by_id(void) {
+	int wildcard_calls;
+
+	ssize_t r; off64_t off = 0; FILE *f = tmpfile(); int in, out = fileno(tmpfile()); fputs("0123456789", f); fflush(f); in = fileno(f);
+
+	external_cb_was_called = 0;
+
+	fiu_enable_external("linux/io/zc/*", 1, NULL, 0, external_cb);
+	r = copy_file_range(in, &off, out, NULL, 4, 0);
+	if (external_cb_was_called == 0) {
+		printf("linux/io/zc/copy_file_range - wildcard callback not invoked\n");
+		return -1;
+	}
+
+	fiu_enable_external("linux/io/zc/copy_file_range", 1, NULL, 0, specific_cb);
+	r = copy_file_range(in, &off, out, NULL, 4, 0);
+	if (specific_cb_was_called != 1) {
+		printf("linux/io/zc/copy_file_range - specific callback not invoked\n");
+		return -1;
+	}
+
+	if (! (errno == EXDEV) ) {
+		printf("linux/io/zc/copy_file_range - errno not set appropriately by id: ");
+		printf("errno:%d, cond:errno == EXDEV\n", errno);
+		return -1;
+	}
+
+	if (! (r == -1) ) {
+		printf("linux/io/zc/copy_file_range - failure condition by id is false\n");
+		return -1;
+	}
+
+	fiu_disable("linux/io/zc/copy_file_range");
+	wildcard_calls = external_cb_was_called;
+	r = copy_file_range(in, &off, out, NULL, 4, 0);
+	if (specific_cb_was_called != 1 ||
+			external_cb_was_called == wildcard_calls) {
+		printf("linux/io/zc/copy_file_range - wildcard not used after disabling\n");
+		return -1;
+	}
+
+	fiu_disable("linux/io/zc/*");
+	wildcard_calls = external_cb_was_called;
+	r = copy_file_range(in, &off, out, NULL, 4, 0);
+	if (specific_cb_was_called != 1 ||
+			external_cb_was_called != wildcard_calls) {
+		printf("linux/io/zc/copy_file_range - callbacks invoked after disabling\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+int main(void) {
+	int s, f, i;
+
+	s = success();
+	f = failure();
+	i = by_id();
+
+	return s + f + i;
+}
+#else
+
+int main(void) {
+	printf("linux/io/zc/copy_file_range: skipping test\n");
+	return 0;
+}
+#endif
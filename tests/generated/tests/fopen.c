@@ -0,0 +1,136 @@
+/* AUTOGENERATED FILE - DO NOT EDIT */
+
+
+#include <fiu.h>
+#include <fiu-control.h>
+#include <stdio.h>
+#include <errno.h>
+#include <stdio.h>
+
+
+
+int success(void) {
+	FILE *fp;
+
+	fiu_disable("posix/stdio/oc/fopen");
+
+	fp = fopen("/dev/null", "r");
+
+	if (! (fp != NULL) ) {
+		printf("posix/stdio/oc/fopen - success condition is false\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static int external_cb_was_called = 0;
+int external_cb(const char *name, int *failnum,
+		void **failinfo, unsigned int *flags) {
+	external_cb_was_called++;
+
+	*failinfo = (void *) ELOOP;
+
+	return *failnum;
+}
+
+int failure(void) {
+	FILE *fp;
+
+	fiu_enable_external("posix/stdio/oc/fopen", 1, NULL, 0, external_cb);
+
+	fp = fopen("/dev/null", "r");
+
+	fiu_disable("posix/stdio/oc/fopen");
+
+	if (external_cb_was_called != 1) {
+		printf("posix/stdio/oc/fopen - external callback not invoked\n");
+		return -1;
+	}
+
+	if (! (errno == ELOOP) ) {
+		printf("posix/stdio/oc/fopen - errno not set appropriately: ");
+		printf("errno:%d, cond:errno == ELOOP\n", errno);
+		return -1;
+	}
+
+	if (! (fp == NULL) ) {
+		printf("posix/stdio/oc/fopen - failure condition is false\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static int specific_cb_was_called = 0;
+int specific_cb(const char *name, int *failnum,
+		void **failinfo, unsigned int *flags) {
+	specific_cb_was_called++;
+
+	*failinfo = (void *) ELOOP;
+
+	return *failnum;
+}
+
+int by_id(void) {
+	int wildcard_calls;
+
+	FILE *fp;
+
+	external_cb_was_called = 0;
+
+	fiu_enable_external("posix/stdio/oc/*", 1, NULL, 0, external_cb);
+	fp = fopen("/dev/null", "r");
+	if (external_cb_was_called == 0) {
+		printf("posix/stdio/oc/fopen - wildcard callback not invoked\n");
+		return -1;
+	}
+
+	fiu_enable_external("posix/stdio/oc/fopen", 1, NULL, 0, specific_cb);
+	fp = fopen("/dev/null", "r");
+	if (specific_cb_was_called != 1) {
+		printf("posix/stdio/oc/fopen - specific callback not invoked\n");
+		return -1;
+	}
+
+	if (! (errno == ELOOP) ) {
+		printf("posix/stdio/oc/fopen - errno not set appropriately by id: ");
+		printf("errno:%d, cond:errno == ELOOP\n", errno);
+		return -1;
+	}
+
+	if (! (fp == NULL) ) {
+		printf("posix/stdio/oc/fopen - failure condition by id is false\n");
+		return -1;
+	}
+
+	fiu_disable("posix/stdio/oc/fopen");
+	wildcard_calls = external_cb_was_called;
+	fp = fopen("/dev/null", "r");
+	if (specific_cb_was_called != 1 ||
+			external_cb_was_called == wildcard_calls) {
+		printf("posix/stdio/oc/fopen - wildcard not used after disabling\n");
+		return -1;
+	}
+
+	fiu_disable("posix/stdio/oc/*");
+	wildcard_calls = external_cb_was_called;
+	fp = fopen("/dev/null", "r");
+	if (specific_cb_was_called != 1 ||
+			external_cb_was_called != wildcard_calls) {
+		printf("posix/stdio/oc/fopen - callbacks invoked after disabling\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+int main(void) {
+	int s, f, i;
+
+	s = success();
+	f = failure();
+	i = by_id();
+
+	return s + f + i;
+}
@@ -0,0 +1,144 @@
+/* AUTOGENERATED FILE - DO NOT EDIT */
+
+
+#include <fiu.h>
+#include <fiu-control.h>
+#include <stdio.h>
+#include <errno.h>
+#include <stdio.h>
+
+
+#if (!defined fprintf) && (!defined _FORTIFY_SOURCE)
+
+int success(void) {
+	int r; FILE *fp = fopen("/dev/null", "w");
+
+	fiu_disable("posix/stdio/sp/fprintf");
+
+	r = fprintf(fp, "%d\n", 1234);
+
+	if (! (fp != NULL && r == 5 && ferror(fp) == 0 && fflush(fp) == 0) ) {
+		printf("posix/stdio/sp/fprintf - success condition is false\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static int external_cb_was_called = 0;
+int external_cb(const char *name, int *failnum,
+		void **failinfo, unsigned int *flags) {
+	external_cb_was_called++;
+
+	*failinfo = (void *) EIO;
+
+	return *failnum;
+}
+
+int failure(void) {
+	int r; FILE *fp = fopen("/dev/null", "w");
+
+	fiu_enable_external("posix/stdio/sp/fprintf", 1, NULL, 0, external_cb);
+
+	r = fprintf(fp, "%d\n", 1234);
+
+	fiu_disable("posix/stdio/sp/fprintf");
+
+	if (external_cb_was_called != 1) {
+		printf("posix/stdio/sp/fprintf - external callback not invoked\n");
+		return -1;
+	}
+
+	if (! (errno == EIO) ) {
+		printf("posix/stdio/sp/fprintf - errno not set appropriately: ");
+		printf("errno:%d, cond:errno == EIO\n", errno);
+		return -1;
+	}
+
+	if (! (r == -1 && ferror(fp) != 0) ) {
+		printf("posix/stdio/sp/fprintf - failure condition is false\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static int specific_cb_was_called = 0;
+int specific_cb(const char *name, int *failnum,
+		void **failinfo, unsigned int *flags) {
+	specific_cb_was_called++;
+
+	*failinfo = (void *) EIO;
+
+	return *failnum;
+}
+
+int by_id(void) {
+	int wildcard_calls;
+
+	int r; FILE *fp = fopen("/dev/null", "w");
+
+	external_cb_was_called = 0;
+
+	fiu_enable_external("posix/stdio/sp/*", 1, NULL, 0, external_cb);
+	r = fprintf(fp, "%d\n", 1234);
+	if (external_cb_was_called == 0) {
+		printf("posix/stdio/sp/fprintf - wildcard callback not invoked\n");
+		return -1;
+	}
+
+	fiu_enable_external("posix/stdio/sp/fprintf", 1, NULL, 0, specific_cb);
+	r = fprintf(fp, "%d\n", 1234);
+	if (specific_cb_was_called != 1) {
+		printf("posix/stdio/sp/fprintf - specific callback not invoked\n");
+		return -1;
+	}
+
+	if (! (errno == EIO) ) {
+		printf("posix/stdio/sp/fprintf - errno not set appropriately by id: ");
+		printf("errno:%d, cond:errno == EIO\n", errno);
+		return -1;
+	}
+
+	if (! (r == -1 && ferror(fp) != 0) ) {
+		printf("posix/stdio/sp/fprintf - failure condition by id is false\n");
+		return -1;
+	}
+
+	fiu_disable("posix/stdio/sp/fprintf");
+	wildcard_calls = external_cb_was_called;
+	r = fprintf(fp, "%d\n", 1234);
+	if (specific_cb_was_called != 1 ||
+			external_cb_was_called == wildcard_calls) {
+		printf("posix/stdio/sp/fprintf - wildcard not used after disabling\n");
+		return -1;
+	}
+
+	fiu_disable("posix/stdio/sp/*");
+	wildcard_calls = external_cb_was_called;
+	r = fprintf(fp, "%d\n", 1234);
+	if (specific_cb_was_called != 1 ||
+			external_cb_was_called != wildcard_calls) {
+		printf("posix/stdio/sp/fprintf - callbacks invoked after disabling\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+int main(void) {
+	int s, f, i;
+
+	s = success();
+	f = failure();
+	i = by_id();
+
+	return s + f + i;
+}
+#else
+
+int main(void) {
+	printf("posix/stdio/sp/fprintf: skipping test\n");
+	return 0;
+}
+#endif
@@ -0,0 +1,136 @@
+/* AUTOGENERATED FILE - DO NOT EDIT */
+
+
+#include <fiu.h>
+#include <fiu-control.h>
+#include <stdio.h>
+#include <errno.h>
+#include <stdio.h>
+
+
+
+int success(void) {
+	unsigned char buf[1024]; ssize_t r; FILE *fp = fopen("/dev/zero", "r");
+
+	fiu_disable("posix/stdio/rw/fread");
+
+	r = fread(buf, 1, 1024, fp);
+
+	if (! (r == 1024 && ferror(fp) == 0) ) {
+		printf("posix/stdio/rw/fread - success condition is false\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static int external_cb_was_called = 0;
+int external_cb(const char *name, int *failnum,
+		void **failinfo, unsigned int *flags) {
+	external_cb_was_called++;
+
+	*failinfo = (void *) EIO;
+
+	return *failnum;
+}
+
+int failure(void) {
+	unsigned char buf[1024]; ssize_t r; FILE *fp = fopen("/dev/zero", "r");
+
+	fiu_enable_external("posix/stdio/rw/fread", 1, NULL, 0, external_cb);
+
+	r = fread(buf, 1, 1024, fp);
+
+	fiu_disable("posix/stdio/rw/fread");
+
+	if (external_cb_was_called != 1) {
+		printf("posix/stdio/rw/fread - external callback not invoked\n");
+		return -1;
+	}
+
+	if (! (errno == EIO) ) {
+		printf("posix/stdio/rw/fread - errno not set appropriately: ");
+		printf("errno:%d, cond:errno == EIO\n", errno);
+		return -1;
+	}
+
+	if (! (r == 0 && ferror(fp) != 0) ) {
+		printf("posix/stdio/rw/fread - failure condition is false\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static int specific_cb_was_called = 0;
+int specific_cb(const char *name, int *failnum,
+		void **failinfo, unsigned int *flags) {
+	specific_cb_was_called++;
+
+	*failinfo = (void *) EIO;
+
+	return *failnum;
+}
+
+int by_id(void) {
+	int wildcard_calls;
+
+	unsigned char buf[1024]; ssize_t r; FILE *fp = fopen("/dev/zero", "r");
+
+	external_cb_was_called = 0;
+
+	fiu_enable_external("posix/stdio/rw/*", 1, NULL, 0, external_cb);
+	r = fread(buf, 1, 1024, fp);
+	if (external_cb_was_called == 0) {
+		printf("posix/stdio/rw/fread - wildcard callback not invoked\n");
+		return -1;
+	}
+
+	fiu_enable_external("posix/stdio/rw/fread", 1, NULL, 0, specific_cb);
+	r = fread(buf, 1, 1024, fp);
+	if (specific_cb_was_called != 1) {
+		printf("posix/stdio/rw/fread - specific callback not invoked\n");
+		return -1;
+	}
+
+	if (! (errno == EIO) ) {
+		printf("posix/stdio/rw/fread - errno not set appropriately by id: ");
+		printf("errno:%d, cond:errno == EIO\n", errno);
+		return -1;
+	}
+
+	if (! (r == 0 && ferror(fp) != 0) ) {
+		printf("posix/stdio/rw/fread - failure condition by id is false\n");
+		return -1;
+	}
+
+	fiu_disable("posix/stdio/rw/fread");
+	wildcard_calls = external_cb_was_called;
+	r = fread(buf, 1, 1024, fp);
+	if (specific_cb_was_called != 1 ||
+			external_cb_was_called == wildcard_calls) {
+		printf("posix/stdio/rw/fread - wildcard not used after disabling\n");
+		return -1;
+	}
+
+	fiu_disable("posix/stdio/rw/*");
+	wildcard_calls = external_cb_was_called;
+	r = fread(buf, 1, 1024, fp);
+	if (specific_cb_was_called != 1 ||
+			external_cb_was_called != wildcard_calls) {
+		printf("posix/stdio/rw/fread - callbacks invoked after disabling\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+int main(void) {
+	int s, f, i;
+
+	s = success();
+	f = failure();
+	i = by_id();
+
+	return s + f + i;
+}
@@ -0,0 +1,137 @@
+/* AUTOGENERATED FILE - DO NOT EDIT */
+
+
+#include <fiu.h>
+#include <fiu-control.h>
+#include <stdio.h>
+#include <errno.h>
+#include <sys/types.h>
+#include <signal.h>
+
+
+
+int success(void) {
+	int r;
+
+	fiu_disable("posix/proc/kill");
+
+	r = kill(0, 0);
+
+	if (! (r != -1) ) {
+		printf("posix/proc/kill - success condition is false\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static int external_cb_was_called = 0;
+int external_cb(const char *name, int *failnum,
+		void **failinfo, unsigned int *flags) {
+	external_cb_was_called++;
+
+	*failinfo = (void *) ESRCH;
+
+	return *failnum;
+}
+
+int failure(void) {
+	int r;
+
+	fiu_enable_external("posix/proc/kill", 1, NULL, 0, external_cb);
+
+	r = kill(0, 0);
+
+	fiu_disable("posix/proc/kill");
+
+	if (external_cb_was_called != 1) {
+		printf("posix/proc/kill - external callback not invoked\n");
+		return -1;
+	}
+
+	if (! (errno == ESRCH) ) {
+		printf("posix/proc/kill - errno not set appropriately: ");
+		printf("errno:%d, cond:errno == ESRCH\n", errno);
+		return -1;
+	}
+
+	if (! (r == -1) ) {
+		printf("posix/proc/kill - failure condition is false\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static int specific_cb_was_called = 0;
+int specific_cb(const char *name, int *failnum,
+		void **failinfo, unsigned int *flags) {
+	specific_cb_was_called++;
+
+	*failinfo = (void *) ESRCH;
+
+	return *failnum;
+}
+
+int by_id(void) {
+	int wildcard_calls;
+
+	int r;
+
+	external_cb_was_called = 0;
+
+	fiu_enable_external("posix/proc/*", 1, NULL, 0, external_cb);
+	r = kill(0, 0);
+	if (external_cb_was_called == 0) {
+		printf("posix/proc/kill - wildcard callback not invoked\n");
+		return -1;
+	}
+
+	fiu_enable_external("posix/proc/kill", 1, NULL, 0, specific_cb);
+	r = kill(0, 0);
+	if (specific_cb_was_called != 1) {
+		printf("posix/proc/kill - specific callback not invoked\n");
+		return -1;
+	}
+
+	if (! (errno == ESRCH) ) {
+		printf("posix/proc/kill - errno not set appropriately by id: ");
+		printf("errno:%d, cond:errno == ESRCH\n", errno);
+		return -1;
+	}
+
+	if (! (r == -1) ) {
+		printf("posix/proc/kill - failure condition by id is false\n");
+		return -1;
+	}
+
+	fiu_disable("posix/proc/kill");
+	wildcard_calls = external_cb_was_called;
+	r = kill(0, 0);
+	if (specific_cb_was_called != 1 ||
+			external_cb_was_called == wildcard_calls) {
+		printf("posix/proc/kill - wildcard not used after disabling\n");
+		return -1;
+	}
+
+	fiu_disable("posix/proc/*");
+	wildcard_calls = external_cb_was_called;
+	r = kill(0, 0);
+	if (specific_cb_was_called != 1 ||
+			external_cb_was_called != wildcard_calls) {
+		printf("posix/proc/kill - callbacks invoked after disabling\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+int main(void) {
+	int s, f, i;
+
+	s = success();
+	f = failure();
+	i = by_id();
+
+	return s + f + i;
+}
@@ -0,0 +1,151 @@
+/* AUTOGENERATED FILE - DO NOT EDIT */
+
+
+#include <fiu.h>
+#include <fiu-control.h>
+#include <stdio.h>
+#include <errno.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+
+#if defined _POSIX_MAPPED_FILES
+
+int success(void) {
+	void *p;
+
+	fiu_disable("posix/mm/mmap");
+
+	p = mmap(NULL, 4096, PROT_READ | PROT_WRITE,
+MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+	if (! (p != MAP_FAILED) ) {
+		printf("posix/mm/mmap - success condition is false\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static int external_cb_was_called = 0;
+int external_cb(const char *name, int *failnum,
+		void **failinfo, unsigned int *flags) {
+	external_cb_was_called++;
+
+	*failinfo = (void *) ETXTBSY;
+
+	return *failnum;
+}
+
+int failure(void) {
+	void *p;
+
+	fiu_enable_external("posix/mm/mmap", 1, NULL, 0, external_cb);
+
+	p = mmap(NULL, 4096, PROT_READ | PROT_WRITE,
+MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+	fiu_disable("posix/mm/mmap");
+
+	if (external_cb_was_called != 1) {
+		printf("posix/mm/mmap - external callback not invoked\n");
+		return -1;
+	}
+
+	if (! (errno == ETXTBSY) ) {
+		printf("posix/mm/mmap - errno not set appropriately: ");
+		printf("errno:%d, cond:errno == ETXTBSY\n", errno);
+		return -1;
+	}
+
+	if (! (p == MAP_FAILED) ) {
+		printf("posix/mm/mmap - failure condition is false\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static int specific_cb_was_called = 0;
+int specific_cb(const char *name, int *failnum,
+		void **failinfo, unsigned int *flags) {
+	specific_cb_was_called++;
+
+	*failinfo = (void *) ETXTBSY;
+
+	return *failnum;
+}
+
+int by_id(void) {
+	int wildcard_calls;
+
+	void *p;
+
+	external_cb_was_called = 0;
+
+	fiu_enable_external("posix/mm/*", 1, NULL, 0, external_cb);
+	p = mmap(NULL, 4096, PROT_READ | PROT_WRITE,
+MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (external_cb_was_called == 0) {
+		printf("posix/mm/mmap - wildcard callback not invoked\n");
+		return -1;
+	}
+
+	fiu_enable_external("posix/mm/mmap", 1, NULL, 0, specific_cb);
+	p = mmap(NULL, 4096, PROT_READ | PROT_WRITE,
+MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (specific_cb_was_called != 1) {
+		printf("posix/mm/mmap - specific callback not invoked\n");
+		return -1;
+	}
+
+	if (! (errno == ETXTBSY) ) {
+		printf("posix/mm/mmap - errno not set appropriately by id: ");
+		printf("errno:%d, cond:errno == ETXTBSY\n", errno);
+		return -1;
+	}
+
+	if (! (p == MAP_FAILED) ) {
+		printf("posix/mm/mmap - failure condition by id is false\n");
+		return -1;
+	}
+
+	fiu_disable("posix/mm/mmap");
+	wildcard_calls = external_cb_was_called;
+	p = mmap(NULL, 4096, PROT_READ | PROT_WRITE,
+MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (specific_cb_was_called != 1 ||
+			external_cb_was_called == wildcard_calls) {
+		printf("posix/mm/mmap - wildcard not used after disabling\n");
+		return -1;
+	}
+
+	fiu_disable("posix/mm/*");
+	wildcard_calls = external_cb_was_called;
+	p = mmap(NULL, 4096, PROT_READ | PROT_WRITE,
+MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	if (specific_cb_was_called != 1 ||
+			external_cb_was_called != wildcard_calls) {
+		printf("posix/mm/mmap - callbacks invoked after disabling\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+int main(void) {
+	int s, f, i;
+
+	s = success();
+	f = failure();
+	i = by_id();
+
+	return s + f + i;
+}
+#else
+
+int main(void) {
+	printf("posix/mm/mmap: skipping test\n");
+	return 0;
+}
+#endif
@@ -0,0 +1,138 @@
+/* AUTOGENERATED FILE - DO NOT EDIT */
+
+
+#include <fiu.h>
+#include <fiu-control.h>
+#include <stdio.h>
+#include <errno.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+
+
+
+int success(void) {
+	int fd = -1;
+
+	fiu_disable("posix/io/oc/open");
+
+	fd = open("/dev/null", O_RDONLY);
+
+	if (! (fd != -1) ) {
+		printf("posix/io/oc/open - success condition is false\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static int external_cb_was_called = 0;
+int external_cb(const char *name, int *failnum,
+		void **failinfo, unsigned int *flags) {
+	external_cb_was_called++;
+
+	*failinfo = (void *) ELOOP;
+
+	return *failnum;
+}
+
+int failure(void) {
+	int fd = -1;
+
+	fiu_enable_external("posix/io/oc/open", 1, NULL, 0, external_cb);
+
+	fd = open("/dev/null", O_RDONLY);
+
+	fiu_disable("posix/io/oc/open");
+
+	if (external_cb_was_called != 1) {
+		printf("posix/io/oc/open - external callback not invoked\n");
+		return -1;
+	}
+
+	if (! (errno == ELOOP) ) {
+		printf("posix/io/oc/open - errno not set appropriately: ");
+		printf("errno:%d, cond:errno == ELOOP\n", errno);
+		return -1;
+	}
+
+	if (! (fd == -1) ) {
+		printf("posix/io/oc/open - failure condition is false\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static int specific_cb_was_called = 0;
+int specific_cb(const char *name, int *failnum,
+		void **failinfo, unsigned int *flags) {
+	specific_cb_was_called++;
+
+	*failinfo = (void *) ELOOP;
+
+	return *failnum;
+}
+
+int by_id(void) {
+	int wildcard_calls;
+
+	int fd = -1;
+
+	external_cb_was_called = 0;
+
+	fiu_enable_external("posix/io/oc/*", 1, NULL, 0, external_cb);
+	fd = open("/dev/null", O_RDONLY);
+	if (external_cb_was_called == 0) {
+		printf("posix/io/oc/open - wildcard callback not invoked\n");
+		return -1;
+	}
+
+	fiu_enable_external("posix/io/oc/open", 1, NULL, 0, specific_cb);
+	fd = open("/dev/null", O_RDONLY);
+	if (specific_cb_was_called != 1) {
+		printf("posix/io/oc/open - specific callback not invoked\n");
+		return -1;
+	}
+
+	if (! (errno == ELOOP) ) {
+		printf("posix/io/oc/open - errno not set appropriately by id: ");
+		printf("errno:%d, cond:errno == ELOOP\n", errno);
+		return -1;
+	}
+
+	if (! (fd == -1) ) {
+		printf("posix/io/oc/open - failure condition by id is false\n");
+		return -1;
+	}
+
+	fiu_disable("posix/io/oc/open");
+	wildcard_calls = external_cb_was_called;
+	fd = open("/dev/null", O_RDONLY);
+	if (specific_cb_was_called != 1 ||
+			external_cb_was_called == wildcard_calls) {
+		printf("posix/io/oc/open - wildcard not used after disabling\n");
+		return -1;
+	}
+
+	fiu_disable("posix/io/oc/*");
+	wildcard_calls = external_cb_was_called;
+	fd = open("/dev/null", O_RDONLY);
+	if (specific_cb_was_called != 1 ||
+			external_cb_was_called != wildcard_calls) {
+		printf("posix/io/oc/open - callbacks invoked after disabling\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+int main(void) {
+	int s, f, i;
+
+	s = success();
+	f = failure();
+	i = by_id();
+
+	return s + f + i;
+}
@@ -0,0 +1,147 @@
+/* AUTOGENERATED FILE - DO NOT EDIT */
+
+
+#include <fiu.h>
+#include <fiu-control.h>
+#include <stdio.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+
+
+#if defined __GLIBC__
+
+int success(void) {
+	unsigned char buf[1024]; ssize_t r; int fd = open("/dev/zero", O_RDONLY);
+
+	fiu_disable("posix/io/rw/pread");
+
+	r = pread64(fd, buf, 1024, 0);
+
+	if (! (r != -1) ) {
+		printf("posix/io/rw/pread - success condition is false\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static int external_cb_was_called = 0;
+int external_cb(const char *name, int *failnum,
+		void **failinfo, unsigned int *flags) {
+	external_cb_was_called++;
+
+	*failinfo = (void *) EIO;
+
+	return *failnum;
+}
+
+int failure(void) {
+	unsigned char buf[1024]; ssize_t r; int fd = open("/dev/zero", O_RDONLY);
+
+	fiu_enable_external("posix/io/rw/pread", 1, NULL, 0, external_cb);
+
+	r = pread64(fd, buf, 1024, 0);
+
+	fiu_disable("posix/io/rw/pread");
+
+	if (external_cb_was_called != 1) {
+		printf("posix/io/rw/pread - external callback not invoked\n");
+		return -1;
+	}
+
+	if (! (errno == EIO) ) {
+		printf("posix/io/rw/pread - errno not set appropriately: ");
+		printf("errno:%d, cond:errno == EIO\n", errno);
+		return -1;
+	}
+
+	if (! (r == -1) ) {
+		printf("posix/io/rw/pread - failure condition is false\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static int specific_cb_was_called = 0;
+int specific_cb(const char *name, int *failnum,
+		void **failinfo, unsigned int *flags) {
+	specific_cb_was_called++;
+
+	*failinfo = (void *) EIO;
+
+	return *failnum;
+}
+
+int by_id(void) {
+	int wildcard_calls;
+
+	unsigned char buf[1024]; ssize_t r; int fd = open("/dev/zero", O_RDONLY);
+
+	external_cb_was_called = 0;
+
+	fiu_enable_external("posix/io/rw/*", 1, NULL, 0, external_cb);
+	r = pread64(fd, buf, 1024, 0);
+	if (external_cb_was_called == 0) {
+		printf("posix/io/rw/pread - wildcard callback not invoked\n");
+		return -1;
+	}
+
+	fiu_enable_external("posix/io/rw/pread", 1, NULL, 0, specific_cb);
+	r = pread64(fd, buf, 1024, 0);
+	if (specific_cb_was_called != 1) {
+		printf("posix/io/rw/pread - specific callback not invoked\n");
+		return -1;
+	}
+
+	if (! (errno == EIO) ) {
+		printf("posix/io/rw/pread - errno not set appropriately by id: ");
+		printf("errno:%d, cond:errno == EIO\n", errno);
+		return -1;
+	}
+
+	if (! (r == -1) ) {
+		printf("posix/io/rw/pread - failure condition by id is false\n");
+		return -1;
+	}
+
+	fiu_disable("posix/io/rw/pread");
+	wildcard_calls = external_cb_was_called;
+	r = pread64(fd, buf, 1024, 0);
+	if (specific_cb_was_called != 1 ||
+			external_cb_was_called == wildcard_calls) {
+		printf("posix/io/rw/pread - wildcard not used after disabling\n");
+		return -1;
+	}
+
+	fiu_disable("posix/io/rw/*");
+	wildcard_calls = external_cb_was_called;
+	r = pread64(fd, buf, 1024, 0);
+	if (specific_cb_was_called != 1 ||
+			external_cb_was_called != wildcard_calls) {
+		printf("posix/io/rw/pread - callbacks invoked after disabling\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+int main(void) {
+	int s, f, i;
+
+	s = success();
+	f = failure();
+	i = by_id();
+
+	return s + f + i;
+}
+#else
+
+int main(void) {
+	printf("posix/io/rw/pread: skipping test\n");
+	return 0;
+}
+#endif
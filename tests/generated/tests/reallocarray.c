@@ -0,0 +1,144 @@
+/* AUTOGENERATED FILE - DO NOT EDIT */
+
+
+#include <fiu.h>
+#include <fiu-control.h>
+#include <stdio.h>
+#include <errno.h>
+#include <stdlib.h>
+
+
+#if defined __GLIBC__
+
+int success(void) {
+	void *p = NULL;
+
+	fiu_disable("libc/mm/reallocarray");
+
+	p = reallocarray(NULL, 1000, 8);
+
+	if (! (p != NULL) ) {
+		printf("libc/mm/reallocarray - success condition is false\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static int external_cb_was_called = 0;
+int external_cb(const char *name, int *failnum,
+		void **failinfo, unsigned int *flags) {
+	external_cb_was_called++;
+
+	*failinfo = (void *) 0;
+
+	return *failnum;
+}
+
+int failure(void) {
+	void *p = NULL;
+
+	fiu_enable_external("libc/mm/reallocarray", 1, NULL, 0, external_cb);
+
+	p = reallocarray(NULL, 1000, 8);
+
+	fiu_disable("libc/mm/reallocarray");
+
+	if (external_cb_was_called != 1) {
+		printf("libc/mm/reallocarray - external callback not invoked\n");
+		return -1;
+	}
+
+	if (! (1) ) {
+		printf("libc/mm/reallocarray - errno not set appropriately: ");
+		printf("errno:%d, cond:1\n", errno);
+		return -1;
+	}
+
+	if (! (p == NULL) ) {
+		printf("libc/mm/reallocarray - failure condition is false\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static int specific_cb_was_called = 0;
+int specific_cb(const char *name, int *failnum,
+		void **failinfo, unsigned int *flags) {
+	specific_cb_was_called++;
+
+	*failinfo = (void *) 0;
+
+	return *failnum;
+}
+
+int by_id(void) {
+	int wildcard_calls;
+
+	void *p = NULL;
+
+	external_cb_was_called = 0;
+
+	fiu_enable_external("libc/mm/*", 1, NULL, 0, external_cb);
+	p = reallocarray(NULL, 1000, 8);
+	if (external_cb_was_called == 0) {
+		printf("libc/mm/reallocarray - wildcard callback not invoked\n");
+		return -1;
+	}
+
+	fiu_enable_external("libc/mm/reallocarray", 1, NULL, 0, specific_cb);
+	p = reallocarray(NULL, 1000, 8);
+	if (specific_cb_was_called != 1) {
+		printf("libc/mm/reallocarray - specific callback not invoked\n");
+		return -1;
+	}
+
+	if (! (1) ) {
+		printf("libc/mm/reallocarray - errno not set appropriately by id: ");
+		printf("errno:%d, cond:1\n", errno);
+		return -1;
+	}
+
+	if (! (p == NULL) ) {
+		printf("libc/mm/reallocarray - failure condition by id is false\n");
+		return -1;
+	}
+
+	fiu_disable("libc/mm/reallocarray");
+	wildcard_calls = external_cb_was_called;
+	p = reallocarray(NULL, 1000, 8);
+	if (specific_cb_was_called != 1 ||
+			external_cb_was_called == wildcard_calls) {
+		printf("libc/mm/reallocarray - wildcard not used after disabling\n");
+		return -1;
+	}
+
+	fiu_disable("libc/mm/*");
+	wildcard_calls = external_cb_was_called;
+	p = reallocarray(NULL, 1000, 8);
+	if (specific_cb_was_called != 1 ||
+			external_cb_was_called != wildcard_calls) {
+		printf("libc/mm/reallocarray - callbacks invoked after disabling\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+int main(void) {
+	int s, f, i;
+
+	s = success();
+	f = failure();
+	i = by_id();
+
+	return s + f + i;
+}
+#else
+
+int main(void) {
+	printf("libc/mm/reallocarray: skipping test\n");
+	return 0;
+}
+#endif
@@ -0,0 +1,148 @@
+/* AUTOGENERATED FILE - DO NOT EDIT */
+
+
+#include <fiu.h>
+#include <fiu-control.h>
+#include <stdio.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <sys/sendfile.h>
+
+
+#if defined __linux__
+
+int success(void) {
+	ssize_t r; off_t off = 0; int in = open("/proc/self/exe", O_RDONLY); int out = open("/dev/null", O_WRONLY);
+
+	fiu_disable("linux/io/zc/sendfile");
+
+	r = sendfile(out, in, &off, 64);
+
+	if (! (r > 0) ) {
+		printf("linux/io/zc/sendfile - success condition is false\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static int external_cb_was_called = 0;
+int external_cb(const char *name, int *failnum,
+		void **failinfo, unsigned int *flags) {
+	external_cb_was_called++;
+
+	*failinfo = (void *) EAGAIN;
+
+	return *failnum;
+}
+
+int failure(void) {
+	ssize_t r; off_t off = 0; int in = open("/proc/self/exe", O_RDONLY); int out = open("/dev/null", O_WRONLY);
+
+	fiu_enable_external("linux/io/zc/sendfile", 1, NULL, 0, external_cb);
+
+	r = sendfile(out, in, &off, 64);
+
+	fiu_disable("linux/io/zc/sendfile");
+
+	if (external_cb_was_called != 1) {
+		printf("linux/io/zc/sendfile - external callback not invoked\n");
+		return -1;
+	}
+
+	if (! (errno == EAGAIN) ) {
+		printf("linux/io/zc/sendfile - errno not set appropriately: ");
+		printf("errno:%d, cond:errno == EAGAIN\n", errno);
+		return -1;
+	}
+
+	if (! (r == -1) ) {
+		printf("linux/io/zc/sendfile - failure condition is false\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static int specific_cb_was_called = 0;
+int specific_cb(const char *name, int *failnum,
+		void **failinfo, unsigned int *flags) {
+	specific_cb_was_called++;
+
+	*failinfo = (void *) EAGAIN;
+
+	return *failnum;
+}
+
+int by_id(void) {
+	int wildcard_calls;
+
+	ssize_t r; off_t off = 0; int in = open("/proc/self/exe", O_RDONLY); int out = open("/dev/null", O_WRONLY);
+
+	external_cb_was_called = 0;
+
+	fiu_enable_external("linux/io/zc/*", 1, NULL, 0, external_cb);
+	r = sendfile(out, in, &off, 64);
+	if (external_cb_was_called == 0) {
+		printf("linux/io/zc/sendfile - wildcard callback not invoked\n");
+		return -1;
+	}
+
+	fiu_enable_external("linux/io/zc/sendfile", 1, NULL, 0, specific_cb);
+	r = sendfile(out, in, &off, 64);
+	if (specific_cb_was_called != 1) {
+		printf("linux/io/zc/sendfile - specific callback not invoked\n");
+		return -1;
+	}
+
+	if (! (errno == EAGAIN) ) {
+		printf("linux/io/zc/sendfile - errno not set appropriately by id: ");
+		printf("errno:%d, cond:errno == EAGAIN\n", errno);
+		return -1;
+	}
+
+	if (! (r == -1) ) {
+		printf("linux/io/zc/sendfile - failure condition by id is false\n");
+		return -1;
+	}
+
+	fiu_disable("linux/io/zc/sendfile");
+	wildcard_calls = external_cb_was_called;
+	r = sendfile(out, in, &off, 64);
+	if (specific_cb_was_called != 1 ||
+			external_cb_was_called == wildcard_calls) {
+		printf("linux/io/zc/sendfile - wildcard not used after disabling\n");
+		return -1;
+	}
+
+	fiu_disable("linux/io/zc/*");
+	wildcard_calls = external_cb_was_called;
+	r = sendfile(out, in, &off, 64);
+	if (specific_cb_was_called != 1 ||
+			external_cb_was_called != wildcard_calls) {
+		printf("linux/io/zc/sendfile - callbacks invoked after disabling\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+int main(void) {
+	int s, f, i;
+
+	s = success();
+	f = failure();
+	i = by_id();
+
+	return s + f + i;
+}
+#else
+
+int main(void) {
+	printf("linux/io/zc/sendfile: skipping test\n");
+	return 0;
+}
+#endif
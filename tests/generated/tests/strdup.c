@@ -0,0 +1,144 @@
+/* AUTOGENERATED FILE - DO NOT EDIT */
+
+
+#include <fiu.h>
+#include <fiu-control.h>
+#include <stdio.h>
+#include <errno.h>
+#include <string.h>
+
+
+#if !(defined strdup)
+
+int success(void) {
+	char *dup, *s = "test string\n";
+
+	fiu_disable("libc/str/strdup");
+
+	dup = strdup(s);
+
+	if (! (strcmp(s, dup) == 0) ) {
+		printf("libc/str/strdup - success condition is false\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static int external_cb_was_called = 0;
+int external_cb(const char *name, int *failnum,
+		void **failinfo, unsigned int *flags) {
+	external_cb_was_called++;
+
+	*failinfo = (void *) ENOMEM;
+
+	return *failnum;
+}
+
+int failure(void) {
+	char *dup, *s = "test string\n";
+
+	fiu_enable_external("libc/str/strdup", 1, NULL, 0, external_cb);
+
+	dup = strdup(s);
+
+	fiu_disable("libc/str/strdup");
+
+	if (external_cb_was_called != 1) {
+		printf("libc/str/strdup - external callback not invoked\n");
+		return -1;
+	}
+
+	if (! (errno == ENOMEM) ) {
+		printf("libc/str/strdup - errno not set appropriately: ");
+		printf("errno:%d, cond:errno == ENOMEM\n", errno);
+		return -1;
+	}
+
+	if (! (dup == NULL) ) {
+		printf("libc/str/strdup - failure condition is false\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static int specific_cb_was_called = 0;
+int specific_cb(const char *name, int *failnum,
+		void **failinfo, unsigned int *flags) {
+	specific_cb_was_called++;
+
+	*failinfo = (void *) ENOMEM;
+
+	return *failnum;
+}
+
+int by_id(void) {
+	int wildcard_calls;
+
+	char *dup, *s = "test string\n";
+
+	external_cb_was_called = 0;
+
+	fiu_enable_external("libc/str/*", 1, NULL, 0, external_cb);
+	dup = strdup(s);
+	if (external_cb_was_called == 0) {
+		printf("libc/str/strdup - wildcard callback not invoked\n");
+		return -1;
+	}
+
+	fiu_enable_external("libc/str/strdup", 1, NULL, 0, specific_cb);
+	dup = strdup(s);
+	if (specific_cb_was_called != 1) {
+		printf("libc/str/strdup - specific callback not invoked\n");
+		return -1;
+	}
+
+	if (! (errno == ENOMEM) ) {
+		printf("libc/str/strdup - errno not set appropriately by id: ");
+		printf("errno:%d, cond:errno == ENOMEM\n", errno);
+		return -1;
+	}
+
+	if (! (dup == NULL) ) {
+		printf("libc/str/strdup - failure condition by id is false\n");
+		return -1;
+	}
+
+	fiu_disable("libc/str/strdup");
+	wildcard_calls = external_cb_was_called;
+	dup = strdup(s);
+	if (specific_cb_was_called != 1 ||
+			external_cb_was_called == wildcard_calls) {
+		printf("libc/str/strdup - wildcard not used after disabling\n");
+		return -1;
+	}
+
+	fiu_disable("libc/str/*");
+	wildcard_calls = external_cb_was_called;
+	dup = strdup(s);
+	if (specific_cb_was_called != 1 ||
+			external_cb_was_called != wildcard_calls) {
+		printf("libc/str/strdup - callbacks invoked after disabling\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+int main(void) {
+	int s, f, i;
+
+	s = success();
+	f = failure();
+	i = by_id();
+
+	return s + f + i;
+}
+#else
+
+int main(void) {
+	printf("libc/str/strdup: skipping test\n");
+	return 0;
+}
+#endif
@@ -0,0 +1,145 @@
+/* AUTOGENERATED FILE - DO NOT EDIT */
+
+
+#include <fiu.h>
+#include <fiu-control.h>
+#include <stdio.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+
+#if defined __linux__
+
+int success(void) {
+	ssize_t r; int a[2], b[2]; pipe(a); pipe(b); write(a[1], "x", 1);
+
+	fiu_disable("linux/io/zc/tee");
+
+	r = tee(a[0], b[1], 1, 0);
+
+	if (! (r == 1) ) {
+		printf("linux/io/zc/tee - success condition is false\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static int external_cb_was_called = 0;
+int external_cb(const char *name, int *failnum,
+		void **failinfo, unsigned int *flags) {
+	external_cb_was_called++;
+
+	*failinfo = (void *) ENOMEM;
+
+	return *failnum;
+}
+
+int failure(void) {
+	ssize_t r; int a[2], b[2]; pipe(a); pipe(b); write(a[1], "x", 1);
+
+	fiu_enable_external("linux/io/zc/tee", 1, NULL, 0, external_cb);
+
+	r = tee(a[0], b[1], 1, 0);
+
+	fiu_disable("linux/io/zc/tee");
+
+	if (external_cb_was_called != 1) {
+		printf("linux/io/zc/tee - external callback not invoked\n");
+		return -1;
+	}
+
+	if (! (errno == ENOMEM) ) {
+		printf("linux/io/zc/tee - errno not set appropriately: ");
+		printf("errno:%d, cond:errno == ENOMEM\n", errno);
+		return -1;
+	}
+
+	if (! (r == -1) ) {
+		printf("linux/io/zc/tee - failure condition is false\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static int specific_cb_was_called = 0;
+int specific_cb(const char *name, int *failnum,
+		void **failinfo, unsigned int *flags) {
+	specific_cb_was_called++;
+
+	*failinfo = (void *) ENOMEM;
+
+	return *failnum;
+}
+
+int by_id(void) {
+	int wildcard_calls;
+
+	ssize_t r; int a[2], b[2]; pipe(a); pipe(b); write(a[1], "x", 1);
+
+	external_cb_was_called = 0;
+
+	fiu_enable_external("linux/io/zc/*", 1, NULL, 0, external_cb);
+	r = tee(a[0], b[1], 1, 0);
+	if (external_cb_was_called == 0) {
+		printf("linux/io/zc/tee - wildcard callback not invoked\n");
+		return -1;
+	}
+
+	fiu_enable_external("linux/io/zc/tee", 1, NULL, 0, specific_cb);
+	r = tee(a[0], b[1], 1, 0);
+	if (specific_cb_was_called != 1) {
+		printf("linux/io/zc/tee - specific callback not invoked\n");
+		return -1;
+	}
+
+	if (! (errno == ENOMEM) ) {
+		printf("linux/io/zc/tee - errno not set appropriately by id: ");
+		printf("errno:%d, cond:errno == ENOMEM\n", errno);
+		return -1;
+	}
+
+	if (! (r == -1) ) {
+		printf("linux/io/zc/tee - failure condition by id is false\n");
+		return -1;
+	}
+
+	fiu_disable("linux/io/zc/tee");
+	wildcard_calls = external_cb_was_called;
+	r = tee(a[0], b[1], 1, 0);
+	if (specific_cb_was_called != 1 ||
+			external_cb_was_called == wildcard_calls) {
+		printf("linux/io/zc/tee - wildcard not used after disabling\n");
+		return -1;
+	}
+
+	fiu_disable("linux/io/zc/*");
+	wildcard_calls = external_cb_was_called;
+	r = tee(a[0], b[1], 1, 0);
+	if (specific_cb_was_called != 1 ||
+			external_cb_was_called != wildcard_calls) {
+		printf("linux/io/zc/tee - callbacks invoked after disabling\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+int main(void) {
+	int s, f, i;
+
+	s = success();
+	f = failure();
+	i = by_id();
+
+	return s + f + i;
+}
+#else
+
+int main(void) {
+	printf("linux/io/zc/tee: skipping test\n");
+	return 0;
+}
+#endif
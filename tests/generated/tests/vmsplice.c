@@ -0,0 +1,146 @@
+/* AUTOGENERATED FILE - DO NOT EDIT */
+
+
+#include <fiu.h>
+#include <fiu-control.h>
+#include <stdio.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/uio.h>
+
+
+#if defined __linux__
+
+int success(void) {
+	ssize_t r; int p[2]; char c = 'x'; struct iovec iov = { &c, 1 }; pipe(p);
+
+	fiu_disable("linux/io/zc/vmsplice");
+
+	r = vmsplice(p[1], &iov, 1, 0);
+
+	if (! (r == 1) ) {
+		printf("linux/io/zc/vmsplice - success condition is false\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static int external_cb_was_called = 0;
+int external_cb(const char *name, int *failnum,
+		void **failinfo, unsigned int *flags) {
+	external_cb_was_called++;
+
+	*failinfo = (void *) EAGAIN;
+
+	return *failnum;
+}
+
+int failure(void) {
+	ssize_t r; int p[2]; char c = 'x'; struct iovec iov = { &c, 1 }; pipe(p);
+
+	fiu_enable_external("linux/io/zc/vmsplice", 1, NULL, 0, external_cb);
+
+	r = vmsplice(p[1], &iov, 1, 0);
+
+	fiu_disable("linux/io/zc/vmsplice");
+
+	if (external_cb_was_called != 1) {
+		printf("linux/io/zc/vmsplice - external callback not invoked\n");
+		return -1;
+	}
+
+	if (! (errno == EAGAIN) ) {
+		printf("linux/io/zc/vmsplice - errno not set appropriately: ");
+		printf("errno:%d, cond:errno == EAGAIN\n", errno);
+		return -1;
+	}
+
+	if (! (r == -1) ) {
+		printf("linux/io/zc/vmsplice - failure condition is false\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+static int specific_cb_was_called = 0;
+int specific_cb(const char *name, int *failnum,
+		void **failinfo, unsigned int *flags) {
+	specific_cb_was_called++;
+
+	*failinfo = (void *) EAGAIN;
+
+	return *failnum;
+}
+
+int by_id(void) {
+	int wildcard_calls;
+
+	ssize_t r; int p[2]; char c = 'x'; struct iovec iov = { &c, 1 }; pipe(p);
+
+	external_cb_was_called = 0;
+
+	fiu_enable_external("linux/io/zc/*", 1, NULL, 0, external_cb);
+	r = vmsplice(p[1], &iov, 1, 0);
+	if (external_cb_was_called == 0) {
+		printf("linux/io/zc/vmsplice - wildcard callback not invoked\n");
+		return -1;
+	}
+
+	fiu_enable_external("linux/io/zc/vmsplice", 1, NULL, 0, specific_cb);
+	r = vmsplice(p[1], &iov, 1, 0);
+	if (specific_cb_was_called != 1) {
+		printf("linux/io/zc/vmsplice - specific callback not invoked\n");
+		return -1;
+	}
+
+	if (! (errno == EAGAIN) ) {
+		printf("linux/io/zc/vmsplice - errno not set appropriately by id: ");
+		printf("errno:%d, cond:errno == EAGAIN\n", errno);
+		return -1;
+	}
+
+	if (! (r == -1) ) {
+		printf("linux/io/zc/vmsplice - failure condition by id is false\n");
+		return -1;
+	}
+
+	fiu_disable("linux/io/zc/vmsplice");
+	wildcard_calls = external_cb_was_called;
+	r = vmsplice(p[1], &iov, 1, 0);
+	if (specific_cb_was_called != 1 ||
+			external_cb_was_called == wildcard_calls) {
+		printf("linux/io/zc/vmsplice - wildcard not used after disabling\n");
+		return -1;
+	}
+
+	fiu_disable("linux/io/zc/*");
+	wildcard_calls = external_cb_was_called;
+	r = vmsplice(p[1], &iov, 1, 0);
+	if (specific_cb_was_called != 1 ||
+			external_cb_was_called != wildcard_calls) {
+		printf("linux/io/zc/vmsplice - callbacks invoked after disabling\n");
+		return -1;
+	}
+
+	return 0;
+}
+
+int main(void) {
+	int s, f, i;
+
+	s = success();
+	f = failure();
+	i = by_id();
+
+	return s + f + i;
+}
+#else
+
+int main(void) {
+	printf("linux/io/zc/vmsplice: skipping test\n");
+	return 0;
+}
+#endif
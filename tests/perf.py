@@ -0,0 +1,381 @@
+#!/usr/bin/env python3
+
+"""
+Performance tests, that measure the overhead of libfiu and the POSIX preload
+library on a few workloads.
+
+Each workload is run with different configurations (what fiu-run enables),
+several times each, and the results (wall time, user and system time, and
+maximum RSS, as reported by rusage) are shown with their 95% confidence
+intervals, and the overhead relative to the "base" configuration, which runs
+the workload without fiu-run.
+
+The workloads are:
+
+ - fsck: fsck.ext2 on a test file (needs e2fsprogs).
+ - tar: tar of a generated tree of small files, to /dev/null.
+ - small-cat: many runs of the small-cat test binary, mostly startup.
+ - writer: the bench-stdio benchmark, several threads writing lines with
+   stdio.
+
+The results can be written as JSON with --json, and compared against a
+previous one with --baseline: the comparison is done on the overhead, so the
+baseline can come from a different machine, and it exits with 1 if any of
+them grew by more than --tolerance.
+
+It can be tuned with the following environment variables:
+
+ - TEST_FILE: The name of the file used for fsck. By default, ".test_fs".
+ - TEST_FILE_SIZE_MB: The size of the test file, in megabytes. Only used if
+   the file doesn't exist. Default: 10.
+ - VERBOSE: Show verbose output (from 0 to 2). Default: 0.
+"""
+
+import argparse
+import json
+import math
+import os
+import platform
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+tests_dir = os.path.abspath(os.path.dirname(sys.argv[0]))
+
+test_file = os.environ.get("TEST_FILE", ".test_fs")
+
+test_file_size = int(os.environ.get("TEST_FILE_SIZE_MB", 10))
+
+verbose = int(os.environ.get("VERBOSE", 0))
+
+dev_null = open("/dev/null", "w")
+
+# The utilities, run against the libraries in this tree.
+fiu_run = [tests_dir + "/utils/wrap", "fiu-run", "-x"]
+
+
+#
+# Workloads
+#
+# Each one has a setup() function, that returns the command to run (or None
+# if it can't be run here), how many times to run it in a single sample, and
+# what to give it as input (or None).
+#
+
+
+def setup_fsck(tmpdir):
+    if not shutil.which("fsck.ext2") or not shutil.which("mkfs.ext2"):
+        return None, 0, None
+
+    if not os.path.exists(test_file):
+        with open(test_file, "w") as fd:
+            fd.truncate(test_file_size * 1024 * 1024)
+
+        retcode = subprocess.call(
+            ["mkfs.ext2", "-F", test_file], stdout=dev_null, stderr=dev_null
+        )
+        if retcode != 0:
+            print("Error running mkfs.ext2:", retcode)
+            return None, 0, None
+
+    return "fsck.ext2 -n -f".split() + [test_file], 1, None
+
+
+def setup_tar(tmpdir):
+    tree = tmpdir + "/tree"
+    for i in range(50):
+        os.makedirs("%s/%d" % (tree, i))
+        for j in range(40):
+            with open("%s/%d/%d" % (tree, i, j), "w") as fd:
+                fd.write("x" * (j * 100))
+
+    return ["tar", "-C", tree, "-cf", "/dev/null", "."], 10, None
+
+
+def setup_small_cat(tmpdir):
+    return [tests_dir + "/small-cat"], 50, b"x" * 4092
+
+
+def setup_writer(tmpdir):
+    return [tests_dir + "/bench/bench-stdio", "perf", "4", "50000"], 1, None
+
+
+workloads = {
+    "fsck": setup_fsck,
+    "tar": setup_tar,
+    "small-cat": setup_small_cat,
+    "writer": setup_writer,
+}
+
+
+#
+# Configurations
+#
+# Each one is a list of arguments for fiu-run, or None to run the workload
+# without it.
+#
+
+
+def many(fmt, n=1000):
+    args = []
+    for i in range(n):
+        args += ["-c", fmt % i]
+    return args
+
+
+configs = {
+    "base": None,
+    # Nothing enabled, only the preload overhead.
+    "none": [],
+    # 1 final failure point that is never checked, which should be as cheap
+    # as nothing enabled.
+    "u1": ["-c", "enable_random name=unrelated,probability=0"],
+    # 1 all-matching wildcard.
+    "w1": ["-c", "enable_random name=*,probability=0"],
+    # 1k final failure points, no matches.
+    "f1k": many("enable_random name=none/%d,probability=0"),
+    # 1k wildcard failure points, no matches.
+    "w1k": many("enable_random name=none/%d/*,probability=0"),
+    # 1k failure points with wildcards in the middle, no matches.
+    "i1k": many("enable_random name=glob:none/%d/*/x,probability=0"),
+    # 1k wildcarded failure points, and 1 match.
+    "w1k+1": many("enable_random name=none/%d/*,probability=0")
+    + ["-c", "enable_random name=*,probability=0"],
+    # 1k final failure points, *all* matches.
+    "m1k": ["-c", "enable_random name=*,probability=0"] * 1000,
+}
+
+
+#
+# Running and statistics
+#
+
+
+def run_sample(cmd, repeat, data, fiu_args):
+    """Runs the command repeat times, returns the wall time and the sum of
+    the rusages, as a dict."""
+    if fiu_args is not None:
+        cmd = fiu_run + fiu_args + cmd
+
+    stdin = subprocess.PIPE if data is not None else None
+
+    sample = {"wall": 0.0, "utime": 0.0, "stime": 0.0, "maxrss_kb": 0}
+    for _ in range(repeat):
+        start = time.time()
+        child = subprocess.Popen(
+            cmd,
+            stdin=stdin,
+            stdout=None if verbose else dev_null,
+            stderr=None if verbose else dev_null,
+        )
+        if data is not None:
+            child.stdin.write(data)
+            child.stdin.close()
+        _, status, rusage = os.wait4(child.pid, 0)
+        end = time.time()
+
+        if verbose == 2:
+            print("Ran %s -> %d" % (cmd, status))
+
+        if status != 0:
+            raise RuntimeError("Error running %s: %s" % (cmd, status))
+
+        sample["wall"] += end - start
+        sample["utime"] += rusage.ru_utime
+        sample["stime"] += rusage.ru_stime
+        sample["maxrss_kb"] = max(sample["maxrss_kb"], rusage.ru_maxrss)
+
+    return sample
+
+
+# Two-sided 95% quantiles of Student's t distribution, by degrees of freedom.
+t95 = [
+    0, 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262,
+    2.228, 2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093,
+    2.086,
+]  # fmt: skip
+
+
+def stats(values):
+    """Returns the mean, standard deviation and half-width of the 95%
+    confidence interval of the values."""
+    n = len(values)
+    mean = sum(values) / n
+    if n < 2:
+        return {"mean": mean, "stdev": 0.0, "ci95": 0.0, "samples": values}
+
+    stdev = math.sqrt(sum((v - mean) ** 2 for v in values) / (n - 1))
+    t = t95[n - 1] if n - 1 < len(t95) else 1.96
+    return {
+        "mean": mean,
+        "stdev": stdev,
+        "ci95": t * stdev / math.sqrt(n),
+        "samples": values,
+    }
+
+
+def run_workload(name, cmd, repeat, data, config_names, runs):
+    results = []
+    base = None
+    for config in config_names:
+        fiu_args = configs[config]
+
+        # Once without measuring, to warm up the caches.
+        run_sample(cmd, repeat, data, fiu_args)
+
+        samples = [
+            run_sample(cmd, repeat, data, fiu_args) for _ in range(runs)
+        ]
+        r = {"workload": name, "config": config, "runs": runs}
+        for k in ("wall", "utime", "stime", "maxrss_kb"):
+            r[k] = stats([s[k] for s in samples])
+
+        if config == "base":
+            base = r["wall"]["mean"]
+        if base:
+            r["overhead"] = r["wall"]["mean"] / base - 1
+
+        print(
+            "%-10s %-6s r:%.3f±%.3f  u:%.3f  s:%.3f  rss:%dk%s"
+            % (
+                name,
+                config,
+                r["wall"]["mean"],
+                r["wall"]["ci95"],
+                r["utime"]["mean"],
+                r["stime"]["mean"],
+                r["maxrss_kb"]["mean"],
+                "  %+.1f%%" % (r["overhead"] * 100) if "overhead" in r else "",
+            )
+        )
+        sys.stdout.flush()
+        results.append(r)
+
+    return results
+
+
+def compare(results, baseline, tolerance):
+    """Compares the overheads against the ones in the baseline, returns True
+    if none grew by more than the tolerance."""
+    old = {}
+    for r in baseline["results"]:
+        if "overhead" in r:
+            old[(r["workload"], r["config"])] = r["overhead"]
+
+    ok = True
+    for r in results:
+        key = (r["workload"], r["config"])
+        if "overhead" not in r or key not in old or r["config"] == "base":
+            continue
+
+        diff = r["overhead"] - old[key]
+        regressed = diff > tolerance
+        ok = ok and not regressed
+        print(
+            "%-10s %-6s overhead %+.1f%% -> %+.1f%%%s"
+            % (
+                key[0],
+                key[1],
+                old[key] * 100,
+                r["overhead"] * 100,
+                "  REGRESSION" if regressed else "",
+            )
+        )
+
+    return ok
+
+
+def build():
+    """Builds the binaries we need, if they're not there."""
+    for args in (
+        ["-C", tests_dir, "small-cat"],
+        ["-C", tests_dir + "/utils", "lnlibs"],
+        ["-C", tests_dir + "/bench", "bench-stdio"],
+    ):
+        subprocess.check_call(["make", "-s"] + args, stdout=dev_null)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Measure the overhead of libfiu on some workloads."
+    )
+    parser.add_argument(
+        "-w",
+        "--workloads",
+        default=",".join(workloads),
+        help="comma-separated workloads to run (default: all)",
+    )
+    parser.add_argument(
+        "-c",
+        "--configs",
+        default=",".join(configs),
+        help="comma-separated configurations to run (default: all)",
+    )
+    parser.add_argument(
+        "-n", "--runs", type=int, default=5, help="runs of each (default: 5)"
+    )
+    parser.add_argument("--json", help="write the results to this file")
+    parser.add_argument("--baseline", help="compare against this file")
+    parser.add_argument(
+        "--tolerance",
+        type=float,
+        default=0.05,
+        help="how much the overhead can grow over the baseline "
+        + "(default: 0.05, 5 points)",
+    )
+    args = parser.parse_args()
+
+    config_names = args.configs.split(",")
+    for c in config_names:
+        if c not in configs:
+            parser.error("unknown configuration %r" % c)
+    if "base" in config_names:
+        # It goes first, as the overhead is relative to it.
+        config_names.remove("base")
+        config_names.insert(0, "base")
+
+    build()
+
+    results = []
+    tmpdir = tempfile.mkdtemp()
+    try:
+        for name in args.workloads.split(","):
+            if name not in workloads:
+                parser.error("unknown workload %r" % name)
+            cmd, repeat, data = workloads[name](tmpdir)
+            if cmd is None:
+                print("%-10s skipped, can't run here" % name)
+                continue
+            results += run_workload(
+                name, cmd, repeat, data, config_names, args.runs
+            )
+    finally:
+        shutil.rmtree(tmpdir)
+
+    if args.json:
+        with open(args.json, "w") as fd:
+            json.dump(
+                {
+                    "date": time.strftime("%Y-%m-%dT%H:%M:%S"),
+                    "machine": platform.machine(),
+                    "system": platform.platform(),
+                    "cpus": os.cpu_count(),
+                    "results": results,
+                },
+                fd,
+                indent=2,
+            )
+
+    if args.baseline:
+        with open(args.baseline) as fd:
+            baseline = json.load(fd)
+        if not compare(results, baseline, args.tolerance):
+            return 1
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,136 @@
+/* Test restricting points of failure to big operations, and the memory
+ * allocation functions of the POSIX preload library. */
+
+#include <assert.h>
+#include <errno.h>
+#include <fiu-control.h>
+#include <fiu.h>
+#include <malloc.h>
+#include <stdlib.h>
+#include <string.h>
+
+static size_t total = 0;
+
+static size_t get_total(void)
+{
+	return total;
+}
+
+static void test_api(void)
+{
+	/* They must outlive the watch. */
+	static const char *names[] = {"s1"};
+	static uint64_t mask[1];
+	struct fiu_watch *w;
+
+	w = fiu_watch_ids(names, 1, mask);
+	assert(w != NULL);
+
+	assert(fiu_enable("s1", 1, NULL, 0) == 0);
+	assert(fiu_set_size("s1", 100, 0) == 0);
+
+	assert(fiu_fail_id_size(w, 0, NULL, 99, NULL) == 0);
+	assert(fiu_fail_id_size(w, 0, NULL, 100, NULL) == 1);
+
+	/* Without a size, they never fail. */
+	assert(fiu_fail("s1") == 0);
+	assert(fiu_fail_id(w, 0) == 0);
+
+	/* The total is only looked at if the size is big enough. */
+	assert(fiu_set_size("s1", 100, 1000) == 0);
+	total = 999;
+	assert(fiu_fail_id_size(w, 0, NULL, 100, get_total) == 0);
+	assert(fiu_fail_id_size(w, 0, NULL, 100, NULL) == 0);
+	total = 1000;
+	assert(fiu_fail_id_size(w, 0, NULL, 99, get_total) == 0);
+	assert(fiu_fail_id_size(w, 0, NULL, 100, get_total) == 1);
+
+	/* Enabling it again removes the restriction. */
+	assert(fiu_enable("s1", 1, NULL, 0) == 0);
+	assert(fiu_fail_id_size(w, 0, NULL, 1, NULL) == 1);
+	assert(fiu_fail("s1") == 1);
+
+	assert(fiu_disable("s1") == 0);
+	assert(fiu_set_size("s1", 100, 0) == -1);
+}
+
+static void test_malloc(void)
+{
+	char *error = NULL;
+	void *p;
+	int i;
+
+	assert(fiu_rc_string("enable name=libc/mm/*,minsize=1M", &error) == 0);
+
+	for (i = 0; i < 1000; i++) {
+		p = malloc(i + 1);
+		assert(p != NULL);
+		free(p);
+	}
+	p = calloc(1024, 1023);
+	assert(p != NULL);
+	free(p);
+
+	errno = 0;
+	assert(malloc(1024 * 1024) == NULL && errno == ENOMEM);
+	assert(calloc(1024, 1024) == NULL);
+	assert(realloc(NULL, 2 * 1024 * 1024) == NULL);
+	assert(posix_memalign(&p, 64, 1024 * 1024) == ENOMEM);
+	assert(posix_memalign(&p, 64, 1024) == 0);
+	free(p);
+	assert(aligned_alloc(64, 1024 * 1024) == NULL);
+	assert(valloc(1024 * 1024) == NULL);
+#ifdef __GLIBC__
+	assert(memalign(64, 1024 * 1024) == NULL);
+	assert(reallocarray(NULL, 1024, 1024) == NULL);
+	p = reallocarray(NULL, 1024, 4);
+	assert(p != NULL);
+	free(p);
+#endif
+
+	assert(fiu_disable("libc/mm/*") == 0);
+
+	p = malloc(1024 * 1024);
+	assert(p != NULL);
+	free(p);
+}
+
+static void test_total(void)
+{
+	char *error = NULL;
+	void *p;
+
+#ifndef __GLIBC__
+	/* We only know the total with glibc. */
+	return;
+#endif
+
+	/* Way more than we have, so it never fails. */
+	assert(fiu_rc_string("enable name=libc/mm/malloc,mintotal=1024G",
+	                     &error) == 0);
+	p = malloc(100);
+	assert(p != NULL);
+	free(p);
+
+	/* And less than we have. */
+	assert(fiu_rc_string("enable name=libc/mm/malloc,minsize=10,"
+	                     "mintotal=1",
+	                     &error) == 0);
+	p = malloc(1);
+	assert(p != NULL);
+	free(p);
+	assert(malloc(100) == NULL);
+
+	assert(fiu_disable("libc/mm/malloc") == 0);
+}
+
+int main(void)
+{
+	fiu_init(0);
+
+	test_api();
+	test_malloc();
+	test_total();
+
+	return 0;
+}
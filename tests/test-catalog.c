@@ -0,0 +1,83 @@
+/* Test that the points of failure are recorded in the binaries, and that
+ * fiu-ls -p lists them. */
+
+#include <assert.h>
+#include <fiu-control.h>
+#include <fiu.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+static int literal(void)
+{
+	fiu_return_on("catalog/literal", -1);
+	return 0;
+}
+
+static int not_literal(const char *name)
+{
+	fiu_return_on(name, -1);
+	return 0;
+}
+
+/* Runs fiu-ls -p on the given binary, and checks that each of the names is
+ * listed in it (or that none of them are, if expected is false). */
+static void check(const char *binary, const char *const *names,
+                  bool expected)
+{
+	char cmd[PATH_MAX + 64], line[256];
+	int i, found[8] = {0};
+	FILE *f;
+
+	snprintf(cmd, sizeof(cmd), "../utils/fiu-ls -p '%s'", binary);
+	f = popen(cmd, "r");
+	assert(f != NULL);
+
+	while (fgets(line, sizeof(line), f) != NULL) {
+		line[strcspn(line, "\n")] = '\0';
+		assert(line[0] != '\0');
+		for (i = 0; names[i] != NULL; i++) {
+			if (strcmp(line, names[i]) == 0)
+				found[i]++;
+		}
+	}
+	assert(pclose(f) == 0);
+
+	/* Each name at most once, even if it appears in many places. */
+	for (i = 0; names[i] != NULL; i++)
+		assert(found[i] == (expected ? 1 : 0));
+}
+
+int main(void)
+{
+	const char *mine[] = {"catalog/literal", NULL};
+	const char *others[] = {"catalog/not_literal", NULL};
+	const char *posix[] = {"posix/io/rw/read", "posix/io/oc/open",
+	                       "libc/mm/malloc", "posix/io/rw/readv/reduce",
+	                       NULL};
+	char self[PATH_MAX];
+	ssize_t len;
+
+	fiu_init(0);
+
+	assert(literal() == 0);
+	assert(not_literal("catalog/not_literal") == 0);
+
+	len = readlink("/proc/self/exe", self, sizeof(self) - 1);
+	if (len < 0) {
+		printf("No /proc/self/exe, skipping test\n");
+		return 0;
+	}
+	self[len] = '\0';
+
+#if defined __GNUC__ && !defined __clang__ && defined __ELF__
+	check(self, mine, true);
+#endif
+	check(self, others, false);
+
+	check("./libs/fiu_posix_preload.so", posix, true);
+
+	return 0;
+}
@@ -0,0 +1,127 @@
+/* Test delay injection, both in our own points of failure and in the POSIX
+ * wrappers. */
+
+#include <assert.h>
+#include <fcntl.h>
+#include <fiu-control.h>
+#include <fiu.h>
+#include <time.h>
+#include <unistd.h>
+
+/* How late we accept a delay to be; delays are usually accurate to a few
+ * microseconds, but we don't want to fail on loaded machines. */
+#define SLACK_US 20000
+
+static double now_us(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+/* Checks the point once, and returns how long it took, in microseconds. */
+static double time_fail(const char *name)
+{
+	double start = now_us();
+
+	assert(fiu_fail(name) == 0);
+	return now_us() - start;
+}
+
+static void test_dists(void)
+{
+	double t;
+	int i;
+
+	assert(fiu_enable_delay("d1", 0, 1, FIU_DELAY_FIXED, 2000, 0) == 0);
+	t = time_fail("d1");
+	assert(t >= 2000 && t < 2000 + SLACK_US);
+
+	/* fiu_delay_on() is just a nicer way of writing the same. */
+	t = now_us();
+	fiu_delay_on("d1");
+	assert(now_us() - t >= 2000);
+
+	/* Long delays only sleep, but must not end early either. */
+	assert(fiu_enable_delay("d1", 0, 1, FIU_DELAY_FIXED, 30000, 0) == 0);
+	t = time_fail("d1");
+	assert(t >= 30000 && t < 30000 + SLACK_US);
+
+	assert(fiu_enable_delay("d1", 0, 1, FIU_DELAY_UNIFORM, 500, 1500) == 0);
+	for (i = 0; i < 20; i++) {
+		t = time_fail("d1");
+		assert(t >= 500 && t < 1500 + SLACK_US);
+	}
+
+	/* With sigma 0, the lognormal is always the median. */
+	assert(fiu_enable_delay("d1", 0, 1, FIU_DELAY_LOGNORMAL, 1000, 0) == 0);
+	t = time_fail("d1");
+	assert(t >= 1000 && t < 1000 + SLACK_US);
+
+	assert(fiu_enable_delay("d1", 0, 0, FIU_DELAY_FIXED, 100000, 0) == 0);
+	assert(time_fail("d1") < SLACK_US);
+
+	assert(fiu_enable_delay("d1", FIU_ONETIME, 1, FIU_DELAY_FIXED, 1000,
+	                        0) == 0);
+	assert(time_fail("d1") >= 1000);
+	assert(time_fail("d1") < 1000);
+
+	assert(fiu_disable("d1") == 0);
+
+	/* Invalid parameters. */
+	assert(fiu_enable_delay("d1", 0, 1, FIU_DELAY_FIXED, -1, 0) != 0);
+	assert(fiu_enable_delay("d1", 0, 1, FIU_DELAY_UNIFORM, 10, 5) != 0);
+	assert(fiu_enable_delay("d1", 0, 1, FIU_DELAY_LOGNORMAL, 10, -1) != 0);
+	assert(fiu_enable_delay("d1", 0, 1, 42, 10, 0) != 0);
+}
+
+static void test_rc(void)
+{
+	char *error = NULL;
+	double t;
+
+	assert(fiu_rc_string("enable_delay name=d2,delay=1000,dist=uniform,"
+	                     "max=3000",
+	                     &error) == 0);
+	t = time_fail("d2");
+	assert(t >= 1000 && t < 3000 + SLACK_US);
+
+	assert(fiu_rc_string("enable_delay name=d2,dist=other,delay=1",
+	                     &error) != 0);
+	assert(fiu_rc_string("enable_delay name=d2", &error) != 0);
+
+	assert(fiu_rc_string("disable name=d2", &error) == 0);
+}
+
+static void test_posix(void)
+{
+	char buf[16];
+	double t;
+	int fd;
+
+	fd = open("/dev/zero", O_RDONLY);
+	assert(fd >= 0);
+
+	/* The wrappers delay, and then behave as usual. */
+	assert(fiu_enable_delay("posix/io/rw/read", 0, 1, FIU_DELAY_FIXED,
+	                        3000, 0) == 0);
+	t = now_us();
+	assert(read(fd, buf, sizeof(buf)) == sizeof(buf));
+	t = now_us() - t;
+	assert(t >= 3000 && t < 3000 + SLACK_US);
+
+	assert(fiu_disable("posix/io/rw/read") == 0);
+	close(fd);
+}
+
+int main(void)
+{
+	fiu_init(0);
+
+	test_dists();
+	test_rc();
+	test_posix();
+
+	return 0;
+}
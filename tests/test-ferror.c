@@ -56,6 +56,48 @@ int test(const char *prefix)
 	return 0;
 }
 
+/* Fail many streams at the same time, more than fit in the preload
+ * library's table, and check they're all tracked. */
+#define NSTREAMS 1500
+
+int test_many(void)
+{
+	static FILE *fps[NSTREAMS];
+	static char data[NSTREAMS][16];
+	unsigned char buf[16];
+	int i;
+
+	for (i = 0; i < NSTREAMS; i++) {
+		fps[i] = fmemopen(data[i], sizeof(data[i]), "r");
+		if (fps[i] == NULL) {
+			perror("fmemopen");
+			return -1;
+		}
+	}
+
+	fiu_enable("posix/stdio/rw/fread", 1, (void *)EIO, 0);
+	for (i = 0; i < NSTREAMS; i++)
+		fread(buf, 1, sizeof(buf), fps[i]);
+	fiu_disable("posix/stdio/rw/fread");
+
+	for (i = 0; i < NSTREAMS; i++) {
+		if (i % 2)
+			clearerr(fps[i]);
+	}
+
+	for (i = 0; i < NSTREAMS; i++) {
+		if ((ferror(fps[i]) != 0) != (i % 2 == 0)) {
+			printf("many: stream %d: wrong ferror()\n", i);
+			return -1;
+		}
+	}
+
+	for (i = 0; i < NSTREAMS; i++)
+		fclose(fps[i]);
+
+	return 0;
+}
+
 int main(void)
 {
 	// Run the test many times, to stress structure reuse a bit. This is
@@ -66,4 +108,10 @@ int main(void)
 		snprintf(prefix, 8, "%2d", i);
 		test(prefix);
 	}
+
+	// Twice, so the second round reuses the slots the first one released.
+	if (test_many() != 0 || test_many() != 0)
+		return 1;
+
+	return 0;
 }
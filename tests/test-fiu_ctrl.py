@@ -55,6 +55,27 @@ cmd.disable("posix/io/rw/*")
 out, err = p.communicate("test\n")
 assert out == "test\n", (out, err)
 
+# List.
+cmd = run_cat(fiu_enable_posix=True)
+p = cmd.start()
+assert cmd.list() == [], cmd.list()
+cmd.enable("p1", failinfo=3)
+cmd.enable_random("p2/*", probability=0.5, flags=[fiu_ctrl.Flags.ONETIME])
+cmd.enable_delay("p3", 1000, dist="lognormal", param=0.5)
+l = sorted(cmd.list())
+assert l == [
+    "enable name=p1,failnum=1,failinfo=3",
+    "enable_delay name=p3,failnum=1,failinfo=0,probability=1,"
+    + "dist=lognormal,delay=1000,sigma=0.5",
+    "enable_random name=p2/*,failnum=1,failinfo=0,"
+    + "probability=0.5,onetime",
+], l
+cmd.disable("p1")
+cmd.disable("p3")
+assert len(cmd.list()) == 1, cmd.list()
+out, err = p.communicate("test\n")
+assert out == "test\n", (out, err)
+
 # Bad command.
 cmd = run_cat(fiu_enable_posix=True)
 p = cmd.start()
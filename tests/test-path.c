@@ -0,0 +1,137 @@
+/* Test restricting points of failure to paths, both directly and through the
+ * POSIX preload library, which tracks the paths of the file descriptors. */
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <fiu-control.h>
+#include <fiu.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static char dir[] = "/tmp/fiu-test-path-XXXXXX";
+static char data[64], data_file[96], log_file[96];
+
+/* Opened before any path was set, so its path is not known. */
+static int early_fd;
+
+static int open_file(const char *path)
+{
+	int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0600);
+	assert(fd >= 0);
+	return fd;
+}
+
+static int writes(int fd)
+{
+	return write(fd, "x", 1) == 1;
+}
+
+static void test_fail_path(void)
+{
+	assert(fiu_enable("p1", 1, NULL, 0) == 0);
+	assert(fiu_set_path("p1", "/a/") == 0);
+
+	assert(fiu_fail_path("p1", "/a/b") == 1);
+	assert(fiu_fail_path("p1", "/b/a") == 0);
+	assert(fiu_fail_path("p1", NULL) == 0);
+	assert(fiu_fail("p1") == 0);
+
+	/* Remove the restriction. */
+	assert(fiu_set_path("p1", NULL) == 0);
+	assert(fiu_fail("p1") == 1);
+	assert(fiu_fail_path("p1", "/b/a") == 1);
+
+	assert(fiu_disable("p1") == 0);
+	assert(fiu_set_path("p1", "/a/") == -1);
+}
+
+static void test_fds(void)
+{
+	int data_fd, log_fd, fd;
+
+	data_fd = open_file(data_file);
+	log_fd = open_file(log_file);
+
+	assert(fiu_enable("posix/io/rw/write", 1, (void *) EIO, 0) == 0);
+	assert(fiu_set_path("posix/io/rw/write", data) == 0);
+
+	assert(!writes(data_fd));
+	assert(errno == EIO);
+	assert(writes(log_fd));
+
+	/* The paths are only recorded once they are used, so the restricted
+	 * points never fail for file descriptors opened before that. */
+	assert(writes(early_fd));
+
+	/* Duplicates keep the path. */
+	fd = dup(data_fd);
+	assert(fd >= 0);
+	assert(!writes(fd));
+	assert(dup2(log_fd, fd) == fd);
+	assert(writes(fd));
+	close(fd);
+
+	/* Once closed, the file descriptor is reused for another file, which
+	 * must not inherit the path. */
+	close(data_fd);
+	fd = open_file(log_file);
+	assert(fd == data_fd);
+	assert(writes(fd));
+	close(fd);
+
+	/* Unrestricted points still fail for everything. */
+	assert(fiu_set_path("posix/io/rw/write", NULL) == 0);
+	assert(!writes(log_fd));
+
+	assert(fiu_disable("posix/io/rw/write") == 0);
+	assert(writes(log_fd));
+	close(log_fd);
+}
+
+static void test_rc(void)
+{
+	char *error = NULL;
+	char cmd[128];
+
+	/* Points enabled with a wildcard can be restricted too, both by
+	 * fiu_set_path() and by the "path" parameter. */
+	snprintf(cmd, sizeof(cmd), "enable name=posix/io/dir/*,path=%s",
+		 data);
+	assert(fiu_rc_string(cmd, &error) == 0);
+
+	assert(unlink(log_file) == 0);
+	assert(unlink(data_file) == -1);
+
+	assert(fiu_rc_string("disable name=posix/io/dir/*", &error) == 0);
+	assert(unlink(data_file) == 0);
+}
+
+int main(void)
+{
+	fiu_init(0);
+
+	assert(mkdtemp(dir) != NULL);
+	snprintf(data, sizeof(data), "%s/data/", dir);
+	snprintf(data_file, sizeof(data_file), "%s/data/f", dir);
+	snprintf(log_file, sizeof(log_file), "%s/log", dir);
+	assert(mkdir(data, 0700) == 0);
+
+	early_fd = open_file(data_file);
+	assert(fiu_paths_used() == 0);
+
+	test_fail_path();
+	assert(fiu_paths_used() == 1);
+
+	test_fds();
+	test_rc();
+
+	close(early_fd);
+
+	rmdir(data);
+	rmdir(dir);
+	return 0;
+}
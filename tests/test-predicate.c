@@ -0,0 +1,192 @@
+/* Test restricting points of failure with predicates over the arguments,
+ * directly and through the POSIX preload library. */
+
+#include <arpa/inet.h>
+#include <assert.h>
+#include <errno.h>
+#include <fiu-control.h>
+#include <fiu.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+static int check(struct fiu_watch *w, int64_t a1, int64_t a2)
+{
+	int64_t args[] = {a1, a2};
+	struct fiu_op op = {.args = args, .nargs = 2};
+
+	return fiu_fail_id_op(w, 0, &op);
+}
+
+static void test_api(void)
+{
+	/* They must outlive the watch. */
+	static const char *names[] = {"p1"};
+	static uint64_t mask[1];
+	struct fiu_watch *w;
+	char *error = NULL;
+	int64_t one = 1;
+	struct fiu_op op = {.args = &one, .nargs = 1};
+
+	w = fiu_watch_ids(names, 1, mask);
+	assert(w != NULL);
+
+	assert(fiu_enable("p1", 1, NULL, 0) == 0);
+	assert(fiu_watch_nargs(w, 0) == 0);
+
+	assert(fiu_set_predicate("p1", "arg1==7&&arg2>4096") == 0);
+	assert(fiu_watch_nargs(w, 0) == 2);
+	assert(check(w, 7, 4097) == 1);
+	assert(check(w, 7, 4096) == 0);
+	assert(check(w, 6, 5000) == 0);
+
+	/* Without the arguments, they never fail. */
+	assert(fiu_fail("p1") == 0);
+	assert(fiu_fail_id(w, 0) == 0);
+	assert(fiu_fail_id_op(w, 0, &op) == 0);
+
+	assert(fiu_set_predicate("p1", "arg1<0||arg2&0x10||arg1>=100") == 0);
+	assert(check(w, -1, 0) == 1);
+	assert(check(w, 0, 0x30) == 1);
+	assert(check(w, 100, 0) == 1);
+	assert(check(w, 0, 0x20) == 0);
+	assert(check(w, 99, 0) == 0);
+
+	assert(fiu_set_predicate("p1", "arg2!=0xffffffffffffffff&&arg1<=-2") ==
+	       0);
+	assert(check(w, -2, 0) == 1);
+	assert(check(w, -2, -1) == 0);
+	assert(check(w, -1, 0) == 0);
+
+	/* Invalid ones. */
+	assert(fiu_set_predicate("p1", "") == -1);
+	assert(fiu_set_predicate("p1", "arg0==1") == -1);
+	assert(fiu_set_predicate("p1", "arg1=1") == -1);
+	assert(fiu_set_predicate("p1", "arg1==x") == -1);
+	assert(fiu_set_predicate("p1", "arg1==1&&") == -1);
+	assert(fiu_set_predicate("p1", "arg1==1 ") == -1);
+	assert(fiu_rc_string("enable name=p2,when=arg1", &error) == -1);
+
+	/* Removing it. */
+	assert(fiu_set_predicate("p1", NULL) == 0);
+	assert(fiu_watch_nargs(w, 0) == 0);
+	assert(fiu_fail("p1") == 1);
+
+	assert(fiu_disable("p1") == 0);
+	assert(fiu_set_predicate("p1", "arg1==1") == -1);
+}
+
+static void test_write(void)
+{
+	char buf[8192] = {0}, cmd[128], *error = NULL;
+	int p[2];
+
+	assert(pipe(p) == 0);
+
+	snprintf(cmd, sizeof(cmd),
+	         "enable name=posix/io/rw/write,failinfo=%d,"
+	         "when=arg1==%d&&arg3>4096",
+	         EIO, p[1]);
+	assert(fiu_rc_string(cmd, &error) == 0);
+
+	assert(write(p[1], buf, 100) == 100);
+	assert(write(p[1], buf, 5000) == -1 && errno == EIO);
+	assert(read(p[0], buf, sizeof(buf)) == 100);
+
+	/* Other file descriptors are not affected. */
+	assert(write(p[0], buf, 5000) == -1 && errno != EIO);
+
+	assert(fiu_disable("posix/io/rw/write") == 0);
+
+	close(p[0]);
+	close(p[1]);
+}
+
+#ifdef MAP_HUGETLB
+static void test_mmap(void)
+{
+	char cmd[128], *error = NULL;
+	void *p;
+
+	snprintf(cmd, sizeof(cmd),
+	         "enable name=posix/mm/mmap,failinfo=%d,when=arg4&%d", EPERM,
+	         MAP_HUGETLB);
+	assert(fiu_rc_string(cmd, &error) == 0);
+
+	p = mmap(NULL, 4096, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	assert(p != MAP_FAILED);
+	munmap(p, 4096);
+
+	p = mmap(NULL, 2 * 1024 * 1024, PROT_READ,
+	         MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+	assert(p == MAP_FAILED && errno == EPERM);
+
+	assert(fiu_disable("posix/mm/mmap") == 0);
+}
+#else
+static void test_mmap(void)
+{
+}
+#endif
+
+static void test_connect(void)
+{
+	struct sockaddr_un sun = {.sun_family = AF_UNIX};
+	struct sockaddr_in sin = {.sin_family = AF_INET};
+	char cmd[128], *error = NULL;
+	int fd;
+
+	strcpy(sun.sun_path, "/nonexistent/fiu-test-predicate");
+	sin.sin_port = htons(1);
+	sin.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+	/* The address family is an extra argument. */
+	snprintf(cmd, sizeof(cmd),
+	         "enable name=posix/io/net/connect,failinfo=%d,when=arg4==%d",
+	         EACCES, AF_UNIX);
+	assert(fiu_rc_string(cmd, &error) == 0);
+
+	fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	assert(fd >= 0);
+	assert(connect(fd, (struct sockaddr *)&sun, sizeof(sun)) == -1);
+	assert(errno == EACCES);
+	close(fd);
+
+	fd = socket(AF_INET, SOCK_STREAM, 0);
+	assert(fd >= 0);
+	assert(connect(fd, (struct sockaddr *)&sin, sizeof(sin)) == -1);
+	assert(errno != EACCES);
+	close(fd);
+
+	assert(fiu_disable("posix/io/net/connect") == 0);
+
+	/* It is only read when the predicate looks at it, so an invalid
+	 * address still fails with EFAULT otherwise. */
+	fd = socket(AF_INET, SOCK_STREAM, 0);
+	assert(fd >= 0);
+	snprintf(cmd, sizeof(cmd),
+	         "enable name=posix/io/net/connect,failinfo=%d,when=arg1==%d",
+	         EACCES, fd + 1);
+	assert(fiu_rc_string(cmd, &error) == 0);
+	assert(connect(fd, (struct sockaddr *)8, sizeof(sin)) == -1);
+	assert(errno == EFAULT);
+	close(fd);
+
+	assert(fiu_disable("posix/io/net/connect") == 0);
+}
+
+int main(void)
+{
+	fiu_init(0);
+
+	test_api();
+	test_write();
+	test_mmap();
+	test_connect();
+
+	return 0;
+}
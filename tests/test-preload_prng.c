@@ -0,0 +1,160 @@
+/* Test that the errnos picked by the POSIX preload library are reproducible
+ * when FIU_PRNG_SEED is set, including in other threads, and that setting
+ * the same seed with fiu_set_prng_seed() gives the same ones.
+ *
+ * The seed is read at startup, so we run ourselves with it set, and compare
+ * the outputs. */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <fiu-control.h>
+#include <fiu.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define NREADS 200
+
+static int fd;
+
+/* Reads with the point enabled, and writes the errnos into buf. */
+static void *collect(void *buf)
+{
+	char *s = buf, c;
+	int i;
+
+	for (i = 0; i < NREADS; i++) {
+		if (read(fd, &c, 1) != -1) {
+			strcpy(s, "read succeeded");
+			return NULL;
+		}
+		s += sprintf(s, "%d ", errno);
+	}
+
+	return NULL;
+}
+
+static int child(int set_seed)
+{
+	static char main_buf[NREADS * 8], thread_buf[NREADS * 8];
+	pthread_t thread;
+
+	if (set_seed)
+		fiu_set_prng_seed(1234);
+
+	fd = open("/dev/zero", O_RDONLY);
+	if (fd < 0) {
+		perror("open");
+		return 1;
+	}
+
+	/* No failinfo, so the wrapper picks the errno. */
+	fiu_enable("posix/io/rw/read", 1, NULL, 0);
+
+	collect(main_buf);
+	pthread_create(&thread, NULL, collect, thread_buf);
+	pthread_join(thread, NULL);
+
+	fiu_disable("posix/io/rw/read");
+
+	printf("%s\n%s\n", main_buf, thread_buf);
+	return 0;
+}
+
+/* Checks if the space-separated numbers in s are not all the same. */
+static int varies(const char *s)
+{
+	char *end;
+	long first, n;
+
+	first = strtol(s, &end, 10);
+	while (*end != '\0') {
+		n = strtol(end, &end, 10);
+		if (n != first && n != 0)
+			return 1;
+		if (*end == ' ')
+			end++;
+	}
+
+	return 0;
+}
+
+static int run_child(const char *self, const char *mode, char *out,
+		size_t len)
+{
+	char cmd[1024];
+	FILE *p;
+	size_t r;
+
+	snprintf(cmd, sizeof(cmd), "%s %s", self, mode);
+	p = popen(cmd, "r");
+	if (p == NULL) {
+		perror("popen");
+		return -1;
+	}
+
+	r = fread(out, 1, len - 1, p);
+	out[r] = '\0';
+
+	return pclose(p) == 0 ? 0 : -1;
+}
+
+int main(int argc, char **argv)
+{
+	static char out1[NREADS * 16 + 2], out2[NREADS * 16 + 2],
+		out3[NREADS * 16 + 2];
+	char *main_errnos, *thread_errnos;
+
+	if (argc > 1)
+		return child(strcmp(argv[1], "set") == 0);
+
+	if (run_child(argv[0], "set", out3, sizeof(out3)) != 0) {
+		printf("child failed\n");
+		return 1;
+	}
+
+	setenv("FIU_PRNG_SEED", "1234", 1);
+
+	if (run_child(argv[0], "child", out1, sizeof(out1)) != 0 ||
+	    run_child(argv[0], "child", out2, sizeof(out2)) != 0) {
+		printf("child failed\n");
+		return 1;
+	}
+
+	if (strcmp(out1, out2) != 0) {
+		printf("different errnos with the same seed:\n%s\n%s\n",
+		       out1, out2);
+		return 1;
+	}
+
+	if (strcmp(out1, out3) != 0) {
+		printf("different errnos with fiu_set_prng_seed():\n%s\n%s\n",
+		       out1, out3);
+		return 1;
+	}
+
+	/* The threads must not use the same sequence, and the errnos must
+	 * actually vary. */
+	main_errnos = out1;
+	thread_errnos = strchr(out1, '\n');
+	if (thread_errnos == NULL) {
+		printf("unexpected output: %s\n", out1);
+		return 1;
+	}
+	*thread_errnos = '\0';
+	thread_errnos++;
+
+	if (strncmp(main_errnos, thread_errnos, strlen(main_errnos)) == 0) {
+		printf("threads got the same errnos: %s\n", main_errnos);
+		return 1;
+	}
+
+	if (!varies(main_errnos)) {
+		printf("errnos do not vary: %s\n", main_errnos);
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,86 @@
+/* Test that the commands fiu_rc_list() gives enable the same points of
+ * failure again, even when the values need escaping, and that the ones that
+ * don't fit in a command are left out instead of truncated. */
+
+#include <assert.h>
+#include <fiu-control.h>
+#include <fiu.h>
+#include <stdio.h>
+#include <string.h>
+
+/* fiu_rc_list() callback, keeps the last line in arg, and counts them. */
+static int nlines;
+
+static int save_line(const char *line, void *arg)
+{
+	snprintf(arg, 1024, "%s", line);
+	nlines++;
+	return 0;
+}
+
+/* Lists the only enabled point into line, checking there's only one. */
+static void list_one(char *line)
+{
+	nlines = 0;
+	assert(fiu_rc_list(save_line, line) == 0);
+	assert(nlines == 1);
+}
+
+/* Checks the point is listed as expected, and that applying the command
+ * after disabling it enables the same one again. */
+static void check(const char *name, const char *expected)
+{
+	char line[1024], again[1024];
+	char *error = NULL;
+
+	list_one(line);
+	assert(strcmp(line, expected) == 0);
+
+	assert(fiu_disable(name) == 0);
+	assert(fiu_rc_string(line, &error) == 0);
+
+	list_one(again);
+	assert(strcmp(again, expected) == 0);
+	assert(fiu_disable(name) == 0);
+}
+
+int main(void)
+{
+	char path[600];
+	char line[1024], expected[1024];
+
+	fiu_init(0);
+
+	assert(fiu_enable("a,b c\\d", 1, NULL, 0) == 0);
+	assert(fiu_set_path("a,b c\\d", "/x,y") == 0);
+	check("a,b c\\d", "enable name=a\\,b\\ c\\\\d,failnum=1,failinfo=0,"
+	                  "path=/x\\,y");
+
+	/* Small probabilities must not become 0; they're kept as floats. */
+	assert(fiu_enable_random("r", 1, NULL, 0, 1e-9) == 0);
+	snprintf(expected, sizeof(expected),
+	         "enable_random name=r,failnum=1,failinfo=0,"
+	         "probability=%.17g",
+	         (double)(float)1e-9);
+	check("r", expected);
+
+	/* A point whose path doesn't fit is left out, as without the path
+	 * it would fail everywhere. */
+	memset(path, 'p', sizeof(path) - 1);
+	path[sizeof(path) - 1] = '\0';
+	assert(fiu_enable("long", 1, NULL, 0) == 0);
+	assert(fiu_set_path("long", path) == 0);
+	nlines = 0;
+	assert(fiu_rc_list(save_line, line) == 0);
+	assert(nlines == 0);
+	assert(fiu_disable("long") == 0);
+
+	/* Same for a name with a newline, which can't be escaped. */
+	assert(fiu_enable("new\nline", 1, NULL, 0) == 0);
+	nlines = 0;
+	assert(fiu_rc_list(save_line, line) == 0);
+	assert(nlines == 0);
+	assert(fiu_disable("new\nline") == 0);
+
+	return 0;
+}
@@ -0,0 +1,54 @@
+/* Test that reducing the vector I/O functions cuts the transfer at any byte,
+ * not just between buffers, and leaves the caller's iovecs alone. */
+
+#include <assert.h>
+#include <fiu-control.h>
+#include <fiu.h>
+#include <string.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+int main(void)
+{
+	char a[8] = "01234567", b[8] = "89abcdef", c[8] = "ghijklmn";
+	struct iovec iov[3] = {
+		{ a, sizeof(a) }, { b, sizeof(b) }, { c, sizeof(c) },
+	};
+	char buf[sizeof(a) * 3];
+	int p[2], i, mid_buffer = 0;
+	ssize_t r;
+
+	fiu_init(0);
+	assert(pipe(p) == 0);
+
+	assert(fiu_enable("posix/io/rw/writev/reduce", 1, NULL, 0) == 0);
+
+	for (i = 0; i < 100; i++) {
+		r = writev(p[1], iov, 3);
+		assert(r > 0 && r <= (ssize_t) sizeof(buf));
+		if (r % sizeof(a) != 0)
+			mid_buffer++;
+
+		/* What was written is a prefix of the data. */
+		assert(read(p[0], buf, sizeof(buf)) == r);
+		assert(memcmp(buf, a, r < 8 ? r : 8) == 0);
+		if (r > 8)
+			assert(memcmp(buf + 8, b, r < 16 ? r - 8 : 8) == 0);
+		if (r > 16)
+			assert(memcmp(buf + 16, c, r - 16) == 0);
+
+		assert(iov[0].iov_base == a && iov[0].iov_len == sizeof(a));
+		assert(iov[1].iov_base == b && iov[1].iov_len == sizeof(b));
+		assert(iov[2].iov_base == c && iov[2].iov_len == sizeof(c));
+	}
+
+	/* With 24 bytes, almost all the cuts are in the middle of a buffer. */
+	assert(mid_buffer > 50);
+
+	assert(fiu_disable("posix/io/rw/writev/reduce") == 0);
+	assert(writev(p[1], iov, 3) == sizeof(buf));
+
+	close(p[0]);
+	close(p[1]);
+	return 0;
+}
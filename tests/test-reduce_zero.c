@@ -0,0 +1,64 @@
+/* Test that the reduce points of failure leave zero-length transfers alone,
+ * as there is nothing to reduce (and it used to divide by zero). */
+
+#include <fiu.h>
+
+#ifdef __linux__
+
+#include <assert.h>
+#include <fcntl.h>
+#include <fiu-control.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/sendfile.h>
+#include <unistd.h>
+
+int main(void)
+{
+	char tmpl[] = "/tmp/fiu-test-reduce_zero-XXXXXX";
+	int fd, p[2], q[2];
+	char buf[1];
+
+	fiu_init(0);
+
+	fd = mkstemp(tmpl);
+	assert(fd >= 0);
+	unlink(tmpl);
+	assert(pipe(p) == 0);
+	assert(pipe(q) == 0);
+
+	assert(fiu_enable("posix/io/rw/read/reduce", 1, NULL, 0) == 0);
+	assert(fiu_enable("linux/io/zc/sendfile/reduce", 1, NULL, 0) == 0);
+	assert(fiu_enable("linux/io/zc/splice/reduce", 1, NULL, 0) == 0);
+	assert(fiu_enable("linux/io/zc/tee/reduce", 1, NULL, 0) == 0);
+	assert(fiu_enable("linux/io/zc/copy_file_range/reduce", 1, NULL, 0) ==
+	       0);
+
+	assert(read(fd, buf, 0) == 0);
+	assert(sendfile(p[1], fd, NULL, 0) == 0);
+	assert(splice(fd, NULL, p[1], NULL, 0, 0) == 0);
+	assert(tee(p[0], q[1], 0, 0) == 0);
+	assert(copy_file_range(fd, NULL, fd, NULL, 0, 0) == 0);
+
+	assert(fiu_disable("posix/io/rw/read/reduce") == 0);
+	assert(fiu_disable("linux/io/zc/sendfile/reduce") == 0);
+	assert(fiu_disable("linux/io/zc/splice/reduce") == 0);
+	assert(fiu_disable("linux/io/zc/tee/reduce") == 0);
+	assert(fiu_disable("linux/io/zc/copy_file_range/reduce") == 0);
+
+	close(fd);
+	close(p[0]);
+	close(p[1]);
+	close(q[0]);
+	close(q[1]);
+	return 0;
+}
+
+#else
+
+int main(void)
+{
+	return 0;
+}
+
+#endif
@@ -0,0 +1,122 @@
+/* Test failing in bursts, and the spurious results of the event loop
+ * functions in the POSIX preload library. */
+
+#include <assert.h>
+#include <errno.h>
+#include <fiu-control.h>
+#include <fiu.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#endif
+
+static int cb_calls = 0;
+
+/* Fails only the first time it's called. */
+static int first_cb(const char *name, int *failnum, void **failinfo,
+                    unsigned int *flags)
+{
+	return cb_calls++ == 0;
+}
+
+static void test_burst(void)
+{
+	char *error = NULL;
+	int i;
+
+	assert(fiu_enable_external("b1", 1, NULL, 0, first_cb) == 0);
+	assert(fiu_set_burst("b1", 5) == 0);
+
+	/* The first failure comes from the callback, and the next 4 from the
+	 * burst, without calling it. */
+	for (i = 0; i < 5; i++)
+		assert(fiu_fail("b1") == 1);
+	assert(cb_calls == 1);
+	assert(fiu_fail("b1") == 0);
+	assert(cb_calls == 2);
+
+	assert(fiu_disable("b1") == 0);
+	assert(fiu_set_burst("b1", 5) == -1);
+
+	/* A burst after a one-time failure. */
+	assert(fiu_rc_string("enable name=b2,onetime,burst=3", &error) == 0);
+	for (i = 0; i < 3; i++)
+		assert(fiu_fail("b2") == 1);
+	for (i = 0; i < 10; i++)
+		assert(fiu_fail("b2") == 0);
+	assert(fiu_rc_string("disable name=b2", &error) == 0);
+}
+
+static void test_recv(void)
+{
+	char *error = NULL;
+	int sv[2], i;
+	char c;
+
+	assert(socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0);
+	assert(write(sv[0], "x", 1) == 1);
+
+	/* A burst of 3 spurious EAGAIN, and then the data. */
+	assert(fiu_rc_string("enable name=posix/io/net/recv/spurious,onetime,"
+	                     "burst=3",
+	                     &error) == 0);
+	for (i = 0; i < 3; i++) {
+		assert(recv(sv[1], &c, 1, 0) == -1);
+		assert(errno == EAGAIN);
+	}
+	assert(recv(sv[1], &c, 1, 0) == 1 && c == 'x');
+	assert(fiu_disable("posix/io/net/recv/spurious") == 0);
+
+	close(sv[0]);
+	close(sv[1]);
+}
+
+#ifdef __linux__
+static void test_epoll(void)
+{
+	struct epoll_event ev = { .events = EPOLLIN };
+	int epfd, efd;
+
+	epfd = epoll_create1(0);
+	assert(epfd >= 0);
+	efd = eventfd(1, EFD_NONBLOCK);
+	assert(efd >= 0);
+	assert(epoll_ctl(epfd, EPOLL_CTL_ADD, efd, &ev) == 0);
+
+	assert(epoll_wait(epfd, &ev, 1, 0) == 1);
+
+	/* Woken up without events, even if there are. */
+	assert(fiu_enable("linux/io/epoll/epoll_wait/spurious", 1, NULL, 0) ==
+	       0);
+	assert(epoll_wait(epfd, &ev, 1, -1) == 0);
+	assert(fiu_disable("linux/io/epoll/epoll_wait/spurious") == 0);
+
+	/* The wildcard covers the error too, which takes precedence. */
+	assert(fiu_enable("linux/io/epoll/*", 1, (void *) EINTR, 0) == 0);
+	assert(epoll_wait(epfd, &ev, 1, 0) == -1 && errno == EINTR);
+	assert(fiu_disable("linux/io/epoll/*") == 0);
+
+	assert(epoll_wait(epfd, &ev, 1, 0) == 1);
+
+	close(efd);
+	close(epfd);
+}
+#else
+static void test_epoll(void)
+{
+}
+#endif
+
+int main(void)
+{
+	fiu_init(0);
+
+	test_burst();
+	test_recv();
+	test_epoll();
+
+	return 0;
+}
@@ -0,0 +1,166 @@
+
+/* Test restricting points of failure to some threads. */
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <fiu-control.h>
+#include <fiu.h>
+
+/* Runs the check in a new thread with the given name. */
+struct check {
+	const char *thread_name;
+	const char *tag;
+	int result;
+};
+
+static void *check_thread(void *arg)
+{
+	struct check *c = arg;
+
+	if (c->thread_name != NULL)
+		pthread_setname_np(pthread_self(), c->thread_name);
+	if (c->tag != NULL)
+		assert(fiu_thread_tag(c->tag) == 0);
+
+	c->result = fiu_fail("p1");
+	return NULL;
+}
+
+static int check_in_thread(const char *thread_name, const char *tag)
+{
+	pthread_t thread;
+	struct check c = {thread_name, tag, -1};
+
+	assert(pthread_create(&thread, NULL, check_thread, &c) == 0);
+	assert(pthread_join(thread, NULL) == 0);
+	return c.result;
+}
+
+static void test_name(void)
+{
+	char *error = NULL;
+
+	assert(fiu_rc_string("enable name=p1,thread=compact*", &error) == 0);
+	assert(fiu_fail("p1") == 0);
+	assert(check_in_thread("compact-1", NULL) == 1);
+	assert(check_in_thread("compact-2", NULL) == 1);
+	assert(check_in_thread("io-1", NULL) == 0);
+	assert(check_in_thread(NULL, NULL) == 0);
+
+	assert(fiu_rc_string("enable name=p1,thread=io-1", &error) == 0);
+	assert(check_in_thread("compact-1", NULL) == 0);
+	assert(check_in_thread("io-1", NULL) == 1);
+	assert(check_in_thread("io-10", NULL) == 0);
+
+	assert(fiu_rc_string("enable name=p1,thread=glob:*-?", &error) == 0);
+	assert(check_in_thread("compact-1", NULL) == 1);
+	assert(check_in_thread("io-1", NULL) == 1);
+	assert(check_in_thread("io-10", NULL) == 0);
+
+	assert(fiu_disable("p1") == 0);
+}
+
+static void test_tid(void)
+{
+	char cmd[128], *error = NULL;
+
+	snprintf(cmd, sizeof(cmd), "enable name=p1,tid=%ld",
+	         (long)syscall(SYS_gettid));
+	assert(fiu_rc_string(cmd, &error) == 0);
+	assert(fiu_fail("p1") == 1);
+	assert(check_in_thread(NULL, NULL) == 0);
+
+	assert(fiu_disable("p1") == 0);
+}
+
+static void test_tag(void)
+{
+	assert(fiu_enable("p1", 1, NULL, 0) == 0);
+	assert(fiu_set_threads("p1", 0, NULL, "compaction") == 0);
+
+	assert(fiu_fail("p1") == 0);
+	assert(check_in_thread(NULL, "compaction") == 1);
+	assert(check_in_thread(NULL, "other") == 0);
+
+	assert(fiu_thread_tag("compaction") == 0);
+	assert(fiu_fail("p1") == 1);
+	assert(fiu_thread_untag("compaction") == 0);
+	assert(fiu_fail("p1") == 0);
+
+	/* Any of them is enough. */
+	assert(fiu_set_threads("p1", 0, "compact*", "compaction") == 0);
+	assert(check_in_thread("compact-1", NULL) == 1);
+	assert(check_in_thread(NULL, "compaction") == 1);
+	assert(check_in_thread("io-1", NULL) == 0);
+
+	/* Removing them. */
+	assert(fiu_set_threads("p1", 0, NULL, NULL) == 0);
+	assert(fiu_fail("p1") == 1);
+	assert(check_in_thread("io-1", NULL) == 1);
+
+	assert(fiu_disable("p1") == 0);
+	assert(fiu_set_threads("p1", 0, NULL, "compaction") == -1);
+}
+
+static void test_many(void)
+{
+	char name[32];
+	int i;
+
+	/* Selectors are released when the points are disabled, so we don't
+	 * run out of them. */
+	for (i = 0; i < 1000; i++) {
+		snprintf(name, sizeof(name), "t%d", i);
+		assert(fiu_enable("p1", 1, NULL, 0) == 0);
+		assert(fiu_set_threads("p1", 0, name, NULL) == 0);
+		assert(fiu_disable("p1") == 0);
+	}
+
+	/* Tags too, once no point and no thread uses them; threads release
+	 * their tags when they exit. */
+	for (i = 0; i < 1000; i++) {
+		snprintf(name, sizeof(name), "t%d", i);
+		assert(fiu_thread_tag(name) == 0);
+		assert(fiu_enable("p1", 1, NULL, 0) == 0);
+		assert(fiu_set_threads("p1", 0, NULL, name) == 0);
+		assert(fiu_disable("p1") == 0);
+		assert(fiu_thread_untag(name) == 0);
+
+		assert(fiu_enable("p1", 1, NULL, 0) == 0);
+		assert(fiu_set_threads("p1", 0, NULL, name) == 0);
+		assert(check_in_thread(NULL, name) == 1);
+		assert(fiu_disable("p1") == 0);
+	}
+
+	/* Removing a tag the thread doesn't have does nothing. */
+	assert(fiu_thread_untag("unknown") == 0);
+
+	/* But there's a limit to how many can be in use at the same time. */
+	for (i = 0; i < 100; i++) {
+		snprintf(name, sizeof(name), "p%d", i);
+		assert(fiu_enable(name, 1, NULL, 0) == 0);
+		if (fiu_set_threads(name, i + 1, NULL, NULL) < 0)
+			break;
+	}
+	assert(i > 32 && i < 100);
+	for (i = 0; i < 100; i++) {
+		snprintf(name, sizeof(name), "p%d", i);
+		fiu_disable(name);
+	}
+}
+
+int main(void)
+{
+	fiu_init(0);
+
+	test_name();
+	test_tid();
+	test_tag();
+	test_many();
+
+	return 0;
+}
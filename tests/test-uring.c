@@ -0,0 +1,232 @@
+/* Test injecting failures in io_uring and Linux AIO operations, through the
+ * POSIX preload library. We make the system calls with syscall(), as we
+ * can't rely on liburing or libaio being available. */
+
+#include <fiu.h>
+
+#ifdef __linux__
+#include <linux/version.h>
+#endif
+
+#if defined __linux__ && LINUX_VERSION_CODE >= KERNEL_VERSION(5, 6, 0)
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <fiu-control.h>
+#include <linux/aio_abi.h>
+#include <linux/io_uring.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+static int fd;
+
+/* A minimal ring, with a single SQE. */
+static struct {
+	int fd;
+	unsigned int *sq_tail, *sq_mask, *sq_array;
+	unsigned int *cq_head, *cq_tail, *cq_mask;
+	struct io_uring_sqe *sqes;
+	struct io_uring_cqe *cqes;
+} ring;
+
+static int ring_init(void)
+{
+	struct io_uring_params p;
+	size_t size;
+	char *r;
+
+	memset(&p, 0, sizeof(p));
+	ring.fd = syscall(__NR_io_uring_setup, 4, &p);
+	if (ring.fd < 0)
+		return -1;
+	assert(p.features & IORING_FEAT_SINGLE_MMAP);
+
+	size = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+	if (p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe) > size)
+		size = p.cq_off.cqes +
+			p.cq_entries * sizeof(struct io_uring_cqe);
+
+	r = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, ring.fd,
+			IORING_OFF_SQ_RING);
+	assert(r != MAP_FAILED);
+	ring.sqes = mmap(NULL, p.sq_entries * sizeof(struct io_uring_sqe),
+			PROT_READ | PROT_WRITE, MAP_SHARED, ring.fd,
+			IORING_OFF_SQES);
+	assert(ring.sqes != MAP_FAILED);
+
+	ring.sq_tail = (unsigned int *) (r + p.sq_off.tail);
+	ring.sq_mask = (unsigned int *) (r + p.sq_off.ring_mask);
+	ring.sq_array = (unsigned int *) (r + p.sq_off.array);
+	ring.cq_head = (unsigned int *) (r + p.cq_off.head);
+	ring.cq_tail = (unsigned int *) (r + p.cq_off.tail);
+	ring.cq_mask = (unsigned int *) (r + p.cq_off.ring_mask);
+	ring.cqes = (struct io_uring_cqe *) (r + p.cq_off.cqes);
+	return 0;
+}
+
+/* Reads into buf with a single IORING_OP_READ, and returns its result, or
+ * -1 (with errno set) if io_uring_enter() fails. */
+static int ring_read(char *buf, unsigned int len)
+{
+	unsigned int tail = *ring.sq_tail, head;
+	struct io_uring_sqe *sqe = &ring.sqes[0];
+	struct io_uring_cqe *cqe;
+	int res;
+
+	memset(sqe, 0, sizeof(*sqe));
+	sqe->opcode = IORING_OP_READ;
+	sqe->fd = fd;
+	sqe->addr = (unsigned long) buf;
+	sqe->len = len;
+	sqe->user_data = 42;
+
+	ring.sq_array[tail & *ring.sq_mask] = 0;
+	__atomic_store_n(ring.sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+	if (syscall(__NR_io_uring_enter, ring.fd, 1, 1,
+			IORING_ENTER_GETEVENTS, NULL, 0) != 1) {
+		/* Take the SQE back, so the ring stays usable. */
+		__atomic_store_n(ring.sq_tail, tail, __ATOMIC_RELEASE);
+		return -1;
+	}
+
+	head = *ring.cq_head;
+	assert(__atomic_load_n(ring.cq_tail, __ATOMIC_ACQUIRE) == head + 1);
+	cqe = &ring.cqes[head & *ring.cq_mask];
+	assert(cqe->user_data == 42);
+	res = cqe->res;
+	__atomic_store_n(ring.cq_head, head + 1, __ATOMIC_RELEASE);
+
+	return res;
+}
+
+static void test_uring(void)
+{
+	char buf[64];
+	int i, r;
+
+	if (ring_init() != 0) {
+		/* io_uring may be disabled, or not allowed. */
+		assert(errno == ENOSYS || errno == EPERM);
+		printf("io_uring not available, skipping its tests\n");
+		return;
+	}
+
+	assert(ring_read(buf, sizeof(buf)) == sizeof(buf));
+
+	/* Completion errors: the read is not done. */
+	assert(fiu_enable("linux/uring/read", 1, (void *) EIO, 0) == 0);
+	memset(buf, 'x', sizeof(buf));
+	assert(ring_read(buf, sizeof(buf)) == -EIO);
+	assert(buf[0] == 'x');
+
+	/* Other opcodes are left alone. */
+	assert(fiu_disable("linux/uring/read") == 0);
+	assert(fiu_enable("linux/uring/write", 1, (void *) EIO, 0) == 0);
+	assert(ring_read(buf, sizeof(buf)) == sizeof(buf));
+	assert(buf[0] == 0);
+	assert(fiu_disable("linux/uring/write") == 0);
+
+	/* Short reads. */
+	assert(fiu_enable("linux/uring/read/reduce", 1, NULL, 0) == 0);
+	for (i = 0; i < 20; i++) {
+		r = ring_read(buf, sizeof(buf));
+		assert(r > 0 && r <= (int) sizeof(buf));
+	}
+	assert(fiu_disable("linux/uring/read/reduce") == 0);
+
+	/* Submission failures. */
+	assert(fiu_enable("linux/uring/enter", 1, (void *) EBUSY, 0) == 0);
+	assert(ring_read(buf, sizeof(buf)) == -1);
+	assert(errno == EBUSY);
+	assert(fiu_disable("linux/uring/enter") == 0);
+	assert(ring_read(buf, sizeof(buf)) == sizeof(buf));
+
+	assert(fiu_enable("linux/uring/setup", 1, (void *) EMFILE, 0) == 0);
+	assert(ring_init() == -1 && errno == EMFILE);
+	assert(fiu_disable("linux/uring/setup") == 0);
+
+	close(ring.fd);
+}
+
+/* Reads into buf with a single AIO pread, and returns its result, or -1
+ * (with errno set) if io_submit() fails. */
+static long aio_read(aio_context_t ctx, char *buf, unsigned int len)
+{
+	struct iocb iocb, *iocbs[1] = { &iocb };
+	struct io_event ev;
+
+	memset(&iocb, 0, sizeof(iocb));
+	iocb.aio_lio_opcode = IOCB_CMD_PREAD;
+	iocb.aio_fildes = fd;
+	iocb.aio_buf = (unsigned long) buf;
+	iocb.aio_nbytes = len;
+
+	if (syscall(__NR_io_submit, ctx, 1, iocbs) != 1)
+		return -1;
+
+	assert(syscall(__NR_io_getevents, ctx, 1, 1, &ev, NULL) == 1);
+	assert(ev.obj == (unsigned long) &iocb);
+	return ev.res;
+}
+
+static void test_aio(void)
+{
+	aio_context_t ctx = 0;
+	char buf[64];
+	long r;
+	int i;
+
+	if (syscall(__NR_io_setup, 4, &ctx) != 0) {
+		assert(errno == ENOSYS || errno == EPERM);
+		printf("AIO not available, skipping its tests\n");
+		return;
+	}
+
+	assert(aio_read(ctx, buf, sizeof(buf)) == sizeof(buf));
+
+	assert(fiu_enable("linux/aio/pread", 1, (void *) EIO, 0) == 0);
+	assert(aio_read(ctx, buf, sizeof(buf)) == -EIO);
+	assert(fiu_disable("linux/aio/pread") == 0);
+
+	assert(fiu_enable("linux/aio/pread/reduce", 1, NULL, 0) == 0);
+	for (i = 0; i < 20; i++) {
+		r = aio_read(ctx, buf, sizeof(buf));
+		assert(r > 0 && r <= (long) sizeof(buf));
+	}
+	assert(fiu_disable("linux/aio/pread/reduce") == 0);
+
+	assert(fiu_enable("linux/aio/submit", 1, (void *) EAGAIN, 0) == 0);
+	assert(aio_read(ctx, buf, sizeof(buf)) == -1);
+	assert(errno == EAGAIN);
+	assert(fiu_disable("linux/aio/submit") == 0);
+
+	syscall(__NR_io_destroy, ctx);
+}
+
+int main(void)
+{
+	fiu_init(0);
+
+	fd = open("/dev/zero", O_RDONLY);
+	assert(fd >= 0);
+
+	test_uring();
+	test_aio();
+
+	close(fd);
+	return 0;
+}
+
+#else
+
+int main(void)
+{
+	return 0;
+}
+
+#endif
@@ -0,0 +1,102 @@
+
+/* Test that the masks registered with fiu_watch() follow the enabled points
+ * of failure, including wildcards; and that fiu_fail_id() agrees with
+ * fiu_fail(). */
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#include <fiu-control.h>
+#include <fiu.h>
+
+/* 70 names, so the mask has two words. */
+#define NNAMES 70
+
+static const char *names[NNAMES];
+static char buf[NNAMES][32];
+static uint64_t mask[2];
+static uint64_t mask_ids[2];
+
+static int is_set(int i)
+{
+	return (mask[i / 64] >> (i % 64)) & 1;
+}
+
+static int count_set(void)
+{
+	int i, n = 0;
+
+	for (i = 0; i < NNAMES; i++)
+		n += is_set(i);
+	return n;
+}
+
+int main(void)
+{
+	struct fiu_watch *w;
+	int i;
+
+	fiu_init(0);
+
+	for (i = 0; i < NNAMES; i++) {
+		snprintf(buf[i], sizeof(buf[i]), "%s/%d",
+		         i % 2 ? "odd" : "even", i);
+		names[i] = buf[i];
+	}
+	names[1] = NULL;
+
+	/* Enabled before watching. */
+	fiu_enable("even/68", 1, NULL, 0);
+	assert(fiu_watch(names, NNAMES, mask) == 0);
+	assert(is_set(68));
+	assert(count_set() == 1);
+
+	fiu_enable("odd/*", 1, NULL, 0);
+	assert(count_set() == 1 + NNAMES / 2 - 1);
+	assert(is_set(69));
+	assert(!is_set(1));
+
+	fiu_enable("unrelated", 1, NULL, 0);
+	assert(count_set() == 1 + NNAMES / 2 - 1);
+
+	fiu_disable("odd/*");
+	assert(count_set() == 1);
+
+	fiu_enable_random("*", 1, NULL, 0, 0.5);
+	assert(count_set() == NNAMES - 1);
+
+	fiu_disable("*");
+	fiu_disable("even/68");
+	assert(count_set() == 0);
+
+	fiu_disable("unrelated");
+	assert(count_set() == 0);
+
+	/* Checking by ID. */
+	w = fiu_watch_ids(names, NNAMES, mask_ids);
+	assert(w != NULL);
+	assert(fiu_fail_id(NULL, 0) == 0);
+	assert(fiu_fail_id(w, NNAMES) == 0);
+
+	fiu_enable("odd/*", 1, (void *)1, 0);
+	fiu_enable("odd/3", 2, (void *)2, 0);
+	for (i = 0; i < NNAMES; i++) {
+		if (names[i] != NULL)
+			assert(fiu_fail_id(w, i) == fiu_fail(names[i]));
+	}
+	assert(fiu_fail_id(w, 1) == 0);
+	assert(fiu_fail_id(w, 3) == 2 && fiu_failinfo() == (void *)2);
+	assert(fiu_fail_id(w, 5) == 1 && fiu_failinfo() == (void *)1);
+
+	/* Replacing and disabling. */
+	fiu_enable("odd/3", 3, NULL, 0);
+	assert(fiu_fail_id(w, 3) == 3);
+	fiu_disable("odd/3");
+	assert(fiu_fail_id(w, 3) == 1);
+	fiu_disable("odd/*");
+	assert(fiu_fail_id(w, 3) == 0);
+	assert(fiu_fail_id(w, 5) == 0);
+
+	return 0;
+}
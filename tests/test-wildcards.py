@@ -2,6 +2,8 @@
 Test the behaviour of the wildcard failure points.
 """
 
+import random
+
 import fiu
 
 fiu.enable("a:b:c")
@@ -44,3 +46,127 @@ fiu.enable("*")
 assert fiu.fail("asdf")
 fiu.disable("*")
 assert not fiu.fail("asdf")
+
+
+# Only a trailing '*' is a wildcard, any other '*' or '?' is taken literally.
+fiu.enable("db/*/write")
+assert fiu.fail("db/*/write")
+assert not fiu.fail("db/users/write")
+fiu.enable("shard-??/io/*")
+assert fiu.fail("shard-??/io/read")
+assert not fiu.fail("shard-01/io/read")
+fiu.disable("db/*/write")
+fiu.disable("shard-??/io/*")
+assert not fiu.fail("db/*/write")
+assert not fiu.fail("shard-??/io/read")
+
+fiu.enable("a*b*")
+assert fiu.fail("a*b")
+assert fiu.fail("a*bxx")
+assert not fiu.fail("axxbyy")
+fiu.disable("a*b*")
+
+# A glob pattern without wildcards only matches the rest of it.
+fiu.enable("glob:plain")
+assert fiu.fail("plain")
+assert not fiu.fail("glob:plain")
+assert not fiu.fail("plainx")
+fiu.disable("glob:plain")
+assert not fiu.fail("plain")
+
+
+# Glob patterns: wildcards in the middle, and '?'.
+fiu.enable("glob:db/*/write")
+assert fiu.fail("db/users/write")
+assert fiu.fail("db/a/b/write")
+assert fiu.fail("db//write")
+assert not fiu.fail("db/users/read")
+assert not fiu.fail("db/users/write/x")
+assert not fiu.fail("xdb/users/write")
+
+fiu.enable("glob:shard-??/io/*")
+assert fiu.fail("shard-01/io/read")
+assert fiu.fail("shard-ab/io/")
+assert not fiu.fail("shard-1/io/read")
+assert not fiu.fail("shard-001/io/read")
+
+fiu.enable("glob:*-tmp-?")
+assert fiu.fail("a-tmp-1")
+assert fiu.fail("-tmp-x")
+assert fiu.fail("a-tmp-b-tmp-c")
+assert not fiu.fail("a-tmp-")
+assert not fiu.fail("a-tmp-12")
+
+# Disabling one leaves the others working.
+fiu.disable("glob:db/*/write")
+assert not fiu.fail("db/users/write")
+assert fiu.fail("shard-01/io/read")
+assert fiu.fail("a-tmp-1")
+
+fiu.disable("glob:shard-??/io/*")
+fiu.disable("glob:*-tmp-?")
+assert not fiu.fail("shard-01/io/read")
+assert not fiu.fail("a-tmp-1")
+
+# A trailing '*' can match nothing, and wildcards mix with final names.
+fiu.enable("glob:a*b*")
+assert fiu.fail("ab")
+assert fiu.fail("axxbyy")
+assert not fiu.fail("axx")
+fiu.enable("axb", failnum=2)
+assert fiu.fail("axb") == 2
+assert fiu.fail("ayb") == 1
+fiu.disable("axb")
+assert fiu.fail("axb") == 1
+fiu.disable("glob:a*b*")
+assert not fiu.fail("axb")
+
+
+# Many patterns that share prefixes, checked against names that match each
+# one of them, and some that don't match any.
+for i in range(100):
+    fiu.enable("glob:svc-%d/*/op-?%d" % (i, i), failnum=i + 1)
+
+for i in range(100):
+    assert fiu.fail("svc-%d/x/op-a%d" % (i, i)) == i + 1
+    assert fiu.fail("svc-%d/x/y/op-b%d" % (i, i)) == i + 1
+    assert not fiu.fail("svc-%d/x/op-%d" % (i, i))
+    assert not fiu.fail("svc-%d/x/op-ab%d" % (i, i))
+
+for i in range(100):
+    fiu.disable("glob:svc-%d/*/op-?%d" % (i, i))
+    assert not fiu.fail("svc-%d/x/op-a%d" % (i, i))
+
+
+# A pattern that needs a lot of DFA states, so we go over the limit and fall
+# back to matching one by one (and then start over), which must give the same
+# results.
+rnd = random.Random(42)
+fiu.enable("glob:*x" + "?" * 13)
+for i in range(3000):
+    s = "".join(rnd.choice("xy") for _ in range(30))
+    assert bool(fiu.fail(s)) == (s[-14] == "x"), s
+fiu.disable("glob:*x" + "?" * 13)
+
+
+# Lookups of names that are not enabled are mostly ruled out by a filter in
+# front of the table, check it keeps up as points come and go.
+for i in range(2000):
+    fiu.enable("final/%d" % i)
+    assert fiu.fail("final/%d" % i)
+for i in range(0, 2000, 2):
+    fiu.disable("final/%d" % i)
+for i in range(2000):
+    assert bool(fiu.fail("final/%d" % i)) == (i % 2 == 1)
+    assert not fiu.fail("final/%d/x" % i)
+for i in range(1, 2000, 2):
+    fiu.disable("final/%d" % i)
+
+# Wildcards with a long fixed prefix.
+prefix = "p" * 100
+fiu.enable(prefix + "/*")
+assert fiu.fail(prefix + "/x")
+assert not fiu.fail(prefix + "x")
+assert not fiu.fail(prefix[:70])
+fiu.disable(prefix + "/*")
+assert not fiu.fail(prefix + "/x")
@@ -1,7 +1,10 @@
 #!/usr/bin/env python3
 
 import os
+import shutil
+import signal
 import subprocess
+import tempfile
 import time
 
 def fiu_ctrl(p, args):
@@ -68,3 +71,121 @@ out, err = send_cmd(p, "test\n")
 assert out == '', out
 assert 'error' in err, err
 
+
+# List the enabled points.
+p = launch_sh()
+fiu_ctrl(p, ["-c", "enable name=p1,failinfo=3"])
+out = subprocess.check_output(
+        "./wrap fiu-ctrl -l".split() + [str(p.pid)],
+        universal_newlines = True)
+assert out == "enable name=p1,failnum=1,failinfo=3\n", out
+out, err = send_cmd(p, "test\n")
+assert out == 'test\n', out
+
+# Multiple processes at once.
+p1 = launch_sh()
+p2 = launch_sh()
+fiu_ctrl(p1, ["-c", "enable name=p2", str(p2.pid)])
+out = subprocess.check_output(
+        "./wrap fiu-ctrl -l".split() + [str(p1.pid), str(p2.pid)],
+        universal_newlines = True)
+assert sorted(out.splitlines()) == [
+        "%d: enable name=p2,failnum=1,failinfo=0" % p1.pid,
+        "%d: enable name=p2,failnum=1,failinfo=0" % p2.pid], out
+send_cmd(p1, "")
+send_cmd(p2, "")
+
+# A stale named pipe (nobody on the other side) must time out, and not
+# prevent the live process from being controlled.
+tmpdir = tempfile.mkdtemp()
+try:
+    stale = tmpdir + "/stale"
+    os.mkfifo(stale + ".in")
+    os.mkfifo(stale + ".out")
+    p = launch_sh()
+    start = time.time()
+    r = subprocess.run(
+            "./wrap fiu-ctrl -t 0.5 -c".split()
+            + ["enable name=posix/io/*", stale, str(p.pid)],
+            universal_newlines = True,
+            stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+    assert r.returncode == 1, r
+    assert (stale + ": timed out") in r.stderr, r.stderr
+    assert time.time() - start < 3
+    out, err = send_cmd(p, "test\n")
+    assert out == '', out
+    assert 'error' in err, err
+finally:
+    shutil.rmtree(tmpdir)
+
+# fiu-ls lists the processes that are listening, with the number of enabled
+# points of failure.
+p = launch_sh()
+fiu_ctrl(p, ["-c", "enable name=p1", "-c", "enable name=p2"])
+out = subprocess.check_output("./wrap fiu-ls -c".split(),
+        universal_newlines = True)
+assert ("%5d: [2] " % p.pid) in out, out
+send_cmd(p, "")
+
+# Stale named pipes, from a dead process and from a live one that is not
+# listening on them, must not be listed.
+tmpdir = tempfile.mkdtemp()
+try:
+    for pid in (2**22 + 1, os.getpid()):
+        os.mkfifo("%s/ctrl-%d.in" % (tmpdir, pid))
+        os.mkfifo("%s/ctrl-%d.out" % (tmpdir, pid))
+    out = subprocess.check_output(
+            "./wrap fiu-ls -t 0.2 -f".split() + [tmpdir + "/ctrl"],
+            universal_newlines = True)
+    assert out == '', out
+finally:
+    shutil.rmtree(tmpdir)
+
+# Lazy remote control: the named pipes are not created until the process
+# gets the signal, and then makes a call to libfiu.
+p = subprocess.Popen(
+        ["./wrap", "fiu-run", "-x", "-s", str(int(signal.SIGUSR1)), "cat"],
+        universal_newlines = True,
+        stdin=subprocess.PIPE, stdout=subprocess.PIPE,
+        stderr=subprocess.PIPE,
+        env=dict(os.environ, LC_ALL="C"))
+time.sleep(0.2)
+fifo_in = "%s/fiu-ctrl-%d.in" % (os.environ.get("TMPDIR", "/tmp"), p.pid)
+assert not os.path.exists(fifo_in)
+
+# cat is blocked reading, so it creates the pipes once it has something to
+# write.
+ctrl = subprocess.Popen(
+        ["./wrap", "fiu-ctrl", "-s", str(int(signal.SIGUSR1)),
+            "-c", "enable name=posix/io/rw/write", str(p.pid)])
+time.sleep(0.2)
+assert not os.path.exists(fifo_in)
+p.stdin.write("a\n")
+p.stdin.flush()
+assert p.stdout.readline() == "a\n"
+assert ctrl.wait(timeout = 5) == 0
+assert os.path.exists(fifo_in)
+
+out, err = send_cmd(p, "b\n")
+assert out == '', out
+assert 'error' in err, err
+
+# With -E, the programs it runs start with the points of failure enabled at
+# the time, so the write fails in cat after sh runs it. Without it, cat
+# starts with none.
+for inherit, fails in (([], False), (["-E"], True)):
+    p = subprocess.Popen(
+            ["./wrap", "fiu-run", "-x"] + inherit
+            + ["sh", "-c", "read x; exec cat"],
+            universal_newlines = True,
+            stdin=subprocess.PIPE, stdout=subprocess.PIPE,
+            stderr=subprocess.PIPE,
+            env=dict(os.environ, LC_ALL="C"))
+    time.sleep(0.2)
+    fiu_ctrl(p, ["-c", "enable name=posix/io/rw/write"])
+    out, err = send_cmd(p, "a\nb\n")
+    if fails:
+        assert out == '', out
+        assert 'error' in err, err
+    else:
+        assert out == 'b\n', out
@@ -19,3 +19,8 @@ set -ex
 
 # Deprecated option: -p.
 ( ! ./wrap fiu-run -x -e "posix/io/oc/open" -p 1 cat /dev/null )
+
+# Resolving all the original functions at startup.
+LD_BIND_NOW=1 ./wrap fiu-run -x true
+( ! LD_BIND_NOW=1 ./wrap fiu-run -x -c "enable name=posix/io/oc/open" \
+	cat /dev/null )
@@ -0,0 +1,355 @@
+
+/*
+ * fiu-ctrl - remote control of processes using libfiu.
+ *
+ * It sends remote control commands over the named pipes created by
+ * fiu_rc_fifo(), to all the target processes in parallel (see rc-client.c).
+ */
+
+#include <limits.h>    /* INT_MAX */
+#include <signal.h>    /* kill(), signal() */
+#include <stdbool.h>   /* bool */
+#include <stdio.h>     /* printf() and friends */
+#include <stdlib.h>    /* malloc(), strtod() */
+#include <string.h>    /* strcmp() and friends */
+#include <sys/types.h> /* pid_t */
+#include <unistd.h>    /* getopt() */
+
+#include "rc-client.h"
+
+static const char *help_msg =
+    "Usage: fiu-ctrl [options] PID [PID ...]\n"
+    "\n"
+    "The following options are supported:\n"
+    "\n"
+    "  -c command	Run the given libfiu remote control command (see "
+    "below for\n"
+    "		reference).\n"
+    "  -f ctrlpath	Use the named pipes with the given path as base name,"
+    " the\n"
+    "		process id will be appended (defaults to\n"
+    "		\"$TMPDIR/fiu-ctrl\", or \"/tmp/fiu-ctrl\" if $TMPDIR is "
+    "not set).\n"
+    "  -l		List the enabled failure points (same as -c list).\n"
+    "  -s signum	For processes that don't have the named pipes yet, "
+    "send them\n"
+    "		the given signal and wait for the pipes to be created (for\n"
+    "		processes run with fiu-run -s).\n"
+    "  -t timeout	Give up on a process if it has not replied after the "
+    "given\n"
+    "		number of seconds (defaults to 10).\n"
+    "  -v		Report the result for every process, not only the "
+    "failures.\n"
+    "\n"
+    "Remote control commands are of the form "
+    "'command param1=value1,param2=value2'.\n"
+    "Valid commands are:\n"
+    "\n"
+    " - 'enable name=NAME'\n"
+    "     Enables the NAME failure point unconditionally.\n"
+    " - 'enable_random name=NAME,probability=P'\n"
+    "     Enables the NAME failure point with a probability of P.\n"
+    " - 'enable_delay name=NAME,delay=D'\n"
+    "     Makes the NAME failure point delay for D microseconds instead "
+    "of failing.\n"
+    "     Takes optional 'dist=uniform,max=M' or 'dist=lognormal,sigma=S'\n"
+    "     parameters to randomize the delay, and 'probability=P'.\n"
+    " - 'disable name=NAME'\n"
+    "     Disables the NAME failure point.\n"
+    " - 'list'\n"
+    "     Lists the enabled failure points, one per line, in the same "
+    "format as\n"
+    "     the enable commands.\n"
+    " - 'ping'\n"
+    "     Does nothing, useful to check that the process is alive.\n"
+    "\n"
+    "All of the enable* can also optionally take 'failnum' and 'failinfo'\n"
+    "parameters, analogous to the ones taken by the C functions.\n"
+    "\n"
+    "The following options existed in the past but are deprecated and WILL "
+    "BE\n"
+    "REMOVED in future releases: -e, -p, -u, -i, and -d.\n"
+    "\n"
+    "\n"
+    "Examples:\n"
+    "\n"
+    "  fiu-ctrl -c 'enable_random name=posix/io/*,probability=0.25' \\\n"
+    "           -c 'enable_random name=libc/mm/*,probability=0.05' 12345\n"
+    "\n"
+    "Tell the process with pid 12345 to enable the failure point "
+    "'posix/io/read'\n"
+    "with a 25% of probability to fail, and the failure point "
+    "'libc/mm/malloc' with\n"
+    "a 5% of probability to fail.\n"
+    "\n"
+    "  fiu-ctrl -c 'disable name=posix/io/read' 12345\n"
+    "\n"
+    "Tell the same process to disable the previously enabled failure "
+    "point.\n"
+    "\n"
+    "You can control multiple processes at once by specifiying more than "
+    "one\n"
+    "process ID. They are all handled in parallel.\n";
+
+/* The commands to send, and the request we build from them. */
+static char **cmds = NULL;
+static int ncmds = 0;
+static char *request = NULL;
+
+static void add_cmd(char *cmd)
+{
+	cmds = realloc(cmds, sizeof(char *) * (ncmds + 1));
+	if (cmds == NULL) {
+		perror("realloc");
+		exit(1);
+	}
+	cmds[ncmds++] = cmd;
+}
+
+/*
+ * Deprecated options (-e, -p, -u, -i), which build an enable command out of
+ * multiple options.
+ */
+
+static const char *dep_name = NULL;
+static const char *dep_prob = NULL;
+static const char *dep_failnum = "1";
+static const char *dep_failinfo = "0";
+
+static void deprecated_warning(void)
+{
+	fprintf(stderr, "Warning: this option is deprecated and will be "
+	                "removed.\n");
+}
+
+static void add_deprecated_enable(void)
+{
+	char *cmd;
+	size_t len;
+
+	if (dep_name == NULL)
+		return;
+
+	len = strlen(dep_name) + strlen(dep_failnum) + strlen(dep_failinfo) +
+	      (dep_prob ? strlen(dep_prob) : 0) + 100;
+	cmd = xmalloc(len);
+
+	if (dep_prob) {
+		snprintf(cmd, len,
+		         "enable_random name=%s,failnum=%s,failinfo=%s,"
+		         "probability=0.%s",
+		         dep_name, dep_failnum, dep_failinfo, dep_prob);
+	} else {
+		snprintf(cmd, len, "enable name=%s,failnum=%s,failinfo=%s",
+		         dep_name, dep_failnum, dep_failinfo);
+	}
+
+	add_cmd(cmd);
+}
+
+static void dep_reset(void)
+{
+	dep_name = NULL;
+	dep_prob = NULL;
+	dep_failnum = "1";
+	dep_failinfo = "0";
+}
+
+/* Processes the reply of a finished target, printing the output of the
+ * commands and the results. Returns 0 if all commands succeeded, -1
+ * otherwise. */
+static int target_report(struct target *t, bool prefix, bool verbose)
+{
+	char *line, *state = NULL;
+	long result;
+	int cmd = 0, failed = 0;
+
+	if (t->error) {
+		fprintf(stderr, "%s: %s\n", t->name, t->error);
+		return -1;
+	}
+
+	for (line = strtok_r(t->reply, "\n", &state); line != NULL;
+	     line = strtok_r(NULL, "\n", &state)) {
+		if (!is_result(line, &result)) {
+			/* Output from the command (e.g. list). */
+			if (prefix)
+				printf("%s: %s\n", t->name, line);
+			else
+				printf("%s\n", line);
+			continue;
+		}
+
+		if (result != 0 && cmd < ncmds) {
+			fprintf(stderr,
+			        "%s: Command '%s' returned error (%ld)\n",
+			        t->name, cmds[cmd], result);
+			failed = 1;
+		}
+		cmd++;
+	}
+
+	if (cmd < ncmds) {
+		fprintf(stderr, "%s: Incomplete reply (%d of %d commands)\n",
+		        t->name, cmd, ncmds);
+		return -1;
+	}
+
+	if (failed)
+		return -1;
+
+	if (verbose)
+		fprintf(stderr, "%s: ok\n", t->name);
+
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	int opt, i, ntargets, failures;
+	size_t request_len = 0;
+	const char *fifo_prefix;
+	char *default_prefix = NULL;
+	double timeout = 10;
+	int lazy_signal = 0;
+	bool verbose = false;
+	struct target *targets;
+
+	if (getenv("TMPDIR") && *getenv("TMPDIR") != '\0') {
+		default_prefix = xasprintf2(getenv("TMPDIR"), "/fiu-ctrl");
+		fifo_prefix = default_prefix;
+	} else {
+		fifo_prefix = "/tmp/fiu-ctrl";
+	}
+
+	if (argc < 2) {
+		printf("%s", help_msg);
+		return 1;
+	}
+
+	while ((opt = getopt(argc, argv, "+c:e:p:u:i:d:f:ls:t:vh")) != -1) {
+		switch (opt) {
+		case 'c':
+			add_cmd(optarg);
+			break;
+		case 'l':
+			add_cmd("list");
+			break;
+		case 'e':
+			/* add the current one, if any */
+			deprecated_warning();
+			add_deprecated_enable();
+			dep_reset();
+			dep_name = optarg;
+			break;
+		case 'p':
+			deprecated_warning();
+			dep_prob = optarg;
+			break;
+		case 'u':
+			deprecated_warning();
+			dep_failnum = optarg;
+			break;
+		case 'i':
+			deprecated_warning();
+			dep_failinfo = optarg;
+			break;
+		case 'd':
+			deprecated_warning();
+			add_cmd(xasprintf2("disable name=", optarg));
+			dep_reset();
+			break;
+		case 'f':
+			fifo_prefix = optarg;
+			break;
+		case 's':
+			lazy_signal = atoi(optarg);
+			break;
+		case 't':
+			timeout = strtod(optarg, NULL);
+			if (timeout <= 0) {
+				fprintf(stderr, "Invalid timeout: %s\n",
+				        optarg);
+				return 1;
+			}
+			break;
+		case 'v':
+			verbose = true;
+			break;
+		case 'h':
+		default:
+			printf("%s", help_msg);
+			return 1;
+		}
+	}
+
+	/* add leftovers */
+	add_deprecated_enable();
+
+	/* Build the request, with all the commands one per line. */
+	for (i = 0; i < ncmds; i++)
+		request_len += strlen(cmds[i]) + 1;
+	request = xmalloc(request_len + 1);
+	request[0] = '\0';
+	for (i = 0; i < ncmds; i++) {
+		strcat(request, cmds[i]);
+		strcat(request, "\n");
+	}
+
+	/* Find out the targets. */
+	targets = xmalloc(sizeof(struct target) * (argc - optind + 1));
+	ntargets = 0;
+
+	for (i = optind; i < argc; i++) {
+		struct target *t = &targets[ntargets];
+		char *pid_prefix, *end;
+		long pid;
+
+		pid_prefix = xmalloc(strlen(fifo_prefix) + strlen(argv[i]) + 2);
+		sprintf(pid_prefix, "%s-%s", fifo_prefix, argv[i]);
+		pid = strtol(argv[i], &end, 10);
+
+		if (has_ctrl_fifo(argv[i])) {
+			/* A named pipe prefix given directly. */
+			target_init(t, argv[i], argv[i]);
+		} else if (*end == '\0' && pid > 0 && pid <= INT_MAX &&
+		           kill((pid_t)pid, 0) == 0 && has_ctrl_fifo(pid_prefix)) {
+			target_init(t, argv[i], pid_prefix);
+		} else if (*end == '\0' && pid > 0 && pid <= INT_MAX &&
+		           lazy_signal > 0 &&
+		           kill((pid_t)pid, lazy_signal) == 0) {
+			/* The process will create the pipes on demand, see
+			 * fiu_rc_fifo_lazy(). */
+			target_init(t, argv[i], pid_prefix);
+			t->wait_fifo = true;
+		} else {
+			printf("Error: unknown pid or named pipe %s, "
+			       "skipping\n",
+			       argv[i]);
+			printf("Note that options must come before the PID\n");
+			free(pid_prefix);
+			continue;
+		}
+
+		free(pid_prefix);
+		ntargets++;
+	}
+
+	if (ncmds == 0 || ntargets == 0)
+		return 0;
+
+	/* A target going away while we write to it must not kill us. */
+	signal(SIGPIPE, SIG_IGN);
+
+	run_targets(targets, ntargets, request, timeout);
+
+	failures = 0;
+	for (i = 0; i < ntargets; i++) {
+		if (target_report(&targets[i], ntargets > 1, verbose) != 0)
+			failures++;
+	}
+
+	free(default_prefix);
+
+	return failures ? 1 : 0;
+}
@@ -0,0 +1,483 @@
+
+/*
+ * fiu-ls - list processes that can be controlled with fiu-ctrl.
+ *
+ * It finds the control pipes with a single scan of their directory, skips
+ * the ones left behind by dead processes, and checks that the others are
+ * really listening by sending them a "ping" (and optionally a "list" to
+ * count the enabled failure points), all in parallel (see rc-client.c).
+ *
+ * With -p, it lists the failure points recorded in a binary instead (see
+ * fiu.h), reading them from its ELF file without running it.
+ */
+
+#include <dirent.h>    /* opendir(), readdir() */
+#include <elf.h>       /* Elf*_Ehdr, Elf*_Shdr */
+#include <errno.h>     /* errno */
+#include <fcntl.h>     /* open() */
+#include <signal.h>    /* kill(), signal() */
+#include <stdbool.h>   /* bool */
+#include <stdio.h>     /* printf() and friends */
+#include <stdlib.h>    /* malloc(), qsort() */
+#include <string.h>    /* strcmp() and friends */
+#include <sys/stat.h>  /* fstat() */
+#include <sys/types.h> /* pid_t */
+#include <unistd.h>    /* getopt(), read() */
+
+#include "rc-client.h"
+
+static const char *help_msg =
+    "Usage: fiu-ls [options]\n"
+    "       fiu-ls -p binary\n"
+    "\n"
+    "The following options are supported:\n"
+    "\n"
+    "  -p binary	List the failure points recorded in the given binary "
+    "(program\n"
+    "		or library), instead of the processes.\n"
+    "  -c		Show how many failure points each process has enabled.\n"
+    "  -f ctrlpath	Set the default prefix for remote control over named "
+    "pipes.\n"
+    "		(defaults to \"$TMPDIR/fiu-ctrl\", or \"/tmp/fiu-ctrl\" if "
+    "$TMPDIR is\n"
+    "		not set, which is usually correct if the program was run "
+    "using\n"
+    "		fiu-run(1)).\n"
+    "  -t timeout	Consider a process is not available if it has not "
+    "replied\n"
+    "		after the given number of seconds (defaults to 1).\n";
+
+struct proc {
+	pid_t pid;
+	struct target target;
+
+	/* Number of enabled failure points, only if counting. */
+	int nenabled;
+};
+
+static int proc_cmp(const void *a, const void *b)
+{
+	const struct proc *pa = a, *pb = b;
+
+	return (pa->pid > pb->pid) - (pa->pid < pb->pid);
+}
+
+/* If the directory entry name is of the form "<base>-<PID>.in", returns the
+ * PID; otherwise returns -1. */
+static pid_t pid_from_entry(const char *name, const char *base,
+                            size_t base_len)
+{
+	const char *p;
+	char *end;
+	long pid;
+
+	if (strncmp(name, base, base_len) != 0 || name[base_len] != '-')
+		return -1;
+
+	p = name + base_len + 1;
+	if (*p < '0' || *p > '9')
+		return -1;
+
+	pid = strtol(p, &end, 10);
+	if (strcmp(end, ".in") != 0 || pid <= 0 || (pid_t)pid != pid)
+		return -1;
+
+	return pid;
+}
+
+/* Finds the processes that have control pipes with the given prefix, and
+ * that are still alive. */
+static struct proc *find_procs(const char *fifo_prefix, int *nprocs)
+{
+	struct proc *procs = NULL;
+	int n = 0, size = 0;
+	char *dir_path, *base, *pid_prefix;
+	size_t base_len;
+	DIR *dir;
+	struct dirent *ent;
+	pid_t pid;
+
+	/* Split the prefix into the directory and the base name. */
+	dir_path = xasprintf2(fifo_prefix, "");
+	base = strrchr(dir_path, '/');
+	if (base == NULL) {
+		base = dir_path;
+		dir = opendir(".");
+	} else if (base == dir_path) {
+		base++;
+		dir = opendir("/");
+	} else {
+		*base = '\0';
+		base++;
+		dir = opendir(dir_path);
+	}
+	base_len = strlen(base);
+
+	if (dir == NULL) {
+		free(dir_path);
+		*nprocs = 0;
+		return NULL;
+	}
+
+	pid_prefix = xmalloc(strlen(fifo_prefix) + 30);
+
+	while ((ent = readdir(dir)) != NULL) {
+		pid = pid_from_entry(ent->d_name, base, base_len);
+		if (pid < 0)
+			continue;
+
+		/* Pipes left behind by processes that are gone. This is much
+		 * cheaper than waiting for them to time out. */
+		if (kill(pid, 0) != 0 && errno == ESRCH)
+			continue;
+
+		if (n == size) {
+			size = size * 2 + 64;
+			procs = realloc(procs, sizeof(struct proc) * size);
+			if (procs == NULL) {
+				perror("realloc");
+				exit(1);
+			}
+		}
+
+		sprintf(pid_prefix, "%s-%d", fifo_prefix, (int)pid);
+		procs[n].pid = pid;
+		procs[n].nenabled = 0;
+		target_init(&procs[n].target, NULL, pid_prefix);
+		n++;
+	}
+
+	closedir(dir);
+	free(pid_prefix);
+	free(dir_path);
+
+	/* Sort them by PID, so the output is stable. */
+	if (n > 0)
+		qsort(procs, n, sizeof(struct proc), proc_cmp);
+
+	*nprocs = n;
+	return procs;
+}
+
+/* Checks the reply to our request: the ping must have succeeded, and if we
+ * asked for the list, we count its lines. */
+static bool check_reply(struct proc *p, bool count)
+{
+	char *line, *state = NULL;
+	long result;
+	int nresults = 0;
+
+	if (p->target.error != NULL || p->target.reply == NULL)
+		return false;
+
+	for (line = strtok_r(p->target.reply, "\n", &state); line != NULL;
+	     line = strtok_r(NULL, "\n", &state)) {
+		if (!is_result(line, &result)) {
+			p->nenabled++;
+			continue;
+		}
+
+		if (result != 0)
+			return false;
+		nresults++;
+	}
+
+	return nresults == (count ? 2 : 1);
+}
+
+static void print_proc(const struct proc *p, bool count)
+{
+	char path[64], cmdline[4096];
+	ssize_t len = 0, r, i;
+	int fd;
+
+	sprintf(path, "/proc/%d/cmdline", (int)p->pid);
+	fd = open(path, O_RDONLY);
+	if (fd >= 0) {
+		while (len < (ssize_t)sizeof(cmdline) - 1) {
+			r = read(fd, cmdline + len, sizeof(cmdline) - 1 - len);
+			if (r <= 0)
+				break;
+			len += r;
+		}
+		close(fd);
+	}
+
+	/* The arguments are separated by \0, and the last one ends with it
+	 * too. */
+	for (i = 0; i < len; i++) {
+		if (cmdline[i] == '\0')
+			cmdline[i] = ' ';
+	}
+	while (len > 0 && cmdline[len - 1] == ' ')
+		len--;
+	cmdline[len] = '\0';
+
+	if (count)
+		printf("%5d: [%d] %s\n", (int)p->pid, p->nenabled, cmdline);
+	else
+		printf("%5d: %s\n", (int)p->pid, cmdline);
+}
+
+/*
+ * Failure points recorded in binaries
+ */
+
+/* Reads the whole file, returns NULL on errors. */
+static unsigned char *read_file(const char *path, size_t *size)
+{
+	unsigned char *buf;
+	struct stat st;
+	size_t len = 0;
+	ssize_t r;
+	int fd;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0 || fstat(fd, &st) != 0) {
+		perror(path);
+		if (fd >= 0)
+			close(fd);
+		return NULL;
+	}
+
+	buf = xmalloc(st.st_size + 1);
+	while (len < (size_t)st.st_size) {
+		r = read(fd, buf + len, st.st_size - len);
+		if (r <= 0) {
+			if (r < 0 && errno == EINTR)
+				continue;
+			break;
+		}
+		len += r;
+	}
+	close(fd);
+
+	*size = len;
+	return buf;
+}
+
+/* The parts of a section header we need, for both ELF classes. */
+struct section {
+	uint64_t name, offset, size;
+};
+
+static bool get_section(const unsigned char *buf, size_t size, bool is64,
+                        uint64_t shoff, uint64_t shentsize, unsigned int i,
+                        struct section *s)
+{
+	uint64_t pos = shoff + shentsize * i;
+
+	if (is64) {
+		Elf64_Shdr sh;
+
+		if (shentsize < sizeof(sh) || pos > size || size - pos < sizeof(sh))
+			return false;
+		memcpy(&sh, buf + pos, sizeof(sh));
+		s->name = sh.sh_name;
+		s->offset = sh.sh_offset;
+		s->size = sh.sh_type == SHT_NOBITS ? 0 : sh.sh_size;
+	} else {
+		Elf32_Shdr sh;
+
+		if (shentsize < sizeof(sh) || pos > size || size - pos < sizeof(sh))
+			return false;
+		memcpy(&sh, buf + pos, sizeof(sh));
+		s->name = sh.sh_name;
+		s->offset = sh.sh_offset;
+		s->size = sh.sh_type == SHT_NOBITS ? 0 : sh.sh_size;
+	}
+
+	return s->offset <= size && size - s->offset >= s->size;
+}
+
+/* Finds the section with the given name. Only files of the same byte order
+ * as ours are supported. */
+static bool find_section(const unsigned char *buf, size_t size,
+                         const char *name, struct section *found)
+{
+	uint64_t shoff, shentsize;
+	unsigned int shnum, shstrndx, i;
+	struct section strtab, s;
+	bool is64;
+
+	if (size < EI_NIDENT || memcmp(buf, ELFMAG, SELFMAG) != 0)
+		return false;
+
+	{
+		const unsigned int one = 1;
+		unsigned char data = *(const unsigned char *)&one == 1
+		                         ? ELFDATA2LSB
+		                         : ELFDATA2MSB;
+
+		if (buf[EI_DATA] != data)
+			return false;
+	}
+
+	is64 = buf[EI_CLASS] == ELFCLASS64;
+	if (is64) {
+		Elf64_Ehdr eh;
+
+		if (size < sizeof(eh))
+			return false;
+		memcpy(&eh, buf, sizeof(eh));
+		shoff = eh.e_shoff;
+		shentsize = eh.e_shentsize;
+		shnum = eh.e_shnum;
+		shstrndx = eh.e_shstrndx;
+	} else if (buf[EI_CLASS] == ELFCLASS32) {
+		Elf32_Ehdr eh;
+
+		if (size < sizeof(eh))
+			return false;
+		memcpy(&eh, buf, sizeof(eh));
+		shoff = eh.e_shoff;
+		shentsize = eh.e_shentsize;
+		shnum = eh.e_shnum;
+		shstrndx = eh.e_shstrndx;
+	} else {
+		return false;
+	}
+
+	if (!get_section(buf, size, is64, shoff, shentsize, shstrndx,
+	                 &strtab))
+		return false;
+
+	for (i = 0; i < shnum; i++) {
+		if (!get_section(buf, size, is64, shoff, shentsize, i, &s))
+			continue;
+		if (s.name >= strtab.size)
+			continue;
+		if (strncmp((const char *)buf + strtab.offset + s.name, name,
+		            strtab.size - s.name) == 0) {
+			*found = s;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static int str_cmp(const void *a, const void *b)
+{
+	return strcmp(*(const char *const *)a, *(const char *const *)b);
+}
+
+/* Lists the failure points recorded in the given binary, sorted and without
+ * duplicates. Returns 0 on success (even if there are none), 1 on errors. */
+static int list_points(const char *path)
+{
+	unsigned char *buf;
+	size_t size, pos, n = 0, i;
+	struct section s;
+	const char **names;
+	char *sec;
+
+	buf = read_file(path, &size);
+	if (buf == NULL)
+		return 1;
+
+	if (size < SELFMAG || memcmp(buf, ELFMAG, SELFMAG) != 0) {
+		fprintf(stderr, "%s: not an ELF file\n", path);
+		free(buf);
+		return 1;
+	}
+
+	if (!find_section(buf, size, "fiu_points", &s)) {
+		free(buf);
+		return 0;
+	}
+
+	/* The records are consecutive \0-terminated names; make sure the last
+	 * one is terminated, there is room for it in buf. */
+	sec = (char *)buf + s.offset;
+	sec[s.size] = '\0';
+
+	names = xmalloc(sizeof(char *) * (s.size + 1));
+	for (pos = 0; pos < s.size; pos += strlen(sec + pos) + 1) {
+		/* Names that were not literals are recorded as "". */
+		if (sec[pos] != '\0')
+			names[n++] = sec + pos;
+	}
+
+	qsort(names, n, sizeof(char *), str_cmp);
+	for (i = 0; i < n; i++) {
+		if (i == 0 || strcmp(names[i], names[i - 1]) != 0)
+			printf("%s\n", names[i]);
+	}
+
+	free(names);
+	free(buf);
+	return 0;
+}
+
+int main(int argc, char **argv)
+{
+	int opt, i, nprocs;
+	const char *fifo_prefix;
+	char *default_prefix = NULL;
+	double timeout = 1;
+	bool count = false;
+	struct proc *procs;
+	struct target *targets;
+
+	if (getenv("TMPDIR") && *getenv("TMPDIR") != '\0') {
+		default_prefix = xasprintf2(getenv("TMPDIR"), "/fiu-ctrl");
+		fifo_prefix = default_prefix;
+	} else {
+		fifo_prefix = "/tmp/fiu-ctrl";
+	}
+
+	while ((opt = getopt(argc, argv, "p:cf:t:h")) != -1) {
+		switch (opt) {
+		case 'p':
+			return list_points(optarg);
+		case 'c':
+			count = true;
+			break;
+		case 'f':
+			fifo_prefix = optarg;
+			break;
+		case 't':
+			timeout = strtod(optarg, NULL);
+			if (timeout <= 0) {
+				fprintf(stderr, "Invalid timeout: %s\n",
+				        optarg);
+				return 1;
+			}
+			break;
+		case 'h':
+		default:
+			printf("%s", help_msg);
+			return 1;
+		}
+	}
+
+	procs = find_procs(fifo_prefix, &nprocs);
+	if (nprocs == 0)
+		return 0;
+
+	/* run_targets() wants them contiguous. */
+	targets = xmalloc(sizeof(struct target) * nprocs);
+	for (i = 0; i < nprocs; i++)
+		targets[i] = procs[i].target;
+
+	/* A process going away while we write to it must not kill us. */
+	signal(SIGPIPE, SIG_IGN);
+
+	run_targets(targets, nprocs, count ? "ping\nlist\n" : "ping\n",
+	            timeout);
+
+	for (i = 0; i < nprocs; i++) {
+		procs[i].target = targets[i];
+		if (check_reply(&procs[i], count))
+			print_proc(&procs[i], count);
+		target_free(&procs[i].target);
+	}
+
+	free(targets);
+	free(procs);
+	free(default_prefix);
+
+	return 0;
+}
+
@@ -0,0 +1,331 @@
+
+/*
+ * Client side of libfiu's remote control over named pipes (see libfiu's
+ * fiu-rc.c for details on the protocol).
+ *
+ * All the targets are handled in parallel: the pipes are opened in
+ * non-blocking mode, and the requests and replies are multiplexed using
+ * poll(). Each target has a deadline, so a wedged process can't hang the
+ * whole run.
+ */
+
+#include <errno.h>     /* errno */
+#include <fcntl.h>     /* open() */
+#include <poll.h>      /* poll() */
+#include <stdio.h>     /* perror() */
+#include <stdlib.h>    /* malloc(), strtol() */
+#include <string.h>    /* strcpy() and friends */
+#include <sys/stat.h>  /* stat() */
+#include <time.h>      /* clock_gettime() */
+#include <unistd.h>    /* read(), write() */
+
+#include "rc-client.h"
+
+/* How many targets we talk to at the same time. Each one uses two file
+ * descriptors, so this keeps us well below the usual limits. */
+#define MAX_IN_FLIGHT 256
+
+/* How often we retry connecting to a target whose control thread is not
+ * waiting for us yet (e.g. it is still busy with another client). */
+#define RECONNECT_MS 10
+
+static const char *request = NULL;
+static size_t request_len = 0;
+
+static double now(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+void *xmalloc(size_t size)
+{
+	void *p = malloc(size);
+	if (p == NULL) {
+		perror("malloc");
+		exit(1);
+	}
+	return p;
+}
+
+char *xasprintf2(const char *a, const char *b)
+{
+	char *s = xmalloc(strlen(a) + strlen(b) + 1);
+	strcpy(s, a);
+	strcat(s, b);
+	return s;
+}
+
+bool has_ctrl_fifo(const char *prefix)
+{
+	struct stat st;
+	char *path;
+	bool r;
+
+	path = xasprintf2(prefix, ".out");
+	r = stat(path, &st) == 0 && S_ISFIFO(st.st_mode);
+	free(path);
+
+	return r;
+}
+
+void target_init(struct target *t, const char *name, const char *prefix)
+{
+	memset(t, 0, sizeof(*t));
+	t->name = name;
+	t->path_in = xasprintf2(prefix, ".in");
+	t->path_out = xasprintf2(prefix, ".out");
+	t->fd_in = t->fd_out = -1;
+}
+
+static void target_close(struct target *t)
+{
+	if (t->fd_in >= 0)
+		close(t->fd_in);
+	if (t->fd_out >= 0)
+		close(t->fd_out);
+	t->fd_in = t->fd_out = -1;
+}
+
+void target_free(struct target *t)
+{
+	target_close(t);
+	free(t->path_in);
+	free(t->path_out);
+	free(t->reply);
+	t->path_in = t->path_out = t->reply = NULL;
+}
+
+static void target_fail(struct target *t, const char *error)
+{
+	target_close(t);
+	t->error = error;
+	t->state = T_DONE;
+}
+
+/* Tries to connect to the target. The control thread opens the "in" pipe for
+ * reading and then the "out" one for writing, so we open "out" first (which
+ * never blocks in non-blocking mode) and then "in", which fails with ENXIO
+ * if the thread is not waiting for us. */
+static void target_connect(struct target *t)
+{
+	if (t->fd_out < 0) {
+		t->fd_out = open(t->path_out, O_RDONLY | O_NONBLOCK);
+		if (t->fd_out < 0) {
+			if (errno == ENOENT && t->wait_fifo) {
+				/* Not created yet, retry later. */
+				t->state = T_CONNECTING;
+				return;
+			}
+
+			target_fail(t, strerror(errno));
+			return;
+		}
+	}
+
+	t->fd_in = open(t->path_in, O_WRONLY | O_NONBLOCK);
+	if (t->fd_in < 0) {
+		if (errno == ENXIO || (errno == ENOENT && t->wait_fifo)) {
+			/* Not ready yet, retry later. */
+			t->state = T_CONNECTING;
+			return;
+		}
+
+		target_fail(t, strerror(errno));
+		return;
+	}
+
+	t->state = T_SENDING;
+}
+
+static void target_send(struct target *t)
+{
+	ssize_t r;
+
+	r = write(t->fd_in, request + t->sent, request_len - t->sent);
+	if (r < 0) {
+		if (errno == EAGAIN || errno == EINTR)
+			return;
+		target_fail(t, strerror(errno));
+		return;
+	}
+
+	t->sent += r;
+	if (t->sent == request_len) {
+		/* Closing our end tells the control thread there are no more
+		 * commands; it will close its end after replying. */
+		close(t->fd_in);
+		t->fd_in = -1;
+		t->state = T_RECEIVING;
+	}
+}
+
+static void target_receive(struct target *t)
+{
+	ssize_t r;
+
+	if (t->reply_size - t->reply_len < 1024) {
+		t->reply_size = t->reply_size * 2 + 4096;
+		t->reply = realloc(t->reply, t->reply_size);
+		if (t->reply == NULL) {
+			perror("realloc");
+			exit(1);
+		}
+	}
+
+	r = read(t->fd_out, t->reply + t->reply_len,
+	         t->reply_size - t->reply_len - 1);
+	if (r < 0) {
+		if (errno == EAGAIN || errno == EINTR)
+			return;
+		target_fail(t, strerror(errno));
+		return;
+	}
+
+	if (r == 0) {
+		/* The control thread closed its end, we're done. */
+		if (t->state != T_RECEIVING) {
+			target_fail(t, "connection closed before the end of "
+			               "the request");
+			return;
+		}
+
+		t->reply[t->reply_len] = '\0';
+		target_close(t);
+		t->state = T_DONE;
+		return;
+	}
+
+	t->reply_len += r;
+}
+
+bool is_result(const char *line, long *result)
+{
+	char *end;
+
+	if (*line == '\0')
+		return false;
+
+	*result = strtol(line, &end, 10);
+	return *end == '\0';
+}
+
+void run_targets(struct target *targets, int ntargets, const char *req,
+                 double timeout)
+{
+	struct pollfd *pfds;
+	struct target **pfd_targets;
+	int next = 0, in_flight = 0, done = 0;
+	int i, npfds, poll_timeout;
+	double t_now, next_deadline;
+	bool connecting;
+
+	request = req;
+	request_len = strlen(req);
+
+	pfds = xmalloc(sizeof(struct pollfd) * MAX_IN_FLIGHT * 2);
+	pfd_targets = xmalloc(sizeof(struct target *) * MAX_IN_FLIGHT * 2);
+
+	while (done < ntargets) {
+		/* Start new targets, if we have room. */
+		while (next < ntargets && in_flight < MAX_IN_FLIGHT) {
+			struct target *t = &targets[next++];
+			t->deadline = now() + timeout;
+			target_connect(t);
+			if (t->state == T_DONE)
+				done++;
+			else
+				in_flight++;
+		}
+
+		/* Build the poll set, retrying connections and checking the
+		 * deadlines along the way. */
+		npfds = 0;
+		connecting = false;
+		t_now = now();
+		next_deadline = t_now + timeout;
+
+		for (i = 0; i < next; i++) {
+			struct target *t = &targets[i];
+
+			if (t->state == T_DONE)
+				continue;
+
+			if (t_now >= t->deadline) {
+				target_fail(t, "timed out");
+				in_flight--;
+				done++;
+				continue;
+			}
+
+			if (t->state == T_CONNECTING) {
+				target_connect(t);
+				if (t->state == T_DONE) {
+					in_flight--;
+					done++;
+					continue;
+				}
+			}
+
+			if (t->deadline < next_deadline)
+				next_deadline = t->deadline;
+
+			if (t->state == T_CONNECTING) {
+				connecting = true;
+				continue;
+			}
+
+			if (t->state == T_SENDING) {
+				pfds[npfds].fd = t->fd_in;
+				pfds[npfds].events = POLLOUT;
+				pfd_targets[npfds] = t;
+				npfds++;
+			}
+
+			/* We read while sending too, otherwise the control
+			 * thread could block writing replies while we block
+			 * writing requests. */
+			pfds[npfds].fd = t->fd_out;
+			pfds[npfds].events = POLLIN;
+			pfd_targets[npfds] = t;
+			npfds++;
+		}
+
+		if (done >= ntargets)
+			break;
+
+		poll_timeout = (next_deadline - t_now) * 1000 + 1;
+		if (connecting && poll_timeout > RECONNECT_MS)
+			poll_timeout = RECONNECT_MS;
+
+		if (poll(pfds, npfds, poll_timeout) < 0) {
+			if (errno == EINTR)
+				continue;
+			perror("poll");
+			exit(1);
+		}
+
+		for (i = 0; i < npfds; i++) {
+			struct target *t = pfd_targets[i];
+
+			if (t->state == T_DONE || pfds[i].revents == 0)
+				continue;
+
+			if (pfds[i].fd == t->fd_in)
+				target_send(t);
+			else if (pfds[i].fd == t->fd_out)
+				target_receive(t);
+
+			if (t->state == T_DONE) {
+				in_flight--;
+				done++;
+			}
+		}
+	}
+
+	free(pfds);
+	free(pfd_targets);
+}
+
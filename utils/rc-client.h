@@ -0,0 +1,72 @@
+
+/*
+ * Client side of libfiu's remote control over named pipes, shared by
+ * fiu-ctrl and fiu-ls.
+ */
+
+#ifndef _RC_CLIENT_H
+#define _RC_CLIENT_H
+
+#include <stdbool.h>   /* bool */
+#include <stddef.h>    /* size_t */
+
+enum target_state {
+	T_PENDING = 0,
+	T_CONNECTING,
+	T_SENDING,
+	T_RECEIVING,
+	T_DONE,
+};
+
+struct target {
+	/* How to refer to the target when reporting. */
+	const char *name;
+
+	char *path_in;
+	char *path_out;
+
+	/* Wait for the pipes to be created, instead of failing if they don't
+	 * exist (for processes in lazy mode, see fiu_rc_fifo_lazy()). */
+	bool wait_fifo;
+
+	enum target_state state;
+	int fd_in;
+	int fd_out;
+	double deadline;
+
+	/* How much of the request we have written so far. */
+	size_t sent;
+
+	/* The reply, as read so far; once done, it is NUL-terminated. */
+	char *reply;
+	size_t reply_len;
+	size_t reply_size;
+
+	/* Human-readable error, NULL if there was none. */
+	const char *error;
+};
+
+void *xmalloc(size_t size);
+char *xasprintf2(const char *a, const char *b);
+
+/* Checks if there is a control pipe with the given prefix. */
+bool has_ctrl_fifo(const char *prefix);
+
+/* Initializes the target to talk over the pipes with the given prefix. */
+void target_init(struct target *t, const char *name, const char *prefix);
+
+/* Frees the resources used by the target (but not the target itself). */
+void target_free(struct target *t);
+
+/* Checks whether a reply line is a result (just a number). */
+bool is_result(const char *line, long *result);
+
+/* Sends the request to all the targets and gets their replies, handling
+ * them in parallel. Each target has the given timeout, in seconds. When it
+ * returns, all targets are in the T_DONE state, and either have the reply or
+ * an error. */
+void run_targets(struct target *targets, int ntargets, const char *request,
+                 double timeout);
+
+#endif
+